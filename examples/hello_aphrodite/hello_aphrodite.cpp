@@ -28,6 +28,7 @@ void HelloAphrodite::setupEngine()
         // for debugging purpose
         .setEnableUIBreadcrumbs(false)
         .setResourceForceUncached(true)
+        .setResidencyBudgets(getOptions().getResidencyBudgets())
         .setEnableDeviceDebug(false);
 
     m_pEngine = aph::Engine::Create(config);
@@ -1,6 +1,7 @@
 #include "allocator.h"
+#include "common/debug.h"
 #include "common/hash.h"
-#include "global/globalManager.h"
+#include "common/smallVector.h"
 
 #include <algorithm>
 #include <atomic>
@@ -24,101 +25,466 @@ constexpr T alignTo(T size, T alignment) noexcept
 namespace aph::memory
 {
 
-// Retrieve the allocation tracker from the global manager if available
-AllocationTracker* getActiveAllocationTracker()
+namespace
+{
+constexpr uint32_t ThreadRingCapacity = 1024;
+constexpr uint32_t NoTag              = ~0u;
+
+std::atomic<uint64_t> s_nextTrackerId{ 1 };
+
+void appendJsonString(std::string& out, std::string_view str)
 {
-    return APH_GLOBAL_MANAGER.getSubsystem<AllocationTracker>(GlobalManager::MEMORY_TRACKER_NAME);
+    out += '"';
+    for (char c : str)
+    {
+        if (c == '"' || c == '\\')
+        {
+            out += '\\';
+        }
+        out += c;
+    }
+    out += '"';
 }
+} // namespace
 
-void AllocationTracker::trackAllocation(const AllocationStat& stat)
+auto getSourceSubsystem(std::string_view file) -> std::string_view
+{
+    std::string_view parent;
+    std::string_view previous;
+    std::string_view subsystem;
+    std::size_t start = 0;
+    while (true)
+    {
+        const std::size_t end = file.find_first_of("/\\", start);
+        if (end == std::string_view::npos)
+        {
+            break;
+        }
+        const std::string_view component = file.substr(start, end - start);
+        if (previous == "src")
+        {
+            subsystem = component;
+        }
+        parent   = component;
+        previous = component;
+        start    = end + 1;
+    }
+
+    if (!subsystem.empty())
+    {
+        return subsystem;
+    }
+    return parent.empty() ? std::string_view{ "unknown" } : parent;
+}
+
+// Single producer single consumer ring. The owning thread appends records, whoever holds the tracker mutex
+// consumes them.
+struct AllocationTracker::ThreadRing
+{
+    alignas(64) std::atomic<uint32_t> head{ 0 };
+    alignas(64) std::atomic<uint32_t> tail{ 0 };
+    std::atomic<bool> retired{ false };
+    AllocationRecord records[ThreadRingCapacity];
+};
+
+// Ring of the calling thread for the tracker it last recorded to. Marks the ring retired when the thread
+// exits so that the tracker can drop it once it is drained.
+struct AllocationTracker::ThreadRingRef
+{
+    ~ThreadRingRef()
+    {
+        if (pRing)
+        {
+            pRing->retired.store(true, std::memory_order_release);
+        }
+    }
+
+    uint64_t trackerId = 0;
+    std::shared_ptr<ThreadRing> pRing;
+};
+
+AllocationTracker::AllocationTracker()
+    : m_id(s_nextTrackerId.fetch_add(1, std::memory_order_relaxed))
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    m_stats.push_back(stat);
 }
 
-const SmallVector<AllocationStat>& AllocationTracker::getStats() const
+AllocationTracker::~AllocationTracker()
 {
-    return m_stats;
+    if (getActiveAllocationTracker() == this)
+    {
+        setActiveAllocationTracker(nullptr);
+    }
 }
 
-void AllocationTracker::clear()
+auto AllocationTracker::getThreadRing() -> ThreadRing*
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    m_stats.clear();
+    thread_local ThreadRingRef t_ring;
+    if (t_ring.trackerId != m_id)
+    {
+        if (t_ring.pRing)
+        {
+            t_ring.pRing->retired.store(true, std::memory_order_release);
+        }
+
+        t_ring.pRing     = std::make_shared<ThreadRing>();
+        t_ring.trackerId = m_id;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_rings.push_back(t_ring.pRing);
+    }
+    return t_ring.pRing.get();
 }
 
-std::string AllocationTracker::generateSummaryReport() const
+void AllocationTracker::trackAllocation(AllocationRecord::Type type, void* ptr, std::size_t size,
+                                        const std::source_location& location)
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    std::stringstream ss;
+    if (!ptr)
+    {
+        return;
+    }
+
+    ThreadRing* pRing   = getThreadRing();
+    const uint32_t tail = pRing->tail.load(std::memory_order_relaxed);
+    if (tail - pRing->head.load(std::memory_order_acquire) == ThreadRingCapacity)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        drain();
+    }
+
+    pRing->records[tail % ThreadRingCapacity] = {
+        .ptr      = ptr,
+        .size     = size,
+        .file     = location.file_name(),
+        .function = location.function_name(),
+        .tag      = detail::t_allocationTag,
+        .sequence = m_nextSequence.fetch_add(1, std::memory_order_release),
+        .line     = location.line(),
+        .type     = type };
+    pRing->tail.store(tail + 1, std::memory_order_release);
+}
 
-    // Counters for allocation types
-    size_t totalAllocations    = 0;
-    size_t totalDeallocations  = 0;
-    size_t totalBytesAllocated = 0;
+void AllocationTracker::drain() const
+{
+    // Every event numbered below the limit is visible in the rings by now, unless its thread is still writing it.
+    // The address of such an event isn't handed out again before the call that records it returns, so no later
+    // event of that address is below the limit either. Merging the rings by sequence up to the limit therefore
+    // replays the events of every address in order, a free is never seen before its allocation.
+    const uint64_t limit = m_nextSequence.load(std::memory_order_acquire);
 
-    // Track active (non-freed) allocations
-    HashMap<void*, AllocationStat> activeAllocations;
+    struct Cursor
+    {
+        ThreadRing* pRing;
+        uint32_t head;
+        uint32_t tail;
+    };
+    SmallVector<Cursor> cursors;
+    for (const auto& pRing : m_rings)
+    {
+        cursors.push_back({ .pRing = pRing.get(),
+                            .head  = pRing->head.load(std::memory_order_relaxed),
+                            .tail  = pRing->tail.load(std::memory_order_acquire) });
+    }
 
-    // Process all allocation events
-    for (const auto& stat : m_stats)
+    while (true)
     {
-        switch (stat.type)
+        // Few threads record at once, a linear scan for the oldest record is enough
+        Cursor* pNext         = nullptr;
+        uint64_t nextSequence = limit;
+        for (Cursor& cursor : cursors)
+        {
+            if (cursor.head != cursor.tail)
+            {
+                const uint64_t sequence = cursor.pRing->records[cursor.head % ThreadRingCapacity].sequence;
+                if (sequence < nextSequence)
+                {
+                    pNext        = &cursor;
+                    nextSequence = sequence;
+                }
+            }
+        }
+        if (!pNext)
         {
-        case AllocationStat::Type::Malloc:
-        case AllocationStat::Type::Memalign:
-        case AllocationStat::Type::Calloc:
-        case AllocationStat::Type::CallocMemalign:
-        case AllocationStat::Type::New:
-            totalAllocations++;
-            totalBytesAllocated += stat.size;
-            activeAllocations[stat.ptr] = stat;
             break;
+        }
+        processRecord(pNext->pRing->records[pNext->head % ThreadRingCapacity]);
+        ++pNext->head;
+    }
+
+    for (const Cursor& cursor : cursors)
+    {
+        cursor.pRing->head.store(cursor.head, std::memory_order_release);
+    }
+
+    std::erase_if(m_rings,
+                  [](const auto& pRing)
+                  {
+                      // Read the retired flag first, everything the thread appended before exiting is then visible.
+                      // Nobody appends to a retired ring anymore, it can go once it is empty.
+                      const bool retired  = pRing->retired.load(std::memory_order_acquire);
+                      const uint32_t tail = pRing->tail.load(std::memory_order_acquire);
+                      return retired && pRing->head.load(std::memory_order_relaxed) == tail;
+                  });
+}
+
+auto AllocationTracker::internCallSite(const AllocationRecord& record) const -> uint32_t
+{
+    // The literals of a source_location are unique per call site, so interning compares pointers only
+    auto& candidates = m_callSiteLookup[record.function];
+    for (uint32_t index : candidates)
+    {
+        const CallSiteStats& site = m_callSites[index];
+        if (site.line == record.line && site.file == record.file)
+        {
+            return index;
+        }
+    }
+
+    const auto index = static_cast<uint32_t>(m_callSites.size());
+    m_callSites.push_back({ .file            = record.file,
+                            .function        = record.function,
+                            .line            = record.line,
+                            .allocationCount = 0,
+                            .freeCount       = 0,
+                            .totalBytes      = 0,
+                            .liveCount       = 0,
+                            .liveBytes       = 0 });
+    m_callSiteTags.push_back(NoTag);
+    candidates.push_back(index);
+    return index;
+}
+
+auto AllocationTracker::internTag(std::string_view name) const -> uint32_t
+{
+    auto [it, inserted] = m_tagLookup.try_emplace(name, static_cast<uint32_t>(m_tags.size()));
+    if (inserted)
+    {
+        m_tags.push_back({ .stats = { .name = name } });
+    }
+    return it->second;
+}
 
-        case AllocationStat::Type::Realloc:
-            // Handle realloc as a special case - could be new or replacement
-            if (activeAllocations.find(stat.ptr) == activeAllocations.end())
+void AllocationTracker::releaseAllocation(const LiveAllocation& allocation) const
+{
+    CallSiteStats& site = m_callSites[allocation.callSite];
+    site.freeCount++;
+    site.liveCount--;
+    site.liveBytes -= allocation.size;
+    m_currentBytes -= allocation.size;
+
+    TagState& tag = m_tags[allocation.tag];
+    tag.stats.freeCount++;
+    tag.stats.liveCount--;
+    tag.stats.liveBytes -= allocation.size;
+    tag.frameFreeCount++;
+}
+
+void AllocationTracker::processRecord(const AllocationRecord& record) const
+{
+    switch (record.type)
+    {
+    case AllocationRecord::Type::Malloc:
+    case AllocationRecord::Type::Memalign:
+    case AllocationRecord::Type::Calloc:
+    case AllocationRecord::Type::CallocMemalign:
+    case AllocationRecord::Type::Realloc:
+    case AllocationRecord::Type::New:
+    {
+        const uint32_t callSite = internCallSite(record);
+        CallSiteStats& site     = m_callSites[callSite];
+        site.allocationCount++;
+        site.totalBytes += record.size;
+        m_totalAllocations++;
+        m_totalBytesAllocated += record.size;
+
+        site.liveCount++;
+        site.liveBytes += record.size;
+        m_currentBytes += record.size;
+
+        uint32_t tagIndex = NoTag;
+        if (record.tag)
+        {
+            tagIndex = internTag(record.tag);
+        }
+        else
+        {
+            // Looked up on first use, so that call sites that are always tagged don't add their subsystem
+            uint32_t& subsystemTag = m_callSiteTags[callSite];
+            if (subsystemTag == NoTag)
             {
-                totalAllocations++;
-                totalBytesAllocated += stat.size;
+                subsystemTag = internTag(getSourceSubsystem(record.file));
             }
-            else
+            tagIndex = subsystemTag;
+        }
+
+        TagState& tag = m_tags[tagIndex];
+        tag.stats.allocationCount++;
+        tag.stats.totalBytes += record.size;
+        tag.stats.liveCount++;
+        tag.stats.liveBytes += record.size;
+        tag.frameAllocationCount++;
+        tag.frameBytes += record.size;
+
+        const LiveAllocation allocation{ .callSite = callSite, .tag = tagIndex, .size = record.size };
+
+        if (auto [it, inserted] = m_liveAllocations.try_emplace(record.ptr, allocation); !inserted)
+        {
+            // Handed out again by realloc before it recorded the free of the previous allocation
+            releaseAllocation(it->second);
+            it->second = allocation;
+            m_lateFrees[record.ptr]++;
+        }
+        break;
+    }
+
+    case AllocationRecord::Type::Free:
+    case AllocationRecord::Type::Delete:
+    {
+        m_totalDeallocations++;
+        if (auto it = m_lateFrees.find(record.ptr); it != m_lateFrees.end())
+        {
+            if (--it->second == 0)
             {
-                // Adjust total bytes for the size difference
-                totalBytesAllocated = totalBytesAllocated - activeAllocations[stat.ptr].size + stat.size;
+                m_lateFrees.erase(it);
             }
-            activeAllocations[stat.ptr] = stat;
-            break;
+        }
+        else if (auto it = m_liveAllocations.find(record.ptr); it != m_liveAllocations.end())
+        {
+            releaseAllocation(it->second);
+            m_liveAllocations.erase(it);
+        }
+        // Otherwise the allocation was made before tracking started
+        break;
+    }
+    }
+}
 
-        case AllocationStat::Type::Free:
-        case AllocationStat::Type::Delete:
-            totalDeallocations++;
-            activeAllocations.erase(stat.ptr);
-            break;
+void AllocationTracker::flush()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    drain();
+}
+
+auto AllocationTracker::getCallSiteStats() const -> std::vector<CallSiteStats>
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    drain();
+    return m_callSites;
+}
+
+void AllocationTracker::nextFrame()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    drain();
+
+    AllocationFrameStats sample{ .frame = m_frame++ };
+    for (uint32_t index = 0; index < m_tags.size(); index++)
+    {
+        TagState& tag = m_tags[index];
+        if (tag.frameAllocationCount > 0 || tag.frameFreeCount > 0 || tag.stats.liveBytes > 0)
+        {
+            sample.tags.push_back({ .tag             = index,
+                                    .allocationCount = tag.frameAllocationCount,
+                                    .freeCount       = tag.frameFreeCount,
+                                    .allocatedBytes  = tag.frameBytes,
+                                    .liveBytes       = tag.stats.liveBytes });
         }
+        tag.frameAllocationCount = 0;
+        tag.frameFreeCount       = 0;
+        tag.frameBytes           = 0;
+    }
+
+    if (m_timeline.size() < m_timelineCapacity)
+    {
+        m_timeline.push_back(std::move(sample));
+    }
+    else
+    {
+        m_timeline[m_timelineHead] = std::move(sample);
+        m_timelineHead             = (m_timelineHead + 1) % m_timelineCapacity;
     }
+}
+
+void AllocationTracker::setTimelineCapacity(std::size_t frameCount)
+{
+    APH_ASSERT(frameCount > 0);
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Keep the newest frames
+    std::rotate(m_timeline.begin(), m_timeline.begin() + static_cast<std::ptrdiff_t>(m_timelineHead),
+                m_timeline.end());
+    if (m_timeline.size() > frameCount)
+    {
+        m_timeline.erase(m_timeline.begin(),
+                         m_timeline.begin() + static_cast<std::ptrdiff_t>(m_timeline.size() - frameCount));
+    }
+    m_timelineHead     = 0;
+    m_timelineCapacity = frameCount;
+}
+
+auto AllocationTracker::getTagStats() const -> std::vector<AllocationTagStats>
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    drain();
+    std::vector<AllocationTagStats> stats;
+    stats.reserve(m_tags.size());
+    for (const TagState& tag : m_tags)
+    {
+        stats.push_back(tag.stats);
+    }
+    return stats;
+}
 
-    // Calculate currently allocated memory
-    size_t currentlyAllocated = 0;
-    for (const auto& [ptr, stat] : activeAllocations)
+auto AllocationTracker::getTimeline() const -> std::vector<AllocationFrameStats>
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<AllocationFrameStats> timeline;
+    timeline.reserve(m_timeline.size());
+    for (std::size_t i = 0; i < m_timeline.size(); i++)
     {
-        currentlyAllocated += stat.size;
+        timeline.push_back(m_timeline[(m_timelineHead + i) % m_timeline.size()]);
     }
+    return timeline;
+}
+
+void AllocationTracker::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    drain();
+    m_callSites.clear();
+    m_callSiteTags.clear();
+    m_callSiteLookup.clear();
+    m_tags.clear();
+    m_tagLookup.clear();
+    m_timeline.clear();
+    m_timelineHead = 0;
+    m_frame        = 0;
+    m_liveAllocations.clear();
+    m_lateFrees.clear();
+    m_totalAllocations    = 0;
+    m_totalDeallocations  = 0;
+    m_totalBytesAllocated = 0;
+    m_currentBytes        = 0;
+}
+
+std::string AllocationTracker::generateSummaryReport() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    drain();
+    std::stringstream ss;
 
     // Format the summary report
     ss << "\n===============================================\n";
     ss << "MEMORY ALLOCATION SUMMARY\n";
     ss << "===============================================\n";
-    ss << "Total allocations:    " << totalAllocations << "\n";
-    ss << "Total deallocations:  " << totalDeallocations << "\n";
-    ss << "Outstanding calls:    " << (totalAllocations - totalDeallocations) << "\n";
-    ss << "Total bytes allocated: " << formatSize(totalBytesAllocated) << "\n";
-    ss << "Current memory usage:  " << formatSize(currentlyAllocated) << "\n";
-    ss << "Outstanding allocations: " << activeAllocations.size() << "\n";
+    ss << "Total allocations:    " << m_totalAllocations << "\n";
+    ss << "Total deallocations:  " << m_totalDeallocations << "\n";
+    ss << "Outstanding calls:    " << (m_totalAllocations - m_totalDeallocations) << "\n";
+    ss << "Total bytes allocated: " << formatSize(m_totalBytesAllocated) << "\n";
+    ss << "Current memory usage:  " << formatSize(m_currentBytes) << "\n";
+    ss << "Outstanding allocations: " << m_liveAllocations.size() << "\n";
     ss << "===============================================\n";
 
     // Add potential leak information
-    if (!activeAllocations.empty())
+    if (!m_liveAllocations.empty())
     {
         ss << "\nPOTENTIAL MEMORY LEAKS:\n";
         ss << "-----------------------------------------------\n";
@@ -126,27 +492,21 @@ std::string AllocationTracker::generateSummaryReport() const
         ss << "-----------------------------------------------\n";
 
         // Sort by size (largest first)
-        std::vector<std::pair<void*, AllocationStat>> leaks;
-        for (const auto& pair : activeAllocations)
-        {
-            leaks.push_back(pair);
-        }
-
-        std::sort(leaks.begin(), leaks.end(),
-                  [](const auto& a, const auto& b)
-                  {
-                      return a.second.size > b.second.size;
-                  });
+        std::vector<std::pair<void*, LiveAllocation>> leaks{ m_liveAllocations.begin(), m_liveAllocations.end() };
+        const std::size_t displayCount = std::min<std::size_t>(leaks.size(), 10);
+        std::partial_sort(leaks.begin(), leaks.begin() + displayCount, leaks.end(),
+                          [](const auto& a, const auto& b)
+                          {
+                              return a.second.size > b.second.size;
+                          });
 
         // Show top 10 largest leaks
-        int count = 0;
-        for (const auto& [ptr, stat] : leaks)
+        for (std::size_t i = 0; i < displayCount; i++)
         {
-            ss << ptr << " | " << formatSize(stat.size) << " | " << stat.file << ":" << stat.line << " ("
-               << stat.function << ")\n";
-
-            if (++count >= 10)
-                break;
+            const auto& [ptr, allocation] = leaks[i];
+            const CallSiteStats& site     = m_callSites[allocation.callSite];
+            ss << ptr << " | " << formatSize(allocation.size) << " | " << site.file << ":" << site.line << " ("
+               << site.function << ")\n";
         }
 
         if (leaks.size() > 10)
@@ -162,54 +522,27 @@ std::string AllocationTracker::generateSummaryReport() const
 std::string AllocationTracker::generateFileReport() const
 {
     std::lock_guard<std::mutex> lock(m_mutex);
+    drain();
     std::stringstream ss;
 
-    // Group allocations by file
-    HashMap<std::string, size_t> fileAllocations;
-    HashMap<std::string, size_t> fileBytes;
-
-    // Track active (non-freed) allocations
-    HashMap<void*, AllocationStat> activeAllocations;
-
-    // Process all allocation events
-    for (const auto& stat : m_stats)
+    // Group the live allocations of every call site by file
+    HashMap<std::string_view, std::pair<size_t, size_t>> files;
+    for (const CallSiteStats& site : m_callSites)
     {
-        switch (stat.type)
+        if (site.liveCount > 0)
         {
-        case AllocationStat::Type::Malloc:
-        case AllocationStat::Type::Memalign:
-        case AllocationStat::Type::Calloc:
-        case AllocationStat::Type::CallocMemalign:
-        case AllocationStat::Type::New:
-        case AllocationStat::Type::Realloc:
-            activeAllocations[stat.ptr] = stat;
-            break;
-
-        case AllocationStat::Type::Free:
-        case AllocationStat::Type::Delete:
-            activeAllocations.erase(stat.ptr);
-            break;
+            auto& [count, bytes] = files[site.file];
+            count += site.liveCount;
+            bytes += site.liveBytes;
         }
     }
 
-    // Count active allocations by file
-    for (const auto& [ptr, stat] : activeAllocations)
-    {
-        fileAllocations[stat.file]++;
-        fileBytes[stat.file] += stat.size;
-    }
-
     // Sort files by total bytes (largest first)
-    std::vector<std::pair<std::string, size_t>> sortedFiles;
-    for (const auto& pair : fileBytes)
-    {
-        sortedFiles.push_back(pair);
-    }
-
+    std::vector<std::pair<std::string_view, std::pair<size_t, size_t>>> sortedFiles{ files.begin(), files.end() };
     std::sort(sortedFiles.begin(), sortedFiles.end(),
               [](const auto& a, const auto& b)
               {
-                  return a.second > b.second;
+                  return a.second.second > b.second.second;
               });
 
     // Format the file report
@@ -219,13 +552,13 @@ std::string AllocationTracker::generateFileReport() const
     ss << "File                  | Count | Size\n";
     ss << "-----------------------------------------------\n";
 
-    for (const auto& [file, bytes] : sortedFiles)
+    for (const auto& [file, stats] : sortedFiles)
     {
-        ss << file << " | " << fileAllocations[file] << " | " << formatSize(bytes) << "\n";
+        ss << file << " | " << stats.first << " | " << formatSize(stats.second) << "\n";
     }
 
     ss << "-----------------------------------------------\n";
-    ss << "Total: " << activeAllocations.size() << " allocations\n";
+    ss << "Total: " << m_liveAllocations.size() << " allocations\n";
     ss << "===============================================\n";
 
     return ss.str();
@@ -234,67 +567,159 @@ std::string AllocationTracker::generateFileReport() const
 std::string AllocationTracker::generateLargestAllocationsReport(size_t count) const
 {
     std::lock_guard<std::mutex> lock(m_mutex);
+    drain();
     std::stringstream ss;
 
-    // Track active (non-freed) allocations
-    HashMap<void*, AllocationStat> activeAllocations;
+    // Sort allocations by size (largest first)
+    std::vector<std::pair<void*, LiveAllocation>> sortedAllocations{ m_liveAllocations.begin(),
+                                                                     m_liveAllocations.end() };
+    size_t displayCount = std::min(count, sortedAllocations.size());
+    std::partial_sort(sortedAllocations.begin(), sortedAllocations.begin() + displayCount, sortedAllocations.end(),
+                      [](const auto& a, const auto& b)
+                      {
+                          return a.second.size > b.second.size;
+                      });
 
-    // Process all allocation events
-    for (const auto& stat : m_stats)
-    {
-        switch (stat.type)
-        {
-        case AllocationStat::Type::Malloc:
-        case AllocationStat::Type::Memalign:
-        case AllocationStat::Type::Calloc:
-        case AllocationStat::Type::CallocMemalign:
-        case AllocationStat::Type::New:
-        case AllocationStat::Type::Realloc:
-            activeAllocations[stat.ptr] = stat;
-            break;
+    // Format the largest allocations report
+    ss << "===============================================\n";
+    ss << "LARGEST ACTIVE ALLOCATIONS\n";
+    ss << "===============================================\n";
+    ss << "Ptr       | Size     | Location\n";
+    ss << "-----------------------------------------------\n";
 
-        case AllocationStat::Type::Free:
-        case AllocationStat::Type::Delete:
-            activeAllocations.erase(stat.ptr);
-            break;
-        }
+    for (size_t i = 0; i < displayCount; i++)
+    {
+        const auto& [ptr, allocation] = sortedAllocations[i];
+        const CallSiteStats& site     = m_callSites[allocation.callSite];
+        ss << ptr << " | " << formatSize(allocation.size) << " | " << site.file << ":" << site.line << " ("
+           << site.function << ")\n";
     }
 
-    // Sort allocations by size (largest first)
-    std::vector<std::pair<void*, AllocationStat>> sortedAllocations;
-    for (const auto& pair : activeAllocations)
+    ss << "-----------------------------------------------\n";
+    ss << "Total active allocations: " << m_liveAllocations.size() << "\n";
+    ss << "===============================================\n";
+
+    return ss.str();
+}
+
+std::string AllocationTracker::generateTagReport() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    drain();
+    std::stringstream ss;
+
+    // Sort tags by allocation count (most first), which is what regresses frame times
+    std::vector<AllocationTagStats> sortedTags;
+    sortedTags.reserve(m_tags.size());
+    for (const TagState& tag : m_tags)
     {
-        sortedAllocations.push_back(pair);
+        sortedTags.push_back(tag.stats);
     }
-
-    std::sort(sortedAllocations.begin(), sortedAllocations.end(),
+    std::sort(sortedTags.begin(), sortedTags.end(),
               [](const auto& a, const auto& b)
               {
-                  return a.second.size > b.second.size;
+                  return a.allocationCount > b.allocationCount;
               });
 
-    // Format the largest allocations report
     ss << "===============================================\n";
-    ss << "LARGEST ACTIVE ALLOCATIONS\n";
+    ss << "MEMORY ALLOCATION BY TAG\n";
     ss << "===============================================\n";
-    ss << "Ptr       | Size     | Location\n";
+    ss << "Tag        | Allocations | Frees | Allocated | Live\n";
     ss << "-----------------------------------------------\n";
 
-    size_t displayCount = std::min(count, sortedAllocations.size());
-    for (size_t i = 0; i < displayCount; i++)
+    for (const AllocationTagStats& tag : sortedTags)
     {
-        const auto& [ptr, stat] = sortedAllocations[i];
-        ss << ptr << " | " << formatSize(stat.size) << " | " << stat.file << ":" << stat.line << " (" << stat.function
-           << ")\n";
+        ss << tag.name << " | " << tag.allocationCount << " | " << tag.freeCount << " | "
+           << formatSize(tag.totalBytes) << " | " << formatSize(tag.liveBytes) << "\n";
     }
 
     ss << "-----------------------------------------------\n";
-    ss << "Total active allocations: " << activeAllocations.size() << "\n";
+    ss << "Frames recorded: " << m_frame << "\n";
     ss << "===============================================\n";
 
     return ss.str();
 }
 
+std::string AllocationTracker::exportChromeTrace() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    drain();
+
+    std::string out = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    out += R"({"name":"process_name","ph":"M","pid":1,"tid":0,"args":{"name":"allocations"}})";
+
+    // One counter event per series and frame, each tag is a stacked track of the counter
+    auto appendCounter = [&](const char* name, uint64_t frame, const AllocationFrameStats& sample, auto&& value)
+    {
+        out += ",\n{\"name\":\"";
+        out += name;
+        out += "\",\"ph\":\"C\",\"pid\":1,\"tid\":0,\"ts\":";
+        out += std::to_string(frame * 1000);
+        out += ",\"args\":{";
+        for (std::size_t i = 0; i < sample.tags.size(); i++)
+        {
+            if (i > 0)
+            {
+                out += ',';
+            }
+            appendJsonString(out, m_tags[sample.tags[i].tag].stats.name);
+            out += ':';
+            out += std::to_string(value(sample.tags[i]));
+        }
+        out += "}}";
+    };
+
+    for (std::size_t i = 0; i < m_timeline.size(); i++)
+    {
+        const AllocationFrameStats& sample = m_timeline[(m_timelineHead + i) % m_timeline.size()];
+        appendCounter("live bytes", sample.frame, sample,
+                      [](const AllocationFrameTagStats& tag)
+                      {
+                          return tag.liveBytes;
+                      });
+        appendCounter("allocations", sample.frame, sample,
+                      [](const AllocationFrameTagStats& tag)
+                      {
+                          return tag.allocationCount;
+                      });
+        appendCounter("allocated bytes", sample.frame, sample,
+                      [](const AllocationFrameTagStats& tag)
+                      {
+                          return tag.allocatedBytes;
+                      });
+    }
+
+    // Totals sorted by name, so that the exports of two runs diff line by line
+    std::vector<const AllocationTagStats*> sortedTags;
+    sortedTags.reserve(m_tags.size());
+    for (const TagState& tag : m_tags)
+    {
+        sortedTags.push_back(&tag.stats);
+    }
+    std::sort(sortedTags.begin(), sortedTags.end(),
+              [](const auto* a, const auto* b)
+              {
+                  return a->name < b->name;
+              });
+
+    out += "\n],\"otherData\":{\"frames\":";
+    out += std::to_string(m_frame);
+    out += ",\"tags\":{";
+    for (std::size_t i = 0; i < sortedTags.size(); i++)
+    {
+        const AllocationTagStats& tag = *sortedTags[i];
+        out += i > 0 ? ",\n" : "\n";
+        appendJsonString(out, tag.name);
+        out += ":{\"allocations\":" + std::to_string(tag.allocationCount);
+        out += ",\"frees\":" + std::to_string(tag.freeCount);
+        out += ",\"allocatedBytes\":" + std::to_string(tag.totalBytes);
+        out += ",\"liveCount\":" + std::to_string(tag.liveCount);
+        out += ",\"liveBytes\":" + std::to_string(tag.liveBytes) + "}";
+    }
+    out += "\n}}}\n";
+    return out;
+}
+
 // Helper method to format bytes into human-readable sizes
 std::string AllocationTracker::formatSize(size_t bytes) const
 {
@@ -8,11 +8,16 @@
 #include <stdint.h>
 #endif
 
+#include "common/hash.h"
 #include "common/logger.h"
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <source_location>
 #include <stddef.h>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace aph::memory
 {
@@ -21,10 +26,11 @@ constexpr std::size_t KB = 1024;
 constexpr std::size_t MB = 1024 * KB;
 constexpr std::size_t GB = 1024 * MB;
 
-// Memory allocation statistics tracking
-struct AllocationStat
+// Compact allocation event. File and function point at the string literals of the std::source_location, so
+// recording an event never copies a string.
+struct AllocationRecord
 {
-    enum class Type
+    enum class Type : uint8_t
     {
         Malloc,
         Memalign,
@@ -36,38 +42,202 @@ struct AllocationStat
         Delete
     };
 
-    Type type;
-    std::string file;
-    int line;
-    std::string function;
     void* ptr;
     std::size_t size;
-    std::size_t alignment;
-    std::size_t count;
+    const char* file;
+    const char* function;
+    // Explicit AllocationTagScope tag, null to attribute the allocation to the subsystem of its file
+    const char* tag;
+    // Order of the event among those of all threads, see AllocationTracker::drain
+    uint64_t sequence;
+    uint32_t line;
+    Type type;
+};
+
+// Running totals of one allocation call site
+struct CallSiteStats
+{
+    const char* file;
+    const char* function;
+    uint32_t line;
+    std::size_t allocationCount;
+    std::size_t freeCount;
+    std::size_t totalBytes;
+    std::size_t liveCount;
+    std::size_t liveBytes;
+};
+
+// Running totals of one tag. Allocations are attributed to the AllocationTagScope active on the allocating thread,
+// or to the subsystem of the allocating file otherwise, frees always to the tag of their allocation.
+struct AllocationTagStats
+{
+    std::string_view name;
+    std::size_t allocationCount;
+    std::size_t freeCount;
+    std::size_t totalBytes;
+    std::size_t liveCount;
+    std::size_t liveBytes;
+};
+
+// What one tag did during one frame, liveBytes is the state at the end of it
+struct AllocationFrameTagStats
+{
+    uint32_t tag;
+    uint32_t allocationCount;
+    uint32_t freeCount;
+    uint64_t allocatedBytes;
+    uint64_t liveBytes;
+};
+
+// One timeline entry, tags is indexed like getTagStats() and only lists tags that were active or held memory
+struct AllocationFrameStats
+{
+    uint64_t frame;
+    std::vector<AllocationFrameTagStats> tags;
 };
 
+// Subsystem of a source file, the directory below the last "src" component, or the parent directory when the
+// path has none. "/repo/src/resource/image/imageLoader.cpp" belongs to "resource".
+auto getSourceSubsystem(std::string_view file) -> std::string_view;
+
+namespace detail
+{
+inline thread_local const char* t_allocationTag = nullptr;
+} // namespace detail
+
+// Attributes the allocations of the calling thread to tag while alive, scopes nest. tag has to outlive the
+// tracker, which string literals do.
+class AllocationTagScope
+{
+public:
+    explicit AllocationTagScope(const char* tag)
+        : m_pPrevious(detail::t_allocationTag)
+    {
+        detail::t_allocationTag = tag;
+    }
+
+    ~AllocationTagScope()
+    {
+        detail::t_allocationTag = m_pPrevious;
+    }
+
+    AllocationTagScope(const AllocationTagScope&)                    = delete;
+    auto operator=(const AllocationTagScope&) -> AllocationTagScope& = delete;
+
+private:
+    const char* m_pPrevious;
+};
+
+// Every thread appends records to its own lock-free ring, which is drained into per call site totals and a
+// table of live allocations whenever it runs full or a report is requested. Reports only read the aggregated
+// state instead of replaying the event history.
 class AllocationTracker
 {
 public:
-    AllocationTracker()  = default;
-    ~AllocationTracker() = default;
+    AllocationTracker();
+    ~AllocationTracker();
+
+    void trackAllocation(AllocationRecord::Type type, void* ptr, std::size_t size,
+                         const std::source_location& location);
 
-    void trackAllocation(const AllocationStat& stat);
-    const SmallVector<AllocationStat>& getStats() const;
+    // Folds all pending records into the totals
+    void flush();
+    auto getCallSiteStats() const -> std::vector<CallSiteStats>;
     void clear();
 
+    // Closes the current frame and appends its per tag counters to the timeline, which keeps the last
+    // timelineCapacity frames
+    void nextFrame();
+    void setTimelineCapacity(std::size_t frameCount);
+    auto getTagStats() const -> std::vector<AllocationTagStats>;
+    // Oldest frame first
+    auto getTimeline() const -> std::vector<AllocationFrameStats>;
+
     std::string generateSummaryReport() const;
     std::string generateFileReport() const;
     std::string generateLargestAllocationsReport(size_t count = 10) const;
+    std::string generateTagReport() const;
+
+    // Chrome trace event JSON (chrome://tracing, Perfetto) with live bytes, allocation count and allocated bytes
+    // counters per tag for every frame in the timeline, plus the tag totals under "otherData". Frames are laid
+    // out one millisecond apart instead of at wall clock time so that traces of different runs line up.
+    std::string exportChromeTrace() const;
 
 private:
+    struct ThreadRing;
+    struct ThreadRingRef;
+    struct LiveAllocation
+    {
+        uint32_t callSite;
+        uint32_t tag;
+        std::size_t size;
+    };
+
+    struct TagState
+    {
+        AllocationTagStats stats;
+        uint32_t frameAllocationCount;
+        uint32_t frameFreeCount;
+        uint64_t frameBytes;
+    };
+
+    auto getThreadRing() -> ThreadRing*;
+    void drain() const;
+    void processRecord(const AllocationRecord& record) const;
+    auto internCallSite(const AllocationRecord& record) const -> uint32_t;
+    auto internTag(std::string_view name) const -> uint32_t;
+    void releaseAllocation(const LiveAllocation& allocation) const;
     std::string formatSize(size_t bytes) const;
+
+    const uint64_t m_id;
+
     std::mutex mutable m_mutex;
-    SmallVector<AllocationStat> m_stats;
+    std::vector<std::shared_ptr<ThreadRing>> mutable m_rings;
+    std::atomic<uint64_t> m_nextSequence{ 0 };
+
+    // Aggregated state, owned by whoever holds m_mutex. Mutable since reports drain pending records first.
+    std::vector<CallSiteStats> mutable m_callSites;
+    // Subsystem tag of every call site, resolved on its first untagged allocation
+    std::vector<uint32_t> mutable m_callSiteTags;
+    HashMap<const void*, SmallVector<uint32_t>> mutable m_callSiteLookup;
+    HashMap<void*, LiveAllocation> mutable m_liveAllocations;
+
+    std::vector<TagState> mutable m_tags;
+    HashMap<std::string_view, uint32_t> mutable m_tagLookup;
+
+    // Ring of the last m_timelineCapacity frames, m_timelineHead is the oldest once it is full
+    std::vector<AllocationFrameStats> m_timeline;
+    std::size_t m_timelineHead     = 0;
+    std::size_t m_timelineCapacity = 600;
+    uint64_t m_frame               = 0;
+
+    // realloc records the free of the old block after it returned, so the address can be handed out and recorded
+    // again before that free. Counts the frees to skip per address.
+    HashMap<void*, uint32_t> mutable m_lateFrees;
+
+    std::size_t mutable m_totalAllocations    = 0;
+    std::size_t mutable m_totalDeallocations  = 0;
+    std::size_t mutable m_totalBytesAllocated = 0;
+    std::size_t mutable m_currentBytes        = 0;
 };
 
-// Forward declaration for getting the allocation tracker from global manager
-AllocationTracker* getActiveAllocationTracker();
+namespace detail
+{
+inline std::atomic<AllocationTracker*> g_pActiveAllocationTracker{ nullptr };
+} // namespace detail
+
+// Tracker that the aph_* allocation functions report to, null when tracking is off. Reading it is a single
+// load, so the disabled case costs one well predicted branch per call.
+inline AllocationTracker* getActiveAllocationTracker()
+{
+    return detail::g_pActiveAllocationTracker.load(std::memory_order_acquire);
+}
+
+// The tracker must stay alive until it has been deactivated and no allocation is in flight anymore
+inline void setActiveAllocationTracker(AllocationTracker* pTracker)
+{
+    detail::g_pActiveAllocationTracker.store(pTracker, std::memory_order_release);
+}
 
 void* malloc_internal(size_t size, const char* f, int l, const char* sf);
 void* memalign_internal(size_t align, size_t size, const char* f, int l, const char* sf);
@@ -104,17 +274,9 @@ inline void* aph_malloc(std::size_t size, const std::source_location& location =
     void* result =
         malloc_internal(size, location.file_name(), static_cast<int>(location.line()), location.function_name());
 
-    // Track allocation if tracker is available
-    if (auto tracker = getActiveAllocationTracker())
+    if (auto* pTracker = getActiveAllocationTracker()) [[unlikely]]
     {
-        tracker->trackAllocation({ .type      = AllocationStat::Type::Malloc,
-                                   .file      = location.file_name(),
-                                   .line      = static_cast<int>(location.line()),
-                                   .function  = location.function_name(),
-                                   .ptr       = result,
-                                   .size      = size,
-                                   .alignment = 0,
-                                   .count     = 0 });
+        pTracker->trackAllocation(AllocationRecord::Type::Malloc, result, size, location);
     }
 
     return result;
@@ -126,17 +288,9 @@ inline void* aph_memalign(std::size_t alignment, std::size_t size,
     void* result = memalign_internal(alignment, size, location.file_name(), static_cast<int>(location.line()),
                                      location.function_name());
 
-    // Track allocation if tracker is available
-    if (auto tracker = getActiveAllocationTracker())
+    if (auto* pTracker = getActiveAllocationTracker()) [[unlikely]]
     {
-        tracker->trackAllocation({ .type      = AllocationStat::Type::Memalign,
-                                   .file      = location.file_name(),
-                                   .line      = static_cast<int>(location.line()),
-                                   .function  = location.function_name(),
-                                   .ptr       = result,
-                                   .size      = size,
-                                   .alignment = alignment,
-                                   .count     = 0 });
+        pTracker->trackAllocation(AllocationRecord::Type::Memalign, result, size, location);
     }
 
     return result;
@@ -148,17 +302,9 @@ inline void* aph_calloc(std::size_t count, std::size_t size,
     void* result =
         calloc_internal(count, size, location.file_name(), static_cast<int>(location.line()), location.function_name());
 
-    // Track allocation if tracker is available
-    if (auto tracker = getActiveAllocationTracker())
+    if (auto* pTracker = getActiveAllocationTracker()) [[unlikely]]
     {
-        tracker->trackAllocation({ .type      = AllocationStat::Type::Calloc,
-                                   .file      = location.file_name(),
-                                   .line      = static_cast<int>(location.line()),
-                                   .function  = location.function_name(),
-                                   .ptr       = result,
-                                   .size      = size,
-                                   .alignment = 0,
-                                   .count     = count });
+        pTracker->trackAllocation(AllocationRecord::Type::Calloc, result, count * size, location);
     }
 
     return result;
@@ -170,17 +316,9 @@ inline void* aph_calloc_memalign(std::size_t count, std::size_t alignment, std::
     void* result = calloc_memalign_internal(count, alignment, size, location.file_name(),
                                             static_cast<int>(location.line()), location.function_name());
 
-    // Track allocation if tracker is available
-    if (auto tracker = getActiveAllocationTracker())
+    if (auto* pTracker = getActiveAllocationTracker()) [[unlikely]]
     {
-        tracker->trackAllocation({ .type      = AllocationStat::Type::CallocMemalign,
-                                   .file      = location.file_name(),
-                                   .line      = static_cast<int>(location.line()),
-                                   .function  = location.function_name(),
-                                   .ptr       = result,
-                                   .size      = size,
-                                   .alignment = alignment,
-                                   .count     = count });
+        pTracker->trackAllocation(AllocationRecord::Type::CallocMemalign, result, count * size, location);
     }
 
     return result;
@@ -192,17 +330,13 @@ inline void* aph_realloc(void* ptr, std::size_t size,
     void* result =
         realloc_internal(ptr, size, location.file_name(), static_cast<int>(location.line()), location.function_name());
 
-    // Track allocation if tracker is available
-    if (auto tracker = getActiveAllocationTracker())
+    if (auto* pTracker = getActiveAllocationTracker(); pTracker && result) [[unlikely]]
     {
-        tracker->trackAllocation({ .type      = AllocationStat::Type::Realloc,
-                                   .file      = location.file_name(),
-                                   .line      = static_cast<int>(location.line()),
-                                   .function  = location.function_name(),
-                                   .ptr       = result,
-                                   .size      = size,
-                                   .alignment = 0,
-                                   .count     = 0 });
+        if (ptr)
+        {
+            pTracker->trackAllocation(AllocationRecord::Type::Free, ptr, 0, location);
+        }
+        pTracker->trackAllocation(AllocationRecord::Type::Realloc, result, size, location);
     }
 
     return result;
@@ -210,17 +344,9 @@ inline void* aph_realloc(void* ptr, std::size_t size,
 
 inline void aph_free(void* ptr, const std::source_location& location = std::source_location::current())
 {
-    // Track deallocation if tracker is available
-    if (auto tracker = getActiveAllocationTracker())
+    if (auto* pTracker = getActiveAllocationTracker()) [[unlikely]]
     {
-        tracker->trackAllocation({ .type      = AllocationStat::Type::Free,
-                                   .file      = location.file_name(),
-                                   .line      = static_cast<int>(location.line()),
-                                   .function  = location.function_name(),
-                                   .ptr       = ptr,
-                                   .size      = 0,
-                                   .alignment = 0,
-                                   .count     = 0 });
+        pTracker->trackAllocation(AllocationRecord::Type::Free, ptr, 0, location);
     }
 
     free_internal(ptr, location.file_name(), static_cast<int>(location.line()), location.function_name());
@@ -232,17 +358,9 @@ ObjectType* aph_new(const std::source_location& location = std::source_location:
     ObjectType* result = new_internal<ObjectType>(location.file_name(), static_cast<int>(location.line()),
                                                   location.function_name(), std::forward<Args>(args)...);
 
-    // Track allocation if tracker is available
-    if (auto tracker = getActiveAllocationTracker())
+    if (auto* pTracker = getActiveAllocationTracker()) [[unlikely]]
     {
-        tracker->trackAllocation({ .type      = AllocationStat::Type::New,
-                                   .file      = location.file_name(),
-                                   .line      = static_cast<int>(location.line()),
-                                   .function  = location.function_name(),
-                                   .ptr       = result,
-                                   .size      = sizeof(ObjectType),
-                                   .alignment = alignof(ObjectType),
-                                   .count     = 0 });
+        pTracker->trackAllocation(AllocationRecord::Type::New, result, sizeof(ObjectType), location);
     }
 
     return result;
@@ -251,17 +369,10 @@ ObjectType* aph_new(const std::source_location& location = std::source_location:
 template <typename ObjectType>
 void aph_delete(ObjectType* ptr, const std::source_location& location = std::source_location::current())
 {
-    // Track deallocation if tracker is available
-    if (auto tracker = getActiveAllocationTracker())
+    if (auto* pTracker = getActiveAllocationTracker()) [[unlikely]]
     {
-        tracker->trackAllocation({ .type      = AllocationStat::Type::Delete,
-                                   .file      = location.file_name(),
-                                   .line      = static_cast<int>(location.line()),
-                                   .function  = location.function_name(),
-                                   .ptr       = static_cast<void*>(ptr),
-                                   .size      = sizeof(ObjectType),
-                                   .alignment = alignof(ObjectType),
-                                   .count     = 0 });
+        pTracker->trackAllocation(AllocationRecord::Type::Delete, static_cast<void*>(ptr), sizeof(ObjectType),
+                                  location);
     }
 
     delete_internal(ptr, location.file_name(), static_cast<int>(location.line()), location.function_name());
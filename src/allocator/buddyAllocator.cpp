@@ -0,0 +1,164 @@
+#include "buddyAllocator.h"
+
+#include "common/debug.h"
+#include <algorithm>
+#include <bit>
+
+namespace aph
+{
+BuddyAllocator::BuddyAllocator(std::size_t capacity, std::size_t minBlockSize)
+    : m_minBlockSize(minBlockSize)
+    , m_minShift(std::countr_zero(minBlockSize))
+    , m_maxOrder(std::countr_zero(capacity / minBlockSize))
+{
+    APH_ASSERT(std::has_single_bit(minBlockSize));
+    APH_ASSERT(capacity >= minBlockSize && std::has_single_bit(capacity / minBlockSize) &&
+               capacity % minBlockSize == 0);
+
+    std::size_t wordCount = 0;
+    for (uint32_t order = 0; order <= m_maxOrder; ++order)
+    {
+        m_orderWords.push_back(wordCount);
+        const std::size_t blockCount = std::size_t{ 1 } << (m_maxOrder - order);
+        wordCount += (blockCount + 63) / 64;
+    }
+    m_freeBits.assign(wordCount, 0);
+    m_splitBits.assign(wordCount, 0);
+    m_freeCounts.assign(m_maxOrder + 1, 0);
+    m_searchHints.assign(m_maxOrder + 1, 0);
+
+    // Everything starts out as one free block
+    setBit(m_freeBits, m_maxOrder, 0, true);
+    m_freeCounts[m_maxOrder] = 1;
+}
+
+auto BuddyAllocator::allocate(std::size_t size, std::size_t alignment) -> std::optional<std::size_t>
+{
+    APH_ASSERT(size > 0);
+    APH_ASSERT(std::has_single_bit(alignment));
+
+    if (size > getCapacity() || alignment > getCapacity())
+    {
+        return std::nullopt;
+    }
+
+    const uint32_t order = orderOf(size, alignment);
+    uint32_t freeOrder   = order;
+    while (freeOrder <= m_maxOrder && m_freeCounts[freeOrder] == 0)
+    {
+        ++freeOrder;
+    }
+    if (freeOrder > m_maxOrder)
+    {
+        return std::nullopt;
+    }
+
+    // Split the smallest free block that fits down to the requested order, keeping the upper halves free
+    std::size_t index = popFree(freeOrder);
+    while (freeOrder > order)
+    {
+        setBit(m_splitBits, freeOrder, index, true);
+        --freeOrder;
+        index *= 2;
+        setBit(m_freeBits, freeOrder, index + 1, true);
+        m_freeCounts[freeOrder]++;
+    }
+
+    m_usedSize += m_minBlockSize << order;
+    m_allocationCount++;
+    return index << (order + m_minShift);
+}
+
+void BuddyAllocator::free(std::size_t offset)
+{
+    auto [order, index] = findAllocation(offset);
+    APH_ASSERT(index << (order + m_minShift) == offset, "Offset is not the start of an allocation");
+    APH_ASSERT(!testBit(m_freeBits, order, index), "Double free");
+
+    m_usedSize -= m_minBlockSize << order;
+    m_allocationCount--;
+
+    // Merge with the buddy for as long as it is free as well
+    while (order < m_maxOrder && testBit(m_freeBits, order, index ^ 1))
+    {
+        setBit(m_freeBits, order, index ^ 1, false);
+        m_freeCounts[order]--;
+        ++order;
+        index /= 2;
+        setBit(m_splitBits, order, index, false);
+    }
+
+    setBit(m_freeBits, order, index, true);
+    m_freeCounts[order]++;
+}
+
+auto BuddyAllocator::getBlockSize(std::size_t offset) const -> std::size_t
+{
+    return m_minBlockSize << findAllocation(offset).first;
+}
+
+auto BuddyAllocator::orderOf(std::size_t size, std::size_t alignment) const -> uint32_t
+{
+    const std::size_t blockSize = std::max({ std::bit_ceil(size), alignment, m_minBlockSize });
+    return std::countr_zero(blockSize) - m_minShift;
+}
+
+auto BuddyAllocator::findAllocation(std::size_t offset) const -> std::pair<uint32_t, std::size_t>
+{
+    APH_ASSERT(offset < getCapacity());
+
+    // The allocation is the first block on the way down from the root that isn't split
+    uint32_t order    = m_maxOrder;
+    std::size_t index = 0;
+    while (order > 0 && testBit(m_splitBits, order, index))
+    {
+        --order;
+        index = offset >> (order + m_minShift);
+    }
+    return { order, index };
+}
+
+auto BuddyAllocator::testBit(const std::vector<uint64_t>& bits, uint32_t order, std::size_t index) const -> bool
+{
+    return (bits[m_orderWords[order] + index / 64] >> (index % 64)) & 1;
+}
+
+void BuddyAllocator::setBit(std::vector<uint64_t>& bits, uint32_t order, std::size_t index, bool value)
+{
+    uint64_t& word      = bits[m_orderWords[order] + index / 64];
+    const uint64_t mask = uint64_t{ 1 } << (index % 64);
+    if (value)
+    {
+        word |= mask;
+        if (&bits == &m_freeBits)
+        {
+            m_searchHints[order] = std::min(m_searchHints[order], index / 64);
+        }
+    }
+    else
+    {
+        word &= ~mask;
+    }
+}
+
+auto BuddyAllocator::popFree(uint32_t order) -> std::size_t
+{
+    const std::size_t firstWord = m_orderWords[order];
+    const std::size_t lastWord  = order < m_maxOrder ? m_orderWords[order + 1] : m_freeBits.size();
+
+    for (std::size_t word = firstWord + m_searchHints[order]; word < lastWord; ++word)
+    {
+        if (m_freeBits[word] != 0)
+        {
+            m_searchHints[order]    = word - firstWord;
+            const std::size_t index = (word - firstWord) * 64 + std::countr_zero(m_freeBits[word]);
+            setBit(m_freeBits, order, index, false);
+            m_freeCounts[order]--;
+            return index;
+        }
+    }
+
+    APH_ASSERT(false, "Free count and bitmap disagree");
+    return 0;
+}
+} // namespace aph
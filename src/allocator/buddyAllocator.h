@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace aph
+{
+// Buddy allocator over an offset range [0, capacity), for memory the CPU can't write bookkeeping into.
+//
+// Blocks are power of two multiples of minBlockSize and start at a multiple of their own size, so any
+// alignment up to the block size comes for free. Free blocks are tracked with one bitmap per order and split
+// blocks with another, which makes free() a walk down from the root and keeps the whole state at about two
+// bits per minimum block. The capacity has to be minBlockSize times a power of two.
+//
+// Not thread safe.
+class BuddyAllocator
+{
+public:
+    BuddyAllocator(std::size_t capacity, std::size_t minBlockSize);
+
+    auto allocate(std::size_t size, std::size_t alignment = 1) -> std::optional<std::size_t>;
+    void free(std::size_t offset);
+
+    // Size of the block serving the allocation at offset
+    auto getBlockSize(std::size_t offset) const -> std::size_t;
+
+    auto getCapacity() const -> std::size_t
+    {
+        return m_minBlockSize << m_maxOrder;
+    }
+
+    auto getMinBlockSize() const -> std::size_t
+    {
+        return m_minBlockSize;
+    }
+
+    auto getUsedSize() const -> std::size_t
+    {
+        return m_usedSize;
+    }
+
+    auto getAllocationCount() const -> std::size_t
+    {
+        return m_allocationCount;
+    }
+
+    auto isEmpty() const -> bool
+    {
+        return m_allocationCount == 0;
+    }
+
+private:
+    auto orderOf(std::size_t size, std::size_t alignment) const -> uint32_t;
+    auto findAllocation(std::size_t offset) const -> std::pair<uint32_t, std::size_t>;
+
+    auto testBit(const std::vector<uint64_t>& bits, uint32_t order, std::size_t index) const -> bool;
+    void setBit(std::vector<uint64_t>& bits, uint32_t order, std::size_t index, bool value);
+    auto popFree(uint32_t order) -> std::size_t;
+
+    std::size_t m_minBlockSize;
+    uint32_t m_minShift;
+    uint32_t m_maxOrder;
+
+    // Both bitmaps store the orders back to back, m_orderWords[order] is the first word of an order
+    std::vector<std::size_t> m_orderWords;
+    std::vector<uint64_t> m_freeBits;
+    std::vector<uint64_t> m_splitBits;
+    std::vector<std::size_t> m_freeCounts;
+    // No free block of the order lives in a word before this one
+    std::vector<std::size_t> m_searchHints;
+
+    std::size_t m_usedSize        = 0;
+    std::size_t m_allocationCount = 0;
+};
+} // namespace aph
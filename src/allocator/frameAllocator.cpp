@@ -0,0 +1,139 @@
+#include "frameAllocator.h"
+
+#include <algorithm>
+
+namespace aph
+{
+namespace
+{
+constexpr std::size_t BlockAlignment = alignof(std::max_align_t);
+
+std::atomic<uint64_t> s_nextFrameAllocatorId{ 1 };
+} // namespace
+
+FrameAllocator::FrameAllocator(uint32_t frameCount, std::size_t blockSize)
+    : m_id(s_nextFrameAllocatorId.fetch_add(1, std::memory_order_relaxed))
+    , m_blockSize(blockSize)
+    , m_frameBlocks(std::max(frameCount, 1u))
+{
+}
+
+FrameAllocator::~FrameAllocator()
+{
+    for (uint32_t frameIndex = 0; frameIndex < m_frameBlocks.size(); ++frameIndex)
+    {
+        recycleFrame(frameIndex);
+    }
+    for (const Block& block : m_freeBlocks)
+    {
+        memory::aph_free(block.pData);
+    }
+}
+
+auto FrameAllocator::allocateSlow(std::size_t size, std::size_t alignment) -> void*
+{
+    std::lock_guard<std::mutex> lock{ m_lock };
+    auto& frameBlocks = m_frameBlocks[m_frameIndex];
+
+    // Large requests get a block of their own and leave the thread's current block alone
+    if (size + alignment > m_blockSize / 4)
+    {
+        const std::size_t blockSize = (size + alignment + BlockAlignment - 1) & ~(BlockAlignment - 1);
+        auto* pData                 = static_cast<std::byte*>(memory::aph_memalign(BlockAlignment, blockSize));
+        if (!pData)
+        {
+            return nullptr;
+        }
+        frameBlocks.push_back({ .pData = pData, .size = blockSize });
+        const auto address = (reinterpret_cast<std::uintptr_t>(pData) + alignment - 1) & ~(alignment - 1);
+        return reinterpret_cast<void*>(address);
+    }
+
+    Block block{};
+    if (!m_freeBlocks.empty())
+    {
+        block = m_freeBlocks.back();
+        m_freeBlocks.pop_back();
+    }
+    else
+    {
+        block.pData = static_cast<std::byte*>(memory::aph_memalign(BlockAlignment, m_blockSize));
+        block.size  = m_blockSize;
+        if (!block.pData)
+        {
+            return nullptr;
+        }
+    }
+    frameBlocks.push_back(block);
+
+    // Small requests always fit at the start of a fresh block
+    const auto address = (reinterpret_cast<std::uintptr_t>(block.pData) + alignment - 1) & ~(alignment - 1);
+    t_cache            = { .allocatorId = m_id,
+                           .frameSerial = m_frameSerial.load(std::memory_order_relaxed),
+                           .pCursor     = reinterpret_cast<std::byte*>(address + size),
+                           .pEnd        = block.pData + block.size };
+    return reinterpret_cast<void*>(address);
+}
+
+void FrameAllocator::recycleFrame(uint32_t frameIndex)
+{
+    for (const Block& block : m_frameBlocks[frameIndex])
+    {
+        if (block.size == m_blockSize)
+        {
+            m_freeBlocks.push_back(block);
+        }
+        else
+        {
+            memory::aph_free(block.pData);
+        }
+    }
+    m_frameBlocks[frameIndex].clear();
+}
+
+void FrameAllocator::nextFrame()
+{
+    std::lock_guard<std::mutex> lock{ m_lock };
+    m_frameSerial.fetch_add(1, std::memory_order_relaxed);
+    m_frameIndex = (m_frameIndex + 1) % static_cast<uint32_t>(m_frameBlocks.size());
+    recycleFrame(m_frameIndex);
+}
+
+void FrameAllocator::setFrameCount(uint32_t frameCount)
+{
+    std::lock_guard<std::mutex> lock{ m_lock };
+    for (uint32_t frameIndex = 0; frameIndex < m_frameBlocks.size(); ++frameIndex)
+    {
+        recycleFrame(frameIndex);
+    }
+    m_frameBlocks.resize(std::max(frameCount, 1u));
+    m_frameSerial.fetch_add(1, std::memory_order_relaxed);
+    m_frameIndex = 0;
+}
+
+auto FrameAllocator::getFrameCount() const -> uint32_t
+{
+    std::lock_guard<std::mutex> lock{ m_lock };
+    return static_cast<uint32_t>(m_frameBlocks.size());
+}
+
+auto FrameAllocator::getFrameIndex() const -> uint32_t
+{
+    std::lock_guard<std::mutex> lock{ m_lock };
+    return m_frameIndex;
+}
+
+auto FrameAllocator::getStats() const -> Stats
+{
+    std::lock_guard<std::mutex> lock{ m_lock };
+    Stats stats{ .frameIndex     = m_frameIndex,
+                 .blockCount     = m_frameBlocks[m_frameIndex].size(),
+                 .reservedBytes  = 0,
+                 .freeBlockCount = m_freeBlocks.size() };
+    for (const Block& block : m_frameBlocks[m_frameIndex])
+    {
+        stats.reservedBytes += block.size;
+    }
+    return stats;
+}
+} // namespace aph
@@ -0,0 +1,175 @@
+#pragma once
+
+#include "allocator/allocator.h"
+#include "common/debug.h"
+#include "common/hash.h"
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace aph
+{
+// Linear allocator for scratch data that only lives until the end of a frame.
+//
+// Memory is bumped out of fixed size blocks and never freed individually. Each frame owns the blocks handed
+// out while it was current, and those are recycled when nextFrame() comes back around to the same slot, so
+// data allocated in a frame stays valid for frameCount frames. Every thread bumps inside a block of its own,
+// which keeps the common path free of atomics and locks; the lock is only taken to hand out the next block.
+//
+// nextFrame() and setFrameCount() must not run concurrently with allocate().
+class FrameAllocator
+{
+public:
+    struct Stats
+    {
+        uint32_t frameIndex;
+        std::size_t blockCount;      // Blocks owned by the current frame
+        std::size_t reservedBytes;   // Bytes of those blocks
+        std::size_t freeBlockCount;  // Blocks waiting to be reused
+    };
+
+    explicit FrameAllocator(uint32_t frameCount = 2, std::size_t blockSize = 256 * memory::KB);
+    ~FrameAllocator();
+
+    FrameAllocator(const FrameAllocator&)            = delete;
+    FrameAllocator& operator=(const FrameAllocator&) = delete;
+    FrameAllocator(FrameAllocator&&)                 = delete;
+    FrameAllocator& operator=(FrameAllocator&&)      = delete;
+
+    [[nodiscard]] auto allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t)) -> void*;
+
+    template <typename T>
+    [[nodiscard]] auto allocateArray(std::size_t count) -> T*
+    {
+        return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    // Starts the next frame and recycles the blocks of the frame that used its slot frameCount frames ago
+    void nextFrame();
+
+    // Drops every allocation of every frame
+    void setFrameCount(uint32_t frameCount);
+
+    auto getFrameCount() const -> uint32_t;
+    auto getFrameIndex() const -> uint32_t;
+    auto getStats() const -> Stats;
+
+private:
+    struct Block
+    {
+        std::byte* pData;
+        std::size_t size;
+    };
+
+    // Block the calling thread is bumping through, valid while both ids match. Zero initialized like any
+    // thread local, allocator ids start at 1.
+    struct ThreadCache
+    {
+        uint64_t allocatorId;
+        uint64_t frameSerial;
+        std::byte* pCursor;
+        std::byte* pEnd;
+    };
+    static inline thread_local ThreadCache t_cache;
+
+    auto allocateSlow(std::size_t size, std::size_t alignment) -> void*;
+    void recycleFrame(uint32_t frameIndex);
+
+    const uint64_t m_id;
+    const std::size_t m_blockSize;
+
+    mutable std::mutex m_lock;
+    std::vector<std::vector<Block>> m_frameBlocks;
+    std::vector<Block> m_freeBlocks;
+
+    // Incremented by every nextFrame(), thread caches of an older frame start a new block
+    std::atomic<uint64_t> m_frameSerial{ 0 };
+    uint32_t m_frameIndex = 0;
+};
+
+inline auto FrameAllocator::allocate(std::size_t size, std::size_t alignment) -> void*
+{
+    APH_ASSERT(std::has_single_bit(alignment));
+
+    ThreadCache& cache = t_cache;
+    if (cache.allocatorId == m_id && cache.frameSerial == m_frameSerial.load(std::memory_order_relaxed))
+    {
+        const auto cursor  = reinterpret_cast<std::uintptr_t>(cache.pCursor);
+        const auto address = (cursor + alignment - 1) & ~(alignment - 1);
+        if (address + size <= reinterpret_cast<std::uintptr_t>(cache.pEnd))
+        {
+            cache.pCursor = reinterpret_cast<std::byte*>(address + size);
+            return reinterpret_cast<void*>(address);
+        }
+    }
+    return allocateSlow(size, alignment);
+}
+
+// STL allocator handing out frame memory, deallocation is a no-op. A default constructed adapter, or one
+// without a frame allocator, falls back to the heap so that containers work outside of a frame as well.
+template <typename T>
+class FrameStlAllocator
+{
+public:
+    using value_type                             = T;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+
+    FrameStlAllocator() noexcept = default;
+
+    FrameStlAllocator(FrameAllocator* pAllocator) noexcept
+        : m_pAllocator(pAllocator)
+    {
+    }
+
+    template <typename U>
+    FrameStlAllocator(const FrameStlAllocator<U>& other) noexcept
+        : m_pAllocator(other.getFrameAllocator())
+    {
+    }
+
+    [[nodiscard]] auto allocate(std::size_t n) -> T*
+    {
+        if (m_pAllocator)
+        {
+            return m_pAllocator->allocateArray<T>(n);
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{ alignof(T) }));
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept
+    {
+        if (!m_pAllocator)
+        {
+            ::operator delete(p, n * sizeof(T), std::align_val_t{ alignof(T) });
+        }
+    }
+
+    auto getFrameAllocator() const noexcept -> FrameAllocator*
+    {
+        return m_pAllocator;
+    }
+
+    template <typename U>
+    friend bool operator==(const FrameStlAllocator& lhs, const FrameStlAllocator<U>& rhs) noexcept
+    {
+        return lhs.getFrameAllocator() == rhs.getFrameAllocator();
+    }
+
+private:
+    FrameAllocator* m_pAllocator = nullptr;
+};
+
+// Containers for per-frame temporaries. SmallVector keeps its inline buffer allocator, so spill-heavy scratch
+// arrays use these instead.
+template <typename T>
+using FrameVector = std::vector<T, FrameStlAllocator<T>>;
+
+template <typename Key, typename T, typename Hash = ::ankerl::unordered_dense::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>>
+using FrameHashMap = HashMap<Key, T, Hash, KeyEqual, FrameStlAllocator<std::pair<Key, T>>>;
+} // namespace aph
@@ -1,11 +1,17 @@
 #pragma once
 
 #include "allocator/allocator.h"
+#include "allocator/poolThreadCache.h"
 #include "common/debug.h"
 #include "common/hash.h"
 #include "common/smallVector.h"
+#include <algorithm>
 #include <atomic>
-#include <shared_mutex>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace aph
 {
@@ -17,6 +23,340 @@ struct PoolDebugInfo
     const char* function;
 };
 
+namespace detail
+{
+// Smallest chunk size of PoolSlabAllocator, the one of every slot type up to a few KB
+constexpr std::size_t PoolChunkSize = 64 * memory::KB;
+
+// Leading fields of every PoolSlabAllocator chunk, the same whatever the slot type
+struct PoolChunkPrefix
+{
+    const void* pOwner;
+    void* pContext;
+};
+
+// Chunk context of a slot, for allocators with PoolChunkSize chunks. Lets type erased code get from an object to
+// the slab it came from without knowing its type.
+inline auto getPoolChunkContext(const void* ptr) -> void*
+{
+    const auto chunk = reinterpret_cast<std::uintptr_t>(ptr) & ~(PoolChunkSize - 1);
+    return reinterpret_cast<const PoolChunkPrefix*>(chunk)->pContext;
+}
+
+// Slab storage shared by the object pools.
+//
+// Slots are carved out of chunks aligned to their own size, so the chunk of any slot is found by masking its
+// address. The chunk header records its owner, which makes ownership checks O(1) without tracking individual
+// objects. Free slots form an intrusive singly linked list threaded through their own storage, and fresh chunks
+// are handed out by bumping an index instead of threading every slot up front. A per-chunk bitmap keeps track
+// of live slots so that clear() can destroy whatever is still allocated and double frees are caught.
+//
+// Not thread safe, except for owns() which only reads immutable chunk headers, the atomic live bits and the
+// published chunk list, and markLive()/markFree() which flip the bits atomically.
+template <typename T>
+class PoolSlabAllocator
+{
+public:
+    PoolSlabAllocator() = default;
+
+    PoolSlabAllocator(const PoolSlabAllocator&)            = delete;
+    PoolSlabAllocator& operator=(const PoolSlabAllocator&) = delete;
+
+    ~PoolSlabAllocator()
+    {
+        releaseChunks();
+    }
+
+    auto allocateSlot() -> void*
+    {
+        Slot* pSlot = popSlot();
+        if (pSlot)
+        {
+            ChunkHeader* pChunk = chunkOf(pSlot);
+            setLive(pChunk, slotIndex(pChunk, pSlot), true);
+            ++m_liveCount;
+        }
+        return pSlot;
+    }
+
+    void freeSlot(void* ptr)
+    {
+        auto* pSlot         = static_cast<Slot*>(ptr);
+        ChunkHeader* pChunk = chunkOf(pSlot);
+        setLive(pChunk, slotIndex(pChunk, pSlot), false);
+        --m_liveCount;
+        pushSlot(pSlot);
+    }
+
+    // Batched transfer of free slots for per-thread caches. The slots stay marked as free, callers flag them
+    // with markLive()/markFree() when they hand them out and take them back, and keep their own live count.
+    auto takeSlots(void** ppSlots, uint32_t count) -> uint32_t
+    {
+        uint32_t taken = 0;
+        while (taken < count)
+        {
+            Slot* pSlot = popSlot();
+            if (!pSlot)
+            {
+                break;
+            }
+            ppSlots[taken++] = pSlot;
+        }
+        return taken;
+    }
+
+    void returnSlots(void* const* ppSlots, uint32_t count)
+    {
+        for (uint32_t index = 0; index < count; ++index)
+        {
+            pushSlot(static_cast<Slot*>(ppSlots[index]));
+        }
+    }
+
+    // Safe to call concurrently from any thread, neighbouring slots may be flagged by other threads
+    static void markLive(void* ptr)
+    {
+        auto* pSlot          = static_cast<Slot*>(ptr);
+        ChunkHeader* pChunk  = chunkOf(pSlot);
+        const uint32_t index = slotIndex(pChunk, pSlot);
+        const uint64_t mask  = uint64_t{ 1 } << (index % 64);
+
+        [[maybe_unused]] const uint64_t word =
+            pChunk->liveBits[index / 64].fetch_or(mask, std::memory_order_relaxed);
+        APH_ASSERT(!(word & mask) && "Pool slot allocated twice");
+    }
+
+    static void markFree(void* ptr)
+    {
+        auto* pSlot          = static_cast<Slot*>(ptr);
+        ChunkHeader* pChunk  = chunkOf(pSlot);
+        const uint32_t index = slotIndex(pChunk, pSlot);
+        const uint64_t mask  = uint64_t{ 1 } << (index % 64);
+
+        [[maybe_unused]] const uint64_t word =
+            pChunk->liveBits[index / 64].fetch_and(~mask, std::memory_order_relaxed);
+        APH_ASSERT((word & mask) && "Pool slot freed twice");
+    }
+
+    // O(1): the chunk must belong to this allocator, and the pointer must be a live slot of it. In release
+    // builds the pointer has to come from some pool, anything else reads unrelated memory through the chunk
+    // mask. Debug builds look the chunk up in the chunk list first, so foreign pointers are rejected safely.
+    auto owns(const void* ptr) const -> bool
+    {
+        if (!ptr)
+        {
+            return false;
+        }
+        const ChunkHeader* pChunk = chunkOf(ptr);
+#ifdef APH_DEBUG
+        if (!hasChunk(pChunk))
+        {
+            return false;
+        }
+#endif
+        if (pChunk->prefix.pOwner != this)
+        {
+            return false;
+        }
+        const auto offset = reinterpret_cast<std::uintptr_t>(ptr) - reinterpret_cast<std::uintptr_t>(pChunk);
+        if (offset < SlotsOffset || (offset - SlotsOffset) % SlotSize != 0)
+        {
+            return false;
+        }
+        const auto index = static_cast<uint32_t>((offset - SlotsOffset) / SlotSize);
+        return index < SlotCount && isLive(pChunk, index);
+    }
+
+    template <typename Func>
+    void forEachLive(Func&& func)
+    {
+        for (ChunkHeader* pChunk = m_pChunks.load(std::memory_order_relaxed); pChunk; pChunk = pChunk->pNext)
+        {
+            for (uint32_t word = 0; word < BitmapWords; ++word)
+            {
+                for (uint64_t bits = pChunk->liveBits[word].load(std::memory_order_relaxed); bits; bits &= bits - 1)
+                {
+                    const uint32_t index = (word * 64) + static_cast<uint32_t>(std::countr_zero(bits));
+                    func(static_cast<void*>(slotAt(pChunk, index)));
+                }
+            }
+        }
+    }
+
+    void releaseChunks()
+    {
+        ChunkHeader* pChunk = m_pChunks.load(std::memory_order_relaxed);
+        while (pChunk)
+        {
+            ChunkHeader* pNext = pChunk->pNext;
+            memory::aph_free(pChunk);
+            pChunk = pNext;
+        }
+        m_pChunks.store(nullptr, std::memory_order_relaxed);
+        m_pBumpChunk = nullptr;
+        m_pFreeList  = nullptr;
+        m_bumpIndex  = 0;
+        m_liveCount  = 0;
+    }
+
+    auto getLiveCount() const -> std::size_t
+    {
+        return m_liveCount;
+    }
+
+    // Stored in every chunk allocated from here on, see getPoolChunkContext()
+    void setChunkContext(void* pContext)
+    {
+        m_pChunkContext = pContext;
+    }
+
+    static constexpr auto getChunkSize() -> std::size_t
+    {
+        return ChunkSize;
+    }
+
+private:
+    union Slot
+    {
+        Slot* pNext;
+        alignas(T) std::byte storage[sizeof(T)];
+    };
+
+    static constexpr std::size_t SlotSize  = sizeof(Slot);
+    static constexpr std::size_t SlotAlign = alignof(Slot);
+
+    // 64 KiB chunks, or enough for 16 objects of a large type
+    static constexpr std::size_t ChunkSize = std::max<std::size_t>(PoolChunkSize, std::bit_ceil(SlotSize * 16 + 256));
+
+    struct ChunkHeader;
+    static constexpr std::size_t HeaderSize = sizeof(PoolChunkPrefix) + sizeof(void*);
+
+    // Largest slot count whose bitmap and slots still fit behind the header
+    static constexpr uint32_t computeSlotCount()
+    {
+        auto count = static_cast<uint32_t>((ChunkSize - HeaderSize) / SlotSize);
+        while (count > 0)
+        {
+            const std::size_t bitmapSize = ((count + 63) / 64) * sizeof(uint64_t);
+            const std::size_t slots      = (HeaderSize + bitmapSize + SlotAlign - 1) & ~(SlotAlign - 1);
+            if (slots + (count * SlotSize) <= ChunkSize)
+            {
+                break;
+            }
+            --count;
+        }
+        return count;
+    }
+
+    static constexpr uint32_t SlotCount     = computeSlotCount();
+    static constexpr uint32_t BitmapWords   = (SlotCount + 63) / 64;
+    static constexpr std::size_t SlotsOffset = (HeaderSize + (BitmapWords * sizeof(uint64_t)) + SlotAlign - 1) &
+                                               ~(SlotAlign - 1);
+    static_assert(SlotCount > 0 && SlotAlign <= ChunkSize);
+
+    struct ChunkHeader
+    {
+        PoolChunkPrefix prefix;
+        ChunkHeader* pNext;
+        std::atomic<uint64_t> liveBits[BitmapWords];
+    };
+    static_assert(sizeof(ChunkHeader) <= SlotsOffset);
+
+    auto popSlot() -> Slot*
+    {
+        Slot* pSlot = m_pFreeList;
+        if (pSlot)
+        {
+            m_pFreeList = pSlot->pNext;
+            return pSlot;
+        }
+
+        if (!m_pBumpChunk || m_bumpIndex == SlotCount)
+        {
+            m_pBumpChunk = allocateChunk();
+            m_bumpIndex  = 0;
+            if (!m_pBumpChunk)
+            {
+                return nullptr;
+            }
+        }
+        return slotAt(m_pBumpChunk, m_bumpIndex++);
+    }
+
+    void pushSlot(Slot* pSlot)
+    {
+        pSlot->pNext = m_pFreeList;
+        m_pFreeList  = pSlot;
+    }
+
+    auto allocateChunk() -> ChunkHeader*
+    {
+        void* memory = memory::aph_memalign(ChunkSize, ChunkSize);
+        if (!memory)
+        {
+            return nullptr;
+        }
+
+        auto* pChunk   = new (memory) ChunkHeader{};
+        pChunk->prefix = { .pOwner = this, .pContext = m_pChunkContext };
+        pChunk->pNext  = m_pChunks.load(std::memory_order_relaxed);
+
+        // Published for the chunk lookups of owns() on other threads
+        m_pChunks.store(pChunk, std::memory_order_release);
+        return pChunk;
+    }
+
+    // Compares addresses only, nothing behind pChunk is read
+    auto hasChunk(const ChunkHeader* pChunk) const -> bool
+    {
+        const ChunkHeader* pCurrent = m_pChunks.load(std::memory_order_acquire);
+        while (pCurrent && pCurrent != pChunk)
+        {
+            pCurrent = pCurrent->pNext;
+        }
+        return pCurrent != nullptr;
+    }
+
+    static auto chunkOf(const void* ptr) -> ChunkHeader*
+    {
+        return reinterpret_cast<ChunkHeader*>(reinterpret_cast<std::uintptr_t>(ptr) & ~(ChunkSize - 1));
+    }
+
+    static auto slotAt(ChunkHeader* pChunk, uint32_t index) -> Slot*
+    {
+        return reinterpret_cast<Slot*>(reinterpret_cast<std::byte*>(pChunk) + SlotsOffset + (index * SlotSize));
+    }
+
+    static auto slotIndex(const ChunkHeader* pChunk, const Slot* pSlot) -> uint32_t
+    {
+        const auto offset = reinterpret_cast<std::uintptr_t>(pSlot) - reinterpret_cast<std::uintptr_t>(pChunk);
+        return static_cast<uint32_t>((offset - SlotsOffset) / SlotSize);
+    }
+
+    static auto isLive(const ChunkHeader* pChunk, uint32_t index) -> bool
+    {
+        return (pChunk->liveBits[index / 64].load(std::memory_order_relaxed) >> (index % 64)) & 1;
+    }
+
+    // Writers are serialized by ObjectPool, a plain load/store keeps the bits readable by owns() without RMWs
+    static void setLive(ChunkHeader* pChunk, uint32_t index, bool live)
+    {
+        APH_ASSERT(isLive(pChunk, index) != live && "Pool slot allocated or freed twice");
+        auto& bits          = pChunk->liveBits[index / 64];
+        const uint64_t mask = uint64_t{ 1 } << (index % 64);
+        const uint64_t word = bits.load(std::memory_order_relaxed);
+        bits.store(live ? (word | mask) : (word & ~mask), std::memory_order_relaxed);
+    }
+
+    std::atomic<ChunkHeader*> m_pChunks = nullptr;
+    ChunkHeader* m_pBumpChunk           = nullptr;
+    Slot* m_pFreeList                   = nullptr;
+    uint32_t m_bumpIndex                = 0;
+    std::size_t m_liveCount             = 0;
+    void* m_pChunkContext               = nullptr;
+};
+} // namespace detail
+
 template <typename T>
 class ObjectPool
 {
@@ -42,8 +382,7 @@ public:
     ~ObjectPool();
 
 private:
-    // Track all allocated objects
-    HashSet<T*> m_allocations;
+    detail::PoolSlabAllocator<T> m_slabs;
 
 #ifdef APH_DEBUG
     // Debug tracking for allocations (file/line where allocated)
@@ -60,27 +399,15 @@ inline ObjectPool<T>::~ObjectPool()
 template <typename T>
 inline size_t ObjectPool<T>::getAllocationCount() const
 {
-    return m_allocations.size();
+    return m_slabs.getLiveCount();
 }
 
 template <typename T>
 inline void ObjectPool<T>::clear()
 {
-    // Make a copy of allocations to avoid iterator invalidation
-    auto allocationsCopy = m_allocations;
-
-    // Free all objects
-    for (T* ptr : allocationsCopy)
-    {
-        // Call destructor
-        ptr->~T();
-
-        // Free memory
-        memory::aph_free(ptr);
-    }
-
-    // Clear tracking
-    m_allocations.clear();
+    // Destroy every live object, then hand the chunks back in one go
+    m_slabs.forEachLive([](void* ptr) { static_cast<T*>(ptr)->~T(); });
+    m_slabs.releaseChunks();
 
 #ifdef APH_DEBUG
     m_debugInfo.clear();
@@ -96,31 +423,29 @@ inline void ObjectPool<T>::free(T* ptr)
     }
 
     // Check if this object belongs to this pool
-    APH_ASSERT(m_allocations.contains(ptr) && "Attempting to free an object not allocated from this pool");
+    const bool owned = m_slabs.owns(ptr);
+    APH_ASSERT(owned && "Attempting to free an object not allocated from this pool");
 
-    if (!m_allocations.contains(ptr))
+    if (!owned)
     {
         return;
     }
 
-    // Remove from allocation tracking
-    m_allocations.erase(ptr);
-
 #ifdef APH_DEBUG
     m_debugInfo.erase(ptr);
 #endif
 
-    // Call destructor and free memory
+    // Call destructor and return the slot
     ptr->~T();
-    memory::aph_free(ptr);
+    m_slabs.freeSlot(ptr);
 }
 
 template <typename T>
 template <typename... P>
 inline T* ObjectPool<T>::allocate(P&&... p)
 {
-    // Allocate memory for the object
-    void* memory = memory::aph_memalign(alignof(T), sizeof(T));
+    // Take a slot for the object
+    void* memory = m_slabs.allocateSlot();
     APH_ASSERT(memory && "Failed to allocate memory");
 
     if (!memory)
@@ -131,9 +456,6 @@ inline T* ObjectPool<T>::allocate(P&&... p)
     // Construct the object
     T* object = new (memory) T(std::forward<P>(p)...);
 
-    // Track the allocation
-    m_allocations.insert(object);
-
 #ifdef APH_DEBUG
     // Store allocation info for debugging
     PoolDebugInfo info{};
@@ -146,24 +468,17 @@ inline T* ObjectPool<T>::allocate(P&&... p)
 
     return object;
 }
-} // namespace aph
-
-namespace aph
-{
-// Node for concurrent operations
-template <typename T>
-struct ConcurrentNode
-{
-    T* value;
-    std::atomic<ConcurrentNode*> next;
-
-    explicit ConcurrentNode(T* val)
-        : value(val)
-        , next(nullptr)
-    {
-    }
-};
 
+// Same slab storage as ObjectPool, fronted by per-thread magazines in the style of Bonwick's magazine layer.
+//
+// Each thread owns a loaded and a previous magazine, small stacks of free slots. Allocations pop from the
+// loaded one and frees push to it, and the two are swapped when the loaded one runs empty or full, so neither
+// path takes the lock in the common case. Only when both are empty or both are full does the thread lock the
+// pool and exchange a whole magazine with the shared depot, or fall back to the slabs. Objects are
+// constructed and destroyed outside of the lock.
+//
+// clear() must not run concurrently with allocate() or free(). Thread caches notice it through an epoch and
+// drop their slots the next time they are used.
 template <typename T>
 class ThreadSafeObjectPool
 {
@@ -189,55 +504,96 @@ public:
     ~ThreadSafeObjectPool();
 
 private:
-    // Head of our linked list
-    std::atomic<ConcurrentNode<T>*> m_head;
+    using SlabAllocator = detail::PoolSlabAllocator<T>;
+
+    // Around 8 KiB of cached objects per magazine
+    static constexpr uint32_t MagazineSize = static_cast<uint32_t>(std::clamp<std::size_t>(8 * memory::KB / sizeof(T),
+                                                                                           4, 64));
+    // Full magazines kept for other threads before slots go back to the slabs
+    static constexpr std::size_t MaxDepotMagazines = 16;
+
+    struct Magazine
+    {
+        uint32_t count = 0;
+        void* slots[MagazineSize];
+    };
+
+    struct ThreadCache
+    {
+        Magazine* pLoaded   = &magazines[0];
+        Magazine* pPrevious = &magazines[1];
+        Magazine magazines[2];
+
+        // Written by the owning thread only, read by getAllocationCount()
+        std::atomic<uint64_t> epoch{ 0 };
+        std::atomic<int64_t> liveCount{ 0 };
+    };
+
+    auto getThreadCache() -> ThreadCache*;
+    auto createThreadCache() -> ThreadCache*;
+    auto allocateSlot() -> void*;
+    void freeSlot(void* ptr);
+    static void releaseThreadCache(void* pPool, void* pCache);
+
+    static void addLive(ThreadCache* pCache, int64_t delta)
+    {
+        pCache->liveCount.store(pCache->liveCount.load(std::memory_order_relaxed) + delta,
+                                std::memory_order_relaxed);
+    }
 
-    // Count of active allocations
-    std::atomic<size_t> m_activeCount;
+    mutable std::mutex m_lock;
+    SlabAllocator m_slabs;
+    std::vector<Magazine> m_depot;
+    std::vector<std::unique_ptr<ThreadCache>> m_threadCaches;
+
+    // Live objects of thread caches that have been released
+    int64_t m_retiredLiveCount = 0;
+
+    std::atomic<uint64_t> m_epoch{ 1 };
+    detail::PoolCacheRegistry::Registration m_registration;
 };
 
 template <typename T>
-inline ThreadSafeObjectPool<T>::~ThreadSafeObjectPool()
+inline ThreadSafeObjectPool<T>::ThreadSafeObjectPool()
+    : m_registration(detail::PoolCacheRegistry::registerPool(this, &ThreadSafeObjectPool::releaseThreadCache))
 {
-    clear();
 }
 
 template <typename T>
-inline size_t ThreadSafeObjectPool<T>::getAllocationCount() const
+inline ThreadSafeObjectPool<T>::~ThreadSafeObjectPool()
 {
-    return m_activeCount.load(std::memory_order_relaxed);
+    // No exiting thread hands its cache back once unregistered
+    detail::PoolCacheRegistry::unregisterPool(m_registration);
+    clear();
 }
 
 template <typename T>
-inline void ThreadSafeObjectPool<T>::clear()
+inline size_t ThreadSafeObjectPool<T>::getAllocationCount() const
 {
-    // Use a linked list traversal to clear everything
-    ConcurrentNode<T>* current = m_head.exchange(nullptr, std::memory_order_acquire);
-
-    // Create a new sentinel node for future use
-    auto* sentinel = new ConcurrentNode<T>(nullptr);
-    sentinel->next.store(nullptr, std::memory_order_relaxed);
-    m_head.store(sentinel, std::memory_order_release);
-
-    // Reset count
-    m_activeCount.store(0, std::memory_order_relaxed);
-
-    // Free all nodes and objects
-    while (current)
+    std::lock_guard<std::mutex> lock{ m_lock };
+    const uint64_t epoch = m_epoch.load(std::memory_order_relaxed);
+    int64_t count        = m_retiredLiveCount;
+    for (const auto& pCache : m_threadCaches)
     {
-        ConcurrentNode<T>* next = current->next.load(std::memory_order_relaxed);
-
-        // Free the object if it exists (skip sentinel nodes)
-        if (current->value)
+        if (pCache->epoch.load(std::memory_order_relaxed) == epoch)
         {
-            current->value->~T();
-            memory::aph_free(current->value);
+            count += pCache->liveCount.load(std::memory_order_relaxed);
         }
-
-        // Free the node
-        delete current;
-        current = next;
     }
+    return count > 0 ? static_cast<size_t>(count) : 0;
+}
+
+template <typename T>
+inline void ThreadSafeObjectPool<T>::clear()
+{
+    std::lock_guard<std::mutex> lock{ m_lock };
+    m_slabs.forEachLive([](void* ptr) { static_cast<T*>(ptr)->~T(); });
+    m_slabs.releaseChunks();
+    m_depot.clear();
+    m_retiredLiveCount = 0;
+
+    // Thread caches still point into the released chunks, they reset themselves on their next use
+    m_epoch.fetch_add(1, std::memory_order_release);
 }
 
 template <typename T>
@@ -248,70 +604,22 @@ inline void ThreadSafeObjectPool<T>::free(T* ptr)
         return;
     }
 
-    // Find and remove the node from our linked list
-    ConcurrentNode<T>* prev = m_head.load(std::memory_order_acquire);
-    if (!prev)
+    const bool owned = m_slabs.owns(ptr);
+    APH_ASSERT(owned && "Attempting to free an object not allocated from this pool");
+    if (!owned)
     {
-        // Empty list
-        APH_ASSERT(false && "Attempting to free an object not allocated from this pool");
         return;
     }
 
-    // Special case for head node
-    if (prev != nullptr && prev->value == ptr)
-    {
-        // Try to remove the head
-        if (m_head.compare_exchange_strong(prev, prev->next.load(std::memory_order_relaxed), std::memory_order_release,
-                                           std::memory_order_relaxed))
-        {
-            // Decrement count
-            m_activeCount.fetch_sub(1, std::memory_order_relaxed);
-
-            // Free the object and node
-            ptr->~T();
-            memory::aph_free(ptr);
-            delete prev;
-            return;
-        }
-    }
-
-    // Traverse the list to find the node
-    ConcurrentNode<T>* current = prev ? prev->next.load(std::memory_order_relaxed) : nullptr;
-    while (current)
-    {
-        if (current->value == ptr)
-        {
-            // Found it, try to remove it
-            ConcurrentNode<T>* nextNode = current->next.load(std::memory_order_relaxed);
-            if (prev->next.compare_exchange_strong(current, nextNode, std::memory_order_release,
-                                                   std::memory_order_relaxed))
-            {
-                // Decrement count
-                m_activeCount.fetch_sub(1, std::memory_order_relaxed);
-
-                // Free the object and node
-                ptr->~T();
-                memory::aph_free(ptr);
-                delete current;
-                return;
-            }
-            // Someone else changed the list, retry from the beginning
-            return free(ptr);
-        }
-        prev    = current;
-        current = current->next.load(std::memory_order_relaxed);
-    }
-
-    // Not found
-    APH_ASSERT(false && "Attempting to free an object not allocated from this pool");
+    ptr->~T();
+    freeSlot(ptr);
 }
 
 template <typename T>
 template <typename... P>
 inline T* ThreadSafeObjectPool<T>::allocate(P&&... p)
 {
-    // Allocate memory for the object
-    void* memory = memory::aph_memalign(alignof(T), sizeof(T));
+    void* memory = allocateSlot();
     APH_ASSERT(memory && "Failed to allocate memory");
 
     if (!memory)
@@ -320,33 +628,128 @@ inline T* ThreadSafeObjectPool<T>::allocate(P&&... p)
     }
 
     // Construct the object
-    T* object = new (memory) T(std::forward<P>(p)...);
+    return new (memory) T(std::forward<P>(p)...);
+}
 
-    // Create a new node
-    auto* newNode = new ConcurrentNode<T>(object);
+template <typename T>
+inline auto ThreadSafeObjectPool<T>::getThreadCache() -> ThreadCache*
+{
+    auto* pCache = static_cast<ThreadCache*>(detail::PoolCacheRegistry::find(m_registration));
+    if (!pCache)
+    {
+        return createThreadCache();
+    }
 
-    // Add to the list using a lock-free approach
-    ConcurrentNode<T>* oldHead = m_head.load(std::memory_order_relaxed);
-    do
+    const uint64_t epoch = m_epoch.load(std::memory_order_acquire);
+    if (pCache->epoch.load(std::memory_order_relaxed) != epoch)
     {
-        newNode->next.store(oldHead, std::memory_order_relaxed);
-    } while (!m_head.compare_exchange_weak(oldHead, newNode, std::memory_order_release, std::memory_order_relaxed));
+        // The pool was cleared, the cached slots are gone with their chunks
+        pCache->magazines[0].count = 0;
+        pCache->magazines[1].count = 0;
+        pCache->liveCount.store(0, std::memory_order_relaxed);
+        pCache->epoch.store(epoch, std::memory_order_relaxed);
+    }
+    return pCache;
+}
 
-    // Increment active count
-    m_activeCount.fetch_add(1, std::memory_order_relaxed);
+template <typename T>
+inline auto ThreadSafeObjectPool<T>::createThreadCache() -> ThreadCache*
+{
+    auto cache = std::make_unique<ThreadCache>();
+    cache->epoch.store(m_epoch.load(std::memory_order_acquire), std::memory_order_relaxed);
 
-    return object;
+    ThreadCache* pCache = cache.get();
+    {
+        std::lock_guard<std::mutex> lock{ m_lock };
+        m_threadCaches.push_back(std::move(cache));
+    }
+    detail::PoolCacheRegistry::bind(m_registration, pCache);
+    return pCache;
 }
 
 template <typename T>
-inline ThreadSafeObjectPool<T>::ThreadSafeObjectPool()
-    : m_head(nullptr)
-    , m_activeCount(0)
+inline auto ThreadSafeObjectPool<T>::allocateSlot() -> void*
+{
+    ThreadCache* pCache = getThreadCache();
+    if (pCache->pLoaded->count == 0)
+    {
+        if (pCache->pPrevious->count != 0)
+        {
+            std::swap(pCache->pLoaded, pCache->pPrevious);
+        }
+        else
+        {
+            // Both empty, reload from the depot or carve a batch out of the slabs
+            std::lock_guard<std::mutex> lock{ m_lock };
+            if (!m_depot.empty())
+            {
+                *pCache->pLoaded = m_depot.back();
+                m_depot.pop_back();
+            }
+            else
+            {
+                pCache->pLoaded->count = m_slabs.takeSlots(pCache->pLoaded->slots, MagazineSize);
+                if (pCache->pLoaded->count == 0)
+                {
+                    return nullptr;
+                }
+            }
+        }
+    }
+
+    void* ptr = pCache->pLoaded->slots[--pCache->pLoaded->count];
+    SlabAllocator::markLive(ptr);
+    addLive(pCache, 1);
+    return ptr;
+}
+
+template <typename T>
+inline void ThreadSafeObjectPool<T>::freeSlot(void* ptr)
 {
-    // Initialize an empty sentinel node
-    auto* sentinel = new ConcurrentNode<T>(nullptr);
-    sentinel->next.store(nullptr, std::memory_order_relaxed);
-    m_head.store(sentinel, std::memory_order_relaxed);
+    ThreadCache* pCache = getThreadCache();
+    SlabAllocator::markFree(ptr);
+    addLive(pCache, -1);
+
+    if (pCache->pLoaded->count == MagazineSize)
+    {
+        if (pCache->pPrevious->count != MagazineSize)
+        {
+            std::swap(pCache->pLoaded, pCache->pPrevious);
+        }
+        else
+        {
+            // Both full, hand one over to the depot
+            std::lock_guard<std::mutex> lock{ m_lock };
+            if (m_depot.size() < MaxDepotMagazines)
+            {
+                m_depot.push_back(*pCache->pLoaded);
+            }
+            else
+            {
+                m_slabs.returnSlots(pCache->pLoaded->slots, MagazineSize);
+            }
+            pCache->pLoaded->count = 0;
+        }
+    }
+
+    pCache->pLoaded->slots[pCache->pLoaded->count++] = ptr;
 }
 
+template <typename T>
+inline void ThreadSafeObjectPool<T>::releaseThreadCache(void* pPool, void* pCache)
+{
+    auto* pSelf        = static_cast<ThreadSafeObjectPool*>(pPool);
+    auto* pThreadCache = static_cast<ThreadCache*>(pCache);
+
+    std::lock_guard<std::mutex> lock{ pSelf->m_lock };
+    if (pThreadCache->epoch.load(std::memory_order_relaxed) == pSelf->m_epoch.load(std::memory_order_relaxed))
+    {
+        for (const Magazine& magazine : pThreadCache->magazines)
+        {
+            pSelf->m_slabs.returnSlots(magazine.slots, magazine.count);
+        }
+        pSelf->m_retiredLiveCount += pThreadCache->liveCount.load(std::memory_order_relaxed);
+    }
+    std::erase_if(pSelf->m_threadCaches, [pThreadCache](const auto& cache) { return cache.get() == pThreadCache; });
+}
 } // namespace aph
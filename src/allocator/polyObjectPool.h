@@ -2,9 +2,33 @@
 
 #include "allocator/objectPool.h"
 #include "common/hash.h"
+#include "common/smallVector.h"
 
 namespace aph
 {
+namespace detail
+{
+// Dense per base type index of every derived type allocated from a polymorphic pool of that base
+template <typename BaseT>
+struct PolymorphicTypeIndex
+{
+    template <typename DerivedT>
+    static auto get() -> uint32_t
+    {
+        static const uint32_t index = s_nextIndex.fetch_add(1, std::memory_order_relaxed);
+        return index;
+    }
+
+    inline static std::atomic<uint32_t> s_nextIndex{ 0 };
+};
+} // namespace detail
+
+// Pool of objects of types derived from BaseT, freed through a BaseT pointer.
+//
+// Every derived type gets its own slab allocator, found through its type index on allocation. The chunks of a
+// slab point back at it, so free() gets from an object to its slab and destructor by masking the address instead
+// of looking the object up, and clear() destroys the live objects slab by slab. Derived types are limited to about
+// 4 KB, sixteen of them have to fit the smallest pool chunk.
 template <typename BaseT>
 class PolymorphicObjectPool
 {
@@ -31,18 +55,79 @@ public:
     ~PolymorphicObjectPool();
 
 private:
-    // Type-erased destructor function pointer
-    using DestructorFn = void (*)(void*);
+    // Slots of one derived type, which holds the type's destructor once for all of its objects
+    class TypeSlab
+    {
+    public:
+        explicit TypeSlab(const PolymorphicObjectPool* pPool)
+            : m_pPool(pPool)
+        {
+        }
+
+        virtual ~TypeSlab() = default;
+
+        // Destroys the object and returns its slot, false if it isn't a live object of this slab
+        virtual auto free(BaseT* ptr) -> bool = 0;
+        // Destroys every live object and releases the chunks
+        virtual void clear() = 0;
 
-    // Store both the destructor and the original memory pointer
-    struct AllocationInfo
+        auto getPool() const -> const PolymorphicObjectPool*
+        {
+            return m_pPool;
+        }
+
+    private:
+        const PolymorphicObjectPool* m_pPool;
+    };
+
+    template <typename DerivedT>
+    class TypedSlab final : public TypeSlab
     {
-        DestructorFn destructor;
-        void* memory;
+    public:
+        static_assert(detail::PoolSlabAllocator<DerivedT>::getChunkSize() == detail::PoolChunkSize,
+                      "DerivedT is too large for a polymorphic pool, use an ObjectPool");
+
+        explicit TypedSlab(const PolymorphicObjectPool* pPool)
+            : TypeSlab(pPool)
+        {
+            m_slots.setChunkContext(static_cast<TypeSlab*>(this));
+        }
+
+        ~TypedSlab() override
+        {
+            clear();
+        }
+
+        auto allocateSlot() -> void*
+        {
+            return m_slots.allocateSlot();
+        }
+
+        auto free(BaseT* ptr) -> bool override
+        {
+            auto* pObject = static_cast<DerivedT*>(ptr);
+            if (!m_slots.owns(pObject))
+            {
+                return false;
+            }
+            pObject->~DerivedT();
+            m_slots.freeSlot(pObject);
+            return true;
+        }
+
+        void clear() override
+        {
+            m_slots.forEachLive([](void* ptr) { static_cast<DerivedT*>(ptr)->~DerivedT(); });
+            m_slots.releaseChunks();
+        }
+
+    private:
+        detail::PoolSlabAllocator<DerivedT> m_slots;
     };
 
-    // Track allocations with their destructors
-    HashMap<BaseT*, AllocationInfo> m_allocations;
+    // Indexed by detail::PolymorphicTypeIndex<BaseT>, null for types never allocated from this pool
+    SmallVector<std::unique_ptr<TypeSlab>> m_slabs;
+    std::size_t m_allocationCount = 0;
 
 #ifdef APH_DEBUG
     // Debug tracking for allocations
@@ -59,31 +144,25 @@ inline PolymorphicObjectPool<BaseT>::~PolymorphicObjectPool()
 template <typename BaseT>
 inline size_t PolymorphicObjectPool<BaseT>::getAllocationCount() const
 {
-    return m_allocations.size();
+    return m_allocationCount;
 }
 
 template <typename BaseT>
 inline void PolymorphicObjectPool<BaseT>::clear()
 {
-    // Make a copy to avoid iterator invalidation
-    auto allocationsCopy = m_allocations;
-
-    // Clear existing allocations first
-    m_allocations.clear();
+    // Slabs stay around for the next allocations of their type, only their chunks go
+    for (auto& pSlab : m_slabs)
+    {
+        if (pSlab)
+        {
+            pSlab->clear();
+        }
+    }
+    m_allocationCount = 0;
 
 #ifdef APH_DEBUG
     m_debugInfo.clear();
 #endif
-
-    // Free all objects
-    for (const auto& [ptr, info] : allocationsCopy)
-    {
-        // Call the type-specific destructor
-        info.destructor(ptr);
-
-        // Free memory
-        memory::aph_free(info.memory);
-    }
 }
 
 template <typename BaseT>
@@ -94,30 +173,21 @@ inline void PolymorphicObjectPool<BaseT>::free(BaseT* ptr)
         return;
     }
 
-    // Check if this object belongs to this pool
-    auto it = m_allocations.find(ptr);
-    APH_ASSERT(it != m_allocations.end() && "Attempting to free an object not allocated from this pool");
+    // The chunk of the object points at its slab. Like ObjectPool::free() this reads the chunk header of
+    // whatever memory ptr points into, so it has to come from some pool.
+    auto* pSlab      = static_cast<TypeSlab*>(detail::getPoolChunkContext(ptr));
+    const bool owned = pSlab && pSlab->getPool() == this && pSlab->free(ptr);
+    APH_ASSERT(owned && "Attempting to free an object not allocated from this pool");
 
-    if (it == m_allocations.end())
+    if (!owned)
     {
         return;
     }
-
-    // Store the memory pointer and destructor
-    AllocationInfo info = it->second;
-
-    // Remove from tracking
-    m_allocations.erase(it);
+    m_allocationCount--;
 
 #ifdef APH_DEBUG
     m_debugInfo.erase(ptr);
 #endif
-
-    // Call the type-specific destructor
-    info.destructor(ptr);
-
-    // Free the memory
-    memory::aph_free(info.memory);
 }
 
 template <typename BaseT>
@@ -126,8 +196,19 @@ inline DerivedT* PolymorphicObjectPool<BaseT>::allocate(Args&&... args)
 {
     static_assert(std::is_base_of<BaseT, DerivedT>::value, "DerivedT must inherit from BaseT");
 
-    // Allocate memory for the derived type
-    void* memory = memory::aph_memalign(alignof(DerivedT), sizeof(DerivedT));
+    // Find the slab of the derived type
+    const uint32_t typeIndex = detail::PolymorphicTypeIndex<BaseT>::template get<DerivedT>();
+    if (typeIndex >= m_slabs.size())
+    {
+        m_slabs.resize(typeIndex + 1);
+    }
+    auto& pSlab = m_slabs[typeIndex];
+    if (!pSlab)
+    {
+        pSlab = std::make_unique<TypedSlab<DerivedT>>(this);
+    }
+
+    void* memory = static_cast<TypedSlab<DerivedT>*>(pSlab.get())->allocateSlot();
     APH_ASSERT(memory && "Failed to allocate memory for polymorphic object");
 
     if (!memory)
@@ -137,14 +218,7 @@ inline DerivedT* PolymorphicObjectPool<BaseT>::allocate(Args&&... args)
 
     // Construct the derived object
     DerivedT* derivedPtr = new (memory) DerivedT(std::forward<Args>(args)...);
-    BaseT* basePtr       = static_cast<BaseT*>(derivedPtr);
-
-    // Store the allocation with its type-specific deleter
-    m_allocations[basePtr] = { [](void* ptr)
-                               {
-                                   static_cast<DerivedT*>(static_cast<BaseT*>(ptr))->~DerivedT();
-                               },
-                               memory };
+    m_allocationCount++;
 
 #ifdef APH_DEBUG
     // Store allocation info for debugging
@@ -153,39 +227,19 @@ inline DerivedT* PolymorphicObjectPool<BaseT>::allocate(Args&&... args)
     info.file                = loc.file_name();
     info.line                = static_cast<int>(loc.line());
     info.function            = loc.function_name();
-    m_debugInfo[basePtr]     = info;
+    m_debugInfo[derivedPtr]  = info;
 #endif
 
     return derivedPtr;
 }
-} // namespace aph
-
-namespace aph
-{
-// Concurrent node for polymorphic objects
-template <typename BaseT>
-struct ConcurrentPolymorphicNode
-{
-    BaseT* ptr;
-    void* memory;
-    void (*destructor)(void*);
-    std::atomic<ConcurrentPolymorphicNode*> next;
-
-    ConcurrentPolymorphicNode(BaseT* p, void* mem, void (*dest)(void*))
-        : ptr(p)
-        , memory(mem)
-        , destructor(dest)
-        , next(nullptr)
-    {
-    }
-};
 
-// Thread-safe version of the polymorphic pool
+// Thread-safe version of the polymorphic pool. Serializes a PolymorphicObjectPool, whose operations are a few
+// pointer updates each.
 template <typename BaseT>
 class ThreadSafePolymorphicObjectPool
 {
 public:
-    ThreadSafePolymorphicObjectPool();
+    ThreadSafePolymorphicObjectPool() = default;
 
     // Delete copy and move operations
     ThreadSafePolymorphicObjectPool(const ThreadSafePolymorphicObjectPool&)            = delete;
@@ -194,185 +248,33 @@ public:
     ThreadSafePolymorphicObjectPool& operator=(ThreadSafePolymorphicObjectPool&&)      = delete;
 
     template <typename DerivedT, typename... Args>
-    DerivedT* allocate(Args&&... args);
-
-    void free(BaseT* ptr);
-
-    void clear();
-
-    // Get current number of allocated objects (for debugging)
-    size_t getAllocationCount() const;
-
-    ~ThreadSafePolymorphicObjectPool();
-
-private:
-    // Head of our linked list
-    std::atomic<ConcurrentPolymorphicNode<BaseT>*> m_head;
-
-    // Count of active allocations
-    std::atomic<size_t> m_activeCount;
-};
-
-template <typename BaseT>
-inline ThreadSafePolymorphicObjectPool<BaseT>::~ThreadSafePolymorphicObjectPool()
-{
-    clear();
-}
-
-template <typename BaseT>
-inline size_t ThreadSafePolymorphicObjectPool<BaseT>::getAllocationCount() const
-{
-    return m_activeCount.load(std::memory_order_relaxed);
-}
-
-template <typename BaseT>
-inline void ThreadSafePolymorphicObjectPool<BaseT>::clear()
-{
-    // Use a linked list traversal to clear everything
-    ConcurrentPolymorphicNode<BaseT>* current = m_head.exchange(nullptr, std::memory_order_acquire);
-
-    // Create a new sentinel node for future use
-    auto* sentinel = new ConcurrentPolymorphicNode<BaseT>(nullptr, nullptr, nullptr);
-    sentinel->next.store(nullptr, std::memory_order_relaxed);
-    m_head.store(sentinel, std::memory_order_release);
-
-    // Reset count
-    m_activeCount.store(0, std::memory_order_relaxed);
-
-    // Free all nodes and objects
-    while (current)
-    {
-        ConcurrentPolymorphicNode<BaseT>* next = current->next.load(std::memory_order_relaxed);
-
-        // Free the object if it exists (skip sentinel nodes)
-        if (current->ptr && current->memory)
-        {
-            current->destructor(current->ptr);
-            memory::aph_free(current->memory);
-        }
-
-        // Free the node
-        delete current;
-        current = next;
-    }
-}
-
-template <typename BaseT>
-inline void ThreadSafePolymorphicObjectPool<BaseT>::free(BaseT* ptr)
-{
-    if (!ptr)
+    DerivedT* allocate(Args&&... args)
     {
-        return;
+        std::lock_guard<std::mutex> lock{ m_lock };
+        return m_pool.template allocate<DerivedT>(std::forward<Args>(args)...);
     }
 
-    // Find and remove the node from our linked list
-    ConcurrentPolymorphicNode<BaseT>* prev = m_head.load(std::memory_order_acquire);
-    if (!prev)
+    void free(BaseT* ptr)
     {
-        // Empty list
-        APH_ASSERT(false && "Attempting to free an object not allocated from this pool");
-        return;
-    }
-
-    // Special case for head node
-    if (prev != nullptr && prev->ptr == ptr)
-    {
-        // Try to remove the head
-        if (m_head.compare_exchange_strong(prev, prev->next.load(std::memory_order_relaxed), std::memory_order_release,
-                                           std::memory_order_relaxed))
-        {
-            // Decrement count
-            m_activeCount.fetch_sub(1, std::memory_order_relaxed);
-
-            // Free the object and node
-            prev->destructor(ptr);
-            memory::aph_free(prev->memory);
-            delete prev;
-            return;
-        }
+        std::lock_guard<std::mutex> lock{ m_lock };
+        m_pool.free(ptr);
     }
 
-    // Traverse the list to find the node
-    ConcurrentPolymorphicNode<BaseT>* current = prev ? prev->next.load(std::memory_order_relaxed) : nullptr;
-    while (current)
+    void clear()
     {
-        if (current->ptr == ptr)
-        {
-            // Found it, try to remove it
-            ConcurrentPolymorphicNode<BaseT>* nextNode = current->next.load(std::memory_order_relaxed);
-            if (prev->next.compare_exchange_strong(current, nextNode, std::memory_order_release,
-                                                   std::memory_order_relaxed))
-            {
-                // Decrement count
-                m_activeCount.fetch_sub(1, std::memory_order_relaxed);
-
-                // Free the object and node
-                current->destructor(ptr);
-                memory::aph_free(current->memory);
-                delete current;
-                return;
-            }
-            // Someone else changed the list, retry from the beginning
-            return free(ptr);
-        }
-        prev    = current;
-        current = current->next.load(std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock{ m_lock };
+        m_pool.clear();
     }
 
-    // Not found
-    APH_ASSERT(false && "Attempting to free an object not allocated from this pool");
-}
-
-template <typename BaseT>
-template <typename DerivedT, typename... Args>
-inline DerivedT* ThreadSafePolymorphicObjectPool<BaseT>::allocate(Args&&... args)
-{
-    static_assert(std::is_base_of<BaseT, DerivedT>::value, "DerivedT must inherit from BaseT");
-
-    // Allocate memory for the derived type
-    void* memory = memory::aph_memalign(alignof(DerivedT), sizeof(DerivedT));
-    APH_ASSERT(memory && "Failed to allocate memory for polymorphic object");
-
-    if (!memory)
+    // Get current number of allocated objects (for debugging)
+    size_t getAllocationCount() const
     {
-        return nullptr;
+        std::lock_guard<std::mutex> lock{ m_lock };
+        return m_pool.getAllocationCount();
     }
 
-    // Construct the derived object
-    DerivedT* derivedPtr = new (memory) DerivedT(std::forward<Args>(args)...);
-    BaseT* basePtr       = static_cast<BaseT*>(derivedPtr);
-
-    // Create destructor function
-    auto destructor = [](void* ptr)
-    {
-        static_cast<DerivedT*>(static_cast<BaseT*>(ptr))->~DerivedT();
-    };
-
-    // Create and add a new node to the list
-    auto* newNode = new ConcurrentPolymorphicNode<BaseT>(basePtr, memory, destructor);
-
-    // Add to the list using a lock-free approach
-    ConcurrentPolymorphicNode<BaseT>* oldHead = m_head.load(std::memory_order_relaxed);
-    do
-    {
-        newNode->next.store(oldHead, std::memory_order_relaxed);
-    } while (!m_head.compare_exchange_weak(oldHead, newNode, std::memory_order_release, std::memory_order_relaxed));
-
-    // Increment count
-    m_activeCount.fetch_add(1, std::memory_order_relaxed);
-
-    return derivedPtr;
-}
-
-template <typename BaseT>
-inline ThreadSafePolymorphicObjectPool<BaseT>::ThreadSafePolymorphicObjectPool()
-    : m_head(nullptr)
-    , m_activeCount(0)
-{
-    // Initialize an empty sentinel node
-    auto* sentinel = new ConcurrentPolymorphicNode<BaseT>(nullptr, nullptr, nullptr);
-    sentinel->next.store(nullptr, std::memory_order_relaxed);
-    m_head.store(sentinel, std::memory_order_relaxed);
-}
-
+private:
+    mutable std::mutex m_lock;
+    PolymorphicObjectPool<BaseT> m_pool;
+};
 } // namespace aph
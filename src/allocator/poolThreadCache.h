@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace aph::detail
+{
+// Per-thread cache lookup for the thread safe pools.
+//
+// Every registered pool gets a dense index into a thread local table, so a thread finds its cache for a pool
+// with one bounds check and one id compare. Indices are recycled when pools are destroyed, ids never are, so a
+// stale table entry of a dead pool can't be mistaken for a cache of a new pool at the same index. When a thread
+// exits, its caches are handed back to the pools that are still alive.
+class PoolCacheRegistry
+{
+public:
+    using ReleaseFunc = void (*)(void* pPool, void* pCache);
+
+    struct Registration
+    {
+        uint32_t index = 0;
+        uint64_t id    = 0;
+    };
+
+    static auto registerPool(void* pPool, ReleaseFunc release) -> Registration
+    {
+        auto& registry = getRegistry();
+        std::lock_guard<std::mutex> lock{ registry.lock };
+
+        Registration registration{};
+        registration.id = ++registry.nextId;
+        if (!registry.freeIndices.empty())
+        {
+            registration.index = registry.freeIndices.back();
+            registry.freeIndices.pop_back();
+        }
+        else
+        {
+            registration.index = static_cast<uint32_t>(registry.pools.size());
+            registry.pools.emplace_back();
+        }
+        registry.pools[registration.index] = { pPool, release, registration.id };
+        return registration;
+    }
+
+    // Once this returns no thread calls the release function of the pool anymore
+    static void unregisterPool(const Registration& registration)
+    {
+        auto& registry = getRegistry();
+        std::lock_guard<std::mutex> lock{ registry.lock };
+        registry.pools[registration.index] = {};
+        registry.freeIndices.push_back(registration.index);
+    }
+
+    // Cache of the calling thread for the pool, null if it doesn't have one yet
+    static auto find(const Registration& registration) -> void*
+    {
+        const auto& entries = t_caches.entries;
+        if (registration.index < entries.size() && entries[registration.index].id == registration.id)
+        {
+            return entries[registration.index].pCache;
+        }
+        return nullptr;
+    }
+
+    static void bind(const Registration& registration, void* pCache)
+    {
+        auto& entries = t_caches.entries;
+        if (registration.index >= entries.size())
+        {
+            entries.resize(registration.index + 1);
+        }
+        entries[registration.index] = { registration.id, pCache };
+    }
+
+private:
+    struct PoolEntry
+    {
+        void* pPool         = nullptr;
+        ReleaseFunc release = nullptr;
+        uint64_t id         = 0;
+    };
+
+    struct Registry
+    {
+        std::mutex lock;
+        std::vector<PoolEntry> pools;
+        std::vector<uint32_t> freeIndices;
+        uint64_t nextId = 0;
+    };
+
+    struct CacheEntry
+    {
+        uint64_t id  = 0;
+        void* pCache = nullptr;
+    };
+
+    struct ThreadCaches
+    {
+        ~ThreadCaches()
+        {
+            auto& registry = getRegistry();
+            std::lock_guard<std::mutex> lock{ registry.lock };
+            for (std::size_t index = 0; index < entries.size(); ++index)
+            {
+                const CacheEntry& entry = entries[index];
+                if (entry.pCache && index < registry.pools.size() && registry.pools[index].id == entry.id)
+                {
+                    registry.pools[index].release(registry.pools[index].pPool, entry.pCache);
+                }
+            }
+        }
+
+        std::vector<CacheEntry> entries;
+    };
+
+    static auto getRegistry() -> Registry&
+    {
+        static Registry registry;
+        return registry;
+    }
+
+    static inline thread_local ThreadCaches t_caches;
+};
+} // namespace aph::detail
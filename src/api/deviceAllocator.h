@@ -10,6 +10,13 @@ class Image;
 
 namespace aph
 {
+struct MemoryRequirement
+{
+    std::size_t size        = 0;
+    std::size_t alignment   = 1;
+    uint32_t memoryTypeBits = UINT32_MAX;
+};
+
 class DeviceAllocation
 {
 public:
@@ -43,6 +50,11 @@ public:
     virtual auto invalidate(vk::Image* pImage, Range range) -> Result   = 0;
     virtual auto invalidate(vk::Buffer* pBuffer, Range range) -> Result = 0;
     virtual auto clear() -> void                                        = 0;
+
+    // Raw memory blocks that several resources can be bound into (transient aliasing)
+    virtual auto allocateMemory(const MemoryRequirement& requirement) -> DeviceAllocation*              = 0;
+    virtual auto freeMemory(DeviceAllocation* pAllocation) -> void                                      = 0;
+    virtual auto bind(vk::Image* pImage, DeviceAllocation* pAllocation, std::size_t offset) -> Result = 0;
 };
 
 } // namespace aph
@@ -137,7 +137,7 @@ void CommandBuffer::bindIndexBuffers(Buffer* pBuffer, std::size_t offset, IndexT
     setDirty(DirtyFlagBits::indexState);
 }
 
-void CommandBuffer::copy(Buffer* srcBuffer, Buffer* dstBuffer, Range range)
+void CommandBuffer::copy(Buffer* srcBuffer, Buffer* dstBuffer, Range range, std::size_t srcOffset)
 {
     APH_PROFILER_SCOPE();
     APH_ASSERT(m_state == RecordState::Recording, "Command buffer must be in recording state");
@@ -153,7 +153,7 @@ void CommandBuffer::copy(Buffer* srcBuffer, Buffer* dstBuffer, Range range)
     m_breadcrumbs.updateBreadcrumb(copyIndex, BreadcrumbState::InProgress);
 
     ::vk::BufferCopy copyRegion{};
-    copyRegion.setSize(range.size).setSrcOffset(0).setDstOffset(range.offset);
+    copyRegion.setSize(range.size).setSrcOffset(srcOffset).setDstOffset(range.offset);
     getHandle().copyBuffer(srcBuffer->getHandle(), dstBuffer->getHandle(), { copyRegion });
 
     m_breadcrumbs.updateBreadcrumb(copyIndex, BreadcrumbState::Completed);
@@ -774,11 +774,29 @@ void CommandBuffer::insertBarrier(ArrayProxy<BufferBarrier> bufferBarriers, Arra
         APH_ASSERT(barrier.pImage, "Image in barrier cannot be null");
     }
 
-    SmallVector<::vk::ImageMemoryBarrier> vkImageBarriers;
-    SmallVector<::vk::BufferMemoryBarrier> vkBufferBarriers;
+    SmallVector<::vk::ImageMemoryBarrier2> vkImageBarriers;
+    SmallVector<::vk::BufferMemoryBarrier2> vkBufferBarriers;
 
-    ::vk::AccessFlags srcAccessFlags = {};
-    ::vk::AccessFlags dstAccessFlags = {};
+    // Every barrier carries its own stage masks, so one command covers all resources without
+    // widening the synchronization scope of any of them
+    auto getStageFlags = [this](::vk::AccessFlags2 accessFlags) -> ::vk::PipelineStageFlags2
+    {
+        // The legacy access and stage bits share their values with the synchronization2 ones
+        ::vk::AccessFlags legacyAccessFlags{ static_cast<VkAccessFlags>(static_cast<VkAccessFlags2>(accessFlags)) };
+        auto stageFlags = m_pDevice->determinePipelineStageFlags(legacyAccessFlags, m_pQueue->getType());
+        return ::vk::PipelineStageFlags2{ static_cast<VkPipelineStageFlags>(stageFlags) };
+    };
+    auto getAccessFlags = [](ResourceState state) -> ::vk::AccessFlags2
+    {
+        return ::vk::AccessFlags2{ static_cast<VkAccessFlags>(utils::getAccessFlags(state)) };
+    };
+    // Discarded contents have nothing to wait for, unless the memory was in use by an aliased resource
+    auto getSrcAccessFlags = [&getAccessFlags](const auto& barrier) -> ::vk::AccessFlags2
+    {
+        const ResourceState srcState =
+            barrier.currentState == ResourceState::Undefined ? barrier.aliasedState : barrier.currentState;
+        return getAccessFlags(srcState);
+    };
 
     for (const auto& bufferBarrier : bufferBarriers)
     {
@@ -789,19 +807,21 @@ void CommandBuffer::insertBarrier(ArrayProxy<BufferBarrier> bufferBarriers, Arra
             ResourceState::UnorderedAccess == pTrans->newState)
         {
             vkBufferBarriers.emplace_back()
-                .setSrcAccessMask(::vk::AccessFlagBits::eShaderWrite)
-                .setDstAccessMask(::vk::AccessFlagBits::eShaderWrite | ::vk::AccessFlagBits::eShaderRead);
+                .setSrcAccessMask(::vk::AccessFlagBits2::eShaderWrite)
+                .setDstAccessMask(::vk::AccessFlagBits2::eShaderWrite | ::vk::AccessFlagBits2::eShaderRead);
         }
         else
         {
             vkBufferBarriers.emplace_back()
-                .setSrcAccessMask(utils::getAccessFlags(pTrans->currentState))
-                .setDstAccessMask(utils::getAccessFlags(pTrans->newState));
+                .setSrcAccessMask(getSrcAccessFlags(*pTrans))
+                .setDstAccessMask(getAccessFlags(pTrans->newState));
         }
 
         {
             auto& vkBufferBarrier = vkBufferBarriers.back();
             vkBufferBarrier.setBuffer(pBuffer->getHandle()).setSize(::vk::WholeSize).setOffset(0);
+            vkBufferBarrier.setSrcStageMask(getStageFlags(vkBufferBarrier.srcAccessMask))
+                .setDstStageMask(getStageFlags(vkBufferBarrier.dstAccessMask));
 
             if (pTrans->acquire)
             {
@@ -818,9 +838,6 @@ void CommandBuffer::insertBarrier(ArrayProxy<BufferBarrier> bufferBarriers, Arra
                 vkBufferBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
                 vkBufferBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
             }
-
-            srcAccessFlags |= vkBufferBarrier.srcAccessMask;
-            dstAccessFlags |= vkBufferBarrier.dstAccessMask;
         }
     }
 
@@ -833,16 +850,16 @@ void CommandBuffer::insertBarrier(ArrayProxy<BufferBarrier> bufferBarriers, Arra
             ResourceState::UnorderedAccess == pTrans->newState)
         {
             vkImageBarriers.emplace_back()
-                .setSrcAccessMask(::vk::AccessFlagBits::eShaderWrite)
-                .setDstAccessMask(::vk::AccessFlagBits::eShaderWrite | ::vk::AccessFlagBits::eShaderRead)
+                .setSrcAccessMask(::vk::AccessFlagBits2::eShaderWrite)
+                .setDstAccessMask(::vk::AccessFlagBits2::eShaderWrite | ::vk::AccessFlagBits2::eShaderRead)
                 .setOldLayout(::vk::ImageLayout::eGeneral)
                 .setNewLayout(::vk::ImageLayout::eGeneral);
         }
         else
         {
             vkImageBarriers.emplace_back()
-                .setSrcAccessMask(utils::getAccessFlags(pTrans->currentState))
-                .setDstAccessMask(utils::getAccessFlags(pTrans->newState))
+                .setSrcAccessMask(getSrcAccessFlags(*pTrans))
+                .setDstAccessMask(getAccessFlags(pTrans->newState))
                 .setOldLayout(utils::getImageLayout(pTrans->currentState))
                 .setNewLayout(utils::getImageLayout(pTrans->newState));
         }
@@ -855,6 +872,8 @@ void CommandBuffer::insertBarrier(ArrayProxy<BufferBarrier> bufferBarriers, Arra
             vkImageBarrier.subresourceRange.levelCount     = pTrans->subresourceBarrier ? 1 : ::vk::RemainingMipLevels;
             vkImageBarrier.subresourceRange.baseArrayLayer = pTrans->subresourceBarrier ? pTrans->arrayLayer : 0;
             vkImageBarrier.subresourceRange.layerCount     = pTrans->subresourceBarrier ? 1 : ::vk::RemainingMipLevels;
+            vkImageBarrier.setSrcStageMask(getStageFlags(vkImageBarrier.srcAccessMask))
+                .setDstStageMask(getStageFlags(vkImageBarrier.dstAccessMask));
 
             if (pTrans->acquire && pTrans->currentState != ResourceState::Undefined)
             {
@@ -871,18 +890,14 @@ void CommandBuffer::insertBarrier(ArrayProxy<BufferBarrier> bufferBarriers, Arra
                 vkImageBarrier.srcQueueFamilyIndex = ::vk::QueueFamilyIgnored;
                 vkImageBarrier.dstQueueFamilyIndex = ::vk::QueueFamilyIgnored;
             }
-
-            srcAccessFlags |= vkImageBarrier.srcAccessMask;
-            dstAccessFlags |= vkImageBarrier.dstAccessMask;
         }
     }
 
-    ::vk::PipelineStageFlags srcStageMask = m_pDevice->determinePipelineStageFlags(srcAccessFlags, m_pQueue->getType());
-    ::vk::PipelineStageFlags dstStageMask = m_pDevice->determinePipelineStageFlags(dstAccessFlags, m_pQueue->getType());
-
     if (!vkBufferBarriers.empty() || !vkImageBarriers.empty())
     {
-        getHandle().pipelineBarrier(srcStageMask, dstStageMask, {}, {}, vkBufferBarriers, vkImageBarriers);
+        ::vk::DependencyInfo dependencyInfo{};
+        dependencyInfo.setBufferMemoryBarriers(vkBufferBarriers).setImageMemoryBarriers(vkImageBarriers);
+        getHandle().pipelineBarrier2(dependencyInfo);
     }
 
     // Update breadcrumb state
@@ -49,6 +49,8 @@ struct BufferBarrier
     QueueType queueType;
     uint8_t acquire;
     uint8_t release;
+    // Last state of the resource that used the memory before, waited for when currentState is Undefined
+    ResourceState aliasedState;
 };
 
 struct ImageBarrier
@@ -62,6 +64,8 @@ struct ImageBarrier
     uint8_t subresourceBarrier;
     uint8_t mipLevel;
     uint16_t arrayLayer;
+    // Last state of the resource that used the memory before, waited for when currentState is Undefined
+    ResourceState aliasedState;
 };
 
 class CommandBuffer : public ResourceHandle<::vk::CommandBuffer>
@@ -206,7 +210,8 @@ public:
 
     // Memory operations
     void update(Buffer* pBuffer, Range range, const void* data);
-    void copy(Buffer* srcBuffer, Buffer* dstBuffer, Range range);
+    // Copies range.size bytes from srcOffset of srcBuffer to range.offset of dstBuffer
+    void copy(Buffer* srcBuffer, Buffer* dstBuffer, Range range, std::size_t srcOffset = 0);
     void copy(Image* srcImage, Image* dstImage, Extent3D extent = {}, const ImageCopyInfo& srcCopyInfo = {},
               const ImageCopyInfo& dstCopyInfo = {});
     void copy(Buffer* buffer, Image* image, ArrayProxy<BufferImageCopy> regions = {});
@@ -191,6 +191,10 @@ auto CommandBufferAllocator::acquire(QueueType queueType, CommandBufferUsage usa
     CommandBuffer* pCmdBuffer = pThreadPool->acquireCommandBuffer(usage);
     if (pCmdBuffer)
     {
+        {
+            std::lock_guard<std::mutex> guard(m_threadPoolMutex);
+            m_commandBufferOwners[pCmdBuffer] = pThreadPool;
+        }
         m_activeCommandBufferCount++;
     }
 
@@ -206,21 +210,22 @@ auto CommandBufferAllocator::release(CommandBuffer* pCmdBuffer) -> void
         return;
     }
 
-    // Each command buffer knows its queue
-    Queue* pQueue = pCmdBuffer->m_pQueue;
-    if (!pQueue)
+    // The command buffer goes back to the pool of the thread that acquired it
+    ThreadCommandPool* pThreadPool = {};
     {
-        CM_LOG_ERR("Command buffer has no associated queue");
-        return;
+        std::lock_guard<std::mutex> guard(m_threadPoolMutex);
+        auto it = m_commandBufferOwners.find(pCmdBuffer);
+        if (it == m_commandBufferOwners.end())
+        {
+            CM_LOG_ERR("Attempted to release a command buffer that is not active");
+            return;
+        }
+        pThreadPool = it->second;
+        m_commandBufferOwners.erase(it);
     }
 
-    // Get the thread pool matching this queue type
-    ThreadCommandPool* pThreadPool = getThreadCommandPool(pQueue->getType());
-    if (pThreadPool)
-    {
-        pThreadPool->release(pCmdBuffer);
-        m_activeCommandBufferCount--;
-    }
+    pThreadPool->release(pCmdBuffer);
+    m_activeCommandBufferCount--;
 }
 
 auto CommandBufferAllocator::reset() -> void
@@ -91,7 +91,7 @@ public:
     // Acquire a command buffer for the current thread from the appropriate queue
     auto acquire(QueueType queueType, CommandBufferUsage usage = CommandBufferUsage::OneTime) -> CommandBuffer*;
 
-    // Release a command buffer back to the allocator
+    // Release a command buffer back to the pool it was acquired from, from any thread
     void release(CommandBuffer* pCmdBuffer);
 
     // Reset all command pools
@@ -111,10 +111,13 @@ private:
     using ThreadPoolMap = HashMap<ThreadId, HashMap<QueueType, std::unique_ptr<ThreadCommandPool>>, ThreadId::Hash>;
     ThreadPoolMap m_threadPools;
 
+    // Pool each active command buffer came from, so any thread can release it
+    HashMap<CommandBuffer*, ThreadCommandPool*> m_commandBufferOwners;
+
     // Track total active command buffers across all threads
     std::atomic<size_t> m_activeCommandBufferCount = 0;
 
-    // Guards thread pool creation
+    // Guards thread pool creation and command buffer ownership
     mutable std::mutex m_threadPoolMutex;
 };
 
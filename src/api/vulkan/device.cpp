@@ -9,6 +9,30 @@ const VkAllocationCallbacks* gVkAllocator = aph::vk::vkAllocator();
 
 namespace aph::vk
 {
+namespace
+{
+auto getVkImageCreateInfo(const ImageCreateInfo& createInfo) -> ::vk::ImageCreateInfo
+{
+    ::vk::ImageCreateInfo imageCreateInfo{};
+    auto [usage, flags] = utils::VkCast(createInfo.usage);
+    imageCreateInfo.setFlags(flags)
+        .setImageType(utils::VkCast(createInfo.imageType))
+        .setFormat(utils::VkCast(createInfo.format))
+        .setMipLevels(createInfo.mipLevels)
+        .setArrayLayers(createInfo.arraySize)
+        .setSamples(utils::getSampleCountFlags(createInfo.sampleCount))
+        .setTiling(::vk::ImageTiling::eOptimal)
+        .setUsage(usage)
+        .setSharingMode(::vk::SharingMode::eExclusive)
+        .setInitialLayout(::vk::ImageLayout::eUndefined);
+
+    imageCreateInfo.extent.width  = createInfo.extent.width;
+    imageCreateInfo.extent.height = createInfo.extent.height;
+    imageCreateInfo.extent.depth  = createInfo.extent.depth;
+    return imageCreateInfo;
+}
+} // namespace
+
 Device::Device(const CreateInfoType& createInfo, HandleType handle)
     : ResourceHandle(handle, createInfo)
     , m_resourcePool(this)
@@ -503,22 +527,7 @@ auto Device::createImpl(const ImageCreateInfo& createInfo) -> Expected<Image*>
     APH_ASSERT(createInfo.format != Format::Undefined, "Image format cannot be undefined");
     APH_ASSERT(createInfo.usage != ImageUsage::None, "Image must have at least one usage flag");
 
-    ::vk::ImageCreateInfo imageCreateInfo{};
-    auto [usage, flags] = utils::VkCast(createInfo.usage);
-    imageCreateInfo.setFlags(flags)
-        .setImageType(utils::VkCast(createInfo.imageType))
-        .setFormat(utils::VkCast(createInfo.format))
-        .setMipLevels(createInfo.mipLevels)
-        .setArrayLayers(createInfo.arraySize)
-        .setSamples(utils::getSampleCountFlags(createInfo.sampleCount))
-        .setTiling(::vk::ImageTiling::eOptimal)
-        .setUsage(usage)
-        .setSharingMode(::vk::SharingMode::eExclusive)
-        .setInitialLayout(::vk::ImageLayout::eUndefined);
-
-    imageCreateInfo.extent.width  = createInfo.extent.width;
-    imageCreateInfo.extent.height = createInfo.extent.height;
-    imageCreateInfo.extent.depth  = createInfo.extent.depth;
+    ::vk::ImageCreateInfo imageCreateInfo = getVkImageCreateInfo(createInfo);
 
     auto [result, image] = getHandle().createImage(imageCreateInfo, vk_allocator());
     if (result != ::vk::Result::eSuccess)
@@ -529,12 +538,45 @@ auto Device::createImpl(const ImageCreateInfo& createInfo) -> Expected<Image*>
     Image* pImage = m_resourcePool.image.allocate(this, createInfo, image);
     APH_ASSERT(pImage, "Failed to allocate image from resource pool");
 
-    auto* allocResult = m_resourcePool.deviceMemory->allocate(pImage);
-    APH_ASSERT(allocResult, "Failed to allocate memory for image");
+    if (createInfo.pAliasMemory)
+    {
+        APH_VERIFY_RESULT(m_resourcePool.deviceMemory->bind(pImage, createInfo.pAliasMemory, createInfo.aliasOffset));
+    }
+    else
+    {
+        auto* allocResult = m_resourcePool.deviceMemory->allocate(pImage);
+        APH_ASSERT(allocResult, "Failed to allocate memory for image");
+    }
 
     return Expected<Image*>{ pImage };
 }
 
+auto Device::getMemoryRequirement(const ImageCreateInfo& createInfo) const -> MemoryRequirement
+{
+    APH_PROFILER_SCOPE();
+    ::vk::ImageCreateInfo imageCreateInfo = getVkImageCreateInfo(createInfo);
+    ::vk::DeviceImageMemoryRequirements requirementInfo{};
+    requirementInfo.setPCreateInfo(&imageCreateInfo);
+    auto requirements = getHandle().getImageMemoryRequirements(requirementInfo).memoryRequirements;
+    return {
+        .size           = requirements.size,
+        .alignment      = requirements.alignment,
+        .memoryTypeBits = requirements.memoryTypeBits,
+    };
+}
+
+auto Device::allocateMemory(const MemoryRequirement& requirement) -> DeviceAllocation*
+{
+    APH_PROFILER_SCOPE();
+    return m_resourcePool.deviceMemory->allocateMemory(requirement);
+}
+
+auto Device::freeMemory(DeviceAllocation* pAllocation) -> void
+{
+    APH_PROFILER_SCOPE();
+    m_resourcePool.deviceMemory->freeMemory(pAllocation);
+}
+
 auto Device::destroyImpl(DescriptorSetLayout* pSetLayout) -> void
 {
     APH_PROFILER_SCOPE();
@@ -621,11 +663,11 @@ auto Device::getQueue(QueueType type, uint32_t queueIndex) -> Queue*
 
     if (type != QueueType::Graphics && type != QueueType::Compute && type != QueueType::Transfer)
     {
-        CM_LOG_WARN("Unsupported queue type %d requested for index %u.", aph::vk::utils::toString(type), queueIndex);
+        CM_LOG_WARN("Unsupported queue type %s requested for index %u.", aph::vk::utils::toString(type), queueIndex);
     }
     else
     {
-        CM_LOG_WARN("No available queue for requested type %d (index %u) nor in fallbacks.",
+        CM_LOG_WARN("No available queue for requested type %s (index %u) nor in fallbacks.",
                     aph::vk::utils::toString(type), queueIndex);
     }
 
@@ -759,6 +801,14 @@ auto Device::acquireSemaphore() -> Semaphore*
     return semaphore;
 }
 
+auto Device::acquireTimelineSemaphore(uint64_t initialValue) -> Semaphore*
+{
+    APH_PROFILER_SCOPE();
+    Semaphore* semaphore = nullptr;
+    APH_VERIFY_RESULT(m_resourcePool.syncPrimitive.acquireTimelineSemaphore(&semaphore, initialValue));
+    return semaphore;
+}
+
 auto Device::releaseSemaphore(Semaphore* semaphore) -> Result
 {
     APH_PROFILER_SCOPE();
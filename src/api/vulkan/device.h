@@ -84,11 +84,15 @@ public:
     auto invalidateMemory(Buffer* pBuffer, Range range = {}) const -> Result;
     auto mapMemory(Buffer* pBuffer) const -> void*;
     auto unMapMemory(Buffer* pBuffer) const -> void;
+    auto getMemoryRequirement(const ImageCreateInfo& createInfo) const -> MemoryRequirement;
+    auto allocateMemory(const MemoryRequirement& requirement) -> DeviceAllocation*;
+    auto freeMemory(DeviceAllocation* pAllocation) -> void;
 
     // Synchronization
     auto waitIdle() -> Result;
     auto waitForFence(ArrayProxy<Fence*> fences, bool waitAll = true, uint64_t timeout = UINT64_MAX) -> Result;
     auto acquireSemaphore() -> Semaphore*;
+    auto acquireTimelineSemaphore(uint64_t initialValue = 0) -> Semaphore*;
     auto acquireFence(bool isSignaled) -> Fence*;
     auto releaseSemaphore(Semaphore* semaphore) -> Result;
     auto releaseFence(Fence* pFence) -> Result;
@@ -6,6 +6,11 @@
 #include "forward.h"
 #include "vkUtils.h"
 
+namespace aph
+{
+class DeviceAllocation;
+} // namespace aph
+
 namespace aph::vk
 {
 struct ImageCreateInfo
@@ -21,6 +26,10 @@ struct ImageCreateInfo
     MemoryDomain domain = { MemoryDomain::Auto };
     ImageType imageType = { ImageType::e2D };
     Format format       = { Format::Undefined };
+
+    // Optional placement inside a shared memory block, the image doesn't own that memory
+    DeviceAllocation* pAliasMemory = {};
+    std::size_t aliasOffset        = 0;
 };
 
 class Image : public ResourceHandle<::vk::Image, ImageCreateInfo>
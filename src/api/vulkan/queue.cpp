@@ -24,8 +24,10 @@ auto Queue::submit(ArrayProxy<QueueSubmitInfo> submitInfos, Fence* pFence) -> Re
     SmallVector<SmallVector<::vk::Semaphore>> vkWaitSemaphores;
     SmallVector<SmallVector<::vk::Semaphore>> vkSignalSemaphores;
     SmallVector<SmallVector<::vk::PipelineStageFlags>> vkWaitStages;
+    SmallVector<::vk::TimelineSemaphoreSubmitInfo> vkTimelineInfos;
 
     vkCmds.reserve(submitInfos.size());
+    vkTimelineInfos.reserve(submitInfos.size());
     vkWaitSemaphores.reserve(submitInfos.size());
     vkSignalSemaphores.reserve(submitInfos.size());
     vkWaitStages.reserve(submitInfos.size());
@@ -80,6 +82,16 @@ auto Queue::submit(ArrayProxy<QueueSubmitInfo> submitInfos, Fence* pFence) -> Re
             info.setWaitDstStageMask(waitStages);
         }
 
+        if (!submitInfo.waitValues.empty() || !submitInfo.signalValues.empty())
+        {
+            APH_ASSERT(submitInfo.waitValues.empty() || submitInfo.waitValues.size() == waitSemaphores.size());
+            APH_ASSERT(submitInfo.signalValues.empty() || submitInfo.signalValues.size() == signalSemaphores.size());
+            auto& timelineInfo = vkTimelineInfos.emplace_back();
+            timelineInfo.setWaitSemaphoreValues(submitInfo.waitValues);
+            timelineInfo.setSignalSemaphoreValues(submitInfo.signalValues);
+            info.setPNext(&timelineInfo);
+        }
+
         vkSubmits.push_back(std::move(info));
     }
 
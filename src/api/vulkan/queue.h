@@ -12,6 +12,10 @@ struct QueueSubmitInfo
     SmallVector<VkPipelineStageFlags> waitStages;
     SmallVector<Semaphore*> waitSemaphores;
     SmallVector<Semaphore*> signalSemaphores;
+
+    // Timeline semaphore values, one per wait/signal semaphore (ignored for binary semaphores)
+    SmallVector<uint64_t> waitValues;
+    SmallVector<uint64_t> signalValues;
 };
 
 class Queue : public ResourceHandle<::vk::Queue>
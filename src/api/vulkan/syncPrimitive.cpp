@@ -136,11 +136,45 @@ auto SyncPrimitiveAllocator::ReleaseSemaphores(uint32_t semaphoreCount, Semaphor
     std::lock_guard<std::mutex> lock{ m_semaphoreLock };
     for (auto i = 0U; i < semaphoreCount; ++i)
     {
-        if (m_allSemaphores.contains(ppSemaphores[i]))
+        auto* pSemaphore = ppSemaphores[i];
+        if (!m_allSemaphores.contains(pSemaphore))
         {
-            m_availableSemaphores.push(ppSemaphores[i]);
+            continue;
         }
+
+        // The payload of a timeline semaphore can't be reset, so it is never recycled
+        if (pSemaphore->isTimeline())
+        {
+            m_pDevice->getHandle().destroySemaphore(pSemaphore->getHandle(), vk_allocator());
+            m_allSemaphores.erase(pSemaphore);
+            m_semaphorePool.free(pSemaphore);
+        }
+        else
+        {
+            m_availableSemaphores.push(pSemaphore);
+        }
+    }
+    return Result::Success;
+}
+
+auto SyncPrimitiveAllocator::acquireTimelineSemaphore(Semaphore** ppSemaphore, uint64_t initialValue) -> Result
+{
+    APH_PROFILER_SCOPE();
+    std::lock_guard<std::mutex> lock{ m_semaphoreLock };
+
+    ::vk::SemaphoreTypeCreateInfo typeCreateInfo{ ::vk::SemaphoreType::eTimeline, initialValue };
+    ::vk::SemaphoreCreateInfo createInfo{};
+    createInfo.setPNext(&typeCreateInfo);
+
+    auto [result, vkSemaphore] = m_pDevice->getHandle().createSemaphore(createInfo, vk_allocator());
+    if (result != ::vk::Result::eSuccess)
+    {
+        return { Result::RuntimeError, "Failed to acquire timeline semaphore." };
     }
+
+    *ppSemaphore = m_semaphorePool.allocate(m_pDevice, vkSemaphore, true);
+    m_allSemaphores.emplace(*ppSemaphore);
+
     return Result::Success;
 }
 
@@ -37,15 +37,22 @@ public:
         return m_signaled;
     }
 
+    auto isTimeline() const -> bool
+    {
+        return m_timeline;
+    }
+
 private:
-    Semaphore(Device* pDevice, HandleType handle)
+    Semaphore(Device* pDevice, HandleType handle, bool timeline = false)
         : ResourceHandle(handle)
         , m_pDevice(pDevice)
+        , m_timeline(timeline)
     {
     }
 
     bool m_signaled   = { false };
     Device* m_pDevice = {};
+    bool m_timeline   = { false };
 };
 
 class SyncPrimitiveAllocator
@@ -62,6 +69,7 @@ public:
 
     auto acquireSemaphore(uint32_t semaphoreCount, Semaphore** ppSemaphores) -> Result;
     auto ReleaseSemaphores(uint32_t semaphoreCount, Semaphore** ppSemaphores) -> Result;
+    auto acquireTimelineSemaphore(Semaphore** ppSemaphore, uint64_t initialValue) -> Result;
 
     auto Exists(Fence* fence) -> bool;
     auto Exists(Semaphore* semaphore) -> bool;
@@ -8,6 +8,7 @@
 namespace aph::vk
 {
 VMADeviceAllocator::VMADeviceAllocator(Instance* pInstance, Device* pDevice)
+    : m_pDevice(pDevice)
 {
     auto& table = VULKAN_HPP_DEFAULT_DISPATCHER;
 
@@ -59,6 +60,14 @@ VMADeviceAllocator::~VMADeviceAllocator()
 
 auto VMADeviceAllocator::allocate(Buffer* pBuffer) -> DeviceAllocation*
 {
+    if (pBuffer->getSize() <= MaxSubAllocationSize)
+    {
+        if (DeviceAllocation* pAllocation = subAllocate(pBuffer))
+        {
+            return pAllocation;
+        }
+    }
+
     std::lock_guard<std::mutex> lock{ m_allocationLock };
     APH_ASSERT(!m_bufferMemoryMap.contains(pBuffer));
 
@@ -96,6 +105,11 @@ auto VMADeviceAllocator::allocate(Image* pImage) -> DeviceAllocation*
 auto VMADeviceAllocator::free(Image* pImage) -> void
 {
     std::lock_guard<std::mutex> lock{ m_allocationLock };
+    // Aliased images don't own their memory, the block is released by freeMemory()
+    if (m_aliasedImageMap.erase(pImage) > 0)
+    {
+        return;
+    }
     APH_ASSERT(m_imageMemoryMap.contains(pImage));
     vmaFreeMemory(m_allocator, m_imageMemoryMap.find(pImage)->second.getHandle());
     m_imageMemoryMap.erase(pImage);
@@ -103,6 +117,11 @@ auto VMADeviceAllocator::free(Image* pImage) -> void
 
 auto VMADeviceAllocator::free(Buffer* pBuffer) -> void
 {
+    if (freeSubAllocation(pBuffer))
+    {
+        return;
+    }
+
     std::lock_guard<std::mutex> lock{ m_allocationLock };
     APH_ASSERT(m_bufferMemoryMap.contains(pBuffer));
     vmaFreeMemory(m_allocator, m_bufferMemoryMap.find(pBuffer)->second.getHandle());
@@ -111,6 +130,20 @@ auto VMADeviceAllocator::free(Buffer* pBuffer) -> void
 
 auto VMADeviceAllocator::map(Buffer* pBuffer, void** ppData) -> Result
 {
+    Result result = Result::Success;
+    if (withSubAllocation(pBuffer,
+                          [&](VMASubAllocation* pAllocation)
+                          {
+                              // Mapping is reference counted per block, every buffer in it can be mapped at once
+                              void* pBlockData    = {};
+                              VmaAllocation block = pAllocation->getBlock();
+                              result              = utils::getResult(vmaMapMemory(m_allocator, block, &pBlockData));
+                              *ppData             = static_cast<std::byte*>(pBlockData) + pAllocation->getBlockOffset();
+                          }))
+    {
+        return result;
+    }
+
     std::lock_guard<std::mutex> lock{ m_allocationLock };
     APH_ASSERT(m_bufferMemoryMap.contains(pBuffer));
     return utils::getResult(vmaMapMemory(m_allocator, m_bufferMemoryMap.find(pBuffer)->second.getHandle(), ppData));
@@ -125,6 +158,15 @@ auto VMADeviceAllocator::map(Image* pImage, void** ppData) -> Result
 
 auto VMADeviceAllocator::unMap(Buffer* pBuffer) -> void
 {
+    if (withSubAllocation(pBuffer,
+                          [&](VMASubAllocation* pAllocation)
+                          {
+                              vmaUnmapMemory(m_allocator, pAllocation->getBlock());
+                          }))
+    {
+        return;
+    }
+
     std::lock_guard<std::mutex> lock{ m_allocationLock };
     APH_ASSERT(m_bufferMemoryMap.contains(pBuffer));
     vmaUnmapMemory(m_allocator, m_bufferMemoryMap.find(pBuffer)->second.getHandle());
@@ -139,6 +181,7 @@ auto VMADeviceAllocator::unMap(Image* pImage) -> void
 
 auto VMADeviceAllocator::clear() -> void
 {
+    clearSubAllocations();
     for (auto& [image, allocation] : m_imageMemoryMap)
     {
         free(image);
@@ -147,6 +190,60 @@ auto VMADeviceAllocator::clear() -> void
     {
         free(buffer);
     }
+    m_aliasedImageMap.clear();
+    for (auto& [pAllocation, pBlock] : m_memoryBlockMap)
+    {
+        vmaFreeMemory(m_allocator, pBlock->getHandle());
+    }
+    m_memoryBlockMap.clear();
+}
+
+auto VMADeviceAllocator::allocateMemory(const MemoryRequirement& requirement) -> DeviceAllocation*
+{
+    std::lock_guard<std::mutex> lock{ m_allocationLock };
+
+    VkMemoryRequirements memoryRequirements{
+        .size           = requirement.size,
+        .alignment      = requirement.alignment,
+        .memoryTypeBits = requirement.memoryTypeBits,
+    };
+    VmaAllocationCreateInfo allocCreateInfo = getAllocationCreateInfo(MemoryDomain::Device, true);
+    VmaAllocationInfo allocInfo;
+    VmaAllocation allocation;
+    if (vmaAllocateMemory(m_allocator, &memoryRequirements, &allocCreateInfo, &allocation, &allocInfo) != VK_SUCCESS)
+    {
+        return nullptr;
+    }
+
+    auto pBlock                   = std::make_unique<VMADeviceAllocation>(allocation, allocInfo);
+    DeviceAllocation* pAllocation = pBlock.get();
+    m_memoryBlockMap[pAllocation] = std::move(pBlock);
+    return pAllocation;
+}
+
+auto VMADeviceAllocator::freeMemory(DeviceAllocation* pAllocation) -> void
+{
+    std::lock_guard<std::mutex> lock{ m_allocationLock };
+    auto it = m_memoryBlockMap.find(pAllocation);
+    APH_ASSERT(it != m_memoryBlockMap.end());
+    vmaFreeMemory(m_allocator, it->second->getHandle());
+    m_memoryBlockMap.erase(it);
+}
+
+auto VMADeviceAllocator::bind(Image* pImage, DeviceAllocation* pAllocation, std::size_t offset) -> Result
+{
+    std::lock_guard<std::mutex> lock{ m_allocationLock };
+    APH_ASSERT(!m_imageMemoryMap.contains(pImage) && !m_aliasedImageMap.contains(pImage));
+    auto it = m_memoryBlockMap.find(pAllocation);
+    APH_ASSERT(it != m_memoryBlockMap.end());
+
+    auto result = vmaBindImageMemory2(m_allocator, it->second->getHandle(), offset, pImage->getHandle(), nullptr);
+    if (result != VK_SUCCESS)
+    {
+        return utils::getResult(result);
+    }
+    m_aliasedImageMap[pImage] = pAllocation;
+    return Result::Success;
 }
 
 auto VMADeviceAllocator::flush(Image* pImage, Range range) -> Result
@@ -163,6 +260,22 @@ auto VMADeviceAllocator::flush(Image* pImage, Range range) -> Result
 
 auto VMADeviceAllocator::flush(Buffer* pBuffer, Range range) -> Result
 {
+    Result result = Result::Success;
+    if (withSubAllocation(pBuffer,
+                          [&](VMASubAllocation* pAllocation)
+                          {
+                              if (range.size == 0 || range.size == ::vk::WholeSize)
+                              {
+                                  range.size = pAllocation->getSize() - range.offset;
+                              }
+                              result = utils::getResult(vmaFlushAllocation(m_allocator, pAllocation->getBlock(),
+                                                                          pAllocation->getBlockOffset() + range.offset,
+                                                                          range.size));
+                          }))
+    {
+        return result;
+    }
+
     std::lock_guard<std::mutex> lock{ m_allocationLock };
     APH_ASSERT(m_bufferMemoryMap.contains(pBuffer));
     if (range.size == 0)
@@ -187,6 +300,22 @@ auto VMADeviceAllocator::invalidate(Image* pImage, Range range) -> Result
 
 auto VMADeviceAllocator::invalidate(Buffer* pBuffer, Range range) -> Result
 {
+    Result result = Result::Success;
+    if (withSubAllocation(pBuffer,
+                          [&](VMASubAllocation* pAllocation)
+                          {
+                              if (range.size == 0 || range.size == ::vk::WholeSize)
+                              {
+                                  range.size = pAllocation->getSize() - range.offset;
+                              }
+                              result = utils::getResult(vmaInvalidateAllocation(m_allocator, pAllocation->getBlock(),
+                                                                          pAllocation->getBlockOffset() + range.offset,
+                                                                          range.size));
+                          }))
+    {
+        return result;
+    }
+
     std::lock_guard<std::mutex> lock{ m_allocationLock };
     APH_ASSERT(m_bufferMemoryMap.contains(pBuffer));
     if (range.size == 0)
@@ -260,4 +389,135 @@ auto VMADeviceAllocator::getAllocationCreateInfo(Buffer* pBuffer) -> VmaAllocati
     return allocCreateInfo;
 }
 
+auto VMADeviceAllocator::getShard(Buffer* pBuffer) -> SubAllocationShard&
+{
+    // Buffers come out of a slab pool, drop the low bits that are the same for neighbouring objects
+    const auto address = reinterpret_cast<std::uintptr_t>(pBuffer);
+    return m_shards[(address / alignof(std::max_align_t)) % SubAllocationShardCount];
+}
+
+auto VMADeviceAllocator::subAllocate(Buffer* pBuffer) -> DeviceAllocation*
+{
+    APH_PROFILER_SCOPE();
+
+    const ::vk::MemoryRequirements requirements =
+        m_pDevice->getHandle().getBufferMemoryRequirements(pBuffer->getHandle());
+    if (requirements.size > MaxSubAllocationSize || requirements.alignment > SubAllocationBlockAlignment)
+    {
+        return nullptr;
+    }
+
+    const MemoryDomain domain = pBuffer->getCreateInfo().domain;
+    SubAllocationShard& shard = getShard(pBuffer);
+    std::lock_guard<std::mutex> lock{ shard.lock };
+    APH_ASSERT(!shard.buffers.contains(pBuffer));
+
+    SubAllocationBlock* pBlock = {};
+    std::optional<std::size_t> offset;
+    for (const auto& block : shard.blocks)
+    {
+        if (block->domain != domain || ((1u << block->info.memoryType) & requirements.memoryTypeBits) == 0)
+        {
+            continue;
+        }
+        offset = block->offsets.allocate(requirements.size, requirements.alignment);
+        if (offset)
+        {
+            pBlock = block.get();
+            break;
+        }
+    }
+
+    if (!pBlock)
+    {
+        VmaAllocationCreateInfo allocCreateInfo = getAllocationCreateInfo(pBuffer);
+        allocCreateInfo.flags &= ~VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT;
+
+        VkMemoryRequirements blockRequirements{
+            .size           = SubAllocationBlockSize,
+            .alignment      = SubAllocationBlockAlignment,
+            .memoryTypeBits = requirements.memoryTypeBits,
+        };
+        auto block = std::make_unique<SubAllocationBlock>();
+        if (vmaAllocateMemory(m_allocator, &blockRequirements, &allocCreateInfo, &block->allocation, &block->info) !=
+            VK_SUCCESS)
+        {
+            return nullptr;
+        }
+        vmaSetAllocationName(m_allocator, block->allocation, "small buffer block");
+        block->domain = domain;
+        offset        = block->offsets.allocate(requirements.size, requirements.alignment);
+        pBlock        = block.get();
+        shard.blocks.push_back(std::move(block));
+    }
+
+    if (vmaBindBufferMemory2(m_allocator, pBlock->allocation, *offset, pBuffer->getHandle(), nullptr) != VK_SUCCESS)
+    {
+        pBlock->offsets.free(*offset);
+        return nullptr;
+    }
+
+    VMASubAllocation* pAllocation =
+        shard.allocationPool.allocate(pBlock->allocation, *offset, pBlock->info.offset + *offset, requirements.size);
+    shard.buffers[pBuffer] = { pAllocation, pBlock };
+    return pAllocation;
+}
+
+auto VMADeviceAllocator::freeSubAllocation(Buffer* pBuffer) -> bool
+{
+    SubAllocationShard& shard = getShard(pBuffer);
+    std::lock_guard<std::mutex> lock{ shard.lock };
+    auto it = shard.buffers.find(pBuffer);
+    if (it == shard.buffers.end())
+    {
+        return false;
+    }
+
+    auto [pAllocation, pBlock] = it->second;
+    pBlock->offsets.free(pAllocation->getBlockOffset());
+    shard.allocationPool.free(pAllocation);
+    shard.buffers.erase(it);
+
+    // Hand empty blocks back to VMA so a burst of small buffers doesn't pin memory forever
+    if (pBlock->offsets.isEmpty())
+    {
+        vmaFreeMemory(m_allocator, pBlock->allocation);
+        aph::erase_if(shard.blocks,
+                      [pBlock](const auto& block)
+                      {
+                          return block.get() == pBlock;
+                      });
+    }
+    return true;
+}
+
+void VMADeviceAllocator::clearSubAllocations()
+{
+    for (SubAllocationShard& shard : m_shards)
+    {
+        std::lock_guard<std::mutex> lock{ shard.lock };
+        for (const auto& block : shard.blocks)
+        {
+            vmaFreeMemory(m_allocator, block->allocation);
+        }
+        shard.blocks.clear();
+        shard.buffers.clear();
+        shard.allocationPool.clear();
+    }
+}
+
+template <typename Func>
+auto VMADeviceAllocator::withSubAllocation(Buffer* pBuffer, Func&& func) -> bool
+{
+    SubAllocationShard& shard = getShard(pBuffer);
+    std::lock_guard<std::mutex> lock{ shard.lock };
+    auto it = shard.buffers.find(pBuffer);
+    if (it == shard.buffers.end())
+    {
+        return false;
+    }
+    func(it->second.pAllocation);
+    return true;
+}
+
 } // namespace aph::vk
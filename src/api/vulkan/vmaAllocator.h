@@ -1,5 +1,7 @@
 #pragma once
 
+#include "allocator/buddyAllocator.h"
+#include "allocator/objectPool.h"
 #include "api/deviceAllocator.h"
 
 #ifndef VMA_ASSERT_LEAK
@@ -67,6 +69,49 @@ private:
     VmaAllocationInfo m_allocationInfo;
 };
 
+// Small buffer placed inside a memory block shared with other small buffers
+class VMASubAllocation final : public DeviceAllocation
+{
+public:
+    VMASubAllocation(VmaAllocation block, std::size_t blockOffset, std::size_t memoryOffset, std::size_t size)
+        : m_block(block)
+        , m_blockOffset(blockOffset)
+        , m_memoryOffset(memoryOffset)
+        , m_size(size)
+    {
+    }
+
+    ~VMASubAllocation() override = default;
+
+    auto getOffset() -> std::size_t override
+    {
+        return m_memoryOffset;
+    }
+
+    auto getSize() -> std::size_t override
+    {
+        return m_size;
+    }
+
+public:
+    auto getBlock() const -> VmaAllocation
+    {
+        return m_block;
+    }
+
+    // Offset into the block allocation, getOffset() is the offset into the device memory
+    auto getBlockOffset() const -> std::size_t
+    {
+        return m_blockOffset;
+    }
+
+private:
+    VmaAllocation m_block;
+    std::size_t m_blockOffset;
+    std::size_t m_memoryOffset;
+    std::size_t m_size;
+};
+
 class VMADeviceAllocator final : public DeviceAllocator
 {
 public:
@@ -93,17 +138,68 @@ public:
     auto invalidate(Buffer* pBuffer, Range range = {}) -> Result override;
     auto invalidate(Image* pImage, Range range = {}) -> Result override;
 
+    // Memory Aliasing
+    auto allocateMemory(const MemoryRequirement& requirement) -> DeviceAllocation* override;
+    auto freeMemory(DeviceAllocation* pAllocation) -> void override;
+    auto bind(Image* pImage, DeviceAllocation* pAllocation, std::size_t offset) -> Result override;
+
 private:
+    // Buffers up to MaxSubAllocationSize are packed into shared blocks with a buddy allocator instead of
+    // getting a VMA allocation each. Buffers are spread over the shards by address and every shard has a lock
+    // of its own, so creating and destroying small buffers doesn't take m_allocationLock, and only reaches VMA
+    // when a shard needs another block.
+    static constexpr std::size_t SubAllocationBlockSize      = 4 * memory::MB;
+    static constexpr std::size_t SubAllocationBlockAlignment = 64 * memory::KB;
+    static constexpr std::size_t MinSubAllocationSize        = 256;
+    static constexpr std::size_t MaxSubAllocationSize        = 256 * memory::KB;
+    static constexpr uint32_t SubAllocationShardCount        = 8;
+
+    struct SubAllocationBlock
+    {
+        VmaAllocation allocation;
+        VmaAllocationInfo info;
+        MemoryDomain domain;
+        BuddyAllocator offsets{ SubAllocationBlockSize, MinSubAllocationSize };
+    };
+
+    struct SubAllocatedBuffer
+    {
+        VMASubAllocation* pAllocation;
+        SubAllocationBlock* pBlock;
+    };
+
+    struct SubAllocationShard
+    {
+        std::mutex lock;
+        SmallVector<std::unique_ptr<SubAllocationBlock>> blocks;
+        HashMap<Buffer*, SubAllocatedBuffer> buffers;
+        ObjectPool<VMASubAllocation> allocationPool;
+    };
+
     // Allocation Helpers
     auto getAllocationCreateInfo(Buffer* pBuffer) -> VmaAllocationCreateInfo;
     auto getAllocationCreateInfo(Image* pImage) -> VmaAllocationCreateInfo;
     auto getAllocationCreateInfo(MemoryDomain memoryDomain, bool deviceAccess) -> VmaAllocationCreateInfo;
 
+    // Small Buffer Sub-Allocation
+    auto getShard(Buffer* pBuffer) -> SubAllocationShard&;
+    auto subAllocate(Buffer* pBuffer) -> DeviceAllocation*;
+    auto freeSubAllocation(Buffer* pBuffer) -> bool;
+    void clearSubAllocations();
+
+    // Runs func on the sub-allocation of the buffer under its shard lock, false if it has none
+    template <typename Func>
+    auto withSubAllocation(Buffer* pBuffer, Func&& func) -> bool;
+
     // Member Variables
     VmaAllocator m_allocator;
+    Device* m_pDevice = {};
     HashMap<Buffer*, VMADeviceAllocation> m_bufferMemoryMap;
     HashMap<Image*, VMADeviceAllocation> m_imageMemoryMap;
+    HashMap<DeviceAllocation*, std::unique_ptr<VMADeviceAllocation>> m_memoryBlockMap;
+    HashMap<Image*, DeviceAllocation*> m_aliasedImageMap;
     std::mutex m_allocationLock;
+    std::array<SubAllocationShard, SubAllocationShardCount> m_shards;
 };
 
 } // namespace aph::vk
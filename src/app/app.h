@@ -2,7 +2,10 @@
 
 #include "appOptions.h"
 
-GENERATE_LOG_FUNCS(APP)
+#define APP_LOG_DEBUG(...) APH_LOG_TAGGED(APP, Debug, __VA_ARGS__)
+#define APP_LOG_INFO(...)  APH_LOG_TAGGED(APP, Info, __VA_ARGS__)
+#define APP_LOG_WARN(...)  APH_LOG_TAGGED(APP, Warn, __VA_ARGS__)
+#define APP_LOG_ERR(...)   APH_LOG_TAGGED(APP, Error, __VA_ARGS__)
 
 namespace aph
 {
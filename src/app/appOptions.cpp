@@ -4,6 +4,7 @@
 #include "common/hash.h"
 #include "common/logger.h"
 
+#include "allocator/allocator.h"
 #include "app/app.h"
 #include "filesystem/filesystem.h"
 #include "global/globalManager.h"
@@ -37,6 +38,12 @@ auto AppOptions::addProtocol(const std::string& protocol, const std::string& pat
     return *this;
 }
 
+auto AppOptions::setResidencyBudget(ResidencyClass residencyClass, ResidencyBudget budget) -> AppOptions&
+{
+    residencyBudgets[static_cast<std::size_t>(residencyClass)] = budget;
+    return *this;
+}
+
 auto AppOptions::setNumThreads(uint32_t threads) -> AppOptions&
 {
     numThreads = threads;
@@ -79,6 +86,24 @@ auto AppOptions::setLogLineInfo(bool enabled) -> AppOptions&
     return *this;
 }
 
+auto AppOptions::setLogAsync(bool enabled) -> AppOptions&
+{
+    logAsync = enabled;
+    return *this;
+}
+
+auto AppOptions::setLogBinaryFile(std::string path) -> AppOptions&
+{
+    logBinaryFile = std::move(path);
+    return *this;
+}
+
+auto AppOptions::setLogText(bool enabled) -> AppOptions&
+{
+    logText = enabled;
+    return *this;
+}
+
 auto AppOptions::processCLI(int argc, char** argv) -> Result
 {
     callbacks.setErrorHandler(
@@ -105,6 +130,13 @@ auto AppOptions::processCLI(int argc, char** argv) -> Result
     registerCLIValue("--log-time", logTime);
     registerCLIValue("--log-color", logColor);
     registerCLIValue("--log-line-info", logLineInfo);
+    registerCLIValue("--log-async", logAsync);
+    addCLICallback("--log-binary",
+                   [this](std::string_view path)
+                   {
+                       logBinaryFile = path;
+                   });
+    registerCLIValue("--log-text", logText);
 
     int exitCode;
     if (!callbacks.parse(argc, argv, exitCode))
@@ -136,6 +168,16 @@ auto AppOptions::processConfigFile(const std::string& configPath) -> Result
     }
 
     numThreads = table.at_path("thread.num_override").value_or(0U);
+
+    // Budgets are given in MB per residency class, a missing or zero entry leaves that side unlimited
+    for (std::size_t i = 0; i < ResidencyClassCount; i++)
+    {
+        const std::string_view name  = getResidencyClassName(static_cast<ResidencyClass>(i));
+        const uint64_t cpuMB         = table.at_path(std::format("memory.{}_cpu_mb", name)).value_or(uint64_t{ 0 });
+        const uint64_t gpuMB         = table.at_path(std::format("memory.{}_gpu_mb", name)).value_or(uint64_t{ 0 });
+        residencyBudgets[i].cpuBytes = cpuMB * memory::MB;
+        residencyBudgets[i].gpuBytes = gpuMB * memory::MB;
+    }
     logLevel   = table.at_path("debug.log_level").value_or(1U);
 
     // Parse boolean options
@@ -146,6 +188,10 @@ auto AppOptions::processConfigFile(const std::string& configPath) -> Result
     logTime     = table.at_path("debug.log_time").value_or(false);
     logColor    = table.at_path("debug.log_color").value_or(true);
     logLineInfo = table.at_path("debug.log_line_info").value_or(true);
+    logAsync    = table.at_path("debug.log_async").value_or(false);
+    logText     = table.at_path("debug.log_text").value_or(true);
+
+    logBinaryFile = table.at_path("debug.log_binary").value_or(std::string{});
 
     return Result::Success;
 }
@@ -161,6 +207,12 @@ auto AppOptions::setupSystems() -> void
     APH_LOGGER.setEnableTime(logTime);
     APH_LOGGER.setEnableColor(logColor);
     APH_LOGGER.setEnableLineInfo(logLineInfo);
+    APH_LOGGER.setAsync({ .enabled = logAsync });
+    if (!logBinaryFile.empty())
+    {
+        APH_LOGGER.setBinaryLogFile(logBinaryFile);
+    }
+    APH_LOGGER.setTextOutput(logText);
     APH_LOGGER.initialize();
 }
 
@@ -177,10 +229,23 @@ auto AppOptions::printOptions() const -> void
     }
     APP_LOG_INFO("Number of Threads: %s",
                  numThreads == 0 ? "Auto (System Hardware Concurrency)" : std::to_string(numThreads));
+    for (std::size_t i = 0; i < ResidencyClassCount; i++)
+    {
+        const ResidencyBudget& budget = residencyBudgets[i];
+        if (budget.cpuBytes != 0 || budget.gpuBytes != 0)
+        {
+            APP_LOG_INFO("Memory Budget [%s]: CPU %zu MB, GPU %zu MB",
+                         getResidencyClassName(static_cast<ResidencyClass>(i)), budget.cpuBytes / memory::MB,
+                         budget.gpuBytes / memory::MB);
+        }
+    }
     APP_LOG_INFO("Log Level: %u", logLevel);
     APP_LOG_INFO("Log Time: %s", logTime ? "true" : "false");
     APP_LOG_INFO("Log Color: %s", logColor ? "true" : "false");
     APP_LOG_INFO("Log Line Info: %s", logLineInfo ? "true" : "false");
+    APP_LOG_INFO("Log Async: %s", logAsync ? "true" : "false");
+    APP_LOG_INFO("Log Binary File: %s", logBinaryFile.empty() ? "None" : logBinaryFile);
+    APP_LOG_INFO("Log Text: %s", logText ? "true" : "false");
     APP_LOG_INFO("Backtrace: %s", backtrace ? "true" : "false");
     APP_LOG_INFO("Abort On Fatal Error: %s", abortOnFatalError ? "true" : "false");
     APP_LOG_INFO("=== Application Options ===");
@@ -246,8 +311,28 @@ auto AppOptions::getLogLineInfo() const -> bool
     return logLineInfo;
 }
 
+auto AppOptions::getLogAsync() const -> bool
+{
+    return logAsync;
+}
+
+auto AppOptions::getLogBinaryFile() const -> const std::string&
+{
+    return logBinaryFile;
+}
+
+auto AppOptions::getLogText() const -> bool
+{
+    return logText;
+}
+
 auto AppOptions::getProtocols() const -> const HashMap<std::string, std::string>&
 {
     return protocols;
 }
+
+auto AppOptions::getResidencyBudgets() const -> const ResidencyBudgets&
+{
+    return residencyBudgets;
+}
 } // namespace aph
@@ -4,6 +4,7 @@
 #include "common/common.h"
 #include "common/functiontraits.h"
 #include "common/hash.h"
+#include "resource/residencyManager.h"
 
 namespace aph
 {
@@ -22,7 +23,11 @@ struct AppOptions
     auto getLogTime() const -> bool;
     auto getLogColor() const -> bool;
     auto getLogLineInfo() const -> bool;
+    auto getLogAsync() const -> bool;
+    auto getLogBinaryFile() const -> const std::string&;
+    auto getLogText() const -> bool;
     auto getProtocols() const -> const HashMap<std::string, std::string>&;
+    auto getResidencyBudgets() const -> const ResidencyBudgets&;
 
     // Builder pattern methods
     auto setWindowWidth(uint32_t width) -> AppOptions&;
@@ -35,7 +40,11 @@ struct AppOptions
     auto setLogTime(bool enabled) -> AppOptions&;
     auto setLogColor(bool enabled) -> AppOptions&;
     auto setLogLineInfo(bool enabled) -> AppOptions&;
+    auto setLogAsync(bool enabled) -> AppOptions&;
+    auto setLogBinaryFile(std::string path) -> AppOptions&;
+    auto setLogText(bool enabled) -> AppOptions&;
     auto addProtocol(const std::string& protocol, const std::string& path) -> AppOptions&;
+    auto setResidencyBudget(ResidencyClass residencyClass, ResidencyBudget budget) -> AppOptions&;
 
     // CLI callback registration
     template <typename Func>
@@ -62,6 +71,9 @@ private:
     // thread
     uint32_t numThreads = 0;
 
+    // memory
+    ResidencyBudgets residencyBudgets = {};
+
     // debug
     uint32_t logLevel      = 0;
     bool backtrace         = true;
@@ -69,6 +81,9 @@ private:
     bool logTime           = false;
     bool logColor          = true;
     bool logLineInfo       = true;
+    bool logAsync          = false;
+    bool logText           = true;
+    std::string logBinaryFile;
 
 private:
     aph::CLICallbacks callbacks;
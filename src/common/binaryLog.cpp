@@ -0,0 +1,487 @@
+#include "binaryLog.h"
+
+namespace
+{
+template <typename T>
+auto readValue(std::ifstream& file, T& value) -> bool
+{
+    return static_cast<bool>(file.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+auto readString(std::ifstream& file, std::string& value, std::size_t size) -> bool
+{
+    value.resize(size);
+    return static_cast<bool>(file.read(value.data(), static_cast<std::streamsize>(size)));
+}
+
+// Reads an integer of the given size, the file holds it in the byte order of this machine
+template <typename T>
+auto readInteger(std::ifstream& file, uint64_t& value) -> bool
+{
+    T integer;
+    if (!readValue(file, integer))
+    {
+        return false;
+    }
+    if constexpr (std::is_signed_v<T>)
+    {
+        value = static_cast<uint64_t>(static_cast<int64_t>(integer));
+    }
+    else
+    {
+        value = integer;
+    }
+    return true;
+}
+
+// Integers as printf would have read them from the original argument for a signed or unsigned conversion
+auto toSigned(const aph::BinaryLogArg& arg) -> long long
+{
+    if (arg.size == 0 || arg.size >= sizeof(uint64_t))
+    {
+        return static_cast<long long>(arg.integer);
+    }
+    const uint32_t shift = 64 - arg.size * 8;
+    return static_cast<long long>(static_cast<int64_t>(arg.integer << shift) >> shift);
+}
+
+auto toUnsigned(const aph::BinaryLogArg& arg) -> unsigned long long
+{
+    if (arg.size == 0 || arg.size >= sizeof(uint64_t))
+    {
+        return arg.integer;
+    }
+    return arg.integer & ((uint64_t{ 1 } << (arg.size * 8)) - 1);
+}
+} // namespace
+
+namespace aph
+{
+BinaryLogWriter::~BinaryLogWriter()
+{
+    close();
+}
+
+auto BinaryLogWriter::open(const std::filesystem::path& path) -> Result
+{
+    close();
+    m_file.open(path, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+    if (!m_file.is_open())
+    {
+        return { Result::RuntimeError, std::format("Failed to open binary log file: {}", path.string()) };
+    }
+
+    m_buffer.clear();
+    m_buffer.reserve(BufferSize + BufferSize / 4);
+    m_siteIds.clear();
+
+    const BinaryLogFileHeader fileHeader{};
+    append(&fileHeader, sizeof(fileHeader));
+    const BinaryLogClock clock{ .sample = detail::sampleLogClock() };
+    append(&clock, sizeof(clock));
+    return Result::Success;
+}
+
+void BinaryLogWriter::close()
+{
+    if (!m_file.is_open())
+    {
+        return;
+    }
+    writeBuffer();
+    m_file.close();
+    m_siteIds.clear();
+}
+
+auto BinaryLogWriter::isOpen() const -> bool
+{
+    return m_file.is_open();
+}
+
+void BinaryLogWriter::write(const detail::LogRecordHeader& header, const std::byte* pArgs)
+{
+    if (!m_file.is_open())
+    {
+        return;
+    }
+
+    const BinaryLogRecord record{ .level = header.level, .siteId = getSiteId(header), .timestamp = header.timestamp };
+    append(&record, sizeof(record));
+    append(pArgs, header.argSize);
+
+    if (m_buffer.size() >= BufferSize)
+    {
+        writeBuffer();
+    }
+}
+
+void BinaryLogWriter::flush()
+{
+    if (!m_file.is_open())
+    {
+        return;
+    }
+    writeBuffer();
+    m_file.flush();
+}
+
+auto BinaryLogWriter::getSiteId(const detail::LogRecordHeader& header) -> uint32_t
+{
+    const SiteKey key{ .fmt = header.fmt, .tag = header.tag, .pLayout = header.pLayout };
+    auto [it, inserted] = m_siteIds.try_emplace(key, static_cast<uint32_t>(m_siteIds.size()));
+    if (inserted)
+    {
+        const BinaryLogSite site{
+            .argCount   = static_cast<uint16_t>(header.pLayout->argCount),
+            .siteId     = it->second,
+            .tagSize    = static_cast<uint32_t>(std::strlen(header.tag)),
+            .formatSize = static_cast<uint32_t>(std::strlen(header.fmt)),
+        };
+        append(&site, sizeof(site));
+        append(header.pLayout->pArgs, site.argCount * sizeof(detail::LogArgInfo));
+        append(header.tag, site.tagSize);
+        append(header.fmt, site.formatSize);
+    }
+    return it->second;
+}
+
+void BinaryLogWriter::append(const void* pData, std::size_t size)
+{
+    if (size == 0)
+    {
+        return;
+    }
+    const std::size_t offset = m_buffer.size();
+    m_buffer.resize_for_overwrite(offset + size);
+    std::memcpy(m_buffer.data() + offset, pData, size);
+}
+
+void BinaryLogWriter::writeBuffer()
+{
+    if (m_buffer.empty())
+    {
+        return;
+    }
+    const BinaryLogClock clock{ .sample = detail::sampleLogClock() };
+    append(&clock, sizeof(clock));
+    m_file.write(reinterpret_cast<const char*>(m_buffer.data()), static_cast<std::streamsize>(m_buffer.size()));
+    m_buffer.clear();
+}
+
+auto formatBinaryLogMessage(const BinaryLogMessage& message) -> std::string
+{
+    const std::string_view fmt = message.format;
+    std::string out;
+    std::string spec;
+    std::size_t argIndex = 0;
+    std::size_t i        = 0;
+
+    auto nextArg = [&]() -> const BinaryLogArg*
+    {
+        return argIndex < message.args.size() ? &message.args[argIndex++] : nullptr;
+    };
+    // Width or precision, a '*' takes its value from the arguments
+    auto copyField = [&]()
+    {
+        if (i < fmt.size() && fmt[i] == '*')
+        {
+            const BinaryLogArg* pArg = nextArg();
+            spec += std::to_string(pArg ? toSigned(*pArg) : 0);
+            i++;
+        }
+        while (i < fmt.size() && fmt[i] >= '0' && fmt[i] <= '9')
+        {
+            spec += fmt[i++];
+        }
+    };
+
+    while (i < fmt.size())
+    {
+        const std::size_t percent = fmt.find('%', i);
+        out.append(fmt.substr(i, percent - i));
+        if (percent == std::string_view::npos || percent + 1 >= fmt.size())
+        {
+            break;
+        }
+        i = percent + 1;
+        if (fmt[i] == '%')
+        {
+            out += '%';
+            i++;
+            continue;
+        }
+
+        // Flags, width and precision are kept
+        spec.assign("%");
+        while (i < fmt.size() && std::string_view{ "-+ #0" }.find(fmt[i]) != std::string_view::npos)
+        {
+            spec += fmt[i++];
+        }
+        copyField();
+        if (i < fmt.size() && fmt[i] == '.')
+        {
+            spec += fmt[i++];
+            copyField();
+        }
+
+        // Length modifiers are replaced with the ones of the stored type
+        while (i < fmt.size() && std::string_view{ "hljztL" }.find(fmt[i]) != std::string_view::npos)
+        {
+            i++;
+        }
+        if (i >= fmt.size())
+        {
+            break;
+        }
+
+        const char conversion    = fmt[i++];
+        const BinaryLogArg* pArg = nextArg();
+        if (!pArg)
+        {
+            out += "<missing>";
+            continue;
+        }
+        switch (conversion)
+        {
+        case 'd':
+        case 'i':
+            spec += "ll";
+            spec += conversion;
+            detail::appendFormatted(out, spec.c_str(), toSigned(*pArg));
+            break;
+        case 'o':
+        case 'u':
+        case 'x':
+        case 'X':
+            spec += "ll";
+            spec += conversion;
+            detail::appendFormatted(out, spec.c_str(), toUnsigned(*pArg));
+            break;
+        case 'c':
+            spec += conversion;
+            detail::appendFormatted(out, spec.c_str(), static_cast<int>(toSigned(*pArg)));
+            break;
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+            spec += conversion;
+            detail::appendFormatted(out, spec.c_str(), pArg->floating);
+            break;
+        case 's':
+            spec += conversion;
+            detail::appendFormatted(out, spec.c_str(), pArg->string.c_str());
+            break;
+        case 'p':
+            spec += conversion;
+            detail::appendFormatted(out, spec.c_str(), reinterpret_cast<const void*>(pArg->integer));
+            break;
+        default:
+            out += spec;
+            out += conversion;
+            break;
+        }
+    }
+    return out;
+}
+
+auto BinaryLogReader::open(const std::filesystem::path& path) -> Result
+{
+    m_path = path;
+    m_file.open(path, std::ifstream::in | std::ifstream::binary);
+    if (!m_file.is_open())
+    {
+        return { Result::RuntimeError, std::format("Failed to open binary log file: {}", path.string()) };
+    }
+
+    BinaryLogFileHeader header;
+    if (!readValue(m_file, header) || header.magic != BinaryLogFileHeader::Magic)
+    {
+        return { Result::RuntimeError, std::format("Not a binary log file: {}", path.string()) };
+    }
+    if (header.version != BinaryLogFileHeader::CurrentVersion)
+    {
+        return { Result::RuntimeError, std::format("Unsupported binary log version {}", header.version) };
+    }
+    if (header.byteOrderMark != BinaryLogFileHeader{}.byteOrderMark)
+    {
+        return { Result::RuntimeError, "The binary log file was written with a different byte order" };
+    }
+    return Result::Success;
+}
+
+auto BinaryLogReader::readEntries(bool decodeRecords, const std::function<void(const BinaryLogMessage&)>& func)
+    -> Result
+{
+    m_file.clear();
+    m_file.seekg(sizeof(BinaryLogFileHeader));
+    m_sites.clear();
+
+    // A crash can leave a partial entry at the end of the file, reading stops there
+    BinaryLogMessage message{};
+    while (m_file.peek() != std::ifstream::traits_type::eof())
+    {
+        const auto kind = static_cast<BinaryLogEntryKind>(m_file.peek());
+        switch (kind)
+        {
+        case BinaryLogEntryKind::Site:
+        {
+            BinaryLogSite entry;
+            if (!readValue(m_file, entry))
+            {
+                return Result::Success;
+            }
+            if (entry.siteId != m_sites.size())
+            {
+                return { Result::RuntimeError, std::format("Binary log site {} is out of order", entry.siteId) };
+            }
+
+            Site site;
+            site.args.resize(entry.argCount);
+            for (detail::LogArgInfo& info : site.args)
+            {
+                if (!readValue(m_file, info))
+                {
+                    return Result::Success;
+                }
+            }
+            if (!readString(m_file, site.tag, entry.tagSize) || !readString(m_file, site.format, entry.formatSize))
+            {
+                return Result::Success;
+            }
+            m_sites.push_back(std::move(site));
+            break;
+        }
+        case BinaryLogEntryKind::Record:
+        {
+            BinaryLogRecord entry;
+            if (!readValue(m_file, entry))
+            {
+                return Result::Success;
+            }
+            if (entry.siteId >= m_sites.size())
+            {
+                return { Result::RuntimeError, std::format("Binary log record of unknown site {}", entry.siteId) };
+            }
+
+            // Strings outlive the message, sites are only added to
+            const Site& site = m_sites[entry.siteId];
+            message.level    = static_cast<Logger::Level>(entry.level);
+            message.tag      = site.tag;
+            message.format   = site.format;
+            message.args.resize(site.args.size());
+            for (std::size_t i = 0; i < site.args.size(); i++)
+            {
+                if (!readArg(site.args[i], message.args[i]))
+                {
+                    return Result::Success;
+                }
+            }
+
+            if (decodeRecords)
+            {
+                message.systemTime = getSystemTime(entry.timestamp);
+                func(message);
+            }
+            break;
+        }
+        case BinaryLogEntryKind::Clock:
+        {
+            BinaryLogClock entry;
+            if (!readValue(m_file, entry))
+            {
+                return Result::Success;
+            }
+            if (!decodeRecords)
+            {
+                m_clockSamples.push_back(entry.sample);
+            }
+            break;
+        }
+        default:
+            return { Result::RuntimeError,
+                     std::format("Unknown binary log entry {} at offset {}", static_cast<uint32_t>(kind),
+                                 static_cast<int64_t>(m_file.tellg())) };
+        }
+    }
+    return Result::Success;
+}
+
+auto BinaryLogReader::readArg(const detail::LogArgInfo& info, BinaryLogArg& arg) -> bool
+{
+    arg.encoding = info.encoding;
+    arg.size     = info.size;
+
+    switch (info.encoding)
+    {
+    case detail::LogArgEncoding::String:
+        // Terminated, the read fails at the end of the file before the terminator
+        arg.string.clear();
+        std::getline(m_file, arg.string, '\0');
+        return m_file.good();
+    case detail::LogArgEncoding::Float:
+        if (info.size == sizeof(float))
+        {
+            float value        = 0.0f;
+            const bool success = readValue(m_file, value);
+            arg.floating       = value;
+            return success;
+        }
+        if (info.size == sizeof(double))
+        {
+            return readValue(m_file, arg.floating);
+        }
+        if (info.size == sizeof(long double))
+        {
+            // Formatted as a double
+            long double value  = 0.0;
+            const bool success = readValue(m_file, value);
+            arg.floating       = static_cast<double>(value);
+            return success;
+        }
+        return false;
+    case detail::LogArgEncoding::Signed:
+    case detail::LogArgEncoding::Unsigned:
+    case detail::LogArgEncoding::Pointer:
+    {
+        const bool isSigned = info.encoding == detail::LogArgEncoding::Signed;
+        switch (info.size)
+        {
+        case 1:
+            return isSigned ? readInteger<int8_t>(m_file, arg.integer) : readInteger<uint8_t>(m_file, arg.integer);
+        case 2:
+            return isSigned ? readInteger<int16_t>(m_file, arg.integer) : readInteger<uint16_t>(m_file, arg.integer);
+        case 4:
+            return isSigned ? readInteger<int32_t>(m_file, arg.integer) : readInteger<uint32_t>(m_file, arg.integer);
+        case 8:
+            return isSigned ? readInteger<int64_t>(m_file, arg.integer) : readInteger<uint64_t>(m_file, arg.integer);
+        default:
+            return false;
+        }
+    }
+    }
+    return false;
+}
+
+auto BinaryLogReader::getSystemTime(uint64_t ticks) const -> int64_t
+{
+    if (m_clockSamples.empty())
+    {
+        return 0;
+    }
+    if (m_clockSamples.size() == 1)
+    {
+        return m_clockSamples[0].systemTime;
+    }
+
+    // Between the closest samples, past the first or last two at the ends
+    auto it = std::ranges::lower_bound(m_clockSamples, ticks, {}, &detail::LogClockSample::ticks);
+    const std::size_t end =
+        std::clamp<std::size_t>(std::distance(m_clockSamples.begin(), it), 1, m_clockSamples.size() - 1);
+    return detail::toSystemTime(m_clockSamples[end - 1], m_clockSamples[end], ticks);
+}
+} // namespace aph
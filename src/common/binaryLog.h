@@ -0,0 +1,172 @@
+#pragma once
+
+#include "common/hash.h"
+#include "common/logger.h"
+#include "common/result.h"
+
+namespace aph
+{
+// Binary log files, written by Logger::setBinaryLogFile() and read back by the log_decoder tool.
+//
+// A file is a BinaryLogFileHeader followed by entries, each starting with its kind. Format strings and tags are
+// interned: the first record of a call site is preceded by a site entry holding its strings and argument layout,
+// records only refer to it by id. Record arguments are stored the way the asynchronous logger queues them, strings
+// with their terminator and everything else as is. Records are timestamped with clock ticks, the clock entries
+// written along with them pair ticks with the system time for the decoder to interpolate between. Everything is in
+// the byte order of the machine that wrote the file.
+enum class BinaryLogEntryKind : uint8_t
+{
+    Site   = 1,
+    Record = 2,
+    Clock  = 3,
+};
+
+struct BinaryLogFileHeader
+{
+    static constexpr std::array<char, 8> Magic = { 'A', 'P', 'H', 'B', 'L', 'O', 'G', '\0' };
+    static constexpr uint32_t CurrentVersion   = 1;
+
+    std::array<char, 8> magic = Magic;
+    uint32_t version          = CurrentVersion;
+    uint32_t byteOrderMark    = 0x01020304;
+};
+
+// Followed by argCount LogArgInfo, the tag and the format string
+struct BinaryLogSite
+{
+    BinaryLogEntryKind kind = BinaryLogEntryKind::Site;
+    uint8_t reserved        = 0;
+    uint16_t argCount;
+    uint32_t siteId; // sites are numbered in the order they are written
+    uint32_t tagSize;
+    uint32_t formatSize;
+};
+
+// Followed by the arguments, their size follows from the layout of the site
+struct BinaryLogRecord
+{
+    BinaryLogEntryKind kind = BinaryLogEntryKind::Record;
+    uint8_t level;
+    uint16_t reserved = 0;
+    uint32_t siteId;
+    uint64_t timestamp; // detail::readLogClock() ticks
+};
+
+struct BinaryLogClock
+{
+    BinaryLogEntryKind kind = BinaryLogEntryKind::Clock;
+    std::array<uint8_t, 7> reserved{};
+    detail::LogClockSample sample;
+};
+
+// Writes the records of a logger into a binary log file, buffering them. Not thread safe, the logger serializes it.
+class BinaryLogWriter
+{
+public:
+    BinaryLogWriter() = default;
+    ~BinaryLogWriter();
+
+    BinaryLogWriter(const BinaryLogWriter&)            = delete;
+    BinaryLogWriter& operator=(const BinaryLogWriter&) = delete;
+
+    auto open(const std::filesystem::path& path) -> Result;
+    void close();
+    auto isOpen() const -> bool;
+
+    void write(const detail::LogRecordHeader& header, const std::byte* pArgs);
+    void flush();
+
+private:
+    struct SiteKey
+    {
+        const char* fmt;
+        const char* tag;
+        const detail::LogRecordLayout* pLayout;
+
+        auto operator==(const SiteKey&) const -> bool = default;
+    };
+
+    struct SiteKeyHash
+    {
+        using is_avalanching = void;
+
+        auto operator()(const SiteKey& key) const noexcept -> uint64_t
+        {
+            return ::ankerl::unordered_dense::hash<std::string_view>{}(
+                std::string_view{ reinterpret_cast<const char*>(&key), sizeof(key) });
+        }
+    };
+
+    // The buffer is written out at this size
+    static constexpr std::size_t BufferSize = 64 * 1024;
+
+    auto getSiteId(const detail::LogRecordHeader& header) -> uint32_t;
+    void append(const void* pData, std::size_t size);
+    // Writes out the buffer behind a clock entry, which comes after all of the buffered records
+    void writeBuffer();
+
+    std::ofstream m_file;
+    SmallVector<std::byte> m_buffer;
+    HashMap<SiteKey, uint32_t, SiteKeyHash> m_siteIds;
+};
+
+struct BinaryLogArg
+{
+    detail::LogArgEncoding encoding;
+    uint8_t size;
+    uint64_t integer = 0; // Signed is sign extended, Pointer holds the address
+    double floating  = 0.0;
+    std::string string;
+};
+
+struct BinaryLogMessage
+{
+    Logger::Level level;
+    int64_t systemTime; // nanoseconds since the epoch
+    std::string_view tag; // as it was written, like "[CM] "
+    std::string_view format;
+    SmallVector<BinaryLogArg> args;
+};
+
+// Formats the message like the logger would have, printf style
+auto formatBinaryLogMessage(const BinaryLogMessage& message) -> std::string;
+
+// Reads a binary log file in two passes, the first one collects the clock entries to timestamp the records with
+class BinaryLogReader
+{
+public:
+    auto open(const std::filesystem::path& path) -> Result;
+
+    // Calls func(const BinaryLogMessage&) for every record in the order they were written
+    template <typename Func>
+    auto read(Func&& func) -> Result;
+
+private:
+    struct Site
+    {
+        SmallVector<detail::LogArgInfo> args;
+        std::string tag;
+        std::string format;
+    };
+
+    // Reads the entries up to the end of the file, records are only decoded with decodeRecords
+    auto readEntries(bool decodeRecords, const std::function<void(const BinaryLogMessage&)>& func) -> Result;
+    auto readArg(const detail::LogArgInfo& info, BinaryLogArg& arg) -> bool;
+    auto getSystemTime(uint64_t ticks) const -> int64_t;
+
+    std::filesystem::path m_path;
+    std::ifstream m_file;
+    SmallVector<Site> m_sites;
+    SmallVector<detail::LogClockSample> m_clockSamples;
+};
+
+template <typename Func>
+inline auto BinaryLogReader::read(Func&& func) -> Result
+{
+    if (Result result = readEntries(false, {}); !result.success())
+    {
+        return result;
+    }
+    return readEntries(true, std::function<void(const BinaryLogMessage&)>{ std::forward<Func>(func) });
+}
+} // namespace aph
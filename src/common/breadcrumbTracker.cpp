@@ -4,8 +4,11 @@
 namespace aph
 {
 
-// Define a namespace-scope logger macro for breadcrumb system
-GENERATE_LOG_FUNCS(BCT);
+// Logging macros of the breadcrumb system
+#define BCT_LOG_DEBUG(...) APH_LOG_TAGGED(BCT, Debug, __VA_ARGS__)
+#define BCT_LOG_INFO(...)  APH_LOG_TAGGED(BCT, Info, __VA_ARGS__)
+#define BCT_LOG_WARN(...)  APH_LOG_TAGGED(BCT, Warn, __VA_ARGS__)
+#define BCT_LOG_ERR(...)   APH_LOG_TAGGED(BCT, Error, __VA_ARGS__)
 
 // Converts a state to a string representation
 auto StateToString(BreadcrumbState state) -> const char*
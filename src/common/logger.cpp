@@ -1,4 +1,5 @@
 #include "logger.h"
+#include "binaryLog.h"
 #include "global/globalManager.h"
 
 #include <cstdarg>
@@ -26,6 +27,7 @@ struct FileSink
 {
     std::ofstream file;
     bool stripColors;
+    std::string strippedMsg;
 
     FileSink(const std::string& filename, bool stripColors = true)
         : file(filename, std::ofstream::out | std::ofstream::trunc)
@@ -41,31 +43,29 @@ struct FileSink
     {
         if (file.is_open())
         {
-            if (stripColors)
+            if (stripColors && msg.find('\033') != std::string::npos)
             {
-                // Strip ANSI color codes from the message
-                std::string strippedMsg = msg;
-                size_t pos              = 0;
-                const std::string esc   = "\033[";
-
-                while ((pos = strippedMsg.find(esc, pos)) != std::string::npos)
+                // Copy the message without its ANSI color codes, in one pass
+                strippedMsg.clear();
+                size_t pos = 0;
+                while (pos < msg.size())
                 {
-                    size_t endPos = strippedMsg.find('m', pos);
-                    if (endPos != std::string::npos)
-                    {
-                        strippedMsg.erase(pos, endPos - pos + 1);
-                    }
-                    else
+                    const size_t escPos = msg.find("\033[", pos);
+                    const size_t endPos = escPos == std::string::npos ? std::string::npos : msg.find('m', escPos);
+                    if (endPos == std::string::npos)
                     {
+                        strippedMsg.append(msg, pos);
                         break;
                     }
+                    strippedMsg.append(msg, pos, escPos - pos);
+                    pos = endPos + 1;
                 }
 
-                file << strippedMsg;
+                file.write(strippedMsg.data(), static_cast<std::streamsize>(strippedMsg.size()));
             }
             else
             {
-                file << msg;
+                file.write(msg.data(), static_cast<std::streamsize>(msg.size()));
             }
         }
     }
@@ -88,14 +88,20 @@ class LoggerImpl
 {
 public:
     LoggerImpl()
-        : m_logLevel(Logger::Level::Debug)
-        , m_enableTime(false)
+        : m_enableTime(false)
         , m_enableColor(true)
         , m_enableLineInfo(true)
         , m_initialized(false)
     {
     }
 
+    ~LoggerImpl()
+    {
+        stopWorker();
+        drain();
+        flushSinks();
+    }
+
     // Structure to store staged log messages
     struct StagedLogMessage
     {
@@ -118,8 +124,10 @@ public:
     static constexpr const char* WARN_COLOR  = "\033[33m";
     static constexpr const char* ERROR_COLOR = "\033[31m";
 
+    // How long the logging thread sleeps when there is nothing to write
+    static constexpr std::chrono::milliseconds ASYNC_IDLE_INTERVAL{ 2 };
+
     // Member variables
-    Logger::Level m_logLevel;
     bool m_enableTime;
     bool m_enableColor;
     bool m_enableLineInfo;
@@ -127,6 +135,34 @@ public:
     std::mutex m_mutex;
     SmallVector<StagedLogMessage> m_stagedLogs;
     SmallVector<SinkEntry> m_sinks;
+    BinaryLogWriter m_binaryLog;
+
+    // The logging thread's copies of the Logger's output switches
+    std::atomic<bool> m_binaryOutput{ false };
+    std::atomic<bool> m_textOutput{ true };
+
+    // Record timestamps are clock ticks, the text sinks get them interpolated between this and the time of the drain
+    const detail::LogClockSample m_clockOrigin = detail::sampleLogClock();
+
+    // Async state. Threads look their ring up by the id of the logger, which is never reused.
+    const uint64_t m_id = s_nextId.fetch_add(1, std::memory_order_relaxed);
+    std::atomic<std::size_t> m_ringSize{ Logger::AsyncOptions{}.ringSize };
+    std::atomic<Logger::OverflowPolicy> m_overflowPolicy{ Logger::OverflowPolicy::Drop };
+    std::mutex m_ringMutex;
+    SmallVector<std::shared_ptr<detail::LogRing>> m_rings;
+
+    // A ring has a single reader, whoever holds the drain mutex
+    std::mutex m_drainMutex;
+    std::atomic<std::thread::id> m_drainOwner;
+    std::string m_recordBuffer;
+    std::atomic<uint64_t> m_droppedCount{ 0 };
+
+    std::thread m_worker;
+    std::mutex m_workerMutex;
+    std::condition_variable m_workerCondition;
+    bool m_stopWorker = false;
+
+    inline static std::atomic<uint64_t> s_nextId{ 1 };
 
     // Helper methods
     void writeToSinks(const std::string& message)
@@ -137,9 +173,9 @@ public:
         }
     }
 
-    std::string getCurrentTime()
+    std::string getCurrentTime(std::chrono::system_clock::time_point time)
     {
-        auto t  = std::time(nullptr);
+        auto t  = std::chrono::system_clock::to_time_t(time);
         auto tm = *std::localtime(&t);
         std::ostringstream oss;
         oss << std::put_time(&tm, "[%Y-%m-%d %H:%M:%S]");
@@ -180,13 +216,14 @@ public:
         }
     }
 
-    std::string formatLogMessage(Logger::Level level, std::string_view message)
+    std::string formatLogMessage(Logger::Level level, std::string_view message,
+                                 std::chrono::system_clock::time_point time)
     {
         std::ostringstream ss;
 
         if (m_enableTime)
         {
-            ss << getCurrentTime();
+            ss << getCurrentTime(time);
         }
 
         if (m_enableColor)
@@ -207,16 +244,13 @@ public:
         return ss.str();
     }
 
-    // Core log implementation
-    void log(Logger::Level level, std::string_view message)
+    // Core log implementation, the level was checked by the caller
+    void log(Logger::Level level, std::string_view message,
+             std::chrono::system_clock::time_point time = std::chrono::system_clock::now())
     {
         std::lock_guard<std::mutex> lock(m_mutex);
 
-        // Apply unified log level filtering
-        if (level < m_logLevel)
-            return;
-
-        std::string logMessage = formatLogMessage(level, message);
+        std::string logMessage = formatLogMessage(level, message, time);
 
         if (!m_initialized)
         {
@@ -236,8 +270,177 @@ public:
         m_sinks.push_back(
             { .writeCallback = std::move(writeFunc), .flushCallback = std::move(flushFunc), .isFileSink = isFileSink });
     }
+
+    void writeBinary(const detail::LogRecordHeader& header, const std::byte* pArgs)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_binaryLog.write(header, pArgs);
+    }
+
+    void flushSinks()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto& sink : m_sinks)
+        {
+            sink.flushCallback();
+        }
+        m_binaryLog.flush();
+    }
+
+    auto createRing() -> std::shared_ptr<detail::LogRing>
+    {
+        auto pRing = std::make_shared<detail::LogRing>(m_ringSize.load(std::memory_order_relaxed));
+        std::lock_guard<std::mutex> lock(m_ringMutex);
+        m_rings.push_back(pRing);
+        return pRing;
+    }
+
+    // Formats and writes every queued record, returns how many there were
+    auto drain() -> std::size_t
+    {
+        std::lock_guard<std::mutex> lock(m_drainMutex);
+        m_drainOwner.store(std::this_thread::get_id(), std::memory_order_relaxed);
+        const std::size_t count = drainLocked();
+        m_drainOwner.store({}, std::memory_order_relaxed);
+        return count;
+    }
+
+    auto drainLocked() -> std::size_t
+    {
+        SmallVector<std::shared_ptr<detail::LogRing>> rings;
+        {
+            std::lock_guard<std::mutex> lock(m_ringMutex);
+            rings.assign(m_rings.begin(), m_rings.end());
+        }
+
+        const detail::LogClockSample now = detail::sampleLogClock();
+        const bool binaryOutput          = m_binaryOutput.load(std::memory_order_relaxed);
+        const bool textOutput            = m_textOutput.load(std::memory_order_relaxed);
+
+        std::size_t count = 0;
+        for (const auto& pRing : rings)
+        {
+            // A ring retired before it was drained has all of its records visible by now
+            const bool retired = pRing->isRetired();
+            count += pRing->drain(
+                [&](const detail::LogRecordHeader& header, const std::byte* pArgs)
+                {
+                    if (binaryOutput)
+                    {
+                        writeBinary(header, pArgs);
+                    }
+                    if (textOutput)
+                    {
+                        using Clock = std::chrono::system_clock;
+                        const std::chrono::nanoseconds time{ detail::toSystemTime(m_clockOrigin, now,
+                                                                                  header.timestamp) };
+                        m_recordBuffer.assign(header.tag);
+                        header.pLayout->pFormat(m_recordBuffer, header.fmt, pArgs);
+                        log(static_cast<Logger::Level>(header.level), m_recordBuffer,
+                            Clock::time_point{ std::chrono::duration_cast<Clock::duration>(time) });
+                    }
+                });
+
+            const uint64_t dropped = pRing->getDroppedCount();
+            const uint64_t newDrops = dropped - pRing->getReportedDropCount();
+            if (newDrops > 0)
+            {
+                pRing->setReportedDropCount(dropped);
+                m_droppedCount.fetch_add(newDrops, std::memory_order_relaxed);
+                log(Logger::Level::Warn,
+                    std::format("[Logger] Dropped {} messages, the log ring of a thread was full", newDrops));
+            }
+
+            if (retired)
+            {
+                std::lock_guard<std::mutex> lock(m_ringMutex);
+                aph::erase(m_rings, pRing);
+            }
+        }
+        return count;
+    }
+
+    void startWorker()
+    {
+        std::lock_guard<std::mutex> lock(m_workerMutex);
+        if (m_worker.joinable())
+        {
+            return;
+        }
+        m_stopWorker = false;
+        m_worker     = std::thread(
+            [this]()
+            {
+                std::unique_lock<std::mutex> lock(m_workerMutex);
+                while (!m_stopWorker)
+                {
+                    lock.unlock();
+                    const std::size_t count = drain();
+                    lock.lock();
+                    if (count == 0)
+                    {
+                        m_workerCondition.wait_for(lock, ASYNC_IDLE_INTERVAL);
+                    }
+                }
+            });
+    }
+
+    void stopWorker()
+    {
+        std::thread worker;
+        {
+            std::lock_guard<std::mutex> lock(m_workerMutex);
+            m_stopWorker = true;
+            worker       = std::move(m_worker);
+        }
+        m_workerCondition.notify_one();
+        if (worker.joinable())
+        {
+            worker.join();
+        }
+    }
+
+    // Called from a signal handler. The thread that crashed may be the one draining, or another one may hold the
+    // drain mutex for good, so this gives up on the queued records rather than waiting forever.
+    void drainOnCrash()
+    {
+        if (m_drainOwner.load(std::memory_order_relaxed) == std::this_thread::get_id())
+        {
+            return;
+        }
+        for (uint32_t attempt = 0; attempt < 100; attempt++)
+        {
+            if (m_drainMutex.try_lock())
+            {
+                std::lock_guard<std::mutex> lock(m_drainMutex, std::adopt_lock);
+                drainLocked();
+                return;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds{ 1 });
+        }
+    }
+};
+
+namespace
+{
+// Ring of the calling thread, retired with the thread so the logger can let go of it once it's drained
+struct ThreadLogRing
+{
+    uint64_t loggerId = 0;
+    std::shared_ptr<detail::LogRing> pRing;
+
+    ~ThreadLogRing()
+    {
+        if (pRing)
+        {
+            pRing->retire();
+        }
+    }
 };
 
+thread_local ThreadLogRing t_logRing;
+} // namespace
+
 // Logger implementation using PIMPL
 
 Logger::Logger()
@@ -248,9 +451,26 @@ Logger::Logger()
     addSink(FileSink("log.txt", true), true);
 }
 
-Logger::~Logger()                            = default;
-Logger::Logger(Logger&&) noexcept            = default;
-Logger& Logger::operator=(Logger&&) noexcept = default;
+Logger::~Logger() = default;
+
+Logger::Logger(Logger&& other) noexcept
+    : m_impl(std::move(other.m_impl))
+    , m_logLevel(other.m_logLevel.load())
+    , m_async(other.m_async.load())
+    , m_binaryOutput(other.m_binaryOutput.load())
+    , m_textOutput(other.m_textOutput.load())
+{
+}
+
+Logger& Logger::operator=(Logger&& other) noexcept
+{
+    m_impl = std::move(other.m_impl);
+    m_logLevel.store(other.m_logLevel.load());
+    m_async.store(other.m_async.load());
+    m_binaryOutput.store(other.m_binaryOutput.load());
+    m_textOutput.store(other.m_textOutput.load());
+    return *this;
+}
 
 void Logger::initialize()
 {
@@ -267,7 +487,7 @@ void Logger::initialize()
     for (const auto& stagedLog : m_impl->m_stagedLogs)
     {
         // Only write logs that pass the current log level filter
-        if (stagedLog.level >= m_impl->m_logLevel)
+        if (isEnabled(stagedLog.level))
         {
             m_impl->writeToSinks(stagedLog.message);
         }
@@ -284,11 +504,100 @@ void Logger::logImpl(Level level, std::string_view message)
 
 void Logger::flush()
 {
+    m_impl->drain();
+    m_impl->flushSinks();
+}
+
+void Logger::setAsync(const AsyncOptions& options)
+{
+    if (options.enabled)
+    {
+        m_impl->m_ringSize.store(options.ringSize, std::memory_order_relaxed);
+        m_impl->m_overflowPolicy.store(options.overflowPolicy, std::memory_order_relaxed);
+        m_impl->startWorker();
+        m_async.store(true, std::memory_order_release);
+    }
+    else
+    {
+        m_async.store(false, std::memory_order_release);
+        m_impl->stopWorker();
+        m_impl->drain();
+    }
+}
+
+void Logger::flushOnCrash()
+{
+    m_async.store(false, std::memory_order_release);
+    m_impl->drainOnCrash();
+    m_impl->flushSinks();
+}
+
+void Logger::setBinaryLogFile(const std::string& filename)
+{
+    // What is queued was logged for the previous file
+    m_impl->drain();
+
     std::lock_guard<std::mutex> lock(m_impl->m_mutex);
-    for (auto& sink : m_impl->m_sinks)
+    m_impl->m_binaryLog.close();
+    if (!filename.empty())
     {
-        sink.flushCallback();
+        if (Result result = m_impl->m_binaryLog.open(filename); !result.success())
+        {
+            std::cerr << result.toString() << "\n";
+        }
     }
+
+    const bool isOpen = m_impl->m_binaryLog.isOpen();
+    m_impl->m_binaryOutput.store(isOpen, std::memory_order_relaxed);
+    m_binaryOutput.store(isOpen, std::memory_order_relaxed);
+}
+
+void Logger::setTextOutput(bool enabled)
+{
+    m_impl->m_textOutput.store(enabled, std::memory_order_relaxed);
+    m_textOutput.store(enabled, std::memory_order_relaxed);
+}
+
+void Logger::writeBinary(const detail::LogRecordHeader& header, const std::byte* pArgs)
+{
+    m_impl->writeBinary(header, pArgs);
+}
+
+auto Logger::getThreadRing() -> detail::LogRing*
+{
+    if (t_logRing.loggerId != m_impl->m_id)
+    {
+        if (t_logRing.pRing)
+        {
+            t_logRing.pRing->retire();
+        }
+        t_logRing.loggerId = m_impl->m_id;
+        t_logRing.pRing    = m_impl->createRing();
+    }
+    return t_logRing.pRing.get();
+}
+
+auto Logger::reserveOnOverflow(detail::LogRing* pRing, std::size_t size) -> std::byte*
+{
+    if (m_impl->m_overflowPolicy.load(std::memory_order_relaxed) == OverflowPolicy::Drop)
+    {
+        pRing->addDropped();
+        return nullptr;
+    }
+
+    // Make room by writing out what's queued, waiting for the logging thread if it is at it already
+    std::byte* pRecord = nullptr;
+    while (!pRecord)
+    {
+        m_impl->drain();
+        pRecord = pRing->tryReserve(size);
+    }
+    return pRecord;
+}
+
+void Logger::drainQueued()
+{
+    m_impl->drain();
 }
 
 void Logger::addSinkWrapper(std::function<void(const std::string&)> writeFunc, std::function<void()> flushFunc,
@@ -299,29 +608,31 @@ void Logger::addSinkWrapper(std::function<void(const std::string&)> writeFunc, s
 
 void Logger::setLogFile(const std::string& filename)
 {
-    std::lock_guard<std::mutex> lock(m_impl->m_mutex);
-
-    // Remove any existing file sinks
-    auto it = m_impl->m_sinks.begin();
-    while (it != m_impl->m_sinks.end())
     {
-        if (it->isFileSink)
-        {
-            it = m_impl->m_sinks.erase(it);
-        }
-        else
+        std::lock_guard<std::mutex> lock(m_impl->m_mutex);
+
+        // Remove any existing file sinks
+        auto it = m_impl->m_sinks.begin();
+        while (it != m_impl->m_sinks.end())
         {
-            ++it;
+            if (it->isFileSink)
+            {
+                it = m_impl->m_sinks.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
         }
     }
 
-    // Add the new file sink with color stripping enabled
+    // Add the new file sink with color stripping enabled, this takes the lock again
     addSink(FileSink(filename, true), true);
 }
 
 void Logger::setLogLevel(Level level)
 {
-    m_impl->m_logLevel = level;
+    m_logLevel.store(level, std::memory_order_relaxed);
 }
 
 void Logger::setLogLevel(uint32_t level)
@@ -362,10 +673,20 @@ bool Logger::getEnableLineInfo() const
     return m_impl->m_enableLineInfo;
 }
 
+bool Logger::isAsync() const
+{
+    return m_async.load(std::memory_order_relaxed);
+}
+
+uint64_t Logger::getDroppedCount() const
+{
+    return m_impl->m_droppedCount.load(std::memory_order_relaxed);
+}
+
 // Helper function to retrieve the logger from GlobalManager
-Logger* getActiveLogger()
+Logger* findActiveLogger()
 {
-    return GlobalManager::instance().getSubsystem<Logger>(GlobalManager::LOGGER_NAME);
+    return getBuiltInSubsystem<Logger>();
 }
 
 auto Logger::toFormat(const char* val) -> const char*
@@ -383,8 +704,8 @@ auto Logger::toFormat(const std::filesystem::path& val) -> const char*
     return val.c_str();
 }
 
-auto Logger::toFormat(std::string_view val) -> const char*
+auto Logger::toFormat(std::string_view val) -> std::string_view
 {
-    return val.data();
+    return val;
 }
 } // namespace aph
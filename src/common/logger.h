@@ -3,11 +3,24 @@
 #include "common/macros.h"
 #include "common/smallVector.h"
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// Lowest log level compiled in, set through the APH_LOG_LEVEL_MIN CMake option (0 Debug to 4 None). Log macros
+// below it compile to nothing, their arguments included.
+#ifndef APH_LOG_LEVEL_MIN
+#define APH_LOG_LEVEL_MIN 0
+#endif
+
 namespace aph
 {
 
 // Forward declaration for implementation details
 class LoggerImpl;
+class Logger;
 
 template <typename T>
 concept LogSinkConcept = requires(T t, const std::string& msg) {
@@ -15,6 +28,593 @@ concept LogSinkConcept = requires(T t, const std::string& msg) {
     { t.flush() } -> std::same_as<void>;
 };
 
+namespace detail
+{
+// Never defined, a call to it makes the consteval format check fail to compile on the line giving the reason
+void logFormatError(const char* reason);
+
+enum class LogArgKind : uint8_t
+{
+    Integer,
+    Float,
+    String,
+    Pointer,
+    Other,
+};
+
+// What a log argument can be formatted as, after Logger::toFormat()
+template <typename T>
+consteval auto getLogArgKind() -> LogArgKind
+{
+    using U = std::remove_cvref_t<T>;
+    if constexpr (std::is_array_v<U>)
+    {
+        return std::is_same_v<std::remove_cv_t<std::remove_extent_t<U>>, char> ? LogArgKind::String :
+                                                                                 LogArgKind::Pointer;
+    }
+    else if constexpr (std::is_same_v<U, const char*> || std::is_same_v<U, char*>)
+    {
+        return LogArgKind::String;
+    }
+    else if constexpr (std::is_pointer_v<U> || std::is_null_pointer_v<U>)
+    {
+        return LogArgKind::Pointer;
+    }
+    else if constexpr (std::is_integral_v<U> || std::is_enum_v<U>)
+    {
+        return LogArgKind::Integer;
+    }
+    else if constexpr (std::is_floating_point_v<U>)
+    {
+        return LogArgKind::Float;
+    }
+    else if constexpr (std::is_same_v<U, std::filesystem::path> || std::is_convertible_v<const U&, std::string_view>)
+    {
+        return LogArgKind::String;
+    }
+    else
+    {
+        return LogArgKind::Other;
+    }
+}
+
+// Matches the printf conversions of fmt against the argument types
+template <typename... Args>
+consteval auto checkLogFormat(std::string_view fmt) -> bool
+{
+    constexpr LogArgKind kinds[] = { getLogArgKind<Args>()..., LogArgKind::Other };
+    std::size_t argIndex         = 0;
+
+    auto consume = [&](bool integer, bool floating, bool string, bool pointer)
+    {
+        if (argIndex == sizeof...(Args))
+        {
+            logFormatError("The format string has more conversions than arguments");
+        }
+        const LogArgKind kind = kinds[argIndex++];
+        if (!((integer && kind == LogArgKind::Integer) || (floating && kind == LogArgKind::Float) ||
+              (string && kind == LogArgKind::String) || (pointer && kind == LogArgKind::Pointer)))
+        {
+            logFormatError("A log argument doesn't match the type of its conversion");
+        }
+    };
+    auto isDigit = [](char c)
+    {
+        return c >= '0' && c <= '9';
+    };
+    auto skip = [&](std::size_t& i, std::string_view chars)
+    {
+        while (i < fmt.size() && chars.find(fmt[i]) != std::string_view::npos)
+        {
+            i++;
+        }
+    };
+
+    for (std::size_t i = 0; i < fmt.size(); i++)
+    {
+        if (fmt[i] != '%')
+        {
+            continue;
+        }
+        if (++i < fmt.size() && fmt[i] == '%')
+        {
+            continue;
+        }
+
+        // Flags, width, precision and length don't change what an argument has to be, except for '*'
+        skip(i, "-+ #0'");
+        if (i < fmt.size() && fmt[i] == '*')
+        {
+            consume(true, false, false, false);
+            i++;
+        }
+        while (i < fmt.size() && isDigit(fmt[i]))
+        {
+            i++;
+        }
+        if (i < fmt.size() && fmt[i] == '.')
+        {
+            i++;
+            if (i < fmt.size() && fmt[i] == '*')
+            {
+                consume(true, false, false, false);
+                i++;
+            }
+            while (i < fmt.size() && isDigit(fmt[i]))
+            {
+                i++;
+            }
+        }
+        skip(i, "hlLqjzt");
+
+        if (i == fmt.size())
+        {
+            logFormatError("The format string ends in the middle of a conversion");
+        }
+        switch (fmt[i])
+        {
+        case 'd':
+        case 'i':
+        case 'o':
+        case 'u':
+        case 'x':
+        case 'X':
+        case 'c':
+            consume(true, false, false, false);
+            break;
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+            consume(false, true, false, false);
+            break;
+        case 's':
+            consume(false, false, true, false);
+            break;
+        case 'p':
+            consume(false, false, true, true);
+            break;
+        default:
+            logFormatError("Unknown conversion in a log format string");
+        }
+    }
+
+    if (argIndex != sizeof...(Args))
+    {
+        logFormatError("The format string has fewer conversions than arguments");
+    }
+    return true;
+}
+
+// printf format string checked against the argument types at compile time, like std::format_string. Being a
+// constant it outlives every record that points at it.
+template <typename... Args>
+class LogFormatString
+{
+public:
+    template <typename S>
+        requires std::is_convertible_v<const S&, std::string_view>
+    consteval LogFormatString(const S& fmt)
+        : m_fmt(fmt)
+    {
+        checkLogFormat<Args...>(m_fmt);
+    }
+
+    constexpr auto get() const -> std::string_view
+    {
+        return m_fmt;
+    }
+
+private:
+    std::string_view m_fmt;
+};
+
+// Appends the printf formatted arguments to out
+template <typename... Args>
+inline void appendFormatted(std::string& out, const char* fmt, const Args&... args)
+{
+    const std::size_t offset    = out.size();
+    const std::size_t available = std::max<std::size_t>(out.capacity() - offset, 256);
+    out.resize(offset + available);
+
+    // The terminator snprintf writes lands on the string's own one
+    const int result = std::snprintf(out.data() + offset, available + 1, fmt, args...);
+    if (result < 0)
+    {
+        out.resize(offset);
+        out += "Error formatting log message";
+        return;
+    }
+
+    out.resize(offset + result);
+    if (static_cast<std::size_t>(result) > available)
+    {
+        std::snprintf(out.data() + offset, result + 1, fmt, args...);
+    }
+}
+
+// How an argument of an asynchronous log record is stored. Strings are copied, they rarely outlive the call,
+// everything else printf takes is stored as is. String views are copied with their length.
+template <typename T>
+using LogArgType = std::conditional_t<std::is_same_v<T, char*>, const char*, T>;
+
+template <typename T>
+struct LogArgCodec
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Log arguments have to be strings or trivially copyable");
+
+    static auto getSize(const T&) -> std::size_t
+    {
+        return sizeof(T);
+    }
+
+    static auto encode(std::byte* pDst, const T& value) -> std::byte*
+    {
+        std::memcpy(pDst, &value, sizeof(T));
+        return pDst + sizeof(T);
+    }
+
+    static auto decode(const std::byte*& pSrc) -> T
+    {
+        T value;
+        std::memcpy(&value, pSrc, sizeof(T));
+        pSrc += sizeof(T);
+        return value;
+    }
+};
+
+template <>
+struct LogArgCodec<const char*>
+{
+    static auto getSize(const char* value) -> std::size_t
+    {
+        return std::strlen(value ? value : "(null)") + 1;
+    }
+
+    static auto encode(std::byte* pDst, const char* value) -> std::byte*
+    {
+        const std::size_t size = getSize(value);
+        std::memcpy(pDst, value ? value : "(null)", size);
+        return pDst + size;
+    }
+
+    // Points into the record, which stays put while it is formatted
+    static auto decode(const std::byte*& pSrc) -> const char*
+    {
+        const char* value = reinterpret_cast<const char*>(pSrc);
+        pSrc += std::strlen(value) + 1;
+        return value;
+    }
+};
+
+// Views aren't terminated, they are copied by their length and terminated in the record
+template <>
+struct LogArgCodec<std::string_view>
+{
+    static auto getSize(std::string_view value) -> std::size_t
+    {
+        return value.size() + 1;
+    }
+
+    static auto encode(std::byte* pDst, std::string_view value) -> std::byte*
+    {
+        std::memcpy(pDst, value.data(), value.size());
+        pDst[value.size()] = std::byte{ 0 };
+        return pDst + value.size() + 1;
+    }
+
+    static auto decode(const std::byte*& pSrc) -> const char*
+    {
+        return LogArgCodec<const char*>::decode(pSrc);
+    }
+};
+
+// Decodes the arguments of a record and appends the formatted message to out
+using LogFormatFunc = void (*)(std::string& out, const char* fmt, const std::byte* pArgs);
+
+// How an encoded argument is read back without its type, by the binary log decoder
+enum class LogArgEncoding : uint8_t
+{
+    Signed,
+    Unsigned,
+    Float,
+    String, // terminated copy
+    Pointer,
+};
+
+struct LogArgInfo
+{
+    LogArgEncoding encoding;
+    uint8_t size; // bytes, 0 for strings
+};
+
+template <typename T>
+consteval auto getLogArgInfo() -> LogArgInfo
+{
+    if constexpr (std::is_same_v<T, const char*> || std::is_same_v<T, std::string_view>)
+    {
+        return { LogArgEncoding::String, 0 };
+    }
+    else if constexpr (std::is_pointer_v<T> || std::is_null_pointer_v<T>)
+    {
+        return { LogArgEncoding::Pointer, sizeof(T) };
+    }
+    else if constexpr (std::is_floating_point_v<T>)
+    {
+        return { LogArgEncoding::Float, sizeof(T) };
+    }
+    else if constexpr (std::is_enum_v<T>)
+    {
+        return getLogArgInfo<std::underlying_type_t<T>>();
+    }
+    else
+    {
+        return { std::is_signed_v<T> ? LogArgEncoding::Signed : LogArgEncoding::Unsigned, sizeof(T) };
+    }
+}
+
+template <typename... Ts>
+inline void formatLogRecord(std::string& out, const char* fmt, [[maybe_unused]] const std::byte* pArgs)
+{
+    // Braced initialization decodes the arguments in order
+    std::tuple<decltype(LogArgCodec<Ts>::decode(pArgs))...> args{ LogArgCodec<Ts>::decode(pArgs)... };
+    std::apply(
+        [&](const auto&... values)
+        {
+            appendFormatted(out, fmt, values...);
+        },
+        args);
+}
+
+// Argument types of a log call, one per signature
+struct LogRecordLayout
+{
+    LogFormatFunc pFormat;
+    const LogArgInfo* pArgs;
+    uint32_t argCount;
+};
+
+template <typename... Ts>
+struct LogRecordLayoutOf
+{
+    // One more entry than there are arguments, arrays can't be empty
+    static constexpr LogArgInfo args[] = { getLogArgInfo<Ts>()..., {} };
+    static constexpr LogRecordLayout value{
+        .pFormat = &formatLogRecord<Ts...>, .pArgs = args, .argCount = sizeof...(Ts) };
+};
+
+// Record timestamps come from the TSC where there is one, invariant on every x86 CPU of the last decade, and from
+// the steady clock elsewhere. Ticks are turned into wall clock time by interpolating between two samples of both
+// clocks.
+inline auto readLogClock() -> uint64_t
+{
+#if defined(_M_X64) || defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+#endif
+}
+
+struct LogClockSample
+{
+    uint64_t ticks;
+    int64_t systemTime; // system clock nanoseconds since the epoch
+};
+
+inline auto sampleLogClock() -> LogClockSample
+{
+    const auto systemTime = std::chrono::system_clock::now().time_since_epoch();
+    return { .ticks      = readLogClock(),
+             .systemTime = std::chrono::duration_cast<std::chrono::nanoseconds>(systemTime).count() };
+}
+
+// System time of the ticks, extrapolated when they aren't between the samples
+inline auto toSystemTime(const LogClockSample& begin, const LogClockSample& end, uint64_t ticks) -> int64_t
+{
+    if (end.ticks == begin.ticks)
+    {
+        return begin.systemTime;
+    }
+    const double nsPerTick = static_cast<double>(end.systemTime - begin.systemTime) /
+                             static_cast<double>(static_cast<int64_t>(end.ticks - begin.ticks));
+    return begin.systemTime +
+           static_cast<int64_t>(static_cast<double>(static_cast<int64_t>(ticks - begin.ticks)) * nsPerTick);
+}
+
+struct LogRecordPrefix
+{
+    uint32_t size; // bytes to the next record, this header included
+    uint32_t isPadding;
+};
+
+// A record is this header followed by its encoded arguments. The padding at the end of a ring, written when a
+// record doesn't fit there, only has the prefix.
+struct LogRecordHeader
+{
+    LogRecordPrefix prefix;
+    uint8_t level;
+    uint32_t argSize;
+    uint64_t timestamp; // readLogClock() ticks
+    const LogRecordLayout* pLayout;
+    const char* tag;
+    const char* fmt;
+};
+
+template <typename... Ts>
+inline auto makeLogRecordHeader(uint8_t level, const char* tag, const char* fmt, std::size_t size,
+                                std::size_t argSize) -> LogRecordHeader
+{
+    return {
+        .prefix    = { .size = static_cast<uint32_t>(size), .isPadding = 0 },
+        .level     = level,
+        .argSize   = static_cast<uint32_t>(argSize),
+        .timestamp = readLogClock(),
+        .pLayout   = &LogRecordLayoutOf<Ts...>::value,
+        .tag       = tag,
+        .fmt       = fmt,
+    };
+}
+
+// Byte ring written by one thread and read by the logging thread. Both positions only grow, each side owns
+// one of them and reads the other's with acquire, so neither takes a lock.
+class LogRing
+{
+public:
+    explicit LogRing(std::size_t capacity)
+    {
+        std::size_t size = 1024;
+        while (size < capacity)
+        {
+            size <<= 1;
+        }
+        m_mask  = size - 1;
+        m_pData = std::make_unique_for_overwrite<std::byte[]>(size);
+    }
+
+    LogRing(const LogRing&)            = delete;
+    LogRing& operator=(const LogRing&) = delete;
+
+    static constexpr auto getRecordSize(std::size_t argBytes) -> std::size_t
+    {
+        return (sizeof(LogRecordHeader) + argBytes + alignof(LogRecordHeader) - 1) &
+               ~(alignof(LogRecordHeader) - 1);
+    }
+
+    // Larger records are written synchronously instead
+    auto getMaxRecordSize() const -> std::size_t
+    {
+        return (m_mask + 1) / 4;
+    }
+
+    // Producer side, returns null when the ring is full. The record becomes visible on commit().
+    auto tryReserve(std::size_t size) -> std::byte*
+    {
+        const std::size_t offset     = m_reservePos & m_mask;
+        const std::size_t contiguous = m_mask + 1 - offset;
+        if (size > contiguous)
+        {
+            // Pad out the end of the ring and start over at its beginning. The padding is published right away,
+            // the record may only fit once the reader went past it.
+            if (!hasSpace(contiguous))
+            {
+                return nullptr;
+            }
+            new (&m_pData[offset]) LogRecordPrefix{ .size = static_cast<uint32_t>(contiguous), .isPadding = 1 };
+            m_reservePos += contiguous;
+            m_writePos.store(m_reservePos, std::memory_order_release);
+        }
+
+        if (!hasSpace(size))
+        {
+            return nullptr;
+        }
+        std::byte* pRecord = &m_pData[m_reservePos & m_mask];
+        m_reservePos += size;
+        return pRecord;
+    }
+
+    void commit()
+    {
+        m_writePos.store(m_reservePos, std::memory_order_release);
+    }
+
+    void addDropped()
+    {
+        m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Marks the ring as no longer written to, it goes away once the reader emptied it
+    void retire()
+    {
+        m_retired.store(true, std::memory_order_release);
+    }
+
+    // Consumer side, calls func(header, pArgs) for every committed record in order
+    template <typename Func>
+    auto drain(Func&& func) -> std::size_t
+    {
+        std::size_t readPos        = m_readPos.load(std::memory_order_relaxed);
+        const std::size_t writePos = m_writePos.load(std::memory_order_acquire);
+        std::size_t count          = 0;
+        while (readPos != writePos)
+        {
+            const std::byte* pRecord = &m_pData[readPos & m_mask];
+            const auto* pPrefix      = reinterpret_cast<const LogRecordPrefix*>(pRecord);
+            const uint32_t size      = pPrefix->size;
+            if (!pPrefix->isPadding)
+            {
+                const auto* pHeader = reinterpret_cast<const LogRecordHeader*>(pRecord);
+                func(*pHeader, reinterpret_cast<const std::byte*>(pHeader + 1));
+                count++;
+            }
+            readPos += size;
+            m_readPos.store(readPos, std::memory_order_release);
+        }
+        return count;
+    }
+
+    auto isRetired() const -> bool
+    {
+        return m_retired.load(std::memory_order_acquire);
+    }
+
+    auto isEmpty() const -> bool
+    {
+        return m_readPos.load(std::memory_order_relaxed) == m_writePos.load(std::memory_order_acquire);
+    }
+
+    auto getDroppedCount() const -> uint64_t
+    {
+        return m_droppedCount.load(std::memory_order_relaxed);
+    }
+
+    // Drops the reader has logged a warning about already
+    auto getReportedDropCount() const -> uint64_t
+    {
+        return m_reportedDropCount;
+    }
+
+    void setReportedDropCount(uint64_t count)
+    {
+        m_reportedDropCount = count;
+    }
+
+private:
+    auto hasSpace(std::size_t size) -> bool
+    {
+        if (m_reservePos + size - m_cachedReadPos <= m_mask + 1)
+        {
+            return true;
+        }
+        m_cachedReadPos = m_readPos.load(std::memory_order_acquire);
+        return m_reservePos + size - m_cachedReadPos <= m_mask + 1;
+    }
+
+    // Producer
+    alignas(64) std::atomic<std::size_t> m_writePos{ 0 };
+    std::size_t m_reservePos    = 0;
+    std::size_t m_cachedReadPos = 0;
+    std::atomic<uint64_t> m_droppedCount{ 0 };
+    std::atomic<bool> m_retired{ false };
+
+    // Consumer
+    alignas(64) std::atomic<std::size_t> m_readPos{ 0 };
+    uint64_t m_reportedDropCount = 0;
+
+    alignas(64) std::size_t m_mask = 0;
+    std::unique_ptr<std::byte[]> m_pData;
+};
+} // namespace detail
+
+template <typename... Args>
+using LogFormat = detail::LogFormatString<std::type_identity_t<Args>...>;
+
 class Logger
 {
 public:
@@ -27,6 +627,23 @@ public:
         None  = 4,
     };
 
+    // Log calls below this level are compiled out by the log macros
+    static constexpr Level CompiledLevel = static_cast<Level>(APH_LOG_LEVEL_MIN);
+
+    // What an asynchronous logger does with a message when the ring of the calling thread is full
+    enum class OverflowPolicy : uint8_t
+    {
+        Drop, // the message is lost and counted, see getDroppedCount()
+        Block, // the caller writes out the queued messages itself until there is room
+    };
+
+    struct AsyncOptions
+    {
+        bool enabled                  = false;
+        std::size_t ringSize          = 64 * 1024; // bytes per logging thread
+        OverflowPolicy overflowPolicy = OverflowPolicy::Drop;
+    };
+
     // Sink interface using type erasure instead of templates
     class ISink
     {
@@ -78,16 +695,20 @@ public:
 
     // Log message methods - keep templates in header but use PIMPL for implementation
     template <typename... Args>
-    void debug(std::string_view fmt, Args&&... args);
+    void debug(LogFormat<Args...> fmt, Args&&... args);
 
     template <typename... Args>
-    void info(std::string_view fmt, Args&&... args);
+    void info(LogFormat<Args...> fmt, Args&&... args);
 
     template <typename... Args>
-    void warn(std::string_view fmt, Args&&... args);
+    void warn(LogFormat<Args...> fmt, Args&&... args);
 
     template <typename... Args>
-    void error(std::string_view fmt, Args&&... args);
+    void error(LogFormat<Args...> fmt, Args&&... args);
+
+    // Logs a message with the tag literal in front of it, nothing is formatted below the log level
+    template <typename... Args>
+    void log(Level level, std::string_view tag, LogFormat<Args...> fmt, Args&&... args);
 
     // Configuration methods
     void setLogLevel(Level level);
@@ -96,9 +717,31 @@ public:
     void setEnableColor(bool value);
     void setEnableLineInfo(bool value);
 
+    // Moves formatting and writing to a background thread. Callers copy the format string pointer and the
+    // arguments into a ring of their thread.
+    void setAsync(const AsyncOptions& options);
+
+    // Writes out what is still queued and everything logged after it right away, for the crash handler
+    void flushOnCrash();
+
+    // Writes every message to a binary log file as well, see common/binaryLog.h. Records keep their arguments
+    // unformatted and refer to their format string, written once per file, the log_decoder tool turns the file
+    // into text or JSON. An empty name closes the file.
+    void setBinaryLogFile(const std::string& filename);
+
+    // Formats messages for the text sinks, on by default. Logging to a binary file only, nothing is formatted.
+    void setTextOutput(bool enabled);
+
     // State queries
     [[nodiscard]] auto isInitialized() const -> bool;
     [[nodiscard]] auto getEnableLineInfo() const -> bool;
+    [[nodiscard]] auto isAsync() const -> bool;
+    [[nodiscard]] auto getDroppedCount() const -> uint64_t;
+
+    [[nodiscard]] auto isEnabled(Level level) const -> bool
+    {
+        return level >= m_logLevel.load(std::memory_order_relaxed);
+    }
 
     // Sink management
     template <LogSinkConcept Sink>
@@ -110,15 +753,29 @@ private:
 
     // Private helper method for formatting log messages
     template <typename... Args>
-    void logFormatted(Level level, std::string_view fmt, Args&&... args);
+    void logFormatted(Level level, std::string_view tag, std::string_view fmt, const Args&... args);
+
+    // Queues the record on the ring of the calling thread, false if it is too large for one
+    template <typename... Ts>
+    auto logAsync(Level level, const char* tag, const char* fmt, const Ts&... args) -> bool;
+
+    // Encodes the record like logAsync() does and writes it to the binary log file
+    template <typename... Ts>
+    void logBinary(Level level, const char* tag, const char* fmt, const Ts&... args);
+    void writeBinary(const detail::LogRecordHeader& header, const std::byte* pArgs);
+
+    // Async helpers, the ring is created on the first message of a thread
+    auto getThreadRing() -> detail::LogRing*;
+    auto reserveOnOverflow(detail::LogRing* pRing, std::size_t size) -> std::byte*;
+    void drainQueued();
 
     // Helper methods for templates
     template <typename T>
-    auto toFormat(const T& val) -> T;
+    static auto toFormat(const T& val);
     static auto toFormat(const char* val) -> const char*;
     static auto toFormat(const std::string& val) -> const char*;
     static auto toFormat(const std::filesystem::path& val) -> const char*;
-    static auto toFormat(std::string_view val) -> const char*;
+    static auto toFormat(std::string_view val) -> std::string_view;
 
     // Function for sink management
     void addSinkWrapper(std::function<void(const std::string&)> writeFunc, std::function<void()> flushFunc,
@@ -126,68 +783,164 @@ private:
 
     // PIMPL implementation
     std::unique_ptr<LoggerImpl> m_impl;
+
+    // Read on every call, outside of the implementation
+    std::atomic<Level> m_logLevel{ Level::Debug };
+    std::atomic<bool> m_async{ false };
+    std::atomic<bool> m_binaryOutput{ false };
+    std::atomic<bool> m_textOutput{ true };
 };
 
 template <typename T>
-inline auto Logger::toFormat(const T& val) -> T
+inline auto Logger::toFormat(const T& val)
 {
-    return val;
+    // Strings that aren't std::string, like Vulkan's fixed size name arrays, are passed on as views
+    if constexpr (std::is_class_v<T> && std::is_convertible_v<const T&, std::string_view>)
+    {
+        return std::string_view{ val };
+    }
+    else
+    {
+        return val;
+    }
 }
 
 // Required template implementations
 template <typename... Args>
-inline void Logger::debug(std::string_view fmt, Args&&... args)
+inline void Logger::debug(LogFormat<Args...> fmt, Args&&... args)
 {
-    logFormatted(Level::Debug, fmt, std::forward<Args>(args)...);
+    log(Level::Debug, "", fmt, std::forward<Args>(args)...);
 }
 
 template <typename... Args>
-inline void Logger::info(std::string_view fmt, Args&&... args)
+inline void Logger::info(LogFormat<Args...> fmt, Args&&... args)
 {
-    logFormatted(Level::Info, fmt, std::forward<Args>(args)...);
+    log(Level::Info, "", fmt, std::forward<Args>(args)...);
 }
 
 template <typename... Args>
-inline void Logger::warn(std::string_view fmt, Args&&... args)
+inline void Logger::warn(LogFormat<Args...> fmt, Args&&... args)
 {
-    logFormatted(Level::Warn, fmt, std::forward<Args>(args)...);
+    log(Level::Warn, "", fmt, std::forward<Args>(args)...);
 }
 
 template <typename... Args>
-inline void Logger::error(std::string_view fmt, Args&&... args)
+inline void Logger::error(LogFormat<Args...> fmt, Args&&... args)
 {
-    logFormatted(Level::Error, fmt, std::forward<Args>(args)...);
+    log(Level::Error, "", fmt, std::forward<Args>(args)...);
 }
 
 template <typename... Args>
-inline void Logger::logFormatted(Level level, std::string_view fmt, Args&&... args)
+inline void Logger::log(Level level, std::string_view tag, LogFormat<Args...> fmt, Args&&... args)
 {
-    constexpr size_t kBufferSize = 4096;
-    aph::SmallVector<char, kBufferSize> buffer(kBufferSize);
-
-    int result = std::snprintf(buffer.data(), kBufferSize, fmt.data(), toFormat(std::forward<Args>(args))...);
+    if (!isEnabled(level))
+    {
+        return;
+    }
 
-    std::string message;
-    if (result >= 0)
+    if (m_async.load(std::memory_order_acquire))
     {
-        if (static_cast<size_t>(result) < kBufferSize)
+        if (logAsync(level, tag.data(), fmt.get().data(), toFormat(args)...))
         {
-            message = buffer.data();
-        }
-        else
-        {
-            // Resize and try again
-            buffer.resize(result + 1);
-            std::snprintf(buffer.data(), buffer.size(), fmt.data(), toFormat(std::forward<Args>(args))...);
-            message = buffer.data();
+            return;
         }
+        // Keep the order of the thread's messages for the one that is written directly
+        drainQueued();
     }
-    else
+    if (m_binaryOutput.load(std::memory_order_relaxed))
+    {
+        logBinary(level, tag.data(), fmt.get().data(), toFormat(args)...);
+    }
+    if (m_textOutput.load(std::memory_order_relaxed))
+    {
+        logFormatted(level, tag, fmt.get(), args...);
+    }
+}
+
+template <typename... Ts>
+inline auto Logger::logAsync(Level level, const char* tag, const char* fmt, const Ts&... args) -> bool
+{
+    const std::size_t argBytes = (std::size_t{ 0 } + ... + detail::LogArgCodec<detail::LogArgType<Ts>>::getSize(args));
+    const std::size_t size     = detail::LogRing::getRecordSize(argBytes);
+
+    detail::LogRing* pRing = getThreadRing();
+    if (size > pRing->getMaxRecordSize())
+    {
+        return false;
+    }
+
+    std::byte* pRecord = pRing->tryReserve(size);
+    if (!pRecord && !(pRecord = reserveOnOverflow(pRing, size)))
+    {
+        return true;
+    }
+
+    auto* pHeader = new (pRecord) detail::LogRecordHeader{ detail::makeLogRecordHeader<detail::LogArgType<Ts>...>(
+        static_cast<uint8_t>(level), tag, fmt, size, argBytes) };
+    [[maybe_unused]] std::byte* pArgs = reinterpret_cast<std::byte*>(pHeader + 1);
+    ((pArgs = detail::LogArgCodec<detail::LogArgType<Ts>>::encode(pArgs, args)), ...);
+    pRing->commit();
+    return true;
+}
+
+template <typename... Ts>
+inline void Logger::logBinary(Level level, const char* tag, const char* fmt, const Ts&... args)
+{
+    const std::size_t argBytes = (std::size_t{ 0 } + ... + detail::LogArgCodec<detail::LogArgType<Ts>>::getSize(args));
+    SmallVector<std::byte, 256> buffer;
+    buffer.resize_for_overwrite(argBytes);
+
+    [[maybe_unused]] std::byte* pArgs = buffer.data();
+    ((pArgs = detail::LogArgCodec<detail::LogArgType<Ts>>::encode(pArgs, args)), ...);
+    writeBinary(detail::makeLogRecordHeader<detail::LogArgType<Ts>...>(static_cast<uint8_t>(level), tag, fmt,
+                                                                          sizeof(detail::LogRecordHeader), argBytes),
+                buffer.data());
+}
+
+template <typename... Args>
+inline void Logger::logFormatted(Level level, std::string_view tag, std::string_view fmt, const Args&... args)
+{
+    constexpr size_t kBufferSize = 4096;
+    // snprintf writes the buffer, no need to zero it first
+    aph::SmallVector<char, kBufferSize> buffer;
+    buffer.resize_for_overwrite(kBufferSize);
+
+    // Tags are short literals, the message goes right behind it
+    const std::size_t tagLength = tag.size();
+    std::memcpy(buffer.data(), tag.data(), tagLength);
+
+    // printf can't take views, they are formatted from a terminated copy like the queued records
+    if constexpr ((std::is_same_v<decltype(toFormat(args)), std::string_view> || ...))
     {
-        message = "Error formatting log message";
+        const std::size_t argBytes =
+            (std::size_t{ 0 } + ... + detail::LogArgCodec<detail::LogArgType<decltype(toFormat(args))>>::getSize(
+                                          toFormat(args)));
+        SmallVector<std::byte, 256> encoded;
+        encoded.resize_for_overwrite(argBytes);
+        std::byte* pArgs = encoded.data();
+        ((pArgs = detail::LogArgCodec<detail::LogArgType<decltype(toFormat(args))>>::encode(pArgs, toFormat(args))),
+         ...);
+
+        std::string message{ tag };
+        detail::formatLogRecord<detail::LogArgType<decltype(toFormat(args))>...>(message, fmt.data(), encoded.data());
+        logImpl(level, message);
+        return;
     }
 
-    logImpl(level, message);
+    int result = std::snprintf(buffer.data() + tagLength, kBufferSize - tagLength, fmt.data(), toFormat(args)...);
+    if (result < 0)
+    {
+        logImpl(level, "Error formatting log message");
+        return;
+    }
+
+    if (tagLength + result >= kBufferSize)
+    {
+        // Resize and try again
+        buffer.resize_for_overwrite(tagLength + result + 1);
+        std::snprintf(buffer.data() + tagLength, result + 1, fmt.data(), toFormat(args)...);
+    }
+    logImpl(level, std::string_view{ buffer.data(), tagLength + result });
 }
 
 template <LogSinkConcept Sink>
@@ -232,8 +985,30 @@ inline void Logger::addSink(Sink&& sink, bool isFileSink)
         isFileSink);
 }
 
-// Helper function for getting the active logger from GlobalManager
-auto getActiveLogger() -> Logger*;
+namespace detail
+{
+inline std::atomic<Logger*> g_pActiveLogger{ nullptr };
+} // namespace detail
+
+// Looks the logger up in GlobalManager, setting it up on first use
+auto findActiveLogger() -> Logger*;
+
+// Logger the log macros write to. GlobalManager sets it along with its logger, so a log call costs a load
+// instead of a subsystem lookup.
+inline auto getActiveLogger() -> Logger*
+{
+    if (auto* pLogger = detail::g_pActiveLogger.load(std::memory_order_acquire)) [[likely]]
+    {
+        return pLogger;
+    }
+    return findActiveLogger();
+}
+
+// The logger must stay alive until it has been deactivated
+inline void setActiveLogger(Logger* pLogger)
+{
+    detail::g_pActiveLogger.store(pLogger, std::memory_order_release);
+}
 
 } // namespace aph
 
@@ -245,46 +1020,42 @@ inline void LOG_FLUSH()
     }
 }
 
-#define GENERATE_LOG_FUNCS(TAG)                                                  \
-    template <typename... Args>                                                  \
-    APH_ALWAYS_INLINE void TAG##_LOG_DEBUG(std::string_view fmt, Args&&... args) \
-    {                                                                            \
-        if (auto* logger = ::aph::getActiveLogger())                             \
-        {                                                                        \
-            std::string combined = std::format("[{}] {}", #TAG, fmt);            \
-            logger->debug(combined, std::forward<Args>(args)...);                \
-        }                                                                        \
-    }                                                                            \
-    template <typename... Args>                                                  \
-    APH_ALWAYS_INLINE void TAG##_LOG_WARN(std::string_view fmt, Args&&... args)  \
-    {                                                                            \
-        if (auto* logger = ::aph::getActiveLogger())                             \
-        {                                                                        \
-            std::string combined = std::format("[{}] {}", #TAG, fmt);            \
-            logger->warn(combined, std::forward<Args>(args)...);                 \
-        }                                                                        \
-    }                                                                            \
-    template <typename... Args>                                                  \
-    APH_ALWAYS_INLINE void TAG##_LOG_INFO(std::string_view fmt, Args&&... args)  \
-    {                                                                            \
-        if (auto* logger = ::aph::getActiveLogger())                             \
-        {                                                                        \
-            std::string combined = std::format("[{}] {}", #TAG, fmt);            \
-            logger->info(combined, std::forward<Args>(args)...);                 \
-        }                                                                        \
-    }                                                                            \
-    template <typename... Args>                                                  \
-    APH_ALWAYS_INLINE void TAG##_LOG_ERR(std::string_view fmt, Args&&... args)   \
-    {                                                                            \
-        if (auto* logger = ::aph::getActiveLogger())                             \
-        {                                                                        \
-            std::string combined = std::format("[{}] {}", #TAG, fmt);            \
-            logger->error(combined, std::forward<Args>(args)...);                \
-            logger->flush();                                                     \
-        }                                                                        \
-    }
-
-GENERATE_LOG_FUNCS(CM)
-GENERATE_LOG_FUNCS(VK)
-GENERATE_LOG_FUNCS(MM)
-GENERATE_LOG_FUNCS(APH)
+// Logs with the tag in front of the message. Calls below Logger::CompiledLevel compile to nothing and calls below
+// the runtime level stop at the level check, neither evaluates its arguments. Errors flush the logger.
+#define APH_LOG_TAGGED(TAG, LEVEL, ...)                                                                               \
+    do                                                                                                                \
+    {                                                                                                                 \
+        if constexpr (::aph::Logger::Level::LEVEL >= ::aph::Logger::CompiledLevel)                                    \
+        {                                                                                                             \
+            if (auto* pActiveLogger = ::aph::getActiveLogger();                                                       \
+                pActiveLogger && pActiveLogger->isEnabled(::aph::Logger::Level::LEVEL))                               \
+            {                                                                                                         \
+                pActiveLogger->log(::aph::Logger::Level::LEVEL, "[" #TAG "] ", __VA_ARGS__);                          \
+                if constexpr (::aph::Logger::Level::LEVEL == ::aph::Logger::Level::Error)                             \
+                {                                                                                                     \
+                    pActiveLogger->flush();                                                                           \
+                }                                                                                                     \
+            }                                                                                                         \
+        }                                                                                                             \
+    } while (0)
+
+// Every tag defines its four log macros like these
+#define CM_LOG_DEBUG(...) APH_LOG_TAGGED(CM, Debug, __VA_ARGS__)
+#define CM_LOG_INFO(...)  APH_LOG_TAGGED(CM, Info, __VA_ARGS__)
+#define CM_LOG_WARN(...)  APH_LOG_TAGGED(CM, Warn, __VA_ARGS__)
+#define CM_LOG_ERR(...)   APH_LOG_TAGGED(CM, Error, __VA_ARGS__)
+
+#define VK_LOG_DEBUG(...) APH_LOG_TAGGED(VK, Debug, __VA_ARGS__)
+#define VK_LOG_INFO(...)  APH_LOG_TAGGED(VK, Info, __VA_ARGS__)
+#define VK_LOG_WARN(...)  APH_LOG_TAGGED(VK, Warn, __VA_ARGS__)
+#define VK_LOG_ERR(...)   APH_LOG_TAGGED(VK, Error, __VA_ARGS__)
+
+#define MM_LOG_DEBUG(...) APH_LOG_TAGGED(MM, Debug, __VA_ARGS__)
+#define MM_LOG_INFO(...)  APH_LOG_TAGGED(MM, Info, __VA_ARGS__)
+#define MM_LOG_WARN(...)  APH_LOG_TAGGED(MM, Warn, __VA_ARGS__)
+#define MM_LOG_ERR(...)   APH_LOG_TAGGED(MM, Error, __VA_ARGS__)
+
+#define APH_LOG_DEBUG(...) APH_LOG_TAGGED(APH, Debug, __VA_ARGS__)
+#define APH_LOG_INFO(...)  APH_LOG_TAGGED(APH, Info, __VA_ARGS__)
+#define APH_LOG_WARN(...)  APH_LOG_TAGGED(APH, Warn, __VA_ARGS__)
+#define APH_LOG_ERR(...)   APH_LOG_TAGGED(APH, Error, __VA_ARGS__)
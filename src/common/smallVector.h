@@ -1,161 +1,772 @@
 #pragma once
 
+#include <algorithm>
+#include <cassert>
+#include <compare>
 #include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
 #include <memory>
+#include <new>
+#include <stdexcept>
 #include <type_traits>
-#include <vector>
+#include <utility>
 
 namespace aph
 {
+// Types whose objects can be moved to another address with memcpy, leaving nothing to destroy behind. Trivially
+// copyable types qualify, specialize this for types that are safe to memcpy despite a non-trivial move.
+template <typename T>
+struct IsTriviallyRelocatable : std::is_trivially_copyable<T>
+{
+};
+
+template <typename T>
+struct IsTriviallyRelocatable<std::unique_ptr<T>> : std::true_type
+{
+};
 
-template <typename T, size_t MaxSize = 8, typename NonReboundT = T>
-struct SmallBufferVectorAllocator
+// Inline capacity used when none is given. Deliberately not derived from sizeof(T), naming SmallVector<T> would
+// otherwise need T to be complete.
+constexpr std::size_t SmallVectorDefaultCapacity = 8;
+
+// std::vector replacement that stores up to N elements inside the object. The header is a pointer plus 32 bit size
+// and capacity, 16 bytes on 64 bit targets, followed by the inline storage.
+//
+// Moving a heap backed vector takes its buffer. Inline elements, and every element when the buffer grows, are
+// relocated with memcpy for trivially relocatable types and moved otherwise. Iterators are plain pointers.
+template <typename T, std::size_t N = SmallVectorDefaultCapacity>
+class SmallVector
 {
-    alignas(alignof(T)) std::byte m_smallBuffer[MaxSize * sizeof(T)];
-    std::allocator<T> m_alloc{};
-    bool m_smallBufferUsed = false;
+public:
+    using value_type             = T;
+    using size_type              = std::size_t;
+    using difference_type        = std::ptrdiff_t;
+    using reference              = T&;
+    using const_reference        = const T&;
+    using pointer                = T*;
+    using const_pointer          = const T*;
+    using iterator               = T*;
+    using const_iterator         = const T*;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
-    using value_type = T;
-    // we have to set this three values, as they are responsible for the correct handling of the move assignment
-    // operator
-    using propagate_on_container_move_assignment = std::false_type;
-    using propagate_on_container_swap            = std::false_type;
-    using is_always_equal                        = std::false_type;
+    static constexpr size_type InlineCapacity = N;
 
-    constexpr SmallBufferVectorAllocator() noexcept = default;
+    static_assert(N <= std::numeric_limits<uint32_t>::max());
 
-    template <class U>
-    constexpr SmallBufferVectorAllocator(const SmallBufferVectorAllocator<U, MaxSize, NonReboundT>&) noexcept
+    SmallVector() noexcept
+        : m_pData(getInlineData())
+        , m_size(0)
+        , m_capacity(N)
     {
     }
 
-    template <class U>
-    struct rebind
+    explicit SmallVector(size_type count)
+        : SmallVector()
     {
-        typedef SmallBufferVectorAllocator<U, MaxSize, NonReboundT> other;
-    };
+        resize(count);
+    }
 
-    // don't copy the small buffer for the copy/move constructors, as the copying is done through the vector
-    constexpr SmallBufferVectorAllocator(const SmallBufferVectorAllocator& other) noexcept
-        : m_smallBufferUsed(other.m_smallBufferUsed)
+    SmallVector(size_type count, const T& value)
+        : SmallVector()
     {
+        assign(count, value);
     }
 
-    constexpr SmallBufferVectorAllocator& operator=(const SmallBufferVectorAllocator& other) noexcept
+    template <std::input_iterator InputIt>
+    SmallVector(InputIt first, InputIt last)
+        : SmallVector()
     {
-        m_smallBufferUsed = other.m_smallBufferUsed;
+        assign(first, last);
+    }
+
+    SmallVector(std::initializer_list<T> init)
+        : SmallVector()
+    {
+        assign(init.begin(), init.end());
+    }
+
+    SmallVector(const SmallVector& other)
+        : SmallVector()
+    {
+        assign(other.begin(), other.end());
+    }
+
+    SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T> ||
+                                              IsTriviallyRelocatable<T>::value)
+        : SmallVector()
+    {
+        takeFrom(other);
+    }
+
+    ~SmallVector()
+    {
+        std::destroy_n(m_pData, m_size);
+        freeBuffer();
+    }
+
+    SmallVector& operator=(const SmallVector& other)
+    {
+        if (this != &other)
+        {
+            assign(other.begin(), other.end());
+        }
         return *this;
     }
 
-    constexpr SmallBufferVectorAllocator(SmallBufferVectorAllocator&&) noexcept
+    SmallVector& operator=(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T> ||
+                                                         IsTriviallyRelocatable<T>::value)
     {
+        if (this != &other)
+        {
+            clear();
+            freeBuffer();
+            m_pData    = getInlineData();
+            m_capacity = N;
+            takeFrom(other);
+        }
+        return *this;
     }
 
-    constexpr SmallBufferVectorAllocator& operator=(const SmallBufferVectorAllocator&&) noexcept
+    SmallVector& operator=(std::initializer_list<T> init)
     {
+        assign(init.begin(), init.end());
         return *this;
     }
 
-    [[nodiscard]] constexpr T* allocate(const size_t n)
+    void assign(size_type count, const T& value)
     {
-        // when the allocator was rebound we don't want to use the small buffer
-        if constexpr (std::is_same_v<T, NonReboundT>)
+        if (count > capacity())
         {
-            if (n <= MaxSize)
+            // value may live in this vector, build the new buffer before letting go of the old one
+            SmallVector replacement;
+            replacement.reserve(count);
+            std::uninitialized_fill_n(replacement.m_pData, count, value);
+            replacement.m_size = static_cast<uint32_t>(count);
+            *this              = std::move(replacement);
+            return;
+        }
+
+        const size_type common = std::min(count, size());
+        std::fill_n(m_pData, common, value);
+        if (count > size())
+        {
+            std::uninitialized_fill_n(m_pData + size(), count - size(), value);
+        }
+        else
+        {
+            std::destroy(m_pData + count, end());
+        }
+        m_size = static_cast<uint32_t>(count);
+    }
+
+    template <std::input_iterator InputIt>
+    void assign(InputIt first, InputIt last)
+    {
+        clear();
+        if constexpr (std::forward_iterator<InputIt>)
+        {
+            const auto count = static_cast<size_type>(std::distance(first, last));
+            reserve(count);
+            std::uninitialized_copy(first, last, m_pData);
+            m_size = static_cast<uint32_t>(count);
+        }
+        else
+        {
+            for (; first != last; ++first)
             {
-                m_smallBufferUsed = true;
-                // as long as we use less memory than the small buffer, we return a pointer to it
-                return reinterpret_cast<T*>(&m_smallBuffer);
+                emplace_back(*first);
             }
         }
-        m_smallBufferUsed = false;
-        // otherwise use the default allocator
-        return m_alloc.allocate(n);
     }
 
-    constexpr void deallocate(void* p, const size_t n)
+    void assign(std::initializer_list<T> init)
     {
-        // we don't deallocate anything if the memory was allocated in small buffer
-        if (&m_smallBuffer != p)
-            m_alloc.deallocate(static_cast<T*>(p), n);
-        m_smallBufferUsed = false;
+        assign(init.begin(), init.end());
     }
 
-    // according to the C++ standard when propagate_on_container_move_assignment is set to false, the comparision
-    // operators are used to check if two allocators are equal. When they are not, an element wise move is done instead
-    // of just taking over the memory. For our implementation this means the comparision has to return false, when the
-    // small buffer is active
-    friend constexpr bool operator==(const SmallBufferVectorAllocator& lhs, const SmallBufferVectorAllocator& rhs)
+    reference at(size_type index)
     {
-        return !lhs.m_smallBufferUsed && !rhs.m_smallBufferUsed;
+        if (index >= size())
+        {
+            throw std::out_of_range("SmallVector::at");
+        }
+        return m_pData[index];
     }
 
-    friend constexpr bool operator!=(const SmallBufferVectorAllocator& lhs, const SmallBufferVectorAllocator& rhs)
+    const_reference at(size_type index) const
     {
-        return !(lhs == rhs);
+        if (index >= size())
+        {
+            throw std::out_of_range("SmallVector::at");
+        }
+        return m_pData[index];
     }
-};
 
-template <typename T, size_t N = 8>
-class SmallVector : public std::vector<T, SmallBufferVectorAllocator<T, N>>
-{
-public:
-    using vec = std::vector<T, SmallBufferVectorAllocator<T, N>>;
+    reference operator[](size_type index)
+    {
+        assert(index < size());
+        return m_pData[index];
+    }
 
-    // default initialize with the small buffer size
-    constexpr SmallVector() noexcept
+    const_reference operator[](size_type index) const
     {
-        vec::reserve(N);
+        assert(index < size());
+        return m_pData[index];
     }
 
-    SmallVector(const SmallVector&)            = default;
-    SmallVector& operator=(const SmallVector&) = default;
+    reference front()
+    {
+        assert(!empty());
+        return m_pData[0];
+    }
 
-    SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+    const_reference front() const
     {
-        if (other.size() <= N)
-            vec::reserve(N);
-        vec::operator=(std::move(other));
+        assert(!empty());
+        return m_pData[0];
     }
 
-    SmallVector& operator=(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+    reference back()
     {
-        if (other.size() <= N)
-            vec::reserve(N);
-        vec::operator=(std::move(other));
-        return *this;
+        assert(!empty());
+        return m_pData[m_size - 1];
     }
 
-    // use the default constructor first to reserve then construct the values
-    explicit SmallVector(size_t count)
-        : SmallVector()
+    const_reference back() const
     {
-        vec::resize(count);
+        assert(!empty());
+        return m_pData[m_size - 1];
     }
 
-    SmallVector(size_t count, const T& value)
-        : SmallVector()
+    T* data() noexcept
     {
-        vec::assign(count, value);
+        return m_pData;
     }
 
-    template <class InputIt>
-    SmallVector(InputIt first, InputIt last)
-        : SmallVector()
+    const T* data() const noexcept
     {
-        vec::insert(vec::begin(), first, last);
+        return m_pData;
     }
 
-    SmallVector(std::initializer_list<T> init)
-        : SmallVector()
+    iterator begin() noexcept
+    {
+        return m_pData;
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return m_pData;
+    }
+
+    const_iterator cbegin() const noexcept
+    {
+        return m_pData;
+    }
+
+    iterator end() noexcept
+    {
+        return m_pData + m_size;
+    }
+
+    const_iterator end() const noexcept
+    {
+        return m_pData + m_size;
+    }
+
+    const_iterator cend() const noexcept
+    {
+        return m_pData + m_size;
+    }
+
+    reverse_iterator rbegin() noexcept
+    {
+        return reverse_iterator{ end() };
+    }
+
+    const_reverse_iterator rbegin() const noexcept
+    {
+        return const_reverse_iterator{ end() };
+    }
+
+    const_reverse_iterator crbegin() const noexcept
+    {
+        return const_reverse_iterator{ end() };
+    }
+
+    reverse_iterator rend() noexcept
+    {
+        return reverse_iterator{ begin() };
+    }
+
+    const_reverse_iterator rend() const noexcept
+    {
+        return const_reverse_iterator{ begin() };
+    }
+
+    const_reverse_iterator crend() const noexcept
+    {
+        return const_reverse_iterator{ begin() };
+    }
+
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return m_size == 0;
+    }
+
+    size_type size() const noexcept
+    {
+        return m_size;
+    }
+
+    size_type capacity() const noexcept
+    {
+        return m_capacity;
+    }
+
+    static constexpr size_type max_size() noexcept
+    {
+        return std::numeric_limits<uint32_t>::max();
+    }
+
+    // True while the elements live in the inline storage
+    bool isInline() const noexcept
+    {
+        return m_pData == getInlineData();
+    }
+
+    void reserve(size_type newCapacity)
+    {
+        if (newCapacity > capacity())
+        {
+            reallocate(newCapacity);
+        }
+    }
+
+    // Moves the elements back into the inline storage when they fit, or into a heap buffer of the exact size
+    void shrink_to_fit()
+    {
+        if (isInline() || size() == capacity())
+        {
+            return;
+        }
+
+        T* pOld = m_pData;
+        if (size() <= N)
+        {
+            relocate(pOld, size(), getInlineData());
+            m_pData    = getInlineData();
+            m_capacity = N;
+        }
+        else
+        {
+            T* pNew = allocateBuffer(size());
+            relocate(pOld, size(), pNew);
+            m_pData    = pNew;
+            m_capacity = m_size;
+        }
+        std::free(pOld);
+    }
+
+    void clear() noexcept
+    {
+        std::destroy_n(m_pData, m_size);
+        m_size = 0;
+    }
+
+    iterator insert(const_iterator pos, const T& value)
+    {
+        return emplace(pos, value);
+    }
+
+    iterator insert(const_iterator pos, T&& value)
+    {
+        return emplace(pos, std::move(value));
+    }
+
+    iterator insert(const_iterator pos, size_type count, const T& value)
+    {
+        const size_type index = pos - begin();
+        if (count == 0)
+        {
+            return begin() + index;
+        }
+
+        // value may live in this vector
+        const T copy{ value };
+        T* pGap = openGap(index, count);
+        std::uninitialized_fill_n(pGap, count, copy);
+        m_size += static_cast<uint32_t>(count);
+        return pGap;
+    }
+
+    template <std::input_iterator InputIt>
+    iterator insert(const_iterator pos, InputIt first, InputIt last)
+    {
+        const size_type index = pos - begin();
+        if constexpr (std::forward_iterator<InputIt>)
+        {
+            const auto count = static_cast<size_type>(std::distance(first, last));
+            if (count == 0)
+            {
+                return begin() + index;
+            }
+            T* pGap = openGap(index, count);
+            std::uninitialized_copy(first, last, pGap);
+            m_size += static_cast<uint32_t>(count);
+            return pGap;
+        }
+        else
+        {
+            // Length unknown up front, append and rotate into place
+            const size_type oldSize = size();
+            for (; first != last; ++first)
+            {
+                emplace_back(*first);
+            }
+            std::rotate(begin() + index, begin() + oldSize, end());
+            return begin() + index;
+        }
+    }
+
+    iterator insert(const_iterator pos, std::initializer_list<T> init)
+    {
+        return insert(pos, init.begin(), init.end());
+    }
+
+    template <typename... Args>
+    iterator emplace(const_iterator pos, Args&&... args)
+    {
+        const size_type index = pos - begin();
+        if (index == size())
+        {
+            emplace_back(std::forward<Args>(args)...);
+            return begin() + index;
+        }
+
+        // The arguments may refer to elements that are about to move
+        T value(std::forward<Args>(args)...);
+        T* pGap = openGap(index, 1);
+        std::construct_at(pGap, std::move(value));
+        m_size++;
+        return pGap;
+    }
+
+    iterator erase(const_iterator pos)
+    {
+        return erase(pos, pos + 1);
+    }
+
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        T* pFirst = begin() + (first - begin());
+        T* pLast  = begin() + (last - begin());
+        if (pFirst != pLast)
+        {
+            T* pNewEnd = std::move(pLast, end(), pFirst);
+            std::destroy(pNewEnd, end());
+            m_size = static_cast<uint32_t>(pNewEnd - m_pData);
+        }
+        return pFirst;
+    }
+
+    void push_back(const T& value)
+    {
+        emplace_back(value);
+    }
+
+    void push_back(T&& value)
+    {
+        emplace_back(std::move(value));
+    }
+
+    template <typename... Args>
+    reference emplace_back(Args&&... args)
+    {
+        if (m_size == m_capacity) [[unlikely]]
+        {
+            return growAndEmplaceBack(std::forward<Args>(args)...);
+        }
+        T* pElement = std::construct_at(m_pData + m_size, std::forward<Args>(args)...);
+        m_size++;
+        return *pElement;
+    }
+
+    void pop_back()
+    {
+        assert(!empty());
+        m_size--;
+        std::destroy_at(m_pData + m_size);
+    }
+
+    void resize(size_type count)
     {
-        vec::insert(vec::begin(), init);
+        resizeImpl(count,
+                   [](T* pFirst, size_type n)
+                   {
+                       std::uninitialized_value_construct_n(pFirst, n);
+                   });
+    }
+
+    void resize(size_type count, const T& value)
+    {
+        // value may live in this vector, copy it before growing
+        const T copy{ value };
+        resizeImpl(count,
+                   [&copy](T* pFirst, size_type n)
+                   {
+                       std::uninitialized_fill_n(pFirst, n, copy);
+                   });
+    }
+
+    // Like resize() but leaves new elements of trivial types uninitialized, for buffers that are written next
+    void resize_for_overwrite(size_type count)
+    {
+        resizeImpl(count,
+                   [](T* pFirst, size_type n)
+                   {
+                       std::uninitialized_default_construct_n(pFirst, n);
+                   });
+    }
+
+    void swap(SmallVector& other) noexcept(std::is_nothrow_move_constructible_v<T> ||
+                                           IsTriviallyRelocatable<T>::value)
+    {
+        SmallVector tmp{ std::move(other) };
+        other = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+    friend void swap(SmallVector& a, SmallVector& b) noexcept(noexcept(a.swap(b)))
+    {
+        a.swap(b);
+    }
+
+    friend bool operator==(const SmallVector& lhs, const SmallVector& rhs)
+        requires std::equality_comparable<T>
+    {
+        return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+    friend auto operator<=>(const SmallVector& lhs, const SmallVector& rhs)
+        requires std::three_way_comparable<T>
+    {
+        return std::lexicographical_compare_three_way(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+private:
+    // Empty when N is 0, so that SmallVector<T, 0> is just the header
+    template <std::size_t Count, typename = void>
+    struct InlineStorage
+    {
+        alignas(T) std::byte bytes[Count * sizeof(T)];
+    };
+
+    template <typename Dummy>
+    struct InlineStorage<0, Dummy>
+    {
+    };
+
+    T* getInlineData() noexcept
+    {
+        if constexpr (N > 0)
+        {
+            return reinterpret_cast<T*>(m_inline.bytes);
+        }
+        else
+        {
+            return nullptr;
+        }
     }
 
-    friend void swap(SmallVector& a, SmallVector& b) noexcept
+    const T* getInlineData() const noexcept
     {
-        using std::swap;
-        swap(static_cast<vec&>(a), static_cast<vec&>(b));
+        return const_cast<SmallVector*>(this)->getInlineData();
     }
+
+    static T* allocateBuffer(size_type count)
+    {
+        if (count > max_size())
+        {
+            throw std::length_error("SmallVector is too large");
+        }
+        void* pBuffer = nullptr;
+        if constexpr (alignof(T) > alignof(std::max_align_t))
+        {
+            pBuffer = std::aligned_alloc(alignof(T), (count * sizeof(T) + alignof(T) - 1) & ~(alignof(T) - 1));
+        }
+        else
+        {
+            pBuffer = std::malloc(count * sizeof(T));
+        }
+        if (!pBuffer)
+        {
+            throw std::bad_alloc{};
+        }
+        return static_cast<T*>(pBuffer);
+    }
+
+    void freeBuffer() noexcept
+    {
+        if (!isInline())
+        {
+            std::free(m_pData);
+        }
+    }
+
+    // Moves count elements from pSrc to uninitialized pDst and ends their lifetime at pSrc
+    static void relocate(T* pSrc, size_type count, T* pDst)
+    {
+        if constexpr (IsTriviallyRelocatable<T>::value)
+        {
+            if (count > 0)
+            {
+                std::memcpy(static_cast<void*>(pDst), static_cast<const void*>(pSrc), count * sizeof(T));
+            }
+        }
+        else
+        {
+            for (size_type i = 0; i < count; i++)
+            {
+                std::construct_at(pDst + i, std::move_if_noexcept(pSrc[i]));
+            }
+            std::destroy_n(pSrc, count);
+        }
+    }
+
+    auto nextCapacity(size_type minCapacity) const -> size_type
+    {
+        const size_type grown = capacity() * 2;
+        return std::min(std::max(grown, minCapacity), max_size());
+    }
+
+    void reallocate(size_type newCapacity)
+    {
+        T* pNew = allocateBuffer(newCapacity);
+        relocate(m_pData, size(), pNew);
+        freeBuffer();
+        m_pData    = pNew;
+        m_capacity = static_cast<uint32_t>(newCapacity);
+    }
+
+    // Takes over the elements of other, which has to be empty and inline after the call
+    void takeFrom(SmallVector& other)
+    {
+        if (other.isInline())
+        {
+            relocate(other.m_pData, other.size(), m_pData);
+        }
+        else
+        {
+            m_pData          = other.m_pData;
+            m_capacity       = other.m_capacity;
+            other.m_pData    = other.getInlineData();
+            other.m_capacity = N;
+        }
+        m_size       = other.m_size;
+        other.m_size = 0;
+    }
+
+    template <typename... Args>
+    reference growAndEmplaceBack(Args&&... args)
+    {
+        // Construct first, the arguments may refer to elements of the old buffer
+        const size_type newCapacity = nextCapacity(size() + 1);
+        T* pNew                     = allocateBuffer(newCapacity);
+        try
+        {
+            std::construct_at(pNew + size(), std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            std::free(pNew);
+            throw;
+        }
+        relocate(m_pData, size(), pNew);
+        freeBuffer();
+        m_pData    = pNew;
+        m_capacity = static_cast<uint32_t>(newCapacity);
+        return m_pData[m_size++];
+    }
+
+    // Makes room for count elements at index and returns the uninitialized gap, the size is left to the caller
+    T* openGap(size_type index, size_type count)
+    {
+        assert(index <= size());
+        const size_type tailCount = size() - index;
+        if (size() + count > capacity())
+        {
+            const size_type newCapacity = nextCapacity(size() + count);
+            T* pNew                     = allocateBuffer(newCapacity);
+            relocate(m_pData, index, pNew);
+            relocate(m_pData + index, tailCount, pNew + index + count);
+            freeBuffer();
+            m_pData    = pNew;
+            m_capacity = static_cast<uint32_t>(newCapacity);
+            return m_pData + index;
+        }
+
+        T* pGap = m_pData + index;
+        if constexpr (IsTriviallyRelocatable<T>::value)
+        {
+            if (tailCount > 0)
+            {
+                std::memmove(static_cast<void*>(pGap + count), static_cast<const void*>(pGap), tailCount * sizeof(T));
+            }
+        }
+        else
+        {
+            // Back to front so that the source and destination ranges may overlap
+            for (size_type i = tailCount; i > 0; i--)
+            {
+                std::construct_at(pGap + count + i - 1, std::move(pGap[i - 1]));
+                std::destroy_at(pGap + i - 1);
+            }
+        }
+        return pGap;
+    }
+
+    template <typename ConstructFunc>
+    void resizeImpl(size_type count, ConstructFunc&& construct)
+    {
+        if (count < size())
+        {
+            std::destroy(m_pData + count, end());
+        }
+        else if (count > size())
+        {
+            reserve(count);
+            construct(m_pData + size(), count - size());
+        }
+        m_size = static_cast<uint32_t>(count);
+    }
+
+    T* m_pData;
+    uint32_t m_size;
+    uint32_t m_capacity;
+    [[no_unique_address]] InlineStorage<N> m_inline;
 };
+
+template <typename T, std::size_t N, typename U>
+auto erase(SmallVector<T, N>& vector, const U& value) -> std::size_t
+{
+    auto newEnd               = std::remove(vector.begin(), vector.end(), value);
+    const std::size_t removed = vector.end() - newEnd;
+    vector.erase(newEnd, vector.end());
+    return removed;
+}
+
+template <typename T, std::size_t N, typename Pred>
+auto erase_if(SmallVector<T, N>& vector, Pred pred) -> std::size_t
+{
+    auto newEnd               = std::remove_if(vector.begin(), vector.end(), pred);
+    const std::size_t removed = vector.end() - newEnd;
+    vector.erase(newEnd, vector.end());
+    return removed;
+}
 } // namespace aph
@@ -4,6 +4,7 @@
 #include "common/logger.h"
 #include "common/profiler.h"
 
+#include "allocator/allocator.h"
 #include "api/capture.h"
 #include "api/vulkan/device.h"
 #include "ui/ui.h"
@@ -215,6 +216,8 @@ auto Engine::initialize(const EngineConfig& config) -> Result
         // Create resource loader
         resourceLoaderCreateInfo                   = config.getResourceLoaderCreateInfo();
         resourceLoaderCreateInfo.pMaterialRegistry = m_pMaterialRegistry;
+        // Frames in flight may still read what the last frames used, keep it out of eviction
+        resourceLoaderCreateInfo.residency.protectedFrameCount = config.getMaxFrames() + 1;
         postDeviceGroup->addTask(
             [](const ResourceLoaderCreateInfo& createInfo, ResourceLoader** ppResourceLoader,
                vk::Device* pDevice) -> TaskType
@@ -317,6 +320,11 @@ void Engine::update()
     APH_PROFILER_SCOPE();
     m_frameCPUTime = m_timer.interval(TimerTag::eTimerTagFrame);
     m_timer.set(TimerTag::eTimerTagFrame);
+    m_pResourceLoader->updateResidency();
+    if (auto* pTracker = memory::getActiveAllocationTracker())
+    {
+        pTracker->nextFrame();
+    }
 }
 
 void Engine::render()
@@ -128,6 +128,12 @@ auto EngineConfig::setResourceForceUncached(bool value) -> EngineConfig&
     return *this;
 }
 
+auto EngineConfig::setResidencyBudgets(const ResidencyBudgets& budgets) -> EngineConfig&
+{
+    m_resourceLoaderCreateInfo.residency.budgets = budgets;
+    return *this;
+}
+
 auto EngineConfig::setUICreateInfo(const UICreateInfo& info) -> EngineConfig&
 {
     m_uiCreateInfo = info;
@@ -215,6 +221,11 @@ auto EngineConfig::getResourceForceUncached() const -> bool
     return m_resourceLoaderCreateInfo.forceUncached;
 }
 
+auto EngineConfig::getResidencyBudgets() const -> const ResidencyBudgets&
+{
+    return m_resourceLoaderCreateInfo.residency.budgets;
+}
+
 auto EngineConfig::getEnableDeviceDebug() const -> bool
 {
     return m_enableDeviceDebug;
@@ -36,6 +36,7 @@ public:
     auto setSwapChainCreateInfo(const vk::SwapChainCreateInfo& info) -> EngineConfig&;
     auto setResourceLoaderCreateInfo(const ResourceLoaderCreateInfo& info) -> EngineConfig&;
     auto setResourceForceUncached(bool value) -> EngineConfig&;
+    auto setResidencyBudgets(const ResidencyBudgets& budgets) -> EngineConfig&;
     auto setUICreateInfo(const UICreateInfo& info) -> EngineConfig&;
     auto setEnableDeviceDebug(bool value) -> EngineConfig&;
     auto setHighDPIEnabled(bool value) -> EngineConfig&;
@@ -54,6 +55,7 @@ public:
     auto getResourceLoaderCreateInfo() const -> const ResourceLoaderCreateInfo&;
     auto getUICreateInfo() const -> const UICreateInfo&;
     auto getResourceForceUncached() const -> bool;
+    auto getResidencyBudgets() const -> const ResidencyBudgets&;
     auto getEnableDeviceDebug() const -> bool;
     auto isHighDPIEnabled() const -> bool;
 
@@ -1,15 +1,28 @@
 #include "eventManager.h"
+#include "event.h"
 
-void aph::EventManager::processAll()
+aph::EventManager::EventManager()
 {
-    for (auto& [_, handler] : m_eventDataMap)
-    {
-        handler->process();
-    }
+    // Raw mouse input can produce thousands of moves per frame
+    registerEventType<MouseMoveEvent>(4096);
+    registerEventType<MouseButtonEvent>();
+    registerEventType<KeyboardEvent>();
+    registerEventType<WindowResizeEvent>();
+    registerEventType<DPIChangeEvent>();
 }
 
-auto aph::EventManager::nextTypeID() -> TypeID
+aph::EventManager::~EventManager() = default;
+
+void aph::EventManager::processAll()
 {
-    static TypeID next = 0;
-    return next++;
+    std::lock_guard<std::mutex> lock{ m_processMutex };
+
+    const uint32_t channelLimit = m_channelLimit.load(std::memory_order_acquire);
+    for (uint32_t typeIndex = 0; typeIndex < channelLimit; ++typeIndex)
+    {
+        if (ChannelBase* pChannel = m_channels[typeIndex].load(std::memory_order_acquire))
+        {
+            pChannel->process();
+        }
+    }
 }
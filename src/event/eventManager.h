@@ -1,121 +1,250 @@
 #pragma once
 
-#include "common/hash.h"
+#include "threads/mpscQueue.h"
 #include "threads/taskManager.h"
 #include <mutex>
 
 namespace aph
 {
+namespace detail
+{
+// Dense index of an event type, shared by all event managers
+struct EventTypeIndex
+{
+    template <typename TEvent>
+    static auto get() -> uint32_t
+    {
+        static const uint32_t index = s_nextIndex.fetch_add(1, std::memory_order_relaxed);
+        return index;
+    }
 
+    inline static std::atomic<uint32_t> s_nextIndex{ 0 };
+};
+} // namespace detail
+
+// Queues events from any thread and dispatches them to their handlers in processAll().
+//
+// Every event type has a channel found by its type index, so pushing an event of a registered type is an array
+// lookup and a push into the lock-free queue of the channel. processAll() drains each queue into a batch and passes
+// it to the handlers as one span, events pushed meanwhile, by handlers too, go to the next batch. When a queue is
+// full the events spill into a locked buffer until the next processAll(), the order of each producer is kept.
+// Handlers registered with registerEvent() are added at the start of the next processAll().
 class EventManager
 {
+public:
+    // The built-in event types are registered on construction. Others can be registered up front with a queue size
+    // of their own, or get the default one on first use.
+    static constexpr uint32_t MaxEventTypes       = 64;
+    static constexpr std::size_t DefaultQueueSize = 1024;
+
     template <typename TEvent>
-    struct EventData
-    {
-        EventData()                                    = default;
-        EventData(const EventData&)                    = delete;
-        EventData(EventData&&)                         = default;
-        auto operator=(const EventData&) -> EventData& = delete;
-        auto operator=(EventData&&) -> EventData&      = default;
+    using BatchHandler = std::function<void(std::span<const TEvent>)>;
 
-        std::queue<TEvent> m_events;
-        SmallVector<std::function<bool(const TEvent&)>> m_handlers;
+    EventManager();
+    ~EventManager();
 
-        void process()
-        {
-            auto& events   = m_events;
-            auto& handlers = m_handlers;
+    EventManager(const EventManager&)            = delete;
+    EventManager& operator=(const EventManager&) = delete;
 
-            while (!events.empty())
-            {
-                auto e = events.front();
-                events.pop();
-                for (const auto& cb : handlers)
-                {
-                    cb(e);
-                }
-            }
-        }
-    };
+    template <typename TEvent>
+    void registerEventType(std::size_t queueSize = DefaultQueueSize);
 
-    struct TypeErased
+    // Thread safe
+    template <typename TEvent>
+    void pushEvent(const TEvent& e);
+
+    // Thread safe, the handler is called once per event
+    template <typename TEvent>
+    void registerEvent(std::function<bool(const TEvent&)>&& func);
+
+    // Thread safe, the handler is called once per batch with the events in push order
+    template <typename TEvent>
+    void registerBatchEvent(BatchHandler<TEvent>&& func);
+
+    // Only one thread dispatches at a time, concurrent calls wait for each other
+    void processAll();
+
+private:
+    struct ChannelBase
     {
-        virtual ~TypeErased()  = default;
+        virtual ~ChannelBase()  = default;
         virtual void process() = 0;
     };
 
     template <typename TEvent>
-    struct TypedEventData : TypeErased
+    struct Channel : ChannelBase
     {
-        EventData<TEvent> data;
-
-        void process() override
+        explicit Channel(std::size_t queueSize)
+            : queue(queueSize)
         {
-            data.process();
         }
+
+        void push(TEvent&& e);
+        void process() override;
+
+        MPSCQueue<TEvent> queue;
+        SmallVector<TEvent> batch;
+        SmallVector<BatchHandler<TEvent>> handlers;
+
+        // Takes the events that did not fit into the queue, pushes go here while it is not empty
+        std::mutex spillMutex;
+        SmallVector<TEvent> spill;
+        std::atomic<bool> spilling{ false };
+
+        // Guarded by the registration mutex of the manager
+        SmallVector<BatchHandler<TEvent>> pendingHandlers;
+        std::atomic<bool> hasPendingHandlers{ false };
+        std::mutex* pRegistrationMutex = nullptr;
     };
 
-public:
-    EventManager() = default;
     template <typename TEvent>
-    void pushEvent(const TEvent& e);
+    auto getChannel() -> Channel<TEvent>&;
 
     template <typename TEvent>
-    void registerEvent(std::function<bool(const TEvent&)>&& func);
+    auto createChannel(uint32_t typeIndex, std::size_t queueSize) -> Channel<TEvent>&;
 
-    void processAll();
+    std::array<std::atomic<ChannelBase*>, MaxEventTypes> m_channels{};
+    std::atomic<uint32_t> m_channelLimit{ 0 };
+    SmallVector<std::unique_ptr<ChannelBase>> m_channelStorage;
+    std::mutex m_registrationMutex;
+    std::mutex m_processMutex;
+};
 
-private:
-    std::mutex m_dataMapMutex;
+template <typename TEvent>
+inline void EventManager::Channel<TEvent>::push(TEvent&& e)
+{
+    if (!spilling.load(std::memory_order_acquire) && queue.tryPush(std::move(e)))
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock{ spillMutex };
+    spill.push_back(std::move(e));
+    spilling.store(true, std::memory_order_release);
+}
 
-    using TypeID = size_t;
+template <typename TEvent>
+inline void EventManager::Channel<TEvent>::process()
+{
+    if (hasPendingHandlers.load(std::memory_order_acquire))
+    {
+        std::lock_guard<std::mutex> lock{ *pRegistrationMutex };
+        for (auto& handler : pendingHandlers)
+        {
+            handlers.push_back(std::move(handler));
+        }
+        pendingHandlers.clear();
+        hasPendingHandlers.store(false, std::memory_order_relaxed);
+    }
 
-    template <typename T>
-    static auto getTypeID() -> TypeID;
+    const auto collect = [this](TEvent&& e)
+    {
+        batch.push_back(std::move(e));
+    };
 
-    static auto nextTypeID() -> TypeID;
+    if (!spilling.load(std::memory_order_acquire))
+    {
+        queue.consume(collect);
+    }
+    else
+    {
+        // The spilled events of a producer are newer than everything it got into the queue
+        std::lock_guard<std::mutex> lock{ spillMutex };
+        queue.consumeAll(collect);
+        for (auto& e : spill)
+        {
+            batch.push_back(std::move(e));
+        }
+        spill.clear();
+        spilling.store(false, std::memory_order_release);
+    }
 
-    HashMap<TypeID, std::unique_ptr<TypeErased>> m_eventDataMap;
+    if (!batch.empty())
+    {
+        const std::span<const TEvent> events{ batch.data(), batch.size() };
+        for (const auto& handler : handlers)
+        {
+            handler(events);
+        }
+        batch.clear();
+    }
+}
 
-    template <typename TEvent>
-    auto getEventData() -> EventData<TEvent>&;
-};
+template <typename TEvent>
+inline auto EventManager::createChannel(uint32_t typeIndex, std::size_t queueSize) -> Channel<TEvent>&
+{
+    auto pChannel                = std::make_unique<Channel<TEvent>>(queueSize);
+    pChannel->pRegistrationMutex = &m_registrationMutex;
+    Channel<TEvent>& channel     = *pChannel;
+    m_channelStorage.push_back(std::move(pChannel));
+
+    m_channels[typeIndex].store(&channel, std::memory_order_release);
+    if (typeIndex >= m_channelLimit.load(std::memory_order_relaxed))
+    {
+        m_channelLimit.store(typeIndex + 1, std::memory_order_release);
+    }
+    return channel;
+}
 
 template <typename TEvent>
-inline auto EventManager::getEventData() -> EventData<TEvent>&
+inline auto EventManager::getChannel() -> Channel<TEvent>&
 {
-    auto typeID = getTypeID<TEvent>();
-    auto it     = m_eventDataMap.find(typeID);
+    const uint32_t typeIndex = detail::EventTypeIndex::get<TEvent>();
+    APH_ASSERT(typeIndex < MaxEventTypes && "Too many event types");
 
-    if (it == m_eventDataMap.end())
+    if (ChannelBase* pChannel = m_channels[typeIndex].load(std::memory_order_acquire))
     {
-        auto typedData         = std::make_unique<TypedEventData<TEvent>>();
-        auto& result           = typedData->data;
-        m_eventDataMap[typeID] = std::move(typedData);
-        return result;
+        return *static_cast<Channel<TEvent>*>(pChannel);
     }
 
-    return static_cast<TypedEventData<TEvent>*>(it->second.get())->data;
+    std::lock_guard<std::mutex> lock{ m_registrationMutex };
+    if (ChannelBase* pChannel = m_channels[typeIndex].load(std::memory_order_acquire))
+    {
+        return *static_cast<Channel<TEvent>*>(pChannel);
+    }
+    return createChannel<TEvent>(typeIndex, DefaultQueueSize);
 }
 
-template <typename T>
-inline auto EventManager::getTypeID() -> TypeID
+template <typename TEvent>
+inline void EventManager::registerEventType(std::size_t queueSize)
 {
-    static TypeID id = nextTypeID();
-    return id;
+    const uint32_t typeIndex = detail::EventTypeIndex::get<TEvent>();
+    APH_ASSERT(typeIndex < MaxEventTypes && "Too many event types");
+
+    std::lock_guard<std::mutex> lock{ m_registrationMutex };
+    if (m_channels[typeIndex].load(std::memory_order_acquire) == nullptr)
+    {
+        createChannel<TEvent>(typeIndex, queueSize);
+    }
+}
+
+template <typename TEvent>
+inline void EventManager::pushEvent(const TEvent& e)
+{
+    getChannel<TEvent>().push(TEvent{ e });
 }
 
 template <typename TEvent>
 inline void EventManager::registerEvent(std::function<bool(const TEvent&)>&& func)
 {
-    getEventData<TEvent>().m_handlers.push_back(std::move(func));
+    registerBatchEvent<TEvent>(
+        [func = std::move(func)](std::span<const TEvent> events)
+        {
+            for (const TEvent& e : events)
+            {
+                func(e);
+            }
+        });
 }
 
 template <typename TEvent>
-inline void EventManager::pushEvent(const TEvent& e)
+inline void EventManager::registerBatchEvent(BatchHandler<TEvent>&& func)
 {
-    std::lock_guard<std::mutex> lock(m_dataMapMutex);
-    getEventData<TEvent>().m_events.push(e);
+    auto& channel = getChannel<TEvent>();
+
+    std::lock_guard<std::mutex> lock{ m_registrationMutex };
+    channel.pendingHandlers.push_back(std::move(func));
+    channel.hasPendingHandlers.store(true, std::memory_order_release);
 }
 
 } // namespace aph
@@ -21,6 +21,12 @@ namespace aph
 // Custom signal handler function that integrates with our ErrorHandler
 void custom_signal_handler(int sig, siginfo_t* info, void* _ctx)
 {
+    // Write out the messages the logging thread hasn't gotten to, the crash report follows them
+    if (auto* pLogger = getActiveLogger())
+    {
+        pLogger->flushOnCrash();
+    }
+
     // Call our error handler
     ErrorHandler::handleSignal(sig, _ctx);
 
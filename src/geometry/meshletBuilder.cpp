@@ -1,6 +1,8 @@
 #include "meshletBuilder.h"
 
 #include "common/profiler.h"
+#include "global/globalManager.h"
+#include "threads/taskManager.h"
 
 #include <meshoptimizer.h>
 
@@ -107,6 +109,11 @@ void MeshletBuilder::build(uint32_t maxVertsPerMeshlet, uint32_t maxPrimsPerMesh
 
     m_meshlets.reserve(meshletCount);
 
+    // Lay out the output sequentially, the copies and per-meshlet bounds are independent and run in parallel
+    std::vector<uint32_t> sourceMeshlets;
+    sourceMeshlets.reserve(meshletCount);
+    uint32_t vertexTotal   = 0;
+    uint32_t triangleTotal = 0;
     for (size_t i = 0; i < meshletCount; ++i)
     {
         const meshopt_Meshlet& meshlet = meshletData[i];
@@ -120,34 +127,38 @@ void MeshletBuilder::build(uint32_t maxVertsPerMeshlet, uint32_t maxPrimsPerMesh
         Meshlet ourMeshlet;
         ourMeshlet.vertexCount    = meshlet.vertex_count;
         ourMeshlet.triangleCount  = meshlet.triangle_count;
-        ourMeshlet.vertexOffset   = static_cast<uint32_t>(m_meshletVertices.size());
-        ourMeshlet.triangleOffset = static_cast<uint32_t>(m_meshletIndices.size() / 3);
+        ourMeshlet.vertexOffset   = vertexTotal;
+        ourMeshlet.triangleOffset = triangleTotal;
         ourMeshlet.materialIndex  = 0; // Default material index
 
-        // Copy vertex indices
-        for (uint32_t j = 0; j < meshlet.vertex_count; ++j)
-        {
-            m_meshletVertices.push_back(meshletVertices[meshlet.vertex_offset + j]);
-        }
+        vertexTotal   += meshlet.vertex_count;
+        triangleTotal += meshlet.triangle_count;
+        m_meshlets.push_back(ourMeshlet);
+        sourceMeshlets.push_back(static_cast<uint32_t>(i));
+    }
 
-        // Copy triangle indices (converting from bytes to uint32_t)
-        for (uint32_t j = 0; j < meshlet.triangle_count * 3; j += 3)
+    m_meshletVertices.resize(vertexTotal);
+    m_meshletIndices.resize(static_cast<size_t>(triangleTotal) * 3);
+
+    APH_DEFAULT_TASK_MANAGER.parallelFor(
+        0, m_meshlets.size(), 16,
+        [&](size_t index)
         {
-            unsigned char a = meshletTriangles[meshlet.triangle_offset + j + 0];
-            unsigned char b = meshletTriangles[meshlet.triangle_offset + j + 1];
-            unsigned char c = meshletTriangles[meshlet.triangle_offset + j + 2];
+            const meshopt_Meshlet& meshlet = meshletData[sourceMeshlets[index]];
+            Meshlet& ourMeshlet            = m_meshlets[index];
 
-            m_meshletIndices.push_back(a);
-            m_meshletIndices.push_back(b);
-            m_meshletIndices.push_back(c);
-        }
+            // Copy vertex indices
+            std::copy_n(meshletVertices.begin() + meshlet.vertex_offset, meshlet.vertex_count,
+                        m_meshletVertices.begin() + ourMeshlet.vertexOffset);
 
-        // Compute bounds and cone data for the meshlet
-        computeMeshletBounds(ourMeshlet);
-        computeMeshletCone(ourMeshlet);
+            // Copy triangle indices (converting from bytes to uint32_t)
+            std::copy_n(meshletTriangles.begin() + meshlet.triangle_offset, meshlet.triangle_count * 3,
+                        m_meshletIndices.begin() + (static_cast<size_t>(ourMeshlet.triangleOffset) * 3));
 
-        m_meshlets.push_back(ourMeshlet);
-    }
+            // Compute bounds and cone data for the meshlet
+            computeMeshletBounds(ourMeshlet);
+            computeMeshletCone(ourMeshlet);
+        });
 
     // Step 4: If requested, optimize for vertex fetch
     if (optimizeForVertexFetch && !m_meshlets.empty())
@@ -157,7 +168,7 @@ void MeshletBuilder::build(uint32_t maxVertsPerMeshlet, uint32_t maxPrimsPerMesh
     }
 }
 
-void MeshletBuilder::computeMeshletBounds(Meshlet& meshlet)
+void MeshletBuilder::computeMeshletBounds(Meshlet& meshlet) const
 {
     // Compute bounding sphere for the meshlet
     float minX = FLT_MAX;
@@ -215,7 +226,7 @@ void MeshletBuilder::computeMeshletBounds(Meshlet& meshlet)
     meshlet.positionBounds[3] = radius;
 }
 
-void MeshletBuilder::computeMeshletCone(Meshlet& meshlet)
+void MeshletBuilder::computeMeshletCone(Meshlet& meshlet) const
 {
     // Compute view cone for backface culling
     float coneX     = 0.0f;
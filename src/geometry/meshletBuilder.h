@@ -44,10 +44,10 @@ private:
     };
 
     // Generate bounding information for a meshlet
-    void computeMeshletBounds(Meshlet& meshlet);
+    void computeMeshletBounds(Meshlet& meshlet) const;
 
     // Build cone for backface culling
-    void computeMeshletCone(Meshlet& meshlet);
+    void computeMeshletCone(Meshlet& meshlet) const;
 
     // Group meshlets into submeshes
     void groupMeshlets();
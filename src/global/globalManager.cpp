@@ -45,12 +45,19 @@ void GlobalManager::initialize(BuiltInSystemFlags systems)
             LOGGER_NAME,
             { [this]()
               {
-                  auto logger = std::make_unique<Logger>();
+                  auto logger   = std::make_unique<Logger>();
+                  auto* pLogger = logger.get();
                   logger->initialize(); // Initialize the logger
 
                   registerSubsystem<Logger>(LOGGER_NAME, std::move(logger),
-                                            InitPriority::Highest // Logger needs highest priority
-                  );
+                                            InitPriority::Highest, // Logger needs highest priority
+                                            []()
+                                            {
+                                                setActiveLogger(nullptr);
+                                            });
+
+                  // The log macros read the active logger on every call instead of looking it up here
+                  setActiveLogger(pLogger);
               }, InitPriority::Highest }
         });
     }
@@ -62,7 +69,8 @@ void GlobalManager::initialize(BuiltInSystemFlags systems)
             MEMORY_TRACKER_NAME,
             { [this]()
               {
-                  auto memoryTracker = std::make_unique<memory::AllocationTracker>();
+                  auto memoryTracker   = std::make_unique<memory::AllocationTracker>();
+                  auto* pMemoryTracker = memoryTracker.get();
 
                   // Register with automatic report generation on shutdown
                   registerSubsystem<memory::AllocationTracker>(
@@ -70,13 +78,19 @@ void GlobalManager::initialize(BuiltInSystemFlags systems)
                       InitPriority::Highest, // Memory tracker needs highest priority
                       [this]()
                       {
-                          std::string report = APH_MEMORY_TRACKER.generateSummaryReport();
+                          // Stop recording before the tracker goes away
+                          memory::setActiveAllocationTracker(nullptr);
+                          std::string report = APH_MEMORY_TRACKER.generateSummaryReport() +
+                                               APH_MEMORY_TRACKER.generateTagReport();
                           if (auto logger = getSubsystem<Logger>(LOGGER_NAME))
                           {
                               logger->debug("Memory Tracker Final Report: %s", report.c_str());
                               logger->flush();
                           }
                       });
+
+                  // The allocation functions read the active tracker on every call instead of looking it up here
+                  memory::setActiveAllocationTracker(pMemoryTracker);
               }, InitPriority::Highest }
         });
     }
@@ -151,10 +165,8 @@ bool GlobalManager::registerShutdownCallback(std::string_view name, ShutdownCall
         return false;
     }
 
-    std::string nameStr{ name };
-
     // Check if the subsystem exists
-    if (m_subsystems.find(nameStr) == m_subsystems.end())
+    if (m_subsystems.find(name) == m_subsystems.end())
     {
         return false;
     }
@@ -162,7 +174,7 @@ bool GlobalManager::registerShutdownCallback(std::string_view name, ShutdownCall
     // Find the subsystem in our initialization order and add the callback
     for (auto& info : m_initOrder)
     {
-        if (info.name == nameStr)
+        if (info.name == name)
         {
             info.shutdownCallback = std::move(callback);
             return true;
@@ -193,6 +205,12 @@ void GlobalManager::shutdown()
                 sysInfo.shutdownCallback();
             }
 
+            // Built-in lookups stop finding it before it is destroyed
+            if (sysInfo.slot != BuiltInSlot::Count)
+            {
+                detail::getBuiltInSlot(sysInfo.slot).store(nullptr, std::memory_order_release);
+            }
+
             // Remove the system
             m_subsystems.erase(it);
         }
@@ -5,6 +5,15 @@
 
 namespace aph
 {
+class TaskManager;
+class Filesystem;
+class EventManager;
+class Logger;
+namespace memory
+{
+class AllocationTracker;
+} // namespace memory
+
 /**
  * @brief Central hub for managing global components
  *
@@ -21,6 +30,17 @@ public:
     static constexpr const char* MEMORY_TRACKER_NAME = "MemoryTracker";
     static constexpr const char* LOGGER_NAME         = "Logger";
 
+    // Slots of the built-in subsystems, see getBuiltInSubsystem()
+    enum class BuiltInSlot : uint32_t
+    {
+        TaskManager,
+        Filesystem,
+        EventManager,
+        MemoryTracker,
+        Logger,
+        Count
+    };
+
     /**
      * @brief Enumeration of priority levels for initialization and shutdown
      * 
@@ -125,6 +145,7 @@ private:
         std::string name;
         InitPriority priority;
         ShutdownCallback shutdownCallback = nullptr;
+        BuiltInSlot slot                  = BuiltInSlot::Count; // Count for custom subsystems
 
         // For sorting
         bool operator<(const SubsystemInfo& other) const
@@ -134,9 +155,21 @@ private:
         }
     };
 
+    // Looks names up without copying them into a std::string
+    struct NameHash
+    {
+        using is_transparent = void;
+        using is_avalanching = void;
+
+        auto operator()(std::string_view name) const noexcept -> uint64_t
+        {
+            return ::ankerl::unordered_dense::hash<std::string_view>{}(name);
+        }
+    };
+
     // Container for custom subsystems with type-safe deletion
     using TypeErasedPtr = std::unique_ptr<void, std::function<void(void*)>>;
-    HashMap<std::string, TypeErasedPtr> m_subsystems;
+    HashMap<std::string, TypeErasedPtr, NameHash, std::equal_to<>> m_subsystems;
 
     // Track initialization order for orderly shutdown
     SmallVector<SubsystemInfo> m_initOrder;
@@ -152,12 +185,81 @@ struct FlagTraits<GlobalManager::BuiltInSystemBits>
     static constexpr GlobalManager::BuiltInSystemFlags allFlags = GlobalManager::BuiltInSystemBits::All;
 };
 
+namespace detail
+{
+// Built-in subsystem types and the names they are registered under
+template <typename T>
+struct BuiltInSubsystemTraits;
+
+template <>
+struct BuiltInSubsystemTraits<TaskManager>
+{
+    static constexpr GlobalManager::BuiltInSlot slot = GlobalManager::BuiltInSlot::TaskManager;
+    static constexpr const char* name                = GlobalManager::TASK_MANAGER_NAME;
+};
+
+template <>
+struct BuiltInSubsystemTraits<Filesystem>
+{
+    static constexpr GlobalManager::BuiltInSlot slot = GlobalManager::BuiltInSlot::Filesystem;
+    static constexpr const char* name                = GlobalManager::FILESYSTEM_NAME;
+};
+
+template <>
+struct BuiltInSubsystemTraits<EventManager>
+{
+    static constexpr GlobalManager::BuiltInSlot slot = GlobalManager::BuiltInSlot::EventManager;
+    static constexpr const char* name                = GlobalManager::EVENT_MANAGER_NAME;
+};
+
+template <>
+struct BuiltInSubsystemTraits<memory::AllocationTracker>
+{
+    static constexpr GlobalManager::BuiltInSlot slot = GlobalManager::BuiltInSlot::MemoryTracker;
+    static constexpr const char* name                = GlobalManager::MEMORY_TRACKER_NAME;
+};
+
+template <>
+struct BuiltInSubsystemTraits<Logger>
+{
+    static constexpr GlobalManager::BuiltInSlot slot = GlobalManager::BuiltInSlot::Logger;
+    static constexpr const char* name                = GlobalManager::LOGGER_NAME;
+};
+
+template <typename T>
+concept BuiltInSubsystem = requires { BuiltInSubsystemTraits<T>::slot; };
+
+inline std::array<std::atomic<void*>, static_cast<std::size_t>(GlobalManager::BuiltInSlot::Count)>
+    g_builtInSubsystems{};
+
+inline auto getBuiltInSlot(GlobalManager::BuiltInSlot slot) -> std::atomic<void*>&
+{
+    return g_builtInSubsystems[static_cast<std::size_t>(slot)];
+}
+} // namespace detail
+
+// Built-in subsystem of type T, a single load once GlobalManager is set up. The subsystems are kept in fixed slots
+// by registerSubsystem() when they are registered under their built-in name, so the hot paths don't pay for a name
+// lookup. Returns nullptr when the subsystem was not initialized.
+template <detail::BuiltInSubsystem T>
+inline auto getBuiltInSubsystem() -> T*
+{
+    auto& slot = detail::getBuiltInSlot(detail::BuiltInSubsystemTraits<T>::slot);
+    if (void* pSubsystem = slot.load(std::memory_order_acquire)) [[likely]]
+    {
+        return static_cast<T*>(pSubsystem);
+    }
+
+    // Sets up GlobalManager on first use
+    GlobalManager::instance();
+    return static_cast<T*>(slot.load(std::memory_order_acquire));
+}
+
 template <typename T>
 bool GlobalManager::registerSubsystem(std::string_view name, std::unique_ptr<T> system, InitPriority priority,
                                       ShutdownCallback shutdownCallback)
 {
-    std::string nameStr{ name };
-    if (m_subsystems.find(nameStr) != m_subsystems.end())
+    if (m_subsystems.find(name) != m_subsystems.end())
     {
         return false;
     }
@@ -170,10 +272,21 @@ bool GlobalManager::registerSubsystem(std::string_view name, std::unique_ptr<T>
     };
 
     // Store in the map with proper type information for deletion
-    m_subsystems.emplace(nameStr, TypeErasedPtr{ rawPtr, deleter });
+    m_subsystems.emplace(std::string{ name }, TypeErasedPtr{ rawPtr, deleter });
+
+    // Built-in subsystems also go into their slot for getBuiltInSubsystem()
+    BuiltInSlot slot = BuiltInSlot::Count;
+    if constexpr (detail::BuiltInSubsystem<T>)
+    {
+        if (name == detail::BuiltInSubsystemTraits<T>::name)
+        {
+            slot = detail::BuiltInSubsystemTraits<T>::slot;
+            detail::getBuiltInSlot(slot).store(rawPtr, std::memory_order_release);
+        }
+    }
 
     // Record the initialization order with priority and shutdown callback
-    m_initOrder.push_back({ nameStr, priority, shutdownCallback });
+    m_initOrder.push_back({ std::string{ name }, priority, shutdownCallback, slot });
 
     // Sort the initialization order after each addition
     std::sort(m_initOrder.begin(), m_initOrder.end());
@@ -184,8 +297,7 @@ bool GlobalManager::registerSubsystem(std::string_view name, std::unique_ptr<T>
 template <typename T>
 T* GlobalManager::getSubsystem(std::string_view name)
 {
-    std::string nameStr(name);
-    if (auto it = m_subsystems.find(nameStr); it != m_subsystems.end())
+    if (auto it = m_subsystems.find(name); it != m_subsystems.end())
     {
         // Cast back to the original type
         return static_cast<T*>(it->second.get());
@@ -201,12 +313,8 @@ inline GlobalManager& getGlobalManager()
 } // namespace aph
 
 #define APH_GLOBAL_MANAGER ::aph::getGlobalManager()
-#define APH_DEFAULT_TASK_MANAGER \
-    (*::aph::getGlobalManager().getSubsystem<aph::TaskManager>(aph::GlobalManager::TASK_MANAGER_NAME))
-#define APH_DEFAULT_FILESYSTEM \
-    (*::aph::getGlobalManager().getSubsystem<aph::Filesystem>(aph::GlobalManager::FILESYSTEM_NAME))
-#define APH_DEFAULT_EVENT_MANAGER \
-    (*::aph::getGlobalManager().getSubsystem<aph::EventManager>(aph::GlobalManager::EVENT_MANAGER_NAME))
-#define APH_MEMORY_TRACKER \
-    (*::aph::getGlobalManager().getSubsystem<aph::memory::AllocationTracker>(aph::GlobalManager::MEMORY_TRACKER_NAME))
-#define APH_LOGGER (*::aph::getGlobalManager().getSubsystem<aph::Logger>(aph::GlobalManager::LOGGER_NAME))
+#define APH_DEFAULT_TASK_MANAGER  (*::aph::getBuiltInSubsystem<aph::TaskManager>())
+#define APH_DEFAULT_FILESYSTEM    (*::aph::getBuiltInSubsystem<aph::Filesystem>())
+#define APH_DEFAULT_EVENT_MANAGER (*::aph::getBuiltInSubsystem<aph::EventManager>())
+#define APH_MEMORY_TRACKER        (*::aph::getBuiltInSubsystem<aph::memory::AllocationTracker>())
+#define APH_LOGGER                (*::aph::getBuiltInSubsystem<aph::Logger>())
@@ -52,8 +52,8 @@ void Material::initializeParameterStorage()
         }
     }
 
-    APH_LOG_INFO("Initialized material using template '{}' with {} parameters and {} textures", m_pTemplate->getName(),
-                 m_parameterOffsets.size(), m_textureBindings.size());
+    APH_LOG_INFO("Initialized material using template '%s' with %zu parameters and %zu textures",
+                 m_pTemplate->getName(), m_parameterOffsets.size(), m_textureBindings.size());
 }
 
 auto Material::findParameter(std::string_view name, DataType expectedType) -> Material::ParameterOffsetInfo*
@@ -64,7 +64,7 @@ auto Material::findParameter(std::string_view name, DataType expectedType) -> Ma
         {
             if (param.type != expectedType)
             {
-                APH_LOG_ERR("Parameter type mismatch for '{}': expected {}, got {}", name,
+                APH_LOG_ERR("Parameter type mismatch for '%s': expected %d, got %d", std::string(name).c_str(),
                             static_cast<int>(expectedType), static_cast<int>(param.type));
                 return nullptr;
             }
@@ -72,7 +72,7 @@ auto Material::findParameter(std::string_view name, DataType expectedType) -> Ma
         }
     }
 
-    APH_LOG_ERR("Parameter '{}' not found in material", name);
+    APH_LOG_ERR("Parameter '%s' not found in material", std::string(name).c_str());
     return nullptr;
 }
 
@@ -156,7 +156,7 @@ auto Material::setTexture(std::string_view name, std::string_view texturePath) -
     auto it = m_textureBindings.find(std::string{ name });
     if (it == m_textureBindings.end())
     {
-        APH_LOG_ERR("Texture parameter '{}' not found in material", name);
+        APH_LOG_ERR("Texture parameter '%s' not found in material", std::string(name).c_str());
         return Result::RuntimeError;
     }
 
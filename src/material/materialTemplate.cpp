@@ -27,7 +27,7 @@ void MaterialTemplate::addParameter(const MaterialParameterDesc& parameter)
     {
         if (existingParam.name == parameter.name)
         {
-            APH_LOG_WARN("Parameter '{}' already exists in material template '{}'. Ignoring.", parameter.name, m_name);
+            APH_LOG_WARN("Parameter '%s' already exists in material template '%s'. Ignoring.", parameter.name, m_name);
             return;
         }
     }
@@ -0,0 +1,342 @@
+#include "compiledGraph.h"
+#include "common/profiler.h"
+
+namespace aph
+{
+namespace
+{
+class SnapshotWriter
+{
+public:
+    template <typename T>
+        requires std::is_trivially_copyable_v<T>
+    void write(const T& value)
+    {
+        const auto* pBytes = reinterpret_cast<const uint8_t*>(&value);
+        m_bytes.insert(m_bytes.end(), pBytes, pBytes + sizeof(T));
+    }
+
+    void write(const std::string& str)
+    {
+        write(static_cast<uint32_t>(str.size()));
+        m_bytes.insert(m_bytes.end(), str.begin(), str.end());
+    }
+
+    template <typename Range, typename Func>
+    void writeArray(const Range& range, Func&& writeElement)
+    {
+        write(static_cast<uint32_t>(range.size()));
+        for (const auto& element : range)
+        {
+            writeElement(element);
+        }
+    }
+
+    auto takeBytes() -> std::vector<uint8_t>
+    {
+        return std::move(m_bytes);
+    }
+
+private:
+    std::vector<uint8_t> m_bytes;
+};
+
+class SnapshotReader
+{
+public:
+    explicit SnapshotReader(ArrayProxy<uint8_t> bytes)
+        : m_bytes(bytes)
+    {
+    }
+
+    template <typename T>
+        requires std::is_trivially_copyable_v<T>
+    auto read(T& value) -> bool
+    {
+        if (!m_valid || m_offset + sizeof(T) > m_bytes.size())
+        {
+            m_valid = false;
+            return false;
+        }
+        std::memcpy(&value, m_bytes.data() + m_offset, sizeof(T));
+        m_offset += sizeof(T);
+        return true;
+    }
+
+    auto read(std::string& str) -> bool
+    {
+        uint32_t length = 0;
+        if (!read(length) || m_offset + length > m_bytes.size())
+        {
+            m_valid = false;
+            return false;
+        }
+        str.assign(reinterpret_cast<const char*>(m_bytes.data() + m_offset), length);
+        m_offset += length;
+        return true;
+    }
+
+    // Every element takes at least one byte, so a count beyond the remaining size means corrupted data
+    template <typename Container, typename Func>
+    auto readArray(Container& container, Func&& readElement) -> bool
+    {
+        uint32_t count = 0;
+        if (!read(count) || count > m_bytes.size() - m_offset)
+        {
+            m_valid = false;
+            return false;
+        }
+        container.clear();
+        container.reserve(count);
+        for (uint32_t index = 0; index < count && m_valid; ++index)
+        {
+            container.emplace_back();
+            readElement(container.back());
+        }
+        return m_valid;
+    }
+
+    auto isValid() const -> bool
+    {
+        return m_valid;
+    }
+
+    auto isAtEnd() const -> bool
+    {
+        return m_offset == m_bytes.size();
+    }
+
+private:
+    ArrayProxy<uint8_t> m_bytes;
+    std::size_t m_offset = 0;
+    bool m_valid         = true;
+};
+
+void writeBarrier(SnapshotWriter& writer, const CompiledGraph::Barrier& barrier)
+{
+    writer.write(barrier.resourceIndex);
+    writer.write(barrier.currentState);
+    writer.write(barrier.newState);
+    writer.write(barrier.queueType);
+    writer.write(barrier.acquire);
+    writer.write(barrier.release);
+}
+
+void readBarrier(SnapshotReader& reader, CompiledGraph::Barrier& barrier)
+{
+    reader.read(barrier.resourceIndex);
+    reader.read(barrier.currentState);
+    reader.read(barrier.newState);
+    reader.read(barrier.queueType);
+    reader.read(barrier.acquire);
+    reader.read(barrier.release);
+}
+} // namespace
+
+auto CompiledGraph::serialize() const -> std::vector<uint8_t>
+{
+    APH_PROFILER_SCOPE();
+
+    SnapshotWriter writer;
+    writer.write(Magic);
+    writer.write(Version);
+    writer.write(hash);
+
+    writer.writeArray(passes,
+                      [&writer](const Pass& pass)
+                      {
+                          writer.write(pass.name);
+                          writer.writeArray(pass.barriers, [&writer](const Barrier& barrier)
+                                            { writeBarrier(writer, barrier); });
+                          writer.writeArray(pass.releaseBarriers, [&writer](const Barrier& barrier)
+                                            { writeBarrier(writer, barrier); });
+                      });
+    writer.writeArray(culledPasses, [&writer](const std::string& name) { writer.write(name); });
+    writer.writeArray(resources,
+                      [&writer](const Resource& resource)
+                      {
+                          writer.write(resource.name);
+                          writer.write(static_cast<uint8_t>(resource.isImage));
+                          writer.write(resource.extent);
+                          writer.write(resource.format);
+                          writer.write(static_cast<uint64_t>(resource.size));
+                          writer.write(resource.usage);
+                          writer.write(resource.finalState);
+                          writer.write(resource.finalOwner);
+                      });
+    writer.writeArray(batches,
+                      [&writer](const Batch& batch)
+                      {
+                          writer.write(batch.queueType);
+                          writer.write(batch.queueBatchIndex);
+                          writer.writeArray(batch.passes, [&writer](uint32_t index) { writer.write(index); });
+                          writer.writeArray(batch.waitBatches, [&writer](uint32_t index) { writer.write(index); });
+                      });
+
+    writer.writeArray(transientPlan.placements,
+                      [&writer](const TransientPlacement& placement)
+                      {
+                          writer.write(placement.heapIndex);
+                          writer.write(static_cast<uint64_t>(placement.offset));
+                          writer.write(static_cast<uint64_t>(placement.size));
+                      });
+    writer.writeArray(transientPlan.heaps,
+                      [&writer](const TransientHeap& heap)
+                      {
+                          writer.write(heap.heapKey);
+                          writer.write(static_cast<uint64_t>(heap.size));
+                          writer.write(static_cast<uint64_t>(heap.alignment));
+                          writer.write(heap.resourceCount);
+                      });
+    writer.writeArray(transientPlan.aliasing,
+                      [&writer](const TransientAliasing& aliasing)
+                      {
+                          writer.write(aliasing.request);
+                          writer.write(aliasing.previousRequest);
+                      });
+    writer.write(static_cast<uint64_t>(transientPlan.naiveSize));
+    writer.write(static_cast<uint64_t>(transientPlan.aliasedSize));
+    writer.write(static_cast<uint64_t>(transientPlan.peakLiveSize));
+    writer.writeArray(transientResources, [&writer](uint32_t index) { writer.write(index); });
+    writer.write(skippedBarrierCount);
+
+    return writer.takeBytes();
+}
+
+auto CompiledGraph::Deserialize(ArrayProxy<uint8_t> bytes) -> Expected<CompiledGraph>
+{
+    APH_PROFILER_SCOPE();
+
+    SnapshotReader reader{ bytes };
+
+    uint32_t magic   = 0;
+    uint32_t version = 0;
+    if (!reader.read(magic) || magic != Magic)
+    {
+        return { Result::RuntimeError, "Not a compiled render graph" };
+    }
+    if (!reader.read(version) || version != Version)
+    {
+        return { Result::RuntimeError, "Unsupported compiled render graph version" };
+    }
+
+    CompiledGraph graph;
+    reader.read(graph.hash);
+
+    auto readSize = [&reader](std::size_t& value)
+    {
+        uint64_t size = 0;
+        reader.read(size);
+        value = static_cast<std::size_t>(size);
+    };
+
+    reader.readArray(graph.passes,
+                     [&reader](Pass& pass)
+                     {
+                         reader.read(pass.name);
+                         reader.readArray(pass.barriers, [&reader](Barrier& barrier) { readBarrier(reader, barrier); });
+                         reader.readArray(pass.releaseBarriers,
+                                          [&reader](Barrier& barrier) { readBarrier(reader, barrier); });
+                     });
+    reader.readArray(graph.culledPasses, [&reader](std::string& name) { reader.read(name); });
+    reader.readArray(graph.resources,
+                     [&reader, &readSize](Resource& resource)
+                     {
+                         uint8_t isImage = 0;
+                         reader.read(resource.name);
+                         reader.read(isImage);
+                         reader.read(resource.extent);
+                         reader.read(resource.format);
+                         readSize(resource.size);
+                         reader.read(resource.usage);
+                         reader.read(resource.finalState);
+                         reader.read(resource.finalOwner);
+                         resource.isImage = isImage != 0;
+                     });
+    reader.readArray(graph.batches,
+                     [&reader](Batch& batch)
+                     {
+                         reader.read(batch.queueType);
+                         reader.read(batch.queueBatchIndex);
+                         reader.readArray(batch.passes, [&reader](uint32_t& index) { reader.read(index); });
+                         reader.readArray(batch.waitBatches, [&reader](uint32_t& index) { reader.read(index); });
+                     });
+
+    auto& plan = graph.transientPlan;
+    reader.readArray(plan.placements,
+                     [&reader, &readSize](TransientPlacement& placement)
+                     {
+                         reader.read(placement.heapIndex);
+                         readSize(placement.offset);
+                         readSize(placement.size);
+                     });
+    reader.readArray(plan.heaps,
+                     [&reader, &readSize](TransientHeap& heap)
+                     {
+                         reader.read(heap.heapKey);
+                         readSize(heap.size);
+                         readSize(heap.alignment);
+                         reader.read(heap.resourceCount);
+                     });
+    reader.readArray(plan.aliasing,
+                     [&reader](TransientAliasing& aliasing)
+                     {
+                         reader.read(aliasing.request);
+                         reader.read(aliasing.previousRequest);
+                     });
+    readSize(plan.naiveSize);
+    readSize(plan.aliasedSize);
+    readSize(plan.peakLiveSize);
+    reader.readArray(graph.transientResources, [&reader](uint32_t& index) { reader.read(index); });
+    reader.read(graph.skippedBarrierCount);
+
+    if (!reader.isValid() || !reader.isAtEnd())
+    {
+        return { Result::RuntimeError, "Compiled render graph data is truncated or corrupted" };
+    }
+
+    // Indices are used without further checks once the snapshot is applied
+    bool indicesValid = graph.transientResources.size() == plan.placements.size();
+    for (const auto& pass : graph.passes)
+    {
+        for (const auto* pBarriers : { &pass.barriers, &pass.releaseBarriers })
+        {
+            for (const auto& barrier : *pBarriers)
+            {
+                indicesValid &= barrier.resourceIndex < graph.resources.size();
+            }
+        }
+    }
+    for (const auto& resource : graph.resources)
+    {
+        indicesValid &= resource.finalOwner == UINT32_MAX || resource.finalOwner < graph.passes.size();
+    }
+    for (const auto& batch : graph.batches)
+    {
+        for (uint32_t passIndex : batch.passes)
+        {
+            indicesValid &= passIndex < graph.passes.size();
+        }
+        for (uint32_t batchIndex : batch.waitBatches)
+        {
+            indicesValid &= batchIndex < graph.batches.size();
+        }
+    }
+    for (uint32_t index = 0; indicesValid && index < plan.placements.size(); ++index)
+    {
+        indicesValid = plan.placements[index].heapIndex < plan.heaps.size() &&
+                       graph.transientResources[index] < graph.resources.size();
+    }
+    for (const auto& aliasing : plan.aliasing)
+    {
+        indicesValid &=
+            aliasing.request < plan.placements.size() && aliasing.previousRequest < plan.placements.size();
+    }
+    if (!indicesValid)
+    {
+        return { Result::RuntimeError, "Compiled render graph references out of range passes or resources" };
+    }
+
+    return graph;
+}
+} // namespace aph
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "api/gpuResource.h"
+#include "common/arrayProxy.h"
+#include "common/result.h"
+#include "transientAllocator.h"
+
+namespace aph
+{
+// Everything RenderGraph::build() derives from the declared passes and resources without touching
+// GPU objects: execution order, queue batches, barrier plan and transient memory placement.
+// Passes and resources are referenced by name, so a snapshot taken in one run can be applied to the
+// same declaration in a later one. See RenderGraph::getCompiledGraph() and setCompiledGraph().
+struct CompiledGraph
+{
+    static constexpr uint32_t Magic   = 0x47524441; // "ADRG"
+    static constexpr uint32_t Version = 3;
+
+    struct Resource
+    {
+        std::string name;
+        bool isImage = false;
+
+        // Image descriptor
+        Extent3D extent = {};
+        Format format   = Format::Undefined;
+
+        // Buffer descriptor
+        std::size_t size = 0;
+
+        // ImageUsageFlags or BufferUsageFlags
+        uint32_t usage = 0;
+
+        // Tracking state once every pass of the frame is planned
+        ResourceState finalState = ResourceState::Undefined;
+        uint32_t finalOwner      = UINT32_MAX; // Index into passes
+    };
+
+    struct Barrier
+    {
+        uint32_t resourceIndex     = 0;
+        ResourceState currentState = ResourceState::Undefined;
+        ResourceState newState     = ResourceState::Undefined;
+        QueueType queueType        = QueueType::Unsupport;
+        uint8_t acquire            = 0;
+        uint8_t release            = 0;
+    };
+
+    struct Pass
+    {
+        std::string name;
+        std::vector<Barrier> barriers; // Before the pass, image and buffer barriers in recording order
+        std::vector<Barrier> releaseBarriers; // Queue ownership releases at the end of the pass
+    };
+
+    struct Batch
+    {
+        QueueType queueType      = QueueType::Graphics;
+        uint32_t queueBatchIndex = 0;
+        std::vector<uint32_t> passes; // Indices into passes
+        std::vector<uint32_t> waitBatches;
+    };
+
+    // Hash of the declaration the snapshot was compiled from, see RenderGraph::getGraphHash()
+    uint64_t hash = 0;
+
+    std::vector<Pass> passes; // Execution order
+    std::vector<std::string> culledPasses;
+    std::vector<Resource> resources;
+    std::vector<Batch> batches;
+
+    TransientMemoryPlan transientPlan;
+    std::vector<uint32_t> transientResources; // Resource index of each plan placement
+    uint32_t skippedBarrierCount = 0;
+
+    auto serialize() const -> std::vector<uint8_t>;
+    static auto Deserialize(ArrayProxy<uint8_t> bytes) -> Expected<CompiledGraph>;
+};
+
+// FNV-1a, stable across runs and platforms of the same endianness
+class GraphHasher
+{
+public:
+    void add(const void* pData, std::size_t size)
+    {
+        const auto* pBytes = static_cast<const uint8_t*>(pData);
+        for (std::size_t index = 0; index < size; ++index)
+        {
+            m_hash = (m_hash ^ pBytes[index]) * 0x100000001b3ULL;
+        }
+    }
+
+    template <typename T>
+        requires std::is_trivially_copyable_v<T>
+    void add(const T& value)
+    {
+        add(&value, sizeof(T));
+    }
+
+    void add(std::string_view str)
+    {
+        add(static_cast<uint64_t>(str.size()));
+        add(str.data(), str.size());
+    }
+
+    auto value() const -> uint64_t
+    {
+        return m_hash;
+    }
+
+private:
+    uint64_t m_hash = 0xcbf29ce484222325ULL;
+};
+} // namespace aph
@@ -1,5 +1,7 @@
 #include "frameComposer.h"
 #include "common/profiler.h"
+#include "filesystem/filesystem.h"
+#include "global/globalManager.h"
 #include "threads/taskManager.h"
 
 namespace aph
@@ -8,6 +10,7 @@ namespace aph
 FrameComposer::FrameComposer(const FrameComposerCreateInfo& createInfo)
     : m_pDevice(createInfo.pDevice)
     , m_pResourceLoader(createInfo.pResourceLoader)
+    , m_frameAllocator(std::max(1u, createInfo.frameCount))
     , m_frameCount(createInfo.frameCount)
 {
 }
@@ -94,7 +97,14 @@ Result FrameComposer::createFrameGraph(uint32_t frameIndex)
         m_frameGraphs.resize(frameIndex + 1, nullptr);
     }
 
-    m_frameGraphs[frameIndex] = result.value();
+    m_frameGraphs[frameIndex]                    = result.value();
+    m_frameGraphs[frameIndex]->m_pFrameAllocator = &m_frameAllocator;
+
+    // The frame graphs share one declaration, the first one to compile it serves the others and later launches
+    if (APH_DEFAULT_FILESYSTEM.protocolExists("graph_cache"))
+    {
+        m_frameGraphs[frameIndex]->setCompiledGraphCache("graph_cache://");
+    }
     return Result::Success;
 }
 
@@ -137,6 +147,7 @@ void FrameComposer::setFrameCount(uint32_t frameCount)
 
     m_frameCount   = frameCount;
     m_currentFrame = std::min(m_currentFrame, frameCount - 1);
+    m_frameAllocator.setFrameCount(frameCount);
 }
 
 void FrameComposer::setCurrentFrame(uint32_t frameIndex)
@@ -160,9 +171,15 @@ FrameComposer::FrameResource FrameComposer::nextFrame()
     APH_PROFILER_SCOPE();
 
     m_currentFrame = (m_currentFrame + 1) % m_frameCount;
+    m_frameAllocator.nextFrame();
     return getCurrentFrame();
 }
 
+FrameAllocator* FrameComposer::getFrameAllocator()
+{
+    return &m_frameAllocator;
+}
+
 RenderGraph* FrameComposer::getCurrentGraph() const
 {
     return getGraph(m_currentFrame);
@@ -49,6 +49,9 @@ public:
     auto getCurrentFrame() const -> FrameResource;
     auto nextFrame() -> FrameResource;
 
+    // Scratch memory valid for frameCount frames, recycled by nextFrame()
+    auto getFrameAllocator() -> FrameAllocator*;
+
     auto frames() -> coro::generator<FrameResource>;
 
 private:
@@ -67,6 +70,7 @@ private:
     vk::Device* m_pDevice             = nullptr;
     ResourceLoader* m_pResourceLoader = nullptr;
     SmallVector<RenderGraph*> m_frameGraphs;
+    FrameAllocator m_frameAllocator;
 
     HashMap<std::string, ImageAsset*> m_buildImage;
     HashMap<std::string, BufferAsset*> m_buildBuffer;
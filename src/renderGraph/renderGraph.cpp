@@ -3,6 +3,8 @@
 #include "common/graphView.h"
 #include "common/profiler.h"
 
+#include "filesystem/filesystem.h"
+#include "global/globalManager.h"
 #include "threads/taskManager.h"
 
 namespace aph
@@ -135,7 +137,17 @@ RenderGraph::~RenderGraph()
                 m_pCommandBufferAllocator->release(cmdBuffer);
             }
         }
+        for (auto [pass, cmdBuffer] : m_buildData.transitionCmds)
+        {
+            m_pCommandBufferAllocator->release(cmdBuffer);
+        }
+        for (auto* cmdBuffer : m_buildData.retiredCmds)
+        {
+            m_pCommandBufferAllocator->release(cmdBuffer);
+        }
         m_buildData.cmds.clear();
+        m_buildData.transitionCmds.clear();
+        m_buildData.retiredCmds.clear();
     }
 
     cleanup();
@@ -224,6 +236,21 @@ void RenderGraph::build(vk::SwapChain* pSwapChain)
         return;
     }
 
+    // Command and binding changes keep the compiled graph, only the affected passes are recorded again
+    constexpr DirtyFlags IncrementalDirtyFlags = DirtyFlagBits::PassCommandDirty | DirtyFlagBits::ResourceBindingDirty;
+    if (!isDirty(~IncrementalDirtyFlags))
+    {
+        rebuildDirtyPasses();
+        clearDirtyFlags();
+
+        if (m_breadcrumbs.isEnabled())
+        {
+            buildBreadcrumbIndex = m_breadcrumbs.findBreadcrumb("Build");
+            m_breadcrumbs.updateBreadcrumb(buildBreadcrumbIndex, BreadcrumbState::Completed);
+        }
+        return;
+    }
+
     uint32_t topologyBreadcrumbIndex = UINT32_MAX;
     if (m_breadcrumbs.isEnabled() && isDirty(DirtyFlagBits::TopologyDirty | DirtyFlagBits::PassDirty))
     {
@@ -240,10 +267,16 @@ void RenderGraph::build(vk::SwapChain* pSwapChain)
             std::lock_guard<std::mutex> holder{ m_buildData.submitLock };
             m_buildData.bufferBarriers.clear();
             m_buildData.imageBarriers.clear();
-            m_buildData.frameSubmitInfos.clear();
+            m_buildData.renderingInfos.clear();
+            m_buildData.releaseImageBarriers.clear();
+            m_buildData.releaseBufferBarriers.clear();
+            m_buildData.barrierResources.clear();
+            m_buildData.submissionBatches.clear();
+            m_buildData.passBatchIndices.clear();
         }
         m_buildData.sortedPasses.clear();
         m_buildData.currentResourceStates.clear();
+        m_buildData.resourceOwners.clear();
         m_buildData.passBreadcrumbIndices.clear();
 
         for (auto [name, pass] : m_declareData.passMap)
@@ -252,7 +285,25 @@ void RenderGraph::build(vk::SwapChain* pSwapChain)
         }
     }
 
-    if (isDirty(DirtyFlagBits::TopologyDirty | DirtyFlagBits::PassDirty))
+    // A declaration compiled before, by another frame graph or an earlier launch, has its snapshot in the cache
+    std::string cachePath;
+    if (isDirty(DirtyFlagBits::TopologyDirty | DirtyFlagBits::PassDirty) && !m_compiledGraph.cacheDirectory.empty())
+    {
+        const auto fileName = std::format("{:016x}.bin", getGraphHash());
+        cachePath           = (std::filesystem::path{ m_compiledGraph.cacheDirectory } / fileName).string();
+        if (!m_compiledGraph.pending && APH_DEFAULT_FILESYSTEM.exist(cachePath))
+        {
+            if (auto result = loadCompiledGraph(cachePath); !result.success())
+            {
+                RDG_LOG_WARN("Failed to load compiled graph '%s': %s", cachePath, result.toString());
+            }
+        }
+    }
+
+    // A snapshot of the same declaration replaces sorting, culling, scheduling and planning
+    m_compiledGraph.applied = isDirty(DirtyFlagBits::TopologyDirty | DirtyFlagBits::PassDirty) && applyCompiledGraph();
+
+    if (isDirty(DirtyFlagBits::TopologyDirty | DirtyFlagBits::PassDirty) && !m_compiledGraph.applied)
     {
         APH_PROFILER_SCOPE_NAME("topological sort");
 
@@ -370,9 +421,31 @@ void RenderGraph::build(vk::SwapChain* pSwapChain)
             RDG_LOG_INFO("[DryRun] Topological sort completed successfully.");
         }
 
-        if (m_breadcrumbs.isEnabled() && topologyBreadcrumbIndex != UINT32_MAX)
+        // Edges point from readers to writers, so the sort yields consumers first
+        std::ranges::reverse(sortedPasses);
+
+        cullPasses();
+
+        {
+            std::lock_guard<std::mutex> holder{ m_buildData.submitLock };
+            scheduleQueues();
+        }
+    }
+
+    if (m_breadcrumbs.isEnabled() && topologyBreadcrumbIndex != UINT32_MAX)
+    {
+        m_breadcrumbs.updateBreadcrumb(topologyBreadcrumbIndex, BreadcrumbState::Completed);
+    }
+
+    // Resource lifetimes depend on the pass order, so aliasing is planned after sorting
+    if (isDirty(DirtyFlagBits::TopologyDirty | DirtyFlagBits::PassDirty | DirtyFlagBits::ImageResourceDirty |
+                DirtyFlagBits::BufferResourceDirty | DirtyFlagBits::BackBufferDirty))
+    {
+        APH_PROFILER_SCOPE_NAME("transient memory planning");
+        if (!m_compiledGraph.applied || !applyCompiledTransientPlan())
         {
-            m_breadcrumbs.updateBreadcrumb(topologyBreadcrumbIndex, BreadcrumbState::Completed);
+            analyzeResourceLifetimes();
+            planTransientMemory();
         }
     }
 
@@ -380,7 +453,7 @@ void RenderGraph::build(vk::SwapChain* pSwapChain)
     if (!isDryRunMode())
     {
         if (isDirty(DirtyFlagBits::ImageResourceDirty | DirtyFlagBits::BufferResourceDirty | DirtyFlagBits::PassDirty |
-                    DirtyFlagBits::BackBufferDirty | DirtyFlagBits::SwapChainDirty))
+                    DirtyFlagBits::TopologyDirty | DirtyFlagBits::BackBufferDirty | DirtyFlagBits::SwapChainDirty))
         {
             uint32_t resourceBreadcrumbIndex = UINT32_MAX;
             if (m_breadcrumbs.isEnabled())
@@ -395,12 +468,6 @@ void RenderGraph::build(vk::SwapChain* pSwapChain)
             {
                 APH_PROFILER_SCOPE_NAME("pass resource build");
 
-                // Acquire command buffers from the allocator if needed
-                if (!m_buildData.cmds.contains(pass))
-                {
-                    m_buildData.cmds[pass] = m_pCommandBufferAllocator->acquire(pass->getQueueType());
-                }
-
                 // Create or update color attachments
                 for (PassImageResource* colorAttachment : pass->m_resource.colorOut)
                 {
@@ -441,7 +508,8 @@ void RenderGraph::build(vk::SwapChain* pSwapChain)
 
         // Record commands for each pass
         if (isDirty(DirtyFlagBits::PassDirty | DirtyFlagBits::ImageResourceDirty | DirtyFlagBits::BufferResourceDirty |
-                    DirtyFlagBits::TopologyDirty | DirtyFlagBits::SwapChainDirty))
+                    DirtyFlagBits::TopologyDirty | DirtyFlagBits::SwapChainDirty | DirtyFlagBits::PassCommandDirty |
+                    DirtyFlagBits::ResourceBindingDirty))
         {
             uint32_t recordBreadcrumbIndex = UINT32_MAX;
             if (m_breadcrumbs.isEnabled())
@@ -456,130 +524,33 @@ void RenderGraph::build(vk::SwapChain* pSwapChain)
                 frameFence->wait();
             }
 
-            // Record commands for each pass
-            for (uint32_t passIndex = 0; passIndex < m_buildData.sortedPasses.size(); passIndex++)
+            // The GPU is idle, the previous command buffers can go back to their pools
+            for (auto [pass, pCmd] : m_buildData.cmds)
             {
-                auto* pass = m_buildData.sortedPasses[passIndex];
-                APH_PROFILER_SCOPE_NAME("pass commands recording");
-
-                // Create a breadcrumb for this pass
-                if (m_breadcrumbs.isEnabled())
-                {
-                    recordPassBreadcrumb(pass, passIndex, true);
-                }
-
-                SmallVector<vk::ImageBarrier> initImageBarriers{};
-                auto& imageBarriers  = m_buildData.imageBarriers[pass];
-                auto& bufferBarriers = m_buildData.bufferBarriers[pass];
-
-                // Clear existing barriers
-                imageBarriers.clear();
-                bufferBarriers.clear();
-
-                auto* pCmd = m_buildData.cmds[pass];
-                APH_VERIFY_RESULT(pCmd->reset());
-                APH_VERIFY_RESULT(pCmd->begin());
-
-                // Collect attachment info
-                vk::RenderingInfo renderingInfo{};
-                {
-                    auto& colorAttachmentInfos = renderingInfo.colors;
-                    for (PassImageResource* colorAttachment : pass->m_resource.colorOut)
-                    {
-                        auto pColorImage                  = m_buildData.image[colorAttachment];
-                        vk::AttachmentInfo attachmentInfo = colorAttachment->getInfo().attachmentInfo;
-                        attachmentInfo.image              = pColorImage;
-                        colorAttachmentInfos.push_back(attachmentInfo);
-                        setupImageBarrier(initImageBarriers, colorAttachment, ResourceState::RenderTarget);
-                    }
-
-                    if (auto depthAttachment = pass->m_resource.depthOut; depthAttachment)
-                    {
-                        vk::Image* pDepthImage    = m_buildData.image[depthAttachment];
-                        renderingInfo.depth       = depthAttachment->getInfo().attachmentInfo;
-                        renderingInfo.depth.image = pDepthImage;
-                        setupImageBarrier(initImageBarriers, depthAttachment, ResourceState::DepthStencil);
-                    }
-
-                    pCmd->insertBarrier(initImageBarriers);
-                }
-
-                // setup resource barriers
-                {
-                    // Set up texture barriers
-                    for (PassImageResource* textureIn : pass->m_resource.textureIn)
-                    {
-                        ResourceState targetState = pass->m_resource.resourceStateMap[textureIn];
-                        setupResourceBarrier(imageBarriers, textureIn, targetState);
-                    }
-
-                    // Set up storage buffer barriers
-                    for (PassBufferResource* bufferIn : pass->m_resource.storageBufferIn)
-                    {
-                        ResourceState targetState = pass->m_resource.resourceStateMap[bufferIn];
-                        setupResourceBarrier(bufferBarriers, bufferIn, targetState);
-                    }
-
-                    // Set up uniform buffer barriers
-                    for (PassBufferResource* bufferIn : pass->m_resource.uniformBufferIn)
-                    {
-                        ResourceState targetState = pass->m_resource.resourceStateMap[bufferIn];
-                        setupResourceBarrier(bufferBarriers, bufferIn, targetState);
-                    }
-                }
-
-                // Record remain commands
-                {
-                    APH_PROFILER_SCOPE_NAME("pass commands submit");
-                    pCmd->insertDebugLabel({
-                        .name = pass->m_name, .color = { 0.6f, 0.6f, 0.6f, 0.6f }
-                    });
-                    pCmd->insertBarrier(m_buildData.bufferBarriers[pass], m_buildData.imageBarriers[pass]);
-
-                    pCmd->beginRendering(renderingInfo);
-                    if (!isDryRunMode())
-                    {
-                        APH_ASSERT(!pass->m_executeCB || pass->m_recordList.empty(),
-                                   "Pass cannot have both executeCB and recordList elements");
-
-                        if (pass->m_executeCB)
-                        {
-                            pass->m_executeCB(pCmd);
-                        }
-                        else
-                        {
-                            for (auto& [shaderName, executeCB] : pass->m_recordList)
-                            {
-                                auto* shaderProgram = m_buildData.program[shaderName];
-                                APH_ASSERT(shaderProgram != nullptr,
-                                           std::format("Shader program not found: {}", shaderName));
-                                pCmd->setProgram(shaderProgram);
-                                executeCB(pCmd);
-                            }
-                        }
-                    }
-                    pCmd->endRendering();
-                    APH_VERIFY_RESULT(pCmd->end());
-
-                    // Mark the pass breadcrumb as completed
-                    if (m_breadcrumbs.isEnabled())
-                    {
-                        recordPassBreadcrumb(pass, passIndex, false);
-
-                        // Integrate CommandBuffer breadcrumbs if available
-                        integrateCommandBufferBreadcrumbs(pass, pCmd);
-                    }
-
-                    vk::QueueSubmitInfo submitInfo{
-                        .commandBuffers   = { pCmd },
-                        .waitSemaphores   = {},
-                        .signalSemaphores = {},
-                    };
+                m_pCommandBufferAllocator->release(pCmd);
+            }
+            for (auto [pass, pCmd] : m_buildData.transitionCmds)
+            {
+                m_pCommandBufferAllocator->release(pCmd);
+            }
+            for (auto* pCmd : m_buildData.retiredCmds)
+            {
+                m_pCommandBufferAllocator->release(pCmd);
+            }
+            m_buildData.cmds.clear();
+            m_buildData.transitionCmds.clear();
+            m_buildData.retiredCmds.clear();
 
-                    std::lock_guard<std::mutex> holder{ m_buildData.submitLock };
-                    m_buildData.frameSubmitInfos.push_back(std::move(submitInfo));
-                }
+            // Barriers depend on the states left by earlier passes, so they are planned serially in submit order
+            if (m_compiledGraph.applied)
+            {
+                applyCompiledBarriers();
+            }
+            else
+            {
+                planBarriers();
             }
+            recordPasses(m_buildData.sortedPasses);
 
             if (m_breadcrumbs.isEnabled() && recordBreadcrumbIndex != UINT32_MAX)
             {
@@ -598,16 +569,67 @@ void RenderGraph::build(vk::SwapChain* pSwapChain)
             }
         }
 
+        // Barriers are planned without GPU objects so their count can be checked
+        if (m_compiledGraph.applied)
+        {
+            applyCompiledBarriers();
+        }
+        else
+        {
+            planBarriers();
+        }
+
         if (m_debugOutputEnabled)
         {
+            for (auto* pass : m_buildData.culledPasses)
+            {
+                RDG_LOG_INFO("[DryRun] Culled pass: %s", pass->m_name);
+            }
+
             RDG_LOG_INFO("[DryRun] Generated execution order:");
             for (uint32_t i = 1; auto* pass : m_buildData.sortedPasses)
             {
-                RDG_LOG_INFO("[DryRun] %u. %s", i++, pass->m_name);
+                RDG_LOG_INFO("[DryRun] %u. %s", i, pass->m_name);
+                i++;
+            }
+
+            const auto& barrierStats = m_buildData.barrierStats;
+            RDG_LOG_INFO("[DryRun] Barriers per frame: %u in %u batch(es), %u redundant transition(s) skipped",
+                         barrierStats.barrierCount, barrierStats.batchCount, barrierStats.skippedCount);
+
+            RDG_LOG_INFO("[DryRun] Queue submissions:");
+            for (uint32_t batchIndex = 0; batchIndex < m_buildData.submissionBatches.size(); ++batchIndex)
+            {
+                const auto& batch = m_buildData.submissionBatches[batchIndex];
+                RDG_LOG_INFO("[DryRun] Batch %u on %s queue: %zu pass(es), %zu cross-queue wait(s)", batchIndex,
+                             aph::vk::utils::toString(batch.queueType), batch.passes.size(), batch.waitBatches.size());
+                for (uint32_t waitBatchIndex : batch.waitBatches)
+                {
+                    RDG_LOG_DEBUG("[DryRun]   waits on batch %u", waitBatchIndex);
+                }
             }
         }
     }
 
+    if (m_compiledGraph.applied)
+    {
+        m_compiledGraph.pending.reset();
+    }
+    else if (!cachePath.empty())
+    {
+        if (auto result = saveCompiledGraph(cachePath); !result.success())
+        {
+            RDG_LOG_WARN("Failed to save compiled graph '%s': %s", cachePath, result.toString());
+        }
+    }
+
+    // Everything was recorded from scratch, pending incremental changes are covered
+    m_buildData.recordedPassCount = m_buildData.sortedPasses.size();
+    m_buildData.dirtyPasses.clear();
+    m_buildData.reboundResources.clear();
+    m_buildData.reboundImages.clear();
+    m_buildData.reboundBuffers.clear();
+
     // All dirty flags have been handled
     clearDirtyFlags();
 
@@ -638,200 +660,610 @@ void RenderGraph::setupImageResource(PassImageResource* imageResource, bool isCo
             m_pDevice->destroy(m_buildData.image[imageResource]);
         }
 
-        vk::Image* pImage = {};
-        vk::ImageCreateInfo createInfo{
-            .extent    = imageResource->getInfo().createInfo.extent,
-            .usage     = imageResource->getUsage(),
-            .domain    = MemoryDomain::Device, // Always use Device domain
-            .imageType = ImageType::e2D,
-            .format    = imageResource->getInfo().createInfo.format,
-        };
-
-        // Determine if this resource is transient - use memory hints if supported
-        bool isAttachment = isColorAttachment || (imageResource->getUsage() & ImageUsage::DepthStencil);
-
-        // Check if this can be a transient resource (not used externally or as back buffer)
-        if (!(imageResource->getFlags() & PassResourceFlagBits::eExternal) &&
-            imageResource->getName() != m_declareData.backBuffer && isAttachment)
-        {
-
-            // If it's an intermediate attachment with short lifetime, optimize memory usage
-            bool onlyUsedByRenderPass = true;
-            for (const auto& readPass : imageResource->getReadPasses())
-            {
-                for (const auto& passRes : readPass->m_resource.textureIn)
-                {
-                    if (passRes == imageResource)
-                    {
-                        onlyUsedByRenderPass = false;
-                        break;
-                    }
-                }
-                if (!onlyUsedByRenderPass)
-                    break;
-            }
-
-            if (onlyUsedByRenderPass)
-            {
-                // Just set this to standard device memory - your custom memory hints would go here
-
-                if (isDryRunMode() && m_debugOutputEnabled)
-                {
-                    RDG_LOG_INFO("[DryRun] Resource '%s' identified as transient", imageResource->getName());
-                }
-            }
-        }
+        vk::ImageCreateInfo createInfo = getImageCreateInfo(imageResource, isColorAttachment);
 
-        // Add transfer source usage for color attachments that might be presented
-        if (isColorAttachment && !m_declareData.backBuffer.empty() &&
-            m_declareData.resourceMap.contains(m_declareData.backBuffer))
+        // Transient attachments are bound into their aliased memory block
+        if (auto it = m_transientMemory.placementIndices.find(imageResource);
+            it != m_transientMemory.placementIndices.end() && !m_transientMemory.heapMemory.empty())
         {
-            createInfo.usage |= ImageUsage::TransferSrc;
+            const auto& placement   = m_transientMemory.plan.placements[it->second];
+            createInfo.pAliasMemory = m_transientMemory.heapMemory[placement.heapIndex];
+            createInfo.aliasOffset  = placement.offset;
         }
 
         auto imageResult = m_pDevice->create(createInfo, imageResource->getName());
         APH_VERIFY_RESULT(imageResult);
-        pImage                           = imageResult.value();
-        m_buildData.image[imageResource] = pImage;
+        m_buildData.image[imageResource] = imageResult.value();
 
         // Initialize resource state for newly created resources
         m_buildData.currentResourceStates[imageResource] = ResourceState::Undefined;
     }
 }
 
-void RenderGraph::setupImageBarrier(SmallVector<vk::ImageBarrier>& barriers, PassImageResource* resource,
-                                    ResourceState newState)
+void RenderGraph::setupPassBarriers(RenderPass* pass)
 {
     APH_PROFILER_SCOPE();
-    auto& image                = m_buildData.image[resource];
-    ResourceState currentState = m_buildData.currentResourceStates[resource];
 
-    barriers.push_back({
-        .pImage       = image,
-        .currentState = currentState,
-        .newState     = newState,
-    });
+    auto& imageBarriers  = m_buildData.imageBarriers[pass];
+    auto& bufferBarriers = m_buildData.bufferBarriers[pass];
 
-    // Update tracking
-    m_buildData.currentResourceStates[resource] = newState;
+    // Clear existing barriers, release barriers are added by later passes on other queues
+    imageBarriers.clear();
+    bufferBarriers.clear();
+    m_buildData.releaseImageBarriers[pass].clear();
+    m_buildData.releaseBufferBarriers[pass].clear();
+    m_buildData.barrierResources[pass] = {};
+
+    setupRenderingInfo(pass);
+
+    // Attachments transition before the inputs
+    for (PassImageResource* colorAttachment : pass->m_resource.colorOut)
+    {
+        setupImageBarrier(imageBarriers, pass, colorAttachment, ResourceState::RenderTarget);
+    }
+    if (auto depthAttachment = pass->m_resource.depthOut; depthAttachment)
+    {
+        setupImageBarrier(imageBarriers, pass, depthAttachment, ResourceState::DepthStencil);
+    }
+
+    // Reads transition into the state planned for their whole read run, see planReadStates
+    auto getReadState = [this, pass](PassResource* resource)
+    {
+        const auto& readStates = m_buildData.readStates.at(pass);
+        auto it                = readStates.find(resource);
+        return it != readStates.end() ? it->second : pass->m_resource.resourceStateMap[resource];
+    };
+
+    // Set up texture barriers
+    for (PassImageResource* textureIn : pass->m_resource.textureIn)
+    {
+        setupResourceBarrier(imageBarriers, pass, textureIn, getReadState(textureIn));
+    }
+
+    // Set up storage buffer barriers
+    for (PassBufferResource* bufferIn : pass->m_resource.storageBufferIn)
+    {
+        setupResourceBarrier(bufferBarriers, pass, bufferIn, getReadState(bufferIn));
+    }
+
+    // Set up uniform buffer barriers
+    for (PassBufferResource* bufferIn : pass->m_resource.uniformBufferIn)
+    {
+        setupResourceBarrier(bufferBarriers, pass, bufferIn, getReadState(bufferIn));
+    }
 }
 
-template <typename BarrierType, typename ResourceType>
-void RenderGraph::setupResourceBarrier(SmallVector<BarrierType>& barriers, ResourceType* resource,
-                                       ResourceState targetState)
+void RenderGraph::setupRenderingInfo(RenderPass* pass)
 {
     APH_PROFILER_SCOPE();
-    ResourceState currentState = m_buildData.currentResourceStates[resource];
 
-    if (currentState != targetState)
+    auto& renderingInfo = m_buildData.renderingInfos[pass];
+    renderingInfo       = {};
+
+    // Collect attachment info
+    auto& colorAttachmentInfos = renderingInfo.colors;
+    for (PassImageResource* colorAttachment : pass->m_resource.colorOut)
     {
-        if constexpr (std::is_same_v<ResourceType, PassImageResource>)
-        {
-            auto& image = m_buildData.image[resource];
-            barriers.push_back(BarrierType{
-                .pImage       = image,
-                .currentState = currentState,
-                .newState     = targetState,
-            });
-        }
-        else if constexpr (std::is_same_v<ResourceType, PassBufferResource>)
-        {
-            auto& buffer = m_buildData.buffer[resource];
-            barriers.push_back(BarrierType{
-                .pBuffer      = buffer,
-                .currentState = currentState,
-                .newState     = targetState,
-            });
-        }
+        auto pColorImage                  = m_buildData.image[colorAttachment];
+        vk::AttachmentInfo attachmentInfo = colorAttachment->getInfo().attachmentInfo;
+        attachmentInfo.image              = pColorImage;
+        colorAttachmentInfos.push_back(attachmentInfo);
+    }
 
-        // Update tracking
-        m_buildData.currentResourceStates[resource] = targetState;
+    if (auto depthAttachment = pass->m_resource.depthOut; depthAttachment)
+    {
+        vk::Image* pDepthImage    = m_buildData.image[depthAttachment];
+        renderingInfo.depth       = depthAttachment->getInfo().attachmentInfo;
+        renderingInfo.depth.image = pDepthImage;
     }
 }
 
-auto RenderGraph::importPassResource(const std::string& name, ResourcePtr resource) -> PassResource*
+auto RenderGraph::recordPass(RenderPass* pass) const -> vk::CommandBuffer*
 {
     APH_PROFILER_SCOPE();
 
-    if (isDryRunMode())
+    // Acquired on the recording thread, so it comes from that thread's command pool
+    auto* pCmd = m_pCommandBufferAllocator->acquire(pass->getQueueType());
+    APH_VERIFY_RESULT(pCmd->begin());
+
+    pCmd->insertDebugLabel({
+        .name = pass->m_name, .color = { 0.6f, 0.6f, 0.6f, 0.6f }
+    });
+
+    // Attachment and input transitions go out as a single barrier command
+    if (const auto& bufferBarriers = m_buildData.bufferBarriers.at(pass),
+        &imageBarriers             = m_buildData.imageBarriers.at(pass);
+        !bufferBarriers.empty() || !imageBarriers.empty())
     {
-        auto type =
-            std::holds_alternative<vk::Buffer*>(resource) ? PassResource::Type::eBuffer : PassResource::Type::eImage;
+        pCmd->insertBarrier(bufferBarriers, imageBarriers);
+    }
 
-        auto* res = createPassResource(name, type);
+    pCmd->beginRendering(m_buildData.renderingInfos.at(pass));
+    {
+        APH_ASSERT(!pass->m_executeCB || pass->m_recordList.empty(),
+                   "Pass cannot have both executeCB and recordList elements");
 
-        if (m_debugOutputEnabled)
+        if (pass->m_executeCB)
         {
-            const char* typeStr = (type == PassResource::Type::eBuffer) ? "Buffer" : "Image";
-            RDG_LOG_INFO("[DryRun] Imported resource '%s' of type %s", name, typeStr);
+            pass->m_executeCB(pCmd);
         }
-
-        res->addFlags(PassResourceFlagBits::eExternal);
-        m_buildData.currentResourceStates[res] = ResourceState::General;
-        return res;
-    }
-
-    PassResource* passResource = std::visit(
-        [this, &name](auto* ptr) -> PassResource*
+        else
         {
-            using T = std::decay_t<decltype(*ptr)>;
-
-            if constexpr (std::is_same_v<T, vk::Buffer>)
-            {
-                auto res = createPassResource(name, PassResource::Type::eBuffer);
-                if (m_buildData.buffer.contains(res) && m_buildData.buffer[res] != ptr)
-                {
-                    RDG_LOG_WARN("Resource %s will be overrided.", name);
-                }
-                m_buildData.buffer[res] = ptr;
-                markBufferResourcesModified();
-                return res;
-            }
-            else if constexpr (std::is_same_v<T, vk::Image>)
-            {
-                auto res = createPassResource(name, PassResource::Type::eImage);
-                if (m_buildData.image.contains(res) && m_buildData.image[res] != ptr)
-                {
-                    RDG_LOG_WARN("Resource %s will be overrided.", name);
-                }
-                m_buildData.image[res] = ptr;
-                markImageResourcesModified();
-                return res;
-            }
-            else
+            for (auto& [shaderName, executeCB] : pass->m_recordList)
             {
-                static_assert(dependent_false_v<T>, "Unsupported resource type");
-                return nullptr;
+                auto it = m_buildData.program.find(shaderName);
+                APH_ASSERT(it != m_buildData.program.end(), std::format("Shader program not found: {}", shaderName));
+                pCmd->setProgram(it->second);
+                executeCB(pCmd);
             }
-        },
-        resource);
+        }
+    }
+    pCmd->endRendering();
+    if (const auto& releaseBufferBarriers = m_buildData.releaseBufferBarriers.at(pass),
+        &releaseImageBarriers             = m_buildData.releaseImageBarriers.at(pass);
+        !releaseBufferBarriers.empty() || !releaseImageBarriers.empty())
+    {
+        pCmd->insertBarrier(releaseBufferBarriers, releaseImageBarriers);
+    }
+    APH_VERIFY_RESULT(pCmd->end());
 
-    passResource->addFlags(PassResourceFlagBits::eExternal);
-    m_buildData.currentResourceStates[passResource] = ResourceState::General;
+    return pCmd;
+}
 
-    // Mark that the graph topology has changed
-    markTopologyModified();
+auto RenderGraph::recordPassTransitions(RenderPass* pass) const -> vk::CommandBuffer*
+{
+    APH_PROFILER_SCOPE();
 
-    return passResource;
+    // Substitutes the pass when its condition is false, so later passes still see the layouts they expect
+    auto* pCmd = m_pCommandBufferAllocator->acquire(pass->getQueueType());
+    APH_VERIFY_RESULT(pCmd->begin());
+    pCmd->insertBarrier(m_buildData.bufferBarriers.at(pass), m_buildData.imageBarriers.at(pass));
+    if (const auto& releaseBufferBarriers = m_buildData.releaseBufferBarriers.at(pass),
+        &releaseImageBarriers             = m_buildData.releaseImageBarriers.at(pass);
+        !releaseBufferBarriers.empty() || !releaseImageBarriers.empty())
+    {
+        pCmd->insertBarrier(releaseBufferBarriers, releaseImageBarriers);
+    }
+    APH_VERIFY_RESULT(pCmd->end());
+
+    return pCmd;
 }
 
-auto RenderGraph::createPassResource(const std::string& name, PassResource::Type type) -> PassResource*
+void RenderGraph::recordPasses(ArrayProxy<RenderPass*> passes)
 {
     APH_PROFILER_SCOPE();
-    if (m_declareData.resourceMap.contains(name))
+
+    const auto& sortedPasses = m_buildData.sortedPasses;
+    auto passIndexOf         = [&sortedPasses](RenderPass* pass) -> uint32_t
+    { return static_cast<uint32_t>(std::ranges::find(sortedPasses, pass) - sortedPasses.begin()); };
+
+    if (m_breadcrumbs.isEnabled())
     {
-        auto res = m_declareData.resourceMap.at(name);
-        APH_ASSERT(res->getType() == type);
-        return res;
+        for (auto* pass : passes)
+        {
+            recordPassBreadcrumb(pass, passIndexOf(pass), true);
+        }
     }
 
-    PassResource* res = {};
-    switch (type)
+    // Recording only reads the planned data, each pass is recorded on a worker with its own command pool
+    std::vector<vk::CommandBuffer*> passCmds(passes.size(), nullptr);
+    std::vector<vk::CommandBuffer*> passTransitionCmds(passes.size(), nullptr);
     {
-    case PassResource::Type::eImage:
-        res = m_resourcePool.passImageResource.allocate(type);
-        markImageResourcesModified();
-        break;
+        APH_PROFILER_SCOPE_NAME("pass commands recording");
+        // Groups live until the task manager is cleaned up, one per graph is reused for every build
+        if (!m_pRecordGroup)
+        {
+            m_pRecordGroup = APH_DEFAULT_TASK_MANAGER.createTaskGroup("render graph recording");
+        }
+        for (uint32_t index = 0; index < passes.size(); index++)
+        {
+            m_pRecordGroup->addTask(
+                [](RenderGraph* pGraph, RenderPass* pass, vk::CommandBuffer** ppCmd,
+                   vk::CommandBuffer** ppTransitionCmd) -> TaskType
+                {
+                    *ppCmd = pGraph->recordPass(pass);
+                    if (pass->m_executionMode == RenderPass::ExecutionMode::eConditional)
+                    {
+                        *ppTransitionCmd = pGraph->recordPassTransitions(pass);
+                    }
+                    co_return Result::Success;
+                }(this, passes[index], &passCmds[index], &passTransitionCmds[index]));
+        }
+        APH_VERIFY_RESULT(m_pRecordGroup->submit());
+    }
+
+    std::lock_guard<std::mutex> holder{ m_buildData.submitLock };
+    for (uint32_t index = 0; index < passes.size(); index++)
+    {
+        auto* pass = passes[index];
+
+        // Replaced command buffers may still be executing, they are released once the frame fence is waited on
+        if (auto it = m_buildData.cmds.find(pass); it != m_buildData.cmds.end())
+        {
+            m_buildData.retiredCmds.push_back(it->second);
+        }
+        if (auto it = m_buildData.transitionCmds.find(pass); it != m_buildData.transitionCmds.end())
+        {
+            m_buildData.retiredCmds.push_back(it->second);
+            m_buildData.transitionCmds.erase(it);
+        }
+
+        m_buildData.cmds[pass] = passCmds[index];
+        if (passTransitionCmds[index])
+        {
+            m_buildData.transitionCmds[pass] = passTransitionCmds[index];
+        }
+
+        // Mark the pass breadcrumb as completed
+        if (m_breadcrumbs.isEnabled())
+        {
+            recordPassBreadcrumb(pass, passIndexOf(pass), false);
+
+            // Integrate CommandBuffer breadcrumbs if available
+            integrateCommandBufferBreadcrumbs(pass, passCmds[index]);
+        }
+    }
+
+    // Submit infos keep the sorted order regardless of which worker finished first
+    for (auto& batch : m_buildData.submissionBatches)
+    {
+        batch.submitInfo = {};
+        for (auto* pass : batch.passes)
+        {
+            batch.submitInfo.commandBuffers.push_back(m_buildData.cmds.at(pass));
+        }
+    }
+}
+
+void RenderGraph::rebuildDirtyPasses()
+{
+    APH_PROFILER_SCOPE();
+
+    auto& dirtyPasses = m_buildData.dirtyPasses;
+
+    // Passes using a rebound resource record its new handle, and the planned barriers and attachments
+    // are patched in place since the resource states did not change
+    for (auto* resource : m_buildData.reboundResources)
+    {
+        dirtyPasses.insert(resource->getReadPasses().begin(), resource->getReadPasses().end());
+        dirtyPasses.insert(resource->getWritePasses().begin(), resource->getWritePasses().end());
+    }
+    if (!m_buildData.reboundImages.empty() || !m_buildData.reboundBuffers.empty())
+    {
+        auto patch = [](auto& rebound, auto*& pResource)
+        {
+            if (auto it = rebound.find(pResource); it != rebound.end())
+            {
+                pResource = it->second;
+                return true;
+            }
+            return false;
+        };
+        auto patchBarriers = [&patch](auto& barrierMap, RenderPass* pass, auto& rebound, auto member)
+        {
+            bool patched = false;
+            if (auto it = barrierMap.find(pass); it != barrierMap.end())
+            {
+                for (auto& barrier : it->second)
+                {
+                    patched |= patch(rebound, barrier.*member);
+                }
+            }
+            return patched;
+        };
+
+        for (auto* pass : m_buildData.sortedPasses)
+        {
+            bool patched = false;
+            patched |= patchBarriers(m_buildData.imageBarriers, pass, m_buildData.reboundImages,
+                                     &vk::ImageBarrier::pImage);
+            patched |= patchBarriers(m_buildData.releaseImageBarriers, pass, m_buildData.reboundImages,
+                                     &vk::ImageBarrier::pImage);
+            patched |= patchBarriers(m_buildData.bufferBarriers, pass, m_buildData.reboundBuffers,
+                                     &vk::BufferBarrier::pBuffer);
+            patched |= patchBarriers(m_buildData.releaseBufferBarriers, pass, m_buildData.reboundBuffers,
+                                     &vk::BufferBarrier::pBuffer);
+
+            if (auto it = m_buildData.renderingInfos.find(pass); it != m_buildData.renderingInfos.end())
+            {
+                for (auto& color : it->second.colors)
+                {
+                    patched |= patch(m_buildData.reboundImages, color.image);
+                }
+                patched |= patch(m_buildData.reboundImages, it->second.depth.image);
+            }
+
+            if (patched)
+            {
+                dirtyPasses.insert(pass);
+            }
+        }
+    }
+    m_buildData.reboundResources.clear();
+    m_buildData.reboundImages.clear();
+    m_buildData.reboundBuffers.clear();
+
+    // Culled passes are never recorded
+    SmallVector<RenderPass*> passes;
+    for (auto* pass : m_buildData.sortedPasses)
+    {
+        if (dirtyPasses.contains(pass))
+        {
+            passes.push_back(pass);
+        }
+    }
+    dirtyPasses.clear();
+    m_buildData.recordedPassCount = passes.size();
+
+    if (isDryRunMode())
+    {
+        if (m_debugOutputEnabled)
+        {
+            RDG_LOG_INFO("[DryRun] Incremental build: re-recording %zu of %zu passes", passes.size(),
+                         m_buildData.sortedPasses.size());
+        }
+        return;
+    }
+
+    if (!passes.empty())
+    {
+        recordPasses(passes);
+    }
+}
+
+auto RenderGraph::getImageCreateInfo(PassImageResource* imageResource, bool isColorAttachment) const
+    -> vk::ImageCreateInfo
+{
+    vk::ImageCreateInfo createInfo{
+        .extent    = imageResource->getInfo().createInfo.extent,
+        .usage     = imageResource->getUsage(),
+        .domain    = MemoryDomain::Device, // Always use Device domain
+        .imageType = ImageType::e2D,
+        .format    = imageResource->getInfo().createInfo.format,
+    };
+
+    // Add transfer source usage for color attachments that might be presented
+    if (isColorAttachment && !m_declareData.backBuffer.empty() &&
+        m_declareData.resourceMap.contains(m_declareData.backBuffer))
+    {
+        createInfo.usage |= ImageUsage::TransferSrc;
+    }
+
+    return createInfo;
+}
+
+void RenderGraph::setupImageBarrier(SmallVector<vk::ImageBarrier>& barriers, RenderPass* pass,
+                                    PassImageResource* resource, ResourceState newState)
+{
+    APH_PROFILER_SCOPE();
+    auto& image                = m_buildData.image[resource];
+    ResourceState currentState = m_buildData.currentResourceStates[resource];
+
+    vk::ImageBarrier barrier{
+        .pImage       = image,
+        .currentState = currentState,
+        .newState     = newState,
+    };
+    setupOwnershipTransfer(barrier, pass, resource);
+    barriers.push_back(barrier);
+    m_buildData.barrierResources[pass].image.push_back(resource);
+
+    // Update tracking
+    m_buildData.currentResourceStates[resource] = newState;
+}
+
+template <typename BarrierType, typename ResourceType>
+void RenderGraph::setupResourceBarrier(SmallVector<BarrierType>& barriers, RenderPass* pass, ResourceType* resource,
+                                       ResourceState targetState)
+{
+    APH_PROFILER_SCOPE();
+    ResourceState currentState = m_buildData.currentResourceStates[resource];
+
+    BarrierType barrier{};
+    if constexpr (std::is_same_v<ResourceType, PassImageResource>)
+    {
+        barrier.pImage = m_buildData.image[resource];
+    }
+    else if constexpr (std::is_same_v<ResourceType, PassBufferResource>)
+    {
+        barrier.pBuffer = m_buildData.buffer[resource];
+    }
+    barrier.currentState = currentState;
+    barrier.newState     = targetState;
+
+    // A queue family change needs a barrier even if the state stays the same
+    setupOwnershipTransfer(barrier, pass, resource);
+    if (currentState != targetState || barrier.acquire)
+    {
+        barriers.push_back(barrier);
+        auto& barrierResources = m_buildData.barrierResources[pass];
+        if constexpr (std::is_same_v<BarrierType, vk::ImageBarrier>)
+        {
+            barrierResources.image.push_back(resource);
+        }
+        else
+        {
+            barrierResources.buffer.push_back(resource);
+        }
+
+        // Update tracking
+        m_buildData.currentResourceStates[resource] = targetState;
+    }
+    else
+    {
+        m_buildData.barrierStats.skippedCount++;
+    }
+}
+
+template <typename BarrierType>
+void RenderGraph::setupOwnershipTransfer(BarrierType& barrier, RenderPass* pass, PassResource* resource)
+{
+    APH_PROFILER_SCOPE();
+
+    auto& pOwner = m_buildData.resourceOwners[resource];
+    RenderPass* pPrevOwner = std::exchange(pOwner, pass);
+
+    // Undefined contents are discarded, so there is nothing to hand over
+    if (!pPrevOwner || barrier.currentState == ResourceState::Undefined ||
+        !needsOwnershipTransfer(pPrevOwner->getQueueType(), pass->getQueueType()))
+    {
+        return;
+    }
+
+    // The release half runs at the end of the previous owner with the same layout transition
+    BarrierType releaseBarrier = barrier;
+    releaseBarrier.queueType   = pass->getQueueType();
+    releaseBarrier.release     = 1;
+    if constexpr (std::is_same_v<BarrierType, vk::ImageBarrier>)
+    {
+        m_buildData.releaseImageBarriers[pPrevOwner].push_back(releaseBarrier);
+        m_buildData.barrierResources[pPrevOwner].releaseImage.push_back(resource);
+    }
+    else
+    {
+        m_buildData.releaseBufferBarriers[pPrevOwner].push_back(releaseBarrier);
+        m_buildData.barrierResources[pPrevOwner].releaseBuffer.push_back(resource);
+    }
+
+    barrier.queueType = pPrevOwner->getQueueType();
+    barrier.acquire   = 1;
+}
+
+auto RenderGraph::importPassResource(const std::string& name, ResourcePtr resource) -> PassResource*
+{
+    APH_PROFILER_SCOPE();
+
+    if (isDryRunMode())
+    {
+        auto type =
+            std::holds_alternative<vk::Buffer*>(resource) ? PassResource::Type::eBuffer : PassResource::Type::eImage;
+
+        auto* res = createPassResource(name, type);
+
+        if (m_debugOutputEnabled)
+        {
+            const char* typeStr = (type == PassResource::Type::eBuffer) ? "Buffer" : "Image";
+            RDG_LOG_INFO("[DryRun] Imported resource '%s' of type %s", name, typeStr);
+        }
+
+        res->addFlags(PassResourceFlagBits::eExternal);
+        m_buildData.currentResourceStates[res] = ResourceState::General;
+        return res;
+    }
+
+    // Re-importing under an existing name only swaps the GPU object, the compiled graph is patched in place
+    if (auto it = m_declareData.resourceMap.find(name);
+        it != m_declareData.resourceMap.end() && (it->second->getFlags() & PassResourceFlagBits::eExternal))
+    {
+        auto* passResource = it->second;
+        auto  rebind       = [passResource](auto& bound, auto& rebound, auto* ptr) -> bool
+        {
+            auto boundIt = bound.find(passResource);
+            if (boundIt == bound.end())
+            {
+                return false;
+            }
+
+            auto* pOld = boundIt->second;
+            if (pOld != ptr)
+            {
+                // Chained rebinds within one frame resolve to the latest object
+                for (auto& [pFrom, pTo] : rebound)
+                {
+                    if (pTo == pOld)
+                    {
+                        pTo = ptr;
+                    }
+                }
+                rebound[pOld]   = ptr;
+                boundIt->second = ptr;
+            }
+            return true;
+        };
+
+        bool rebound = std::visit(
+            [this, &rebind](auto* ptr) -> bool
+            {
+                using T = std::decay_t<decltype(*ptr)>;
+                if constexpr (std::is_same_v<T, vk::Buffer>)
+                {
+                    return rebind(m_buildData.buffer, m_buildData.reboundBuffers, ptr);
+                }
+                else
+                {
+                    return rebind(m_buildData.image, m_buildData.reboundImages, ptr);
+                }
+            },
+            resource);
+
+        if (rebound)
+        {
+            markResourceRebound(passResource);
+            return passResource;
+        }
+    }
+
+    PassResource* passResource = std::visit(
+        [this, &name](auto* ptr) -> PassResource*
+        {
+            using T = std::decay_t<decltype(*ptr)>;
+
+            if constexpr (std::is_same_v<T, vk::Buffer>)
+            {
+                auto res = createPassResource(name, PassResource::Type::eBuffer);
+                if (m_buildData.buffer.contains(res) && m_buildData.buffer[res] != ptr)
+                {
+                    RDG_LOG_WARN("Resource %s will be overrided.", name);
+                }
+                m_buildData.buffer[res] = ptr;
+                markBufferResourcesModified();
+                return res;
+            }
+            else if constexpr (std::is_same_v<T, vk::Image>)
+            {
+                auto res = createPassResource(name, PassResource::Type::eImage);
+                if (m_buildData.image.contains(res) && m_buildData.image[res] != ptr)
+                {
+                    RDG_LOG_WARN("Resource %s will be overrided.", name);
+                }
+                m_buildData.image[res] = ptr;
+                markImageResourcesModified();
+                return res;
+            }
+            else
+            {
+                static_assert(dependent_false_v<T>, "Unsupported resource type");
+                return nullptr;
+            }
+        },
+        resource);
+
+    passResource->addFlags(PassResourceFlagBits::eExternal);
+    m_buildData.currentResourceStates[passResource] = ResourceState::General;
+
+    // Mark that the graph topology has changed
+    markTopologyModified();
+
+    return passResource;
+}
+
+auto RenderGraph::createPassResource(const std::string& name, PassResource::Type type) -> PassResource*
+{
+    APH_PROFILER_SCOPE();
+    if (m_declareData.resourceMap.contains(name))
+    {
+        auto res = m_declareData.resourceMap.at(name);
+        APH_ASSERT(res->getType() == type);
+        return res;
+    }
+
+    PassResource* res = {};
+    switch (type)
+    {
+    case PassResource::Type::eImage:
+        res = m_resourcePool.passImageResource.allocate(type);
+        markImageResourcesModified();
+        break;
     case PassResource::Type::eBuffer:
         res = m_resourcePool.passBufferResource.allocate(type);
         markBufferResourcesModified();
@@ -883,6 +1315,12 @@ void RenderGraph::execute(vk::Fence** ppFence)
 
             for (auto* pass : m_buildData.sortedPasses)
             {
+                if (!pass->shouldExecute())
+                {
+                    RDG_LOG_INFO("[DryRun] Skipping pass: %s (execution condition is false)", pass->m_name);
+                    continue;
+                }
+
                 RDG_LOG_INFO("[DryRun] Executing pass: %s", pass->m_name);
 
                 // Debug info about resources used by this pass
@@ -918,135 +1356,1134 @@ void RenderGraph::execute(vk::Fence** ppFence)
                     }
                 }
 
-                if (!pass->m_resource.uniformBufferIn.empty())
-                {
-                    RDG_LOG_DEBUG("[DryRun]   Reading uniform buffers: ");
-                    for (auto* buf : pass->m_resource.uniformBufferIn)
-                    {
-                        RDG_LOG_DEBUG("%s ", buf->getName());
-                    }
-                }
+                if (!pass->m_resource.uniformBufferIn.empty())
+                {
+                    RDG_LOG_DEBUG("[DryRun]   Reading uniform buffers: ");
+                    for (auto* buf : pass->m_resource.uniformBufferIn)
+                    {
+                        RDG_LOG_DEBUG("%s ", buf->getName());
+                    }
+                }
+
+                if (!pass->m_resource.storageBufferOut.empty())
+                {
+                    RDG_LOG_DEBUG("[DryRun]   Writing storage buffers: ");
+                    for (auto* buf : pass->m_resource.storageBufferOut)
+                    {
+                        RDG_LOG_DEBUG("%s ", buf->getName());
+                    }
+                }
+            }
+
+            RDG_LOG_INFO("[DryRun] Render graph execution completed");
+
+            if (!m_declareData.backBuffer.empty())
+            {
+                RDG_LOG_INFO("[DryRun] Presenting back buffer: %s", m_declareData.backBuffer);
+            }
+        }
+
+        // Mark execute as completed in dry run mode
+        if (m_breadcrumbs.isEnabled() && executeBreadcrumbIndex != UINT32_MAX)
+        {
+            m_breadcrumbs.updateBreadcrumb(executeBreadcrumbIndex, BreadcrumbState::Completed);
+        }
+
+        return;
+    }
+
+    // Create submission breadcrumb
+    uint32_t submissionBreadcrumbIndex = UINT32_MAX;
+    if (m_breadcrumbs.isEnabled())
+    {
+        submissionBreadcrumbIndex =
+            m_breadcrumbs.addBreadcrumb("Queue Submit", "Submitting to GPU queue", executeBreadcrumbIndex);
+        m_breadcrumbs.updateBreadcrumb(submissionBreadcrumbIndex, BreadcrumbState::InProgress);
+    }
+
+    // submit && present
+    {
+        if (ppFence)
+        {
+            *ppFence = m_buildData.frameExecuteFence;
+        }
+
+        vk::Fence* frameFence = m_buildData.frameExecuteFence;
+        {
+            frameFence->wait();
+            frameFence->reset();
+        }
+
+        std::lock_guard<std::mutex> holder{ m_buildData.submitLock };
+        auto& batches = m_buildData.submissionBatches;
+
+        // The previous frame is done with the command buffers replaced since then
+        for (auto* pCmd : m_buildData.retiredCmds)
+        {
+            m_pCommandBufferAllocator->release(pCmd);
+        }
+        m_buildData.retiredCmds.clear();
+
+        // Conditions are evaluated every frame, a skipped pass still performs its layout transitions
+        for (auto [pass, pTransitionCmd] : m_buildData.transitionCmds)
+        {
+            auto& batch      = batches[m_buildData.passBatchIndices.at(pass)];
+            auto cmdIndex    = std::ranges::find(batch.passes, pass) - batch.passes.begin();
+            auto* pCmd       = pass->shouldExecute() ? m_buildData.cmds[pass] : pTransitionCmd;
+            batch.submitInfo.commandBuffers[cmdIndex] = pCmd;
+        }
+
+        // Timeline values of this frame start after the ones signaled by the previous frame. The scratch
+        // containers live in frame memory when the graph belongs to a FrameComposer.
+        SmallVector<QueueType> queueOrder;
+        FrameHashMap<QueueType, uint32_t> queueBatchCounts(m_pFrameAllocator);
+        for (const auto& batch : batches)
+        {
+            auto& timeline = m_buildData.queueTimelines[batch.queueType];
+            if (!timeline.pSemaphore)
+            {
+                timeline.pSemaphore = m_pDevice->acquireTimelineSemaphore();
+            }
+            if (queueBatchCounts[batch.queueType]++ == 0)
+            {
+                queueOrder.push_back(batch.queueType);
+            }
+        }
+
+        FrameHashMap<QueueType, SmallVector<vk::QueueSubmitInfo>> queueSubmitInfos(m_pFrameAllocator);
+        for (const auto& batch : batches)
+        {
+            const auto& timeline = m_buildData.queueTimelines[batch.queueType];
+
+            auto& submitInfo = queueSubmitInfos[batch.queueType].emplace_back(batch.submitInfo);
+            submitInfo.signalSemaphores.push_back(timeline.pSemaphore);
+            submitInfo.signalValues.push_back(timeline.value + batch.queueBatchIndex + 1);
+            for (uint32_t waitBatchIndex : batch.waitBatches)
+            {
+                const auto& waitBatch    = batches[waitBatchIndex];
+                const auto& waitTimeline = m_buildData.queueTimelines[waitBatch.queueType];
+                submitInfo.waitSemaphores.push_back(waitTimeline.pSemaphore);
+                submitInfo.waitValues.push_back(waitTimeline.value + waitBatch.queueBatchIndex + 1);
+            }
+        }
+
+        // The frame fence is signaled on the queue of the last batch, once every other queue has drained
+        QueueType fenceQueueType = batches.empty() ? QueueType::Graphics : batches.back().queueType;
+        if (queueOrder.size() > 1)
+        {
+            vk::QueueSubmitInfo joinInfo{};
+            for (QueueType queueType : queueOrder)
+            {
+                if (queueType != fenceQueueType)
+                {
+                    const auto& timeline = m_buildData.queueTimelines[queueType];
+                    joinInfo.waitSemaphores.push_back(timeline.pSemaphore);
+                    joinInfo.waitValues.push_back(timeline.value + queueBatchCounts[queueType]);
+                }
+            }
+            queueSubmitInfos[fenceQueueType].push_back(std::move(joinInfo));
+        }
+
+        for (QueueType queueType : queueOrder)
+        {
+            m_buildData.queueTimelines[queueType].value += queueBatchCounts[queueType];
+            if (queueType != fenceQueueType)
+            {
+                APH_VERIFY_RESULT(m_pDevice->getQueue(queueType)->submit(queueSubmitInfos[queueType], nullptr));
+            }
+        }
+        APH_VERIFY_RESULT(m_pDevice->getQueue(fenceQueueType)->submit(queueSubmitInfos[fenceQueueType], frameFence));
+
+        // Mark submission as completed
+        if (m_breadcrumbs.isEnabled() && submissionBreadcrumbIndex != UINT32_MAX)
+        {
+            m_breadcrumbs.updateBreadcrumb(submissionBreadcrumbIndex, BreadcrumbState::Completed);
+        }
+
+        // Create present breadcrumb if there's a swapchain
+        if (m_buildData.pSwapchain)
+        {
+            uint32_t presentBreadcrumbIndex = UINT32_MAX;
+            if (m_breadcrumbs.isEnabled())
+            {
+                presentBreadcrumbIndex =
+                    m_breadcrumbs.addBreadcrumb("Present", "Presenting to screen", executeBreadcrumbIndex);
+                m_breadcrumbs.updateBreadcrumb(presentBreadcrumbIndex, BreadcrumbState::InProgress);
+            }
+
+            auto outImage = m_buildData.image[m_declareData.resourceMap[m_declareData.backBuffer]];
+
+            // Update resource state for the back buffer to Present state
+            m_buildData.currentResourceStates[m_declareData.resourceMap[m_declareData.backBuffer]] =
+                ResourceState::Present;
+
+            APH_VERIFY_RESULT(m_buildData.pSwapchain->presentImage({}, outImage));
+
+            // Mark present as completed
+            if (m_breadcrumbs.isEnabled() && presentBreadcrumbIndex != UINT32_MAX)
+            {
+                m_breadcrumbs.updateBreadcrumb(presentBreadcrumbIndex, BreadcrumbState::Completed);
+
+                // Mark frame as completed since present is the last operation in a frame
+                uint32_t frameIndex = m_breadcrumbs.findBreadcrumb("Frame");
+                if (frameIndex != UINT32_MAX)
+                {
+                    m_breadcrumbs.updateBreadcrumb(frameIndex, BreadcrumbState::Completed);
+                }
+            }
+        }
+    }
+
+    // Mark execute as completed
+    if (m_breadcrumbs.isEnabled() && executeBreadcrumbIndex != UINT32_MAX)
+    {
+        m_breadcrumbs.updateBreadcrumb(executeBreadcrumbIndex, BreadcrumbState::Completed);
+
+        // Mark frame as completed if there's no swapchain (meaning this is the last operation)
+        if (!m_buildData.pSwapchain)
+        {
+            uint32_t frameIndex = m_breadcrumbs.findBreadcrumb("Frame");
+            if (frameIndex != UINT32_MAX)
+            {
+                m_breadcrumbs.updateBreadcrumb(frameIndex, BreadcrumbState::Completed);
+            }
+        }
+    }
+}
+
+void RenderGraph::setBackBuffer(const std::string& backBuffer)
+{
+    APH_PROFILER_SCOPE();
+    m_declareData.backBuffer = backBuffer;
+    markBackBufferModified();
+
+    if (isDryRunMode() && m_debugOutputEnabled)
+    {
+        RDG_LOG_INFO("[DryRun] Set back buffer to '%s'", backBuffer.c_str());
+    }
+}
+
+void RenderGraph::exportResource(const std::string& name)
+{
+    APH_PROFILER_SCOPE();
+    m_declareData.exportedResources.insert(name);
+    markTopologyModified();
+
+    if (isDryRunMode() && m_debugOutputEnabled)
+    {
+        RDG_LOG_INFO("[DryRun] Exported resource '%s'", name.c_str());
+    }
+}
+
+void RenderGraph::cullPasses()
+{
+    APH_PROFILER_SCOPE();
+
+    auto& sortedPasses = m_buildData.sortedPasses;
+    m_buildData.culledPasses.clear();
+
+    // Resources whose contents are observed outside of this graph
+    SmallVector<PassResource*> rootResources;
+    for (auto [name, resource] : m_declareData.resourceMap)
+    {
+        if (name == m_declareData.backBuffer || m_declareData.exportedResources.contains(name) ||
+            (resource->getFlags() & (PassResourceFlagBits::eExternal | PassResourceFlagBits::eShared)))
+        {
+            rootResources.push_back(resource);
+        }
+    }
+
+    HashSet<RenderPass*> livePasses;
+    SmallVector<RenderPass*> worklist;
+    auto markLive = [&livePasses, &worklist](RenderPass* pass)
+    {
+        if (pass->m_executionMode != RenderPass::ExecutionMode::eCulled && livePasses.insert(pass).second)
+        {
+            worklist.push_back(pass);
+        }
+    };
+
+    if (rootResources.empty())
+    {
+        // Nothing leaves the graph, so only explicit culling applies
+        for (auto* pass : sortedPasses)
+        {
+            markLive(pass);
+        }
+    }
+    else
+    {
+        for (auto* resource : rootResources)
+        {
+            for (auto* writePass : resource->getWritePasses())
+            {
+                markLive(writePass);
+            }
+        }
+    }
+
+    // Walk backwards: everything a live pass reads keeps its producers alive
+    HashMap<RenderPass*, SmallVector<PassResource*>> passReads;
+    for (auto [name, resource] : m_declareData.resourceMap)
+    {
+        for (auto* readPass : resource->getReadPasses())
+        {
+            passReads[readPass].push_back(resource);
+        }
+    }
+
+    while (!worklist.empty())
+    {
+        auto* pass = worklist.back();
+        worklist.pop_back();
+
+        if (auto it = passReads.find(pass); it != passReads.end())
+        {
+            for (auto* resource : it->second)
+            {
+                for (auto* writePass : resource->getWritePasses())
+                {
+                    markLive(writePass);
+                }
+            }
+        }
+    }
+
+    SmallVector<RenderPass*> livePassOrder;
+    for (auto* pass : sortedPasses)
+    {
+        if (livePasses.contains(pass))
+        {
+            livePassOrder.push_back(pass);
+        }
+        else
+        {
+            m_buildData.culledPasses.push_back(pass);
+        }
+    }
+    sortedPasses = std::move(livePassOrder);
+}
+
+namespace
+{
+// States that only read, any number of them can be combined without a barrier in between
+constexpr uint32_t ReadOnlyResourceStates =
+    static_cast<uint32_t>(ResourceState::UniformBuffer) | static_cast<uint32_t>(ResourceState::VertexBuffer) |
+    static_cast<uint32_t>(ResourceState::IndexBuffer) | static_cast<uint32_t>(ResourceState::IndirectArgument) |
+    static_cast<uint32_t>(ResourceState::ShaderResource) | static_cast<uint32_t>(ResourceState::CopySource) |
+    static_cast<uint32_t>(ResourceState::ResolveSource) | static_cast<uint32_t>(ResourceState::AccelStructRead);
+
+auto isReadOnlyState(ResourceState state) -> bool
+{
+    auto mask = static_cast<uint32_t>(state);
+    return mask != 0 && (mask & ~ReadOnlyResourceStates) == 0;
+}
+
+auto combineStates(ResourceState lhs, ResourceState rhs) -> ResourceState
+{
+    return static_cast<ResourceState>(static_cast<uint32_t>(lhs) | static_cast<uint32_t>(rhs));
+}
+} // namespace
+
+void RenderGraph::planReadStates()
+{
+    APH_PROFILER_SCOPE();
+
+    // Consecutive reads of a resource share one transition into the union of their states, issued
+    // before the first of them, as long as they agree on the image layout
+    struct ReadRun
+    {
+        SmallVector<RenderPass*> passes;
+        ResourceState state = ResourceState::Undefined;
+    };
+    HashMap<PassResource*, ReadRun> openRuns;
+
+    auto& readStates = m_buildData.readStates;
+    readStates.clear();
+
+    auto closeRun = [&readStates](PassResource* resource, ReadRun& run)
+    {
+        for (auto* pass : run.passes)
+        {
+            readStates[pass][resource] = run.state;
+        }
+        run = {};
+    };
+
+    auto canMerge = [](PassResource* resource, ResourceState lhs, ResourceState rhs)
+    {
+        if (!isReadOnlyState(lhs) || !isReadOnlyState(rhs))
+        {
+            return false;
+        }
+        if (resource->getType() != PassResource::Type::eImage)
+        {
+            return true;
+        }
+        auto layout = vk::utils::getImageLayout(lhs);
+        return layout == vk::utils::getImageLayout(rhs) && layout == vk::utils::getImageLayout(combineStates(lhs, rhs));
+    };
+
+    for (auto* pass : m_buildData.sortedPasses)
+    {
+        readStates[pass];
+
+        auto readResource = [&](PassResource* resource)
+        {
+            ResourceState state = pass->m_resource.resourceStateMap[resource];
+            auto& run           = openRuns[resource];
+            if (!run.passes.empty() && !canMerge(resource, run.state, state))
+            {
+                closeRun(resource, run);
+            }
+            run.state = run.passes.empty() ? state : combineStates(run.state, state);
+            run.passes.push_back(pass);
+        };
+        auto writeResource = [&](PassResource* resource)
+        {
+            if (auto it = openRuns.find(resource); it != openRuns.end())
+            {
+                closeRun(resource, it->second);
+            }
+        };
+
+        const auto& resources = pass->m_resource;
+        std::ranges::for_each(resources.textureIn, readResource);
+        std::ranges::for_each(resources.storageBufferIn, readResource);
+        std::ranges::for_each(resources.uniformBufferIn, readResource);
+        std::ranges::for_each(resources.textureOut, writeResource);
+        std::ranges::for_each(resources.storageBufferOut, writeResource);
+        std::ranges::for_each(resources.colorOut, writeResource);
+        if (resources.depthOut)
+        {
+            writeResource(resources.depthOut);
+        }
+    }
+
+    for (auto& [resource, run] : openRuns)
+    {
+        closeRun(resource, run);
+    }
+}
+
+void RenderGraph::planBarriers()
+{
+    APH_PROFILER_SCOPE();
+
+    m_buildData.barrierStats = {};
+    planReadStates();
+
+    for (auto* pass : m_buildData.sortedPasses)
+    {
+        setupPassBarriers(pass);
+    }
+    planAliasingBarriers();
+
+    // Release halves are added by later passes, so the totals are taken once every pass is planned
+    countBarriers();
+}
+
+void RenderGraph::planAliasingBarriers()
+{
+    APH_PROFILER_SCOPE();
+
+    const auto& transient = m_transientMemory;
+    if (transient.plan.aliasing.empty())
+    {
+        return;
+    }
+
+    // The first barrier of a transient resource discards its contents, that is where its memory changes hands
+    struct FirstBarrier
+    {
+        RenderPass* pass;
+        uint32_t index;
+        bool isImage;
+    };
+    HashMap<PassResource*, FirstBarrier> firstBarriers;
+    for (auto* pass : m_buildData.sortedPasses)
+    {
+        const auto& barrierResources = m_buildData.barrierResources[pass];
+        for (uint32_t index = 0; index < barrierResources.image.size(); ++index)
+        {
+            firstBarriers.try_emplace(barrierResources.image[index], FirstBarrier{ pass, index, true });
+        }
+        for (uint32_t index = 0; index < barrierResources.buffer.size(); ++index)
+        {
+            firstBarriers.try_emplace(barrierResources.buffer[index], FirstBarrier{ pass, index, false });
+        }
+    }
+
+    // Every pass is planned, so the state the previous resource is left in is the one of its last use
+    auto waitForPrevious = [this](auto& barrier, PassResource* previous)
+    {
+        const ResourceState previousState = m_buildData.currentResourceStates[previous];
+        if (barrier.currentState != ResourceState::Undefined || previousState == ResourceState::Undefined)
+        {
+            return;
+        }
+        if (barrier.aliasedState == ResourceState::Undefined)
+        {
+            m_buildData.barrierStats.aliasingCount++;
+        }
+        barrier.aliasedState = combineStates(barrier.aliasedState, previousState);
+    };
+
+    for (const auto& aliasing : transient.plan.aliasing)
+    {
+        auto it = firstBarriers.find(transient.resources[aliasing.request]);
+        if (it == firstBarriers.end())
+        {
+            // Only dry run plans place resources that are never transitioned, e.g. written storage buffers
+            continue;
+        }
+
+        auto* previous           = transient.resources[aliasing.previousRequest];
+        const FirstBarrier first = it->second;
+        if (first.isImage)
+        {
+            waitForPrevious(m_buildData.imageBarriers[first.pass][first.index], previous);
+        }
+        else
+        {
+            waitForPrevious(m_buildData.bufferBarriers[first.pass][first.index], previous);
+        }
+    }
+}
+
+void RenderGraph::countBarriers()
+{
+    auto& stats = m_buildData.barrierStats;
+    for (auto* pass : m_buildData.sortedPasses)
+    {
+        auto acquireCount =
+            static_cast<uint32_t>(m_buildData.imageBarriers[pass].size() + m_buildData.bufferBarriers[pass].size());
+        auto releaseCount = static_cast<uint32_t>(m_buildData.releaseImageBarriers[pass].size() +
+                                                  m_buildData.releaseBufferBarriers[pass].size());
+        stats.barrierCount += acquireCount + releaseCount;
+        stats.batchCount += (acquireCount > 0) + (releaseCount > 0);
+    }
+}
+
+void RenderGraph::scheduleQueues()
+{
+    APH_PROFILER_SCOPE();
+
+    auto& batches = m_buildData.submissionBatches;
+    batches.clear();
+    m_buildData.passBatchIndices.clear();
+
+    // Accesses seen so far, in execution order
+    struct ResourceAccess
+    {
+        RenderPass* lastWriter   = {};
+        RenderPass* lastAccessor = {}; // Owns the resource, see setupOwnershipTransfer
+        SmallVector<RenderPass*> readersSinceWrite;
+    };
+    HashMap<PassResource*, ResourceAccess> accesses;
+
+    // Batch of each queue that still accepts passes
+    HashMap<QueueType, uint32_t> openBatches;
+    HashMap<QueueType, uint32_t> queueBatchCounts;
+
+    for (auto* pass : m_buildData.sortedPasses)
+    {
+        QueueType queueType = getSubmitQueueType(pass->getQueueType());
+
+        // Passes on other queues this one has to wait for
+        SmallVector<RenderPass*> dependencies;
+        auto addDependency = [this, queueType, &dependencies](RenderPass* other)
+        {
+            if (other && getSubmitQueueType(other->getQueueType()) != queueType &&
+                std::ranges::find(dependencies, other) == dependencies.end())
+            {
+                dependencies.push_back(other);
+            }
+        };
+
+        auto readResource = [&](PassResource* resource)
+        {
+            auto& access = accesses[resource];
+            addDependency(access.lastWriter);
+            addDependency(access.lastAccessor);
+            access.readersSinceWrite.push_back(pass);
+            access.lastAccessor = pass;
+        };
+        auto writeResource = [&](PassResource* resource)
+        {
+            auto& access = accesses[resource];
+            addDependency(access.lastWriter);
+            addDependency(access.lastAccessor);
+            for (auto* reader : access.readersSinceWrite)
+            {
+                addDependency(reader);
+            }
+            access.readersSinceWrite.clear();
+            access.lastWriter   = pass;
+            access.lastAccessor = pass;
+        };
+
+        const auto& resources = pass->m_resource;
+        std::ranges::for_each(resources.textureIn, readResource);
+        std::ranges::for_each(resources.storageBufferIn, readResource);
+        std::ranges::for_each(resources.uniformBufferIn, readResource);
+        std::ranges::for_each(resources.textureOut, writeResource);
+        std::ranges::for_each(resources.storageBufferOut, writeResource);
+        std::ranges::for_each(resources.colorOut, writeResource);
+        if (resources.depthOut)
+        {
+            writeResource(resources.depthOut);
+        }
+
+        // A wait starts a new batch, so the passes already batched on this queue don't wait with it
+        auto openIt = openBatches.find(queueType);
+        if (openIt == openBatches.end() || !dependencies.empty())
+        {
+            uint32_t batchIndex = batches.size();
+            batches.push_back({ .queueType = queueType, .queueBatchIndex = queueBatchCounts[queueType]++ });
+            openBatches[queueType] = batchIndex;
+        }
+
+        uint32_t batchIndex = openBatches[queueType];
+        for (auto* dependency : dependencies)
+        {
+            uint32_t waitBatchIndex = m_buildData.passBatchIndices.at(dependency);
+            QueueType waitQueueType = batches[waitBatchIndex].queueType;
+
+            // A batch only signals once all of its passes are done, so stop extending the producer
+            if (auto it = openBatches.find(waitQueueType); it != openBatches.end() && it->second == waitBatchIndex)
+            {
+                openBatches.erase(it);
+            }
+
+            // Timeline values are monotonic, waiting on the latest batch of a queue covers the earlier ones
+            auto& waitBatches = batches[batchIndex].waitBatches;
+            auto sameQueueIt  = std::ranges::find_if(waitBatches, [&batches, waitQueueType](uint32_t index)
+                                                    { return batches[index].queueType == waitQueueType; });
+            if (sameQueueIt == waitBatches.end())
+            {
+                waitBatches.push_back(waitBatchIndex);
+            }
+            else if (batches[*sameQueueIt].queueBatchIndex < batches[waitBatchIndex].queueBatchIndex)
+            {
+                *sameQueueIt = waitBatchIndex;
+            }
+        }
+
+        batches[batchIndex].passes.push_back(pass);
+        m_buildData.passBatchIndices[pass] = batchIndex;
+    }
+}
+
+auto RenderGraph::getSubmitQueueType(QueueType queueType) const -> QueueType
+{
+    // Without a dedicated queue the device falls back to another one, both then share a timeline
+    return isDryRunMode() ? queueType : m_pDevice->getQueue(queueType)->getType();
+}
+
+auto RenderGraph::needsOwnershipTransfer(QueueType srcQueueType, QueueType dstQueueType) const -> bool
+{
+    if (getSubmitQueueType(srcQueueType) == getSubmitQueueType(dstQueueType))
+    {
+        return false;
+    }
+
+    // Dry run assumes a dedicated family per queue type
+    if (isDryRunMode())
+    {
+        return true;
+    }
+    return m_pDevice->getQueue(srcQueueType)->getFamilyIndex() != m_pDevice->getQueue(dstQueueType)->getFamilyIndex();
+}
+
+namespace
+{
+template <typename BitType>
+auto toMask(Flags<BitType> flags) -> uint32_t
+{
+    return static_cast<typename Flags<BitType>::MaskType>(flags);
+}
+} // namespace
+
+auto RenderGraph::getGraphHash() const -> uint64_t
+{
+    APH_PROFILER_SCOPE();
+
+    GraphHasher hasher;
+    hasher.add(CompiledGraph::Version);
+    hasher.add(isDryRunMode());
+    hasher.add(m_transientMemory.enabled);
+    hasher.add(std::string_view{ m_declareData.backBuffer });
+
+    // Batching and ownership transfers depend on the queues the device provides
+    constexpr std::array QueueTypes = { QueueType::Graphics, QueueType::Compute, QueueType::Transfer };
+    for (auto srcQueueType : QueueTypes)
+    {
+        hasher.add(getSubmitQueueType(srcQueueType));
+        for (auto dstQueueType : QueueTypes)
+        {
+            hasher.add(needsOwnershipTransfer(srcQueueType, dstQueueType));
+        }
+    }
+
+    // Hash maps don't keep a stable order, everything is hashed sorted by name
+    SmallVector<std::string_view> exportedNames;
+    for (const auto& name : m_declareData.exportedResources)
+    {
+        exportedNames.push_back(name);
+    }
+    std::ranges::sort(exportedNames);
+    for (auto name : exportedNames)
+    {
+        hasher.add(name);
+    }
+
+    auto sortedByName = [](const auto& map)
+    {
+        std::vector<std::pair<std::string_view, typename std::decay_t<decltype(map)>::mapped_type>> entries{
+            map.begin(), map.end()
+        };
+        std::ranges::sort(entries, {}, [](const auto& entry) { return entry.first; });
+        return entries;
+    };
+
+    for (auto [name, resource] : sortedByName(m_declareData.resourceMap))
+    {
+        hasher.add(name);
+        hasher.add(resource->getType());
+        hasher.add(toMask(resource->getFlags()));
+        if (resource->getType() == PassResource::Type::eImage)
+        {
+            auto* imageResource = static_cast<PassImageResource*>(resource);
+            hasher.add(imageResource->getInfo().createInfo.extent);
+            hasher.add(imageResource->getInfo().createInfo.format);
+            hasher.add(toMask(imageResource->getUsage()));
+        }
+        else
+        {
+            auto* bufferResource = static_cast<PassBufferResource*>(resource);
+            hasher.add(bufferResource->getInfo().size);
+            hasher.add(toMask(bufferResource->getUsage()));
+        }
+    }
+
+    for (auto [name, pass] : sortedByName(m_declareData.passMap))
+    {
+        hasher.add(name);
+        hasher.add(pass->getQueueType());
+        hasher.add(pass->m_executionMode);
+
+        // Slots are hashed separately, the same resources in another slot give another plan
+        auto addResources = [&hasher, pass](const auto& resources)
+        {
+            hasher.add(static_cast<uint32_t>(resources.size()));
+            for (auto* resource : resources)
+            {
+                hasher.add(std::string_view{ resource->getName() });
+                const auto& stateMap = pass->m_resource.resourceStateMap;
+                auto it              = stateMap.find(resource);
+                hasher.add(it != stateMap.end() ? it->second : ResourceState::Undefined);
+            }
+        };
+
+        const auto& resources = pass->m_resource;
+        addResources(resources.textureIn);
+        addResources(resources.textureOut);
+        addResources(resources.storageBufferIn);
+        addResources(resources.storageBufferOut);
+        addResources(resources.uniformBufferIn);
+        addResources(resources.colorOut);
+        hasher.add(std::string_view{ resources.depthOut ? resources.depthOut->getName() : std::string{} });
+    }
+
+    return hasher.value();
+}
+
+auto RenderGraph::getCompiledGraph() const -> CompiledGraph
+{
+    APH_PROFILER_SCOPE();
+
+    const auto& sortedPasses = m_buildData.sortedPasses;
+
+    CompiledGraph compiledGraph;
+    compiledGraph.hash                = getGraphHash();
+    compiledGraph.skippedBarrierCount = m_buildData.barrierStats.skippedCount;
+
+    HashMap<RenderPass*, uint32_t> passIndices;
+    for (uint32_t index = 0; index < sortedPasses.size(); ++index)
+    {
+        passIndices[sortedPasses[index]] = index;
+    }
+
+    SmallVector<PassResource*> resources;
+    for (auto [name, resource] : m_declareData.resourceMap)
+    {
+        resources.push_back(resource);
+    }
+    std::ranges::sort(resources, {}, [](PassResource* resource) { return resource->getName(); });
+
+    HashMap<PassResource*, uint32_t> resourceIndices;
+    for (auto* resource : resources)
+    {
+        resourceIndices[resource] = compiledGraph.resources.size();
+
+        CompiledGraph::Resource compiledResource{
+            .name    = resource->getName(),
+            .isImage = resource->getType() == PassResource::Type::eImage,
+        };
+        if (compiledResource.isImage)
+        {
+            auto* imageResource     = static_cast<PassImageResource*>(resource);
+            compiledResource.extent = imageResource->getInfo().createInfo.extent;
+            compiledResource.format = imageResource->getInfo().createInfo.format;
+            compiledResource.usage  = toMask(imageResource->getUsage());
+        }
+        else
+        {
+            auto* bufferResource   = static_cast<PassBufferResource*>(resource);
+            compiledResource.size  = bufferResource->getInfo().size;
+            compiledResource.usage = toMask(bufferResource->getUsage());
+        }
+
+        if (auto it = m_buildData.currentResourceStates.find(resource); it != m_buildData.currentResourceStates.end())
+        {
+            compiledResource.finalState = it->second;
+        }
+        if (auto it = m_buildData.resourceOwners.find(resource); it != m_buildData.resourceOwners.end())
+        {
+            if (auto passIt = passIndices.find(it->second); passIt != passIndices.end())
+            {
+                compiledResource.finalOwner = passIt->second;
+            }
+        }
+        compiledGraph.resources.push_back(std::move(compiledResource));
+    }
+
+    auto addBarriers = [&resourceIndices](std::vector<CompiledGraph::Barrier>& compiledBarriers, const auto& barriers,
+                                          const SmallVector<PassResource*>& barrierResources)
+    {
+        APH_ASSERT(barriers.size() == barrierResources.size());
+        for (uint32_t index = 0; index < barriers.size(); ++index)
+        {
+            const auto& barrier = barriers[index];
+            compiledBarriers.push_back({
+                .resourceIndex = resourceIndices.at(barrierResources[index]),
+                .currentState  = barrier.currentState,
+                .newState      = barrier.newState,
+                .queueType     = barrier.queueType,
+                .acquire       = barrier.acquire,
+                .release       = barrier.release,
+            });
+        }
+    };
+
+    for (auto* pass : sortedPasses)
+    {
+        const auto& barrierResources = m_buildData.barrierResources.at(pass);
+
+        CompiledGraph::Pass compiledPass{ .name = pass->m_name };
+        addBarriers(compiledPass.barriers, m_buildData.imageBarriers.at(pass), barrierResources.image);
+        addBarriers(compiledPass.barriers, m_buildData.bufferBarriers.at(pass), barrierResources.buffer);
+        addBarriers(compiledPass.releaseBarriers, m_buildData.releaseImageBarriers.at(pass),
+                    barrierResources.releaseImage);
+        addBarriers(compiledPass.releaseBarriers, m_buildData.releaseBufferBarriers.at(pass),
+                    barrierResources.releaseBuffer);
+        compiledGraph.passes.push_back(std::move(compiledPass));
+    }
+
+    for (auto* pass : m_buildData.culledPasses)
+    {
+        compiledGraph.culledPasses.push_back(pass->m_name);
+    }
+
+    for (const auto& batch : m_buildData.submissionBatches)
+    {
+        CompiledGraph::Batch compiledBatch{
+            .queueType       = batch.queueType,
+            .queueBatchIndex = batch.queueBatchIndex,
+        };
+        compiledBatch.waitBatches.assign(batch.waitBatches.begin(), batch.waitBatches.end());
+        for (auto* pass : batch.passes)
+        {
+            compiledBatch.passes.push_back(passIndices.at(pass));
+        }
+        compiledGraph.batches.push_back(std::move(compiledBatch));
+    }
+
+    compiledGraph.transientPlan = m_transientMemory.plan;
+    for (auto* resource : m_transientMemory.resources)
+    {
+        compiledGraph.transientResources.push_back(resourceIndices.at(resource));
+    }
+
+    return compiledGraph;
+}
+
+void RenderGraph::setCompiledGraph(CompiledGraph compiledGraph)
+{
+    APH_PROFILER_SCOPE();
+    m_compiledGraph.pending = std::move(compiledGraph);
+    markTopologyModified();
+}
+
+auto RenderGraph::saveCompiledGraph(std::string_view path) const -> Result
+{
+    APH_PROFILER_SCOPE();
 
-                if (!pass->m_resource.storageBufferOut.empty())
-                {
-                    RDG_LOG_DEBUG("[DryRun]   Writing storage buffers: ");
-                    for (auto* buf : pass->m_resource.storageBufferOut)
-                    {
-                        RDG_LOG_DEBUG("%s ", buf->getName());
-                    }
-                }
-            }
+    auto& fs          = APH_DEFAULT_FILESYSTEM;
+    auto resolvedPath = fs.resolvePath(path);
+    if (!resolvedPath.success())
+    {
+        return resolvedPath;
+    }
 
-            RDG_LOG_INFO("[DryRun] Render graph execution completed");
+    auto directory = std::filesystem::path{ resolvedPath.value() }.parent_path().string();
+    if (!directory.empty() && !fs.exist(directory))
+    {
+        APH_RETURN_IF_ERROR(fs.createDirectories(directory));
+    }
+    return fs.writeBytesToFile(path, getCompiledGraph().serialize());
+}
 
-            if (!m_declareData.backBuffer.empty())
-            {
-                RDG_LOG_INFO("[DryRun] Presenting back buffer: %s", m_declareData.backBuffer);
-            }
-        }
+auto RenderGraph::loadCompiledGraph(std::string_view path) -> Result
+{
+    APH_PROFILER_SCOPE();
 
-        // Mark execute as completed in dry run mode
-        if (m_breadcrumbs.isEnabled() && executeBreadcrumbIndex != UINT32_MAX)
-        {
-            m_breadcrumbs.updateBreadcrumb(executeBreadcrumbIndex, BreadcrumbState::Completed);
-        }
+    auto bytes = APH_DEFAULT_FILESYSTEM.readFileToBytes(path);
+    if (!bytes.success())
+    {
+        return bytes;
+    }
 
-        return;
+    auto compiledGraph = CompiledGraph::Deserialize(bytes.value());
+    if (!compiledGraph.success())
+    {
+        return compiledGraph;
     }
 
-    auto* queue = m_pDevice->getQueue(aph::QueueType::Graphics);
+    setCompiledGraph(std::move(compiledGraph.value()));
+    return Result::Success;
+}
 
-    // Create submission breadcrumb
-    uint32_t submissionBreadcrumbIndex = UINT32_MAX;
-    if (m_breadcrumbs.isEnabled())
+auto RenderGraph::applyCompiledGraph() -> bool
+{
+    APH_PROFILER_SCOPE();
+
+    if (!m_compiledGraph.pending)
     {
-        submissionBreadcrumbIndex =
-            m_breadcrumbs.addBreadcrumb("Queue Submit", "Submitting to GPU queue", executeBreadcrumbIndex);
-        m_breadcrumbs.updateBreadcrumb(submissionBreadcrumbIndex, BreadcrumbState::InProgress);
+        return false;
     }
 
-    // submit && present
+    const auto& compiledGraph = *m_compiledGraph.pending;
+    auto reject               = [this](const char* reason)
     {
-        if (ppFence)
-        {
-            *ppFence = m_buildData.frameExecuteFence;
-        }
+        RDG_LOG_WARN("Compiled graph snapshot rejected (%s), compiling the graph from scratch.", reason);
+        m_compiledGraph.pending.reset();
+        return false;
+    };
 
-        vk::Fence* frameFence = m_buildData.frameExecuteFence;
-        {
-            frameFence->wait();
-            frameFence->reset();
-        }
+    if (compiledGraph.hash != getGraphHash())
+    {
+        return reject("declaration changed");
+    }
 
-        APH_VERIFY_RESULT(queue->submit(m_buildData.frameSubmitInfos, frameFence));
+    // The hash covers every name, a missing one means the data doesn't belong to this graph
+    auto findPass = [this](const std::string& name) -> RenderPass*
+    {
+        auto it = m_declareData.passMap.find(name);
+        return it != m_declareData.passMap.end() ? it->second : nullptr;
+    };
 
-        // Mark submission as completed
-        if (m_breadcrumbs.isEnabled() && submissionBreadcrumbIndex != UINT32_MAX)
+    SmallVector<RenderPass*> sortedPasses;
+    SmallVector<RenderPass*> culledPasses;
+    for (const auto& compiledPass : compiledGraph.passes)
+    {
+        sortedPasses.push_back(findPass(compiledPass.name));
+    }
+    for (const auto& name : compiledGraph.culledPasses)
+    {
+        culledPasses.push_back(findPass(name));
+    }
+    if (std::ranges::find(sortedPasses, nullptr) != sortedPasses.end() ||
+        std::ranges::find(culledPasses, nullptr) != culledPasses.end())
+    {
+        return reject("unknown pass");
+    }
+
+    auto& resources = m_compiledGraph.resources;
+    resources.clear();
+    for (const auto& compiledResource : compiledGraph.resources)
+    {
+        auto it = m_declareData.resourceMap.find(compiledResource.name);
+        if (it == m_declareData.resourceMap.end() ||
+            (it->second->getType() == PassResource::Type::eImage) != compiledResource.isImage)
         {
-            m_breadcrumbs.updateBreadcrumb(submissionBreadcrumbIndex, BreadcrumbState::Completed);
+            return reject("unknown resource");
         }
+        resources.push_back(it->second);
+    }
 
-        // Create present breadcrumb if there's a swapchain
-        if (m_buildData.pSwapchain)
+    m_buildData.sortedPasses = std::move(sortedPasses);
+    m_buildData.culledPasses = std::move(culledPasses);
+
+    {
+        std::lock_guard<std::mutex> holder{ m_buildData.submitLock };
+        auto& batches = m_buildData.submissionBatches;
+        batches.clear();
+        m_buildData.passBatchIndices.clear();
+        for (const auto& compiledBatch : compiledGraph.batches)
         {
-            uint32_t presentBreadcrumbIndex = UINT32_MAX;
-            if (m_breadcrumbs.isEnabled())
+            SubmissionBatch batch{
+                .queueType       = compiledBatch.queueType,
+                .queueBatchIndex = compiledBatch.queueBatchIndex,
+            };
+            for (uint32_t passIndex : compiledBatch.passes)
             {
-                presentBreadcrumbIndex =
-                    m_breadcrumbs.addBreadcrumb("Present", "Presenting to screen", executeBreadcrumbIndex);
-                m_breadcrumbs.updateBreadcrumb(presentBreadcrumbIndex, BreadcrumbState::InProgress);
+                auto* pass = m_buildData.sortedPasses[passIndex];
+                batch.passes.push_back(pass);
+                m_buildData.passBatchIndices[pass] = batches.size();
             }
+            batch.waitBatches.insert(batch.waitBatches.end(), compiledBatch.waitBatches.begin(),
+                                     compiledBatch.waitBatches.end());
+            batches.push_back(std::move(batch));
+        }
+    }
 
-            auto outImage = m_buildData.image[m_declareData.resourceMap[m_declareData.backBuffer]];
+    if (isDryRunMode() && m_debugOutputEnabled)
+    {
+        RDG_LOG_INFO("[DryRun] Using compiled graph snapshot %016llx, skipping compilation",
+                     static_cast<unsigned long long>(compiledGraph.hash));
+    }
+    return true;
+}
 
-            // Update resource state for the back buffer to Present state
-            m_buildData.currentResourceStates[m_declareData.resourceMap[m_declareData.backBuffer]] =
-                ResourceState::Present;
+auto RenderGraph::applyCompiledTransientPlan() -> bool
+{
+    APH_PROFILER_SCOPE();
 
-            APH_VERIFY_RESULT(m_buildData.pSwapchain->presentImage({}, outImage));
+    const auto& compiledGraph = *m_compiledGraph.pending;
+    const auto& plan          = compiledGraph.transientPlan;
 
-            // Mark present as completed
-            if (m_breadcrumbs.isEnabled() && presentBreadcrumbIndex != UINT32_MAX)
-            {
-                m_breadcrumbs.updateBreadcrumb(presentBreadcrumbIndex, BreadcrumbState::Completed);
+    releaseTransientMemory();
 
-                // Mark frame as completed since present is the last operation in a frame
-                uint32_t frameIndex = m_breadcrumbs.findBreadcrumb("Frame");
-                if (frameIndex != UINT32_MAX)
-                {
-                    m_breadcrumbs.updateBreadcrumb(frameIndex, BreadcrumbState::Completed);
-                }
-            }
-        }
-    }
+    auto& transient = m_transientMemory;
+    transient.resources.clear();
+    transient.placementIndices.clear();
+    transient.plan = {};
 
-    // Mark execute as completed
-    if (m_breadcrumbs.isEnabled() && executeBreadcrumbIndex != UINT32_MAX)
+    for (uint32_t index = 0; index < compiledGraph.transientResources.size(); ++index)
     {
-        m_breadcrumbs.updateBreadcrumb(executeBreadcrumbIndex, BreadcrumbState::Completed);
+        auto* resource = m_compiledGraph.resources[compiledGraph.transientResources[index]];
 
-        // Mark frame as completed if there's no swapchain (meaning this is the last operation)
-        if (!m_buildData.pSwapchain)
+        // Memory requirements come from the driver, the snapshot may have been taken on another device
+        if (!isDryRunMode())
         {
-            uint32_t frameIndex = m_breadcrumbs.findBreadcrumb("Frame");
-            if (frameIndex != UINT32_MAX)
+            const auto& placement = plan.placements[index];
+            bool fits             = resource->getType() == PassResource::Type::eImage;
+            if (fits)
             {
-                m_breadcrumbs.updateBreadcrumb(frameIndex, BreadcrumbState::Completed);
+                auto* imageResource    = static_cast<PassImageResource*>(resource);
+                bool isColorAttachment = static_cast<bool>(imageResource->getUsage() & ImageUsage::ColorAttachment);
+                MemoryRequirement requirement =
+                    m_pDevice->getMemoryRequirement(getImageCreateInfo(imageResource, isColorAttachment));
+                fits = requirement.size <= placement.size && placement.offset % requirement.alignment == 0 &&
+                       plan.heaps[placement.heapIndex].heapKey == requirement.memoryTypeBits;
+            }
+            if (!fits)
+            {
+                RDG_LOG_WARN("Compiled graph memory plan doesn't fit resource %s, planning transient memory again.",
+                             resource->getName());
+                transient.resources.clear();
+                transient.placementIndices.clear();
+                return false;
             }
         }
+
+        transient.placementIndices[resource] = index;
+        transient.resources.push_back(resource);
     }
+
+    transient.plan = plan;
+    allocateTransientMemory();
+    return true;
 }
 
-void RenderGraph::setBackBuffer(const std::string& backBuffer)
+void RenderGraph::applyCompiledBarriers()
 {
     APH_PROFILER_SCOPE();
-    m_declareData.backBuffer = backBuffer;
-    markBackBufferModified();
 
-    if (isDryRunMode() && m_debugOutputEnabled)
+    const auto& compiledGraph = *m_compiledGraph.pending;
+    const auto& resources     = m_compiledGraph.resources;
+    const auto& sortedPasses  = m_buildData.sortedPasses;
+
+    auto addBarriers = [this, &resources](const std::vector<CompiledGraph::Barrier>& compiledBarriers,
+                                          SmallVector<vk::ImageBarrier>& imageBarriers,
+                                          SmallVector<vk::BufferBarrier>& bufferBarriers,
+                                          SmallVector<PassResource*>& imageResources,
+                                          SmallVector<PassResource*>& bufferResources)
     {
-        RDG_LOG_INFO("[DryRun] Set back buffer to '%s'", backBuffer.c_str());
+        imageBarriers.clear();
+        bufferBarriers.clear();
+        for (const auto& compiledBarrier : compiledBarriers)
+        {
+            auto* resource = resources[compiledBarrier.resourceIndex];
+            if (resource->getType() == PassResource::Type::eImage)
+            {
+                imageBarriers.push_back({
+                    .pImage       = m_buildData.image[resource],
+                    .currentState = compiledBarrier.currentState,
+                    .newState     = compiledBarrier.newState,
+                    .queueType    = compiledBarrier.queueType,
+                    .acquire      = compiledBarrier.acquire,
+                    .release      = compiledBarrier.release,
+                });
+                imageResources.push_back(resource);
+            }
+            else
+            {
+                bufferBarriers.push_back({
+                    .pBuffer      = m_buildData.buffer[resource],
+                    .currentState = compiledBarrier.currentState,
+                    .newState     = compiledBarrier.newState,
+                    .queueType    = compiledBarrier.queueType,
+                    .acquire      = compiledBarrier.acquire,
+                    .release      = compiledBarrier.release,
+                });
+                bufferResources.push_back(resource);
+            }
+        }
+    };
+
+    for (uint32_t passIndex = 0; passIndex < sortedPasses.size(); ++passIndex)
+    {
+        auto* pass               = sortedPasses[passIndex];
+        const auto& compiledPass = compiledGraph.passes[passIndex];
+        auto& barrierResources   = m_buildData.barrierResources[pass];
+        barrierResources         = {};
+
+        setupRenderingInfo(pass);
+        addBarriers(compiledPass.barriers, m_buildData.imageBarriers[pass], m_buildData.bufferBarriers[pass],
+                    barrierResources.image, barrierResources.buffer);
+        addBarriers(compiledPass.releaseBarriers, m_buildData.releaseImageBarriers[pass],
+                    m_buildData.releaseBufferBarriers[pass], barrierResources.releaseImage,
+                    barrierResources.releaseBuffer);
+    }
+
+    // Later plans continue from the tracking state the snapshot ended with
+    for (uint32_t index = 0; index < resources.size(); ++index)
+    {
+        const auto& compiledResource                        = compiledGraph.resources[index];
+        m_buildData.currentResourceStates[resources[index]] = compiledResource.finalState;
+        if (compiledResource.finalOwner != UINT32_MAX)
+        {
+            m_buildData.resourceOwners[resources[index]] = sortedPasses[compiledResource.finalOwner];
+        }
     }
+
+    // The snapshot doesn't keep them, the memory plan may have been redone for this device
+    m_buildData.barrierStats = { .skippedCount = compiledGraph.skippedBarrierCount };
+    planAliasingBarriers();
+    countBarriers();
 }
 
 void RenderGraph::cleanup()
@@ -1055,7 +2492,18 @@ void RenderGraph::cleanup()
     {
         m_buildData.bufferBarriers.clear();
         m_buildData.imageBarriers.clear();
-        m_buildData.frameSubmitInfos.clear();
+        m_buildData.renderingInfos.clear();
+        m_buildData.releaseImageBarriers.clear();
+        m_buildData.releaseBufferBarriers.clear();
+        m_buildData.barrierResources.clear();
+        m_buildData.submissionBatches.clear();
+        m_buildData.passBatchIndices.clear();
+
+        for (auto [queueType, timeline] : m_buildData.queueTimelines)
+        {
+            APH_VERIFY_RESULT(m_pDevice->releaseSemaphore(timeline.pSemaphore));
+        }
+        m_buildData.queueTimelines.clear();
 
         // Release the frame execute fence
         if (m_buildData.frameExecuteFence)
@@ -1071,31 +2519,49 @@ void RenderGraph::cleanup()
             {
             case PassResource::Type::eImage:
             {
-                if (!(pResource->getFlags() & PassResourceFlagBits::eExternal))
+                // Resources of culled passes were never created
+                auto it = m_buildData.image.find(pResource);
+                if (!(pResource->getFlags() & PassResourceFlagBits::eExternal) && it != m_buildData.image.end())
                 {
-                    auto pImage = m_buildData.image[pResource];
-                    m_pDevice->destroy(pImage);
+                    m_pDevice->destroy(it->second);
                 }
             }
             break;
             case PassResource::Type::eBuffer:
             {
-                if (!(pResource->getFlags() & PassResourceFlagBits::eExternal))
+                auto it = m_buildData.buffer.find(pResource);
+                if (!(pResource->getFlags() & PassResourceFlagBits::eExternal) && it != m_buildData.buffer.end())
                 {
-                    auto pBuffer = m_buildData.buffer[pResource];
-                    m_pDevice->destroy(pBuffer);
+                    m_pDevice->destroy(it->second);
                 }
             }
             break;
             }
         }
 
+        // The aliased images are gone, release the memory blocks that backed them
+        for (auto* pMemory : m_transientMemory.heapMemory)
+        {
+            m_pDevice->freeMemory(pMemory);
+        }
+        m_transientMemory.heapMemory.clear();
+
         // Release command buffers
         for (auto [pass, cmdBuffer] : m_buildData.cmds)
         {
             m_pCommandBufferAllocator->release(cmdBuffer);
         }
+        for (auto [pass, cmdBuffer] : m_buildData.transitionCmds)
+        {
+            m_pCommandBufferAllocator->release(cmdBuffer);
+        }
+        for (auto* cmdBuffer : m_buildData.retiredCmds)
+        {
+            m_pCommandBufferAllocator->release(cmdBuffer);
+        }
         m_buildData.cmds.clear();
+        m_buildData.transitionCmds.clear();
+        m_buildData.retiredCmds.clear();
     }
 
     // Clean up graph data structures in both modes
@@ -1105,6 +2571,9 @@ void RenderGraph::cleanup()
         m_resourcePool.renderPass.free(pass);
     }
     m_declareData.passMap.clear();
+    m_declareData.exportedResources.clear();
+    m_buildData.sortedPasses.clear();
+    m_buildData.culledPasses.clear();
 
     for (auto [name, pResource] : m_declareData.resourceMap)
     {
@@ -1123,6 +2592,11 @@ void RenderGraph::cleanup()
     m_buildData.image.clear();
     m_buildData.buffer.clear();
 
+    m_transientResources.clear();
+    m_transientMemory.resources.clear();
+    m_transientMemory.placementIndices.clear();
+    m_transientMemory.plan = {};
+
     if (isDryRunMode() && m_debugOutputEnabled)
     {
         RDG_LOG_INFO("[DryRun] Cleaned up render graph");
@@ -1299,10 +2773,6 @@ void RenderGraph::analyzeResourceLifetimes()
     APH_PROFILER_SCOPE();
     m_transientResources.clear();
 
-    // Skip if in dry run mode
-    if (isDryRunMode())
-        return;
-
     // Map passes to their indices in the execution order
     HashMap<RenderPass*, uint32_t> passIndices;
     for (uint32_t i = 0; i < m_buildData.sortedPasses.size(); i++)
@@ -1313,14 +2783,7 @@ void RenderGraph::analyzeResourceLifetimes()
     // Analyze resource usage patterns
     for (auto [name, resource] : m_declareData.resourceMap)
     {
-        // Skip external resources
-        if (resource->getFlags() & PassResourceFlagBits::eExternal)
-        {
-            continue;
-        }
-
-        // Skip resources used as back buffer
-        if (name == m_declareData.backBuffer)
+        if (!isResourceTransient(resource))
         {
             continue;
         }
@@ -1328,19 +2791,31 @@ void RenderGraph::analyzeResourceLifetimes()
         TransientResourceInfo info;
         info.isImage = resource->getType() == PassResource::Type::eImage;
 
-        // Find first and last usage
+        // Find first and last usage, culled passes don't keep anything alive
+        auto updateLifetime = [this, &info, &passIndices](RenderPass* pass)
+        {
+            if (auto it = passIndices.find(pass); it != passIndices.end())
+            {
+                info.firstUsePassIndex = std::min(info.firstUsePassIndex, it->second);
+                info.lastUsePassIndex  = std::max(info.lastUsePassIndex, it->second);
+
+                QueueType queueType = getSubmitQueueType(pass->getQueueType());
+                if (info.queueType != QueueType::Unsupport && info.queueType != queueType)
+                {
+                    info.multiQueue = true;
+                }
+                info.queueType = queueType;
+            }
+        };
+
         for (auto* pass : resource->getReadPasses())
         {
-            uint32_t passIndex     = passIndices[pass];
-            info.firstUsePassIndex = std::min(info.firstUsePassIndex, passIndex);
-            info.lastUsePassIndex  = std::max(info.lastUsePassIndex, passIndex);
+            updateLifetime(pass);
         }
 
         for (auto* pass : resource->getWritePasses())
         {
-            uint32_t passIndex     = passIndices[pass];
-            info.firstUsePassIndex = std::min(info.firstUsePassIndex, passIndex);
-            info.lastUsePassIndex  = std::max(info.lastUsePassIndex, passIndex);
+            updateLifetime(pass);
         }
 
         // Calculate resource size
@@ -1350,7 +2825,7 @@ void RenderGraph::analyzeResourceLifetimes()
             auto& extent           = imgResource->getInfo().createInfo.extent;
             auto format            = imgResource->getInfo().createInfo.format;
             uint32_t bytesPerPixel = vk::utils::getFormatSize(format);
-            info.size              = extent.width * extent.height * extent.depth * bytesPerPixel;
+            info.size              = std::size_t{ extent.width } * extent.height * extent.depth * bytesPerPixel;
         }
         else
         {
@@ -1362,6 +2837,170 @@ void RenderGraph::analyzeResourceLifetimes()
     }
 }
 
+auto RenderGraph::isResourceTransient(PassResource* resource) const -> bool
+{
+    // External, cross-frame and presented resources must keep their own memory
+    if (resource->getFlags() & (PassResourceFlagBits::eExternal | PassResourceFlagBits::eShared))
+    {
+        return false;
+    }
+    return resource->getName() != m_declareData.backBuffer;
+}
+
+void RenderGraph::planTransientMemory()
+{
+    APH_PROFILER_SCOPE();
+
+    releaseTransientMemory();
+
+    auto& transient = m_transientMemory;
+    transient.resources.clear();
+    transient.placementIndices.clear();
+    transient.plan = {};
+
+    if (!transient.enabled)
+    {
+        return;
+    }
+
+    // Without a device the sizes are estimated from the formats, the alignments are common GPU granularities
+    constexpr std::size_t DryRunImageAlignment  = 64 * 1024;
+    constexpr std::size_t DryRunBufferAlignment = 256;
+
+    SmallVector<TransientAllocationRequest> requests;
+    for (auto [resource, info] : m_transientResources)
+    {
+        if (info.firstUsePassIndex == UINT32_MAX)
+        {
+            continue;
+        }
+
+        // Passes of different queues overlap in time, so resources only alias others of their own queue
+        const uint32_t queueKey =
+            info.multiQueue ? TransientAllocationRequest::MultiQueueKey : static_cast<uint32_t>(info.queueType);
+
+        TransientAllocationRequest request{
+            .size              = info.size,
+            .alignment         = info.isImage ? DryRunImageAlignment : DryRunBufferAlignment,
+            .firstUsePassIndex = info.firstUsePassIndex,
+            .lastUsePassIndex  = info.lastUsePassIndex,
+            .heapKey           = info.isImage ? 0U : 1U,
+            .queueKey          = queueKey,
+        };
+
+        if (!isDryRunMode())
+        {
+            // Only attachments are created by the graph, everything else is not ours to place
+            if (!info.isImage)
+            {
+                continue;
+            }
+            auto* imageResource = static_cast<PassImageResource*>(resource);
+            if (!(imageResource->getUsage() & (ImageUsage::ColorAttachment | ImageUsage::DepthStencil)))
+            {
+                continue;
+            }
+
+            bool isColorAttachment = static_cast<bool>(imageResource->getUsage() & ImageUsage::ColorAttachment);
+            MemoryRequirement requirement =
+                m_pDevice->getMemoryRequirement(getImageCreateInfo(imageResource, isColorAttachment));
+            request.size      = requirement.size;
+            request.alignment = requirement.alignment;
+            request.heapKey   = requirement.memoryTypeBits;
+        }
+
+        if (request.size == 0)
+        {
+            continue;
+        }
+
+        transient.placementIndices[resource] = static_cast<uint32_t>(requests.size());
+        transient.resources.push_back(resource);
+        requests.push_back(request);
+    }
+
+    transient.plan = TransientAliasingAllocator::plan(requests);
+    APH_ASSERT(TransientAliasingAllocator::validate(requests, transient.plan));
+
+    allocateTransientMemory();
+
+    if (isDryRunMode() && m_debugOutputEnabled)
+    {
+        const auto& plan = transient.plan;
+        RDG_LOG_INFO("[DryRun] Transient memory plan: %zu resources in %zu heaps", transient.resources.size(),
+                     plan.heaps.size());
+        for (uint32_t index = 0; index < transient.resources.size(); ++index)
+        {
+            const auto& placement = plan.placements[index];
+            const auto& request   = requests[index];
+            RDG_LOG_INFO("[DryRun]   %s: heap %u, offset %zu, size %zu, passes [%u, %u]",
+                         transient.resources[index]->getName(), placement.heapIndex, placement.offset, placement.size,
+                         request.firstUsePassIndex, request.lastUsePassIndex);
+        }
+        RDG_LOG_INFO("[DryRun] Transient memory: %zu bytes aliased, %zu bytes naive, %zu bytes peak live",
+                     plan.aliasedSize, plan.naiveSize, plan.peakLiveSize);
+    }
+}
+
+void RenderGraph::allocateTransientMemory()
+{
+    APH_PROFILER_SCOPE();
+
+    if (isDryRunMode())
+    {
+        return;
+    }
+
+    for (const auto& heap : m_transientMemory.plan.heaps)
+    {
+        auto* pMemory = m_pDevice->allocateMemory({
+            .size           = heap.size,
+            .alignment      = heap.alignment,
+            .memoryTypeBits = heap.heapKey,
+        });
+        APH_ASSERT(pMemory, "Failed to allocate transient memory block");
+        m_transientMemory.heapMemory.push_back(pMemory);
+    }
+}
+
+void RenderGraph::releaseTransientMemory()
+{
+    APH_PROFILER_SCOPE();
+
+    if (isDryRunMode() || m_transientMemory.heapMemory.empty())
+    {
+        return;
+    }
+
+    // The previous frame may still be using the aliased images
+    m_buildData.frameExecuteFence->wait();
+
+    for (auto* resource : m_transientMemory.resources)
+    {
+        if (auto it = m_buildData.image.find(resource); it != m_buildData.image.end())
+        {
+            m_pDevice->destroy(it->second);
+            m_buildData.image.erase(it);
+        }
+    }
+
+    for (auto* pMemory : m_transientMemory.heapMemory)
+    {
+        m_pDevice->freeMemory(pMemory);
+    }
+    m_transientMemory.heapMemory.clear();
+}
+
+auto RenderGraph::getTransientPlacement(const std::string& resourceName) const -> const TransientPlacement*
+{
+    auto* resource = getPassResource(resourceName);
+    if (auto it = m_transientMemory.placementIndices.find(resource); it != m_transientMemory.placementIndices.end())
+    {
+        return &m_transientMemory.plan.placements[it->second];
+    }
+    return nullptr;
+}
+
 RenderPass* RenderGraph::getPass(const std::string& name) const noexcept
 {
     if (m_declareData.passMap.contains(name))
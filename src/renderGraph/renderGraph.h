@@ -1,15 +1,21 @@
 #pragma once
 
+#include "allocator/frameAllocator.h"
 #include "api/vulkan/device.h"
 #include "common/breadcrumbTracker.h"
 #include "common/result.h"
+#include "compiledGraph.h"
 #include "exception/errorMacros.h"
 #include "renderPass.h"
 #include "resource/resourceLoader.h"
 #include "threads/taskManager.h"
+#include "transientAllocator.h"
 #include <variant>
 
-GENERATE_LOG_FUNCS(RDG)
+#define RDG_LOG_DEBUG(...) APH_LOG_TAGGED(RDG, Debug, __VA_ARGS__)
+#define RDG_LOG_INFO(...)  APH_LOG_TAGGED(RDG, Info, __VA_ARGS__)
+#define RDG_LOG_WARN(...)  APH_LOG_TAGGED(RDG, Warn, __VA_ARGS__)
+#define RDG_LOG_ERR(...)   APH_LOG_TAGGED(RDG, Error, __VA_ARGS__)
 
 namespace aph
 {
@@ -41,6 +47,8 @@ public:
     auto createPass(const std::string& name, QueueType queueType) -> RenderPass*;
     auto getPass(const std::string& name) const noexcept -> RenderPass*;
     void setBackBuffer(const std::string& backBuffer);
+    // Keeps the passes producing this resource alive even if the back buffer doesn't depend on it
+    void exportResource(const std::string& name);
     template <typename T>
     auto getResource(const std::string& name) -> T*;
 
@@ -54,6 +62,53 @@ public:
     void enableDebugOutput(bool enable);
     void setForceDryRun(bool value);
 
+    // Transient resource memory aliasing
+    void setTransientAliasingEnabled(bool enable);
+    auto getTransientMemoryPlan() const -> const TransientMemoryPlan&;
+    auto getTransientPlacement(const std::string& resourceName) const -> const TransientPlacement*;
+
+    // Execution order of the last build, and the passes it dropped (explicitly culled or unreachable from the outputs)
+    auto getSortedPasses() const -> const SmallVector<RenderPass*>&;
+    auto getCulledPasses() const -> const SmallVector<RenderPass*>&;
+
+    // Passes grouped into per-queue submissions, split only where a resource crosses queues
+    struct SubmissionBatch
+    {
+        QueueType queueType = QueueType::Graphics;
+        SmallVector<RenderPass*> passes;
+        // Batches on other queues that have to complete first, at most one per queue
+        SmallVector<uint32_t> waitBatches;
+        // Position among the batches of the same queue, selects the timeline value signaled by this batch
+        uint32_t queueBatchIndex = 0;
+        vk::QueueSubmitInfo submitInfo;
+    };
+    auto getSubmissionBatches() const -> const SmallVector<SubmissionBatch>&;
+
+    // Barriers recorded for one frame of the last build
+    struct BarrierStats
+    {
+        uint32_t barrierCount  = 0; // Image and buffer barriers, including queue ownership releases
+        uint32_t batchCount    = 0; // Pipeline barrier commands they are grouped into
+        uint32_t skippedCount  = 0; // Accesses that needed no transition, e.g. reads of an already readable resource
+        uint32_t aliasingCount = 0; // First uses of transient memory that wait for the resources it held before
+    };
+    auto getBarrierStats() const -> const BarrierStats&;
+
+    // Passes (re-)recorded by the last build that did any work; untouched passes keep their command buffers
+    auto getRecordedPassCount() const -> uint32_t;
+
+    // Compiled graph snapshots. A snapshot taken after build() is used by the next full build of a graph
+    // with the same hash instead of sorting, culling, scheduling and planning barriers and memory again
+    auto getGraphHash() const -> uint64_t;
+    auto getCompiledGraph() const -> CompiledGraph;
+    void setCompiledGraph(CompiledGraph compiledGraph);
+    auto isCompiledGraphApplied() const -> bool;
+    auto saveCompiledGraph(std::string_view path) const -> Result;
+    auto loadCompiledGraph(std::string_view path) -> Result;
+    // Full builds load the snapshot named after getGraphHash() from this directory and save one when they had to
+    // compile. Empty turns the cache off.
+    void setCompiledGraphCache(std::string directory);
+
     // Breadcrumb tracking methods
     auto getBreadcrumbTracker() -> BreadcrumbTracker&;
     auto generateBreadcrumbReport() const -> std::string;
@@ -110,12 +165,39 @@ private:
     void importShader(const std::string& name, vk::ShaderProgram* pProgram);
 
     void setupImageResource(PassImageResource* imageResource, bool isColorAttachment);
+    auto getImageCreateInfo(PassImageResource* imageResource, bool isColorAttachment) const -> vk::ImageCreateInfo;
 
-    void setupImageBarrier(SmallVector<vk::ImageBarrier>& barriers, PassImageResource* resource,
+    void setupImageBarrier(SmallVector<vk::ImageBarrier>& barriers, RenderPass* pass, PassImageResource* resource,
                            ResourceState newState);
 
     template <typename BarrierType, typename ResourceType>
-    void setupResourceBarrier(SmallVector<BarrierType>& barriers, ResourceType* resource, ResourceState targetState);
+    void setupResourceBarrier(SmallVector<BarrierType>& barriers, RenderPass* pass, ResourceType* resource,
+                              ResourceState targetState);
+    template <typename BarrierType>
+    void setupOwnershipTransfer(BarrierType& barrier, RenderPass* pass, PassResource* resource);
+
+    // Command recording: barriers are planned serially, then passes are recorded concurrently
+    void planReadStates();
+    void planBarriers();
+    void planAliasingBarriers();
+    void countBarriers();
+    void setupPassBarriers(RenderPass* pass);
+    void setupRenderingInfo(RenderPass* pass);
+    auto recordPass(RenderPass* pass) const -> vk::CommandBuffer*;
+    auto recordPassTransitions(RenderPass* pass) const -> vk::CommandBuffer*;
+    void recordPasses(ArrayProxy<RenderPass*> passes);
+    void rebuildDirtyPasses();
+
+    void cullPasses();
+
+    auto applyCompiledGraph() -> bool;
+    auto applyCompiledTransientPlan() -> bool;
+    void applyCompiledBarriers();
+
+    // Multi-queue scheduling
+    void scheduleQueues();
+    auto getSubmitQueueType(QueueType queueType) const -> QueueType;
+    auto needsOwnershipTransfer(QueueType srcQueueType, QueueType dstQueueType) const -> bool;
 
 private:
     // Dirty flags to track what needs to be rebuilt
@@ -128,7 +210,10 @@ private:
         TopologyDirty       = 1 << 3, // Graph topology changed
         BackBufferDirty     = 1 << 4, // Back buffer changed
         SwapChainDirty      = 1 << 5, // Swapchain changed
-        All                 = 0xFFFFFFFF // Everything is dirty
+        // Incremental changes, the compiled graph stays valid and only the affected passes are re-recorded
+        PassCommandDirty     = 1 << 6, // Recorded commands of some passes changed
+        ResourceBindingDirty = 1 << 7, // Imported resources were rebound to other GPU objects
+        All                  = 0xFFFFFFFF // Everything is dirty
     };
 
     using DirtyFlags        = uint32_t;
@@ -140,6 +225,8 @@ private:
 
     void markResourcesChanged(PassResource::Type type);
     void markPassModified();
+    void markPassCommandModified(RenderPass* pass);
+    void markResourceRebound(PassResource* resource);
     void markImageResourcesModified();
     void markBufferResourcesModified();
     void markBackBufferModified();
@@ -148,6 +235,8 @@ private:
 private:
     vk::Device* m_pDevice                                 = {}; // Will be nullptr in dry run mode
     vk::CommandBufferAllocator* m_pCommandBufferAllocator = {};
+    FrameAllocator* m_pFrameAllocator                     = {}; // Per-frame scratch memory, set by the FrameComposer
+    TaskGroup* m_pRecordGroup                             = {}; // Resubmitted by every build that records passes
     BreadcrumbTracker m_breadcrumbs; // Frame-level breadcrumb tracker
 
     // Pending resource loads
@@ -187,16 +276,50 @@ private:
         HashMap<std::string, PendingBufferLoad> pendingBufferLoad;
         HashMap<std::string, PendingImageLoad> pendingImageLoad;
         HashMap<std::string, PendingShaderLoad> pendingShaderLoad;
+        HashSet<std::string> exportedResources;
     } m_declareData;
 
     struct
     {
         HashMap<RenderPass*, HashSet<RenderPass*>> passDependencyGraph;
         SmallVector<RenderPass*> sortedPasses;
+        SmallVector<RenderPass*> culledPasses;
 
         HashMap<RenderPass*, vk::CommandBuffer*> cmds;
+        // Replaced by an incremental rebuild while the previous frame may still use them
+        SmallVector<vk::CommandBuffer*> retiredCmds;
+        uint32_t recordedPassCount = 0;
+
+        // Pending incremental changes
+        HashSet<RenderPass*> dirtyPasses;
+        HashSet<PassResource*> reboundResources;
+        HashMap<vk::Image*, vk::Image*> reboundImages;
+        HashMap<vk::Buffer*, vk::Buffer*> reboundBuffers;
+
+        // Barrier-only command buffers submitted in place of conditional passes that are skipped
+        HashMap<RenderPass*, vk::CommandBuffer*> transitionCmds;
         HashMap<RenderPass*, SmallVector<vk::ImageBarrier>> imageBarriers;
         HashMap<RenderPass*, SmallVector<vk::BufferBarrier>> bufferBarriers;
+        HashMap<RenderPass*, vk::RenderingInfo> renderingInfos;
+
+        // Target state of each read, widened to cover the reads that follow it without a write in between
+        HashMap<RenderPass*, HashMap<PassResource*, ResourceState>> readStates;
+        BarrierStats barrierStats;
+
+        // Queue family ownership released at the end of a pass, acquired by a pass on another queue
+        HashMap<RenderPass*, SmallVector<vk::ImageBarrier>> releaseImageBarriers;
+        HashMap<RenderPass*, SmallVector<vk::BufferBarrier>> releaseBufferBarriers;
+        HashMap<PassResource*, RenderPass*> resourceOwners;
+
+        // Pass resource of each planned barrier, in the order of the barrier lists above
+        struct BarrierResources
+        {
+            SmallVector<PassResource*> image;
+            SmallVector<PassResource*> buffer;
+            SmallVector<PassResource*> releaseImage;
+            SmallVector<PassResource*> releaseBuffer;
+        };
+        HashMap<RenderPass*, BarrierResources> barrierResources;
 
         HashMap<PassResource*, vk::Image*> image;
         HashMap<PassResource*, vk::Buffer*> buffer;
@@ -208,9 +331,18 @@ private:
         vk::SwapChain* pSwapchain    = {};
         vk::Fence* frameExecuteFence = {};
 
-        SmallVector<vk::QueueSubmitInfo> frameSubmitInfos{};
+        SmallVector<SubmissionBatch> submissionBatches;
+        HashMap<RenderPass*, uint32_t> passBatchIndices;
         std::mutex submitLock;
 
+        // One timeline semaphore per queue, batches signal consecutive values
+        struct QueueTimeline
+        {
+            vk::Semaphore* pSemaphore = {};
+            uint64_t value            = 0;
+        };
+        HashMap<QueueType, QueueTimeline> queueTimelines;
+
         // Breadcrumb indices for each pass
         HashMap<RenderPass*, uint32_t> passBreadcrumbIndices;
     } m_buildData;
@@ -232,6 +364,8 @@ private:
         uint32_t lastUsePassIndex  = 0;
         size_t size                = 0;
         bool isImage               = false;
+        QueueType queueType        = QueueType::Unsupport; // Submit queue of the passes using it
+        bool multiQueue            = false;                // Used on more than one submit queue
     };
 
     HashMap<PassResource*, TransientResourceInfo> m_transientResources;
@@ -239,6 +373,27 @@ private:
     void analyzeResourceLifetimes();
     auto isResourceTransient(PassResource* resource) const -> bool;
 
+    struct
+    {
+        bool enabled = true;
+        SmallVector<PassResource*> resources; // Same order as the plan placements
+        HashMap<PassResource*, uint32_t> placementIndices;
+        TransientMemoryPlan plan;
+        SmallVector<DeviceAllocation*> heapMemory; // One block per plan heap, GPU mode only
+    } m_transientMemory;
+
+    void planTransientMemory();
+    void allocateTransientMemory();
+    void releaseTransientMemory();
+
+    struct
+    {
+        std::optional<CompiledGraph> pending; // Consumed by the next full build
+        SmallVector<PassResource*> resources; // Resolved CompiledGraph::resources
+        bool applied = false; // The last full build came from a snapshot
+        std::string cacheDirectory;
+    } m_compiledGraph;
+
     DebugCaptureInfo m_debugCapture;
     void capturePassOutput(RenderPass* pass, vk::CommandBuffer* cmd);
 };
@@ -307,6 +462,52 @@ inline void RenderGraph::setForceDryRun(bool value)
     m_forceDryRun = value;
 }
 
+inline void RenderGraph::setTransientAliasingEnabled(bool enable)
+{
+    m_transientMemory.enabled = enable;
+    markImageResourcesModified();
+}
+
+inline void RenderGraph::setCompiledGraphCache(std::string directory)
+{
+    m_compiledGraph.cacheDirectory = std::move(directory);
+}
+
+inline auto RenderGraph::getTransientMemoryPlan() const -> const TransientMemoryPlan&
+{
+    return m_transientMemory.plan;
+}
+
+inline auto RenderGraph::getSortedPasses() const -> const SmallVector<RenderPass*>&
+{
+    return m_buildData.sortedPasses;
+}
+
+inline auto RenderGraph::getCulledPasses() const -> const SmallVector<RenderPass*>&
+{
+    return m_buildData.culledPasses;
+}
+
+inline auto RenderGraph::getRecordedPassCount() const -> uint32_t
+{
+    return m_buildData.recordedPassCount;
+}
+
+inline auto RenderGraph::isCompiledGraphApplied() const -> bool
+{
+    return m_compiledGraph.applied;
+}
+
+inline auto RenderGraph::getBarrierStats() const -> const BarrierStats&
+{
+    return m_buildData.barrierStats;
+}
+
+inline auto RenderGraph::getSubmissionBatches() const -> const SmallVector<SubmissionBatch>&
+{
+    return m_buildData.submissionBatches;
+}
+
 inline void RenderGraph::enableFrameCapture(const std::string& outputPath)
 {
     m_debugCapture.enabled    = true;
@@ -367,6 +568,18 @@ inline void RenderGraph::markPassModified()
     setDirty(DirtyFlagBits::PassDirty | DirtyFlagBits::TopologyDirty);
 }
 
+inline void RenderGraph::markPassCommandModified(RenderPass* pass)
+{
+    m_buildData.dirtyPasses.insert(pass);
+    setDirty(DirtyFlagBits::PassCommandDirty);
+}
+
+inline void RenderGraph::markResourceRebound(PassResource* resource)
+{
+    m_buildData.reboundResources.insert(resource);
+    setDirty(DirtyFlagBits::ResourceBindingDirty);
+}
+
 inline void RenderGraph::markImageResourcesModified()
 {
     setDirty(DirtyFlagBits::ImageResourceDirty);
@@ -379,7 +592,8 @@ inline void RenderGraph::markBufferResourcesModified()
 
 inline void RenderGraph::markBackBufferModified()
 {
-    setDirty(DirtyFlagBits::BackBufferDirty);
+    // The back buffer is a culling root, so the pass list has to be rebuilt
+    setDirty(DirtyFlagBits::BackBufferDirty | DirtyFlagBits::TopologyDirty);
 }
 
 inline void RenderGraph::markTopologyModified()
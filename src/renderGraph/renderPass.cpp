@@ -221,19 +221,19 @@ auto RenderPass::setDepthStencilOut(const std::string& name, const RenderPassAtt
 void RenderPass::recordExecute(ExecuteCallBack&& cb)
 {
     m_executeCB = std::move(cb);
-    m_pRenderGraph->markPassModified();
+    m_pRenderGraph->markPassCommandModified(this);
 }
 
 void RenderPass::recordClear(ClearColorCallBack&& cb)
 {
+    // Not read when recording the pass, so there is nothing to re-record
     m_clearColorCB = std::move(cb);
-    m_pRenderGraph->markPassModified();
 }
 
 void RenderPass::recordDepthStencil(ClearDepthStencilCallBack&& cb)
 {
+    // Not read when recording the pass, so there is nothing to re-record
     m_clearDepthStencilCB = std::move(cb);
-    m_pRenderGraph->markPassModified();
 }
 
 void RenderPass::setExecutionCondition(std::function<bool()>&& condition)
@@ -278,13 +278,13 @@ void RenderPass::resetCommand()
 {
     m_executeCB = {};
     m_recordList.clear();
-    m_pRenderGraph->markPassModified();
+    m_pRenderGraph->markPassCommandModified(this);
 }
 
 void RenderPass::recordCommand(const std::string& shaderName, ExecuteCallBack&& callback)
 {
     m_recordList.push_back({ .shaderName = shaderName, .callback = std::move(callback) });
-    m_pRenderGraph->markPassModified();
+    m_pRenderGraph->markPassCommandModified(this);
 }
 
 auto RenderPass::Builder::build() -> RenderPass*
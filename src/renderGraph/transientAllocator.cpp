@@ -0,0 +1,201 @@
+#include "transientAllocator.h"
+
+#include "common/profiler.h"
+#include "common/utils.h"
+
+namespace aph
+{
+auto TransientAliasingAllocator::plan(ArrayProxy<TransientAllocationRequest> requests) -> TransientMemoryPlan
+{
+    APH_PROFILER_SCOPE();
+
+    TransientMemoryPlan plan{};
+    plan.placements.resize(requests.size());
+
+    // Largest resources first, earlier lifetimes first on ties, so the result is deterministic
+    SmallVector<uint32_t> order;
+    order.reserve(requests.size());
+    for (uint32_t index = 0; index < requests.size(); ++index)
+    {
+        const auto& request = requests[index];
+        plan.naiveSize += request.size;
+        if (request.size > 0)
+        {
+            order.push_back(index);
+        }
+    }
+    std::ranges::stable_sort(order,
+                             [&requests](uint32_t lhs, uint32_t rhs)
+                             {
+                                 if (requests[lhs].size != requests[rhs].size)
+                                 {
+                                     return requests[lhs].size > requests[rhs].size;
+                                 }
+                                 return requests[lhs].firstUsePassIndex < requests[rhs].firstUsePassIndex;
+                             });
+
+    struct Interval
+    {
+        std::size_t begin;
+        std::size_t end;
+    };
+
+    std::vector<SmallVector<uint32_t>> heapResources;
+    SmallVector<Interval> liveIntervals;
+
+    for (uint32_t index : order)
+    {
+        const auto& request = requests[index];
+
+        uint32_t heapIndex = 0;
+        for (; heapIndex < plan.heaps.size(); ++heapIndex)
+        {
+            if (plan.heaps[heapIndex].heapKey == request.heapKey)
+            {
+                break;
+            }
+        }
+        if (heapIndex == plan.heaps.size())
+        {
+            plan.heaps.push_back({ .heapKey = request.heapKey });
+            heapResources.emplace_back();
+        }
+
+        // Memory ranges that are in use while this resource is alive
+        liveIntervals.clear();
+        for (uint32_t placedIndex : heapResources[heapIndex])
+        {
+            if (lifetimesOverlap(request, requests[placedIndex]))
+            {
+                const auto& placed = plan.placements[placedIndex];
+                liveIntervals.push_back({ placed.offset, placed.offset + placed.size });
+            }
+        }
+        std::ranges::sort(liveIntervals, {}, &Interval::begin);
+
+        // Best fit: the smallest gap that still holds the resource, the heap tail otherwise
+        std::size_t bestOffset = SIZE_MAX;
+        std::size_t bestGap    = SIZE_MAX;
+        std::size_t cursor     = 0;
+        for (const auto& interval : liveIntervals)
+        {
+            std::size_t offset = utils::paddingSize(request.alignment, cursor);
+            if (offset + request.size <= interval.begin)
+            {
+                std::size_t gap = interval.begin - offset;
+                if (gap < bestGap)
+                {
+                    bestGap    = gap;
+                    bestOffset = offset;
+                }
+            }
+            cursor = std::max(cursor, interval.end);
+        }
+        if (bestOffset == SIZE_MAX)
+        {
+            bestOffset = utils::paddingSize(request.alignment, cursor);
+        }
+
+        plan.placements[index] = {
+            .heapIndex = heapIndex,
+            .offset    = bestOffset,
+            .size      = request.size,
+        };
+        heapResources[heapIndex].push_back(index);
+
+        auto& heap     = plan.heaps[heapIndex];
+        heap.size      = std::max(heap.size, bestOffset + request.size);
+        heap.alignment = std::max(heap.alignment, request.alignment);
+        heap.resourceCount++;
+    }
+
+    for (const auto& heap : plan.heaps)
+    {
+        plan.aliasedSize += heap.size;
+    }
+
+    // Placed resources overlapping in memory never overlap in lifetime, so one of each pair ends before the other
+    SmallVector<uint32_t> firstUseOrder{ order.begin(), order.end() };
+    std::ranges::stable_sort(firstUseOrder, {},
+                             [&requests](uint32_t index) { return requests[index].firstUsePassIndex; });
+    for (uint32_t index : firstUseOrder)
+    {
+        const auto& placement = plan.placements[index];
+        for (uint32_t previousIndex : heapResources[placement.heapIndex])
+        {
+            const auto& previous = plan.placements[previousIndex];
+            if (requests[previousIndex].lastUsePassIndex < requests[index].firstUsePassIndex &&
+                previous.offset < placement.offset + placement.size &&
+                placement.offset < previous.offset + previous.size)
+            {
+                plan.aliasing.push_back({ .request = index, .previousRequest = previousIndex });
+            }
+        }
+    }
+
+    // Peak of the bytes that are alive at the same time, the bound no packing can beat
+    uint32_t lastPassIndex = 0;
+    for (uint32_t index : order)
+    {
+        lastPassIndex = std::max(lastPassIndex, requests[index].lastUsePassIndex);
+    }
+    if (!order.empty())
+    {
+        std::vector<std::size_t> liveBytes(lastPassIndex + 1, 0);
+        for (uint32_t index : order)
+        {
+            const auto& request = requests[index];
+            for (uint32_t passIndex = request.firstUsePassIndex; passIndex <= request.lastUsePassIndex; ++passIndex)
+            {
+                liveBytes[passIndex] += request.size;
+            }
+        }
+        plan.peakLiveSize = *std::ranges::max_element(liveBytes);
+    }
+
+    return plan;
+}
+
+auto TransientAliasingAllocator::validate(ArrayProxy<TransientAllocationRequest> requests,
+                                          const TransientMemoryPlan& plan) -> bool
+{
+    if (plan.placements.size() != requests.size())
+    {
+        return false;
+    }
+
+    for (uint32_t lhs = 0; lhs < requests.size(); ++lhs)
+    {
+        const auto& lhsPlacement = plan.placements[lhs];
+        if (requests[lhs].size == 0)
+        {
+            continue;
+        }
+        if (lhsPlacement.heapIndex >= plan.heaps.size() ||
+            lhsPlacement.offset % requests[lhs].alignment != 0 ||
+            lhsPlacement.offset + lhsPlacement.size > plan.heaps[lhsPlacement.heapIndex].size)
+        {
+            return false;
+        }
+
+        for (uint32_t rhs = lhs + 1; rhs < requests.size(); ++rhs)
+        {
+            const auto& rhsPlacement = plan.placements[rhs];
+            if (requests[rhs].size == 0 || lhsPlacement.heapIndex != rhsPlacement.heapIndex ||
+                !lifetimesOverlap(requests[lhs], requests[rhs]))
+            {
+                continue;
+            }
+
+            bool memoryOverlaps = lhsPlacement.offset < rhsPlacement.offset + rhsPlacement.size &&
+                                  rhsPlacement.offset < lhsPlacement.offset + lhsPlacement.size;
+            if (memoryOverlaps)
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+} // namespace aph
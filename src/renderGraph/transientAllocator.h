@@ -0,0 +1,85 @@
+#pragma once
+
+#include "common/arrayProxy.h"
+#include "common/smallVector.h"
+
+namespace aph
+{
+struct TransientAllocationRequest
+{
+    std::size_t size           = 0;
+    std::size_t alignment      = 1; // Must be a power of two
+    uint32_t firstUsePassIndex = UINT32_MAX;
+    uint32_t lastUsePassIndex  = 0;
+
+    // Only requests with the same key can share a heap (e.g. images vs buffers, memory type bits)
+    uint32_t heapKey = 0;
+
+    // Pass indices only order the passes of one queue, requests of different queues may be alive together whatever
+    // their lifetimes say, so only requests with the same key share memory. MultiQueueKey never shares it.
+    static constexpr uint32_t MultiQueueKey = UINT32_MAX;
+    uint32_t queueKey                       = 0;
+};
+
+struct TransientPlacement
+{
+    uint32_t heapIndex = UINT32_MAX;
+    std::size_t offset = 0;
+    std::size_t size   = 0;
+};
+
+// Two requests that share memory one after the other. The first use of request has to wait for the last use of
+// previousRequest, it may still be accessing the bytes
+struct TransientAliasing
+{
+    uint32_t request         = 0;
+    uint32_t previousRequest = 0;
+};
+
+struct TransientHeap
+{
+    uint32_t heapKey       = 0;
+    std::size_t size       = 0;
+    std::size_t alignment  = 1;
+    uint32_t resourceCount = 0;
+};
+
+struct TransientMemoryPlan
+{
+    // One placement per request, in request order
+    SmallVector<TransientPlacement> placements;
+    SmallVector<TransientHeap> heaps;
+    // Every pair of placements whose memory overlaps, ordered by the first use of request
+    SmallVector<TransientAliasing> aliasing;
+
+    std::size_t naiveSize    = 0; // Every resource in its own allocation
+    std::size_t aliasedSize  = 0; // Sum of all heap sizes
+    std::size_t peakLiveSize = 0; // Largest number of bytes alive during a single pass (lower bound)
+
+    auto getSavedSize() const -> std::size_t
+    {
+        return naiveSize - aliasedSize;
+    }
+};
+
+// Packs resources with disjoint pass lifetimes into shared heaps.
+// Resources are placed largest first; each one takes the smallest gap that fits between the
+// resources it is alive together with, or the end of the heap if no gap is big enough.
+class TransientAliasingAllocator
+{
+public:
+    static auto plan(ArrayProxy<TransientAllocationRequest> requests) -> TransientMemoryPlan;
+
+    // True if no two lifetime-overlapping requests share memory in the plan
+    static auto validate(ArrayProxy<TransientAllocationRequest> requests, const TransientMemoryPlan& plan) -> bool;
+
+    static auto lifetimesOverlap(const TransientAllocationRequest& lhs, const TransientAllocationRequest& rhs) -> bool
+    {
+        if (lhs.queueKey != rhs.queueKey || lhs.queueKey == TransientAllocationRequest::MultiQueueKey)
+        {
+            return true;
+        }
+        return lhs.firstUsePassIndex <= rhs.lastUsePassIndex && rhs.firstUsePassIndex <= lhs.lastUsePassIndex;
+    }
+};
+} // namespace aph
@@ -54,7 +54,23 @@ Result BufferLoader::update(BufferAsset* pBufferAsset, const BufferUpdateInfo& u
         return { Result::RuntimeError, "Buffer asset is null" };
     }
 
-    return pBufferAsset->update(updateInfo);
+    vk::Buffer* pBuffer = pBufferAsset->getBuffer();
+    if (!pBuffer || pBuffer->getCreateInfo().domain != MemoryDomain::Device)
+    {
+        return pBufferAsset->update(updateInfo);
+    }
+
+    // Device local buffers can't be mapped, stage the data and wait for the copy
+    Range range = updateInfo.range;
+    if (range.size == VK_WHOLE_SIZE)
+    {
+        range.size = pBufferAsset->getSize() - range.offset;
+    }
+
+    StagingUploader* pUploader = m_pResourceLoader->getStagingUploader();
+    APH_RETURN_IF_ERROR(pUploader->uploadBuffer(pBuffer, range, updateInfo.data));
+    pUploader->flush();
+    return Result::Success;
 }
 
 void BufferLoader::unload(BufferAsset* pBufferAsset)
@@ -127,8 +143,8 @@ Result BufferLoader::createBufferResources(const BufferLoadInfo& info, BufferAss
     if (info.data && info.dataSize > 0)
     {
         // For Host or Upload memory, we can map directly
-        // For Device memory, we need a staging buffer
-        if (info.createInfo.domain == MemoryDomain::Host || info.createInfo.domain == MemoryDomain::Upload)
+        // Device memory is written through the staging ring, the copy goes out with the next upload flush
+        if (buffer->getCreateInfo().domain != MemoryDomain::Device)
         {
             void* pMapped = pDevice->mapMemory(buffer);
             if (pMapped)
@@ -139,34 +155,8 @@ Result BufferLoader::createBufferResources(const BufferLoadInfo& info, BufferAss
         }
         else
         {
-            // Otherwise, we need to use a staging buffer
-            vk::Buffer* stagingBuffer;
-            vk::BufferCreateInfo stagingCI{
-                .size   = info.dataSize,
-                .usage  = BufferUsage::TransferSrc,
-                .domain = MemoryDomain::Upload,
-            };
-
-            auto stagingResult = pDevice->create(stagingCI, std::string{ info.debugName } + std::string{ "_staging" });
-            APH_VERIFY_RESULT(stagingResult);
-            stagingBuffer = stagingResult.value();
-
-            // Map and copy data to staging buffer
-            void* pMapped = pDevice->mapMemory(stagingBuffer);
-            APH_ASSERT(pMapped);
-            std::memcpy(pMapped, info.data, info.dataSize);
-            pDevice->unMapMemory(stagingBuffer);
-
-            // Copy from staging buffer to destination buffer
-            vk::Queue* pTransferQueue = pDevice->getQueue(QueueType::Transfer);
-            pDevice->executeCommand(pTransferQueue,
-                                    [&](auto* cmd)
-                                    {
-                                        cmd->copy(stagingBuffer, buffer, Range{ .offset = 0, .size = info.dataSize });
-                                    });
-
-            // Cleanup staging buffer
-            pDevice->destroy(stagingBuffer);
+            APH_VERIFY_RESULT(m_pResourceLoader->getStagingUploader()->uploadBuffer(
+                buffer, Range{ .offset = 0, .size = info.dataSize }, info.data));
         }
     }
 
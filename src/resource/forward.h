@@ -2,11 +2,14 @@
 
 #include "common/logger.h"
 
+// Logging macros of the resource loader module
+#define LOADER_LOG_DEBUG(...) APH_LOG_TAGGED(LOADER, Debug, __VA_ARGS__)
+#define LOADER_LOG_INFO(...)  APH_LOG_TAGGED(LOADER, Info, __VA_ARGS__)
+#define LOADER_LOG_WARN(...)  APH_LOG_TAGGED(LOADER, Warn, __VA_ARGS__)
+#define LOADER_LOG_ERR(...)   APH_LOG_TAGGED(LOADER, Error, __VA_ARGS__)
+
 namespace aph
 {
-// Forward declaration of logging functions for the resource loader module
-GENERATE_LOG_FUNCS(LOADER)
-
 // Forward declare Asset classes
 class BufferAsset;
 class ImageAsset;
@@ -81,6 +81,16 @@ auto GeometryAsset::getGeometryResource() const -> IGeometryResource*
     return m_pGeometryResource.get();
 }
 
+void GeometryAsset::setBufferAssets(SmallVector<BufferAsset*> bufferAssets)
+{
+    m_bufferAssets = std::move(bufferAssets);
+}
+
+auto GeometryAsset::getBufferAssets() const -> const SmallVector<BufferAsset*>&
+{
+    return m_bufferAssets;
+}
+
 // Buffer accessors implementation
 auto GeometryAsset::getPositionBuffer() const -> vk::Buffer*
 {
@@ -3,6 +3,7 @@
 #include "coro/coro.hpp"
 #include "geometry/geometry.h"
 #include "geometry/geometryResource.h"
+#include "resource/forward.h"
 
 namespace aph
 {
@@ -158,7 +159,12 @@ public:
     void setMaterialIndex(uint32_t submeshIndex, uint32_t materialIndex);
     void setGeometryResource(std::unique_ptr<IGeometryResource> pResource);
 
+    // Buffer assets backing the geometry resource, they are released together with the geometry
+    void setBufferAssets(SmallVector<BufferAsset*> bufferAssets);
+    [[nodiscard]] auto getBufferAssets() const -> const SmallVector<BufferAsset*>&;
+
 private:
     std::unique_ptr<IGeometryResource> m_pGeometryResource;
+    SmallVector<BufferAsset*> m_bufferAssets;
 };
 } // namespace aph
@@ -48,7 +48,13 @@ void GeometryLoader::unload(GeometryAsset* pGeometryAsset)
 {
     if (pGeometryAsset != nullptr)
     {
+        // The buffers belong to the geometry alone, nothing else unloads them
+        SmallVector<BufferAsset*> bufferAssets = pGeometryAsset->getBufferAssets();
         m_geometryAssetPool.free(pGeometryAsset);
+        for (BufferAsset* pBufferAsset : bufferAssets)
+        {
+            m_pResourceLoader->unLoadOwnedBuffer(pBufferAsset);
+        }
     }
 }
 
@@ -479,6 +485,9 @@ auto GeometryLoader::createGeometryResources(const std::vector<Meshlet>& meshlet
     // Determine index type based on vertex count
     gpuData.indexType = (vertices.size() > static_cast<size_t>(UINT16_MAX)) ? IndexType::UINT32 : IndexType::UINT16;
 
+    // Owned by the geometry asset, which accounts their memory in its residency and unloads them with it
+    SmallVector<BufferAsset*> bufferAssets;
+
     // Create position buffer
     {
         BufferLoadInfo bufferInfo{
@@ -491,9 +500,10 @@ auto GeometryLoader::createGeometryResources(const std::vector<Meshlet>& meshlet
             .contentType = BufferContentType::Vertex
         };
 
-        auto expected = m_pResourceLoader->load(bufferInfo);
+        auto expected = m_pResourceLoader->loadOwnedBuffer(bufferInfo);
         VerifyExpected(expected);
         gpuData.pPositionBuffer = expected.value()->getBuffer();
+        bufferAssets.push_back(expected.value());
     }
 
     // Create attribute buffer
@@ -508,9 +518,10 @@ auto GeometryLoader::createGeometryResources(const std::vector<Meshlet>& meshlet
             .contentType = BufferContentType::Vertex
         };
 
-        auto expected = m_pResourceLoader->load(bufferInfo);
+        auto expected = m_pResourceLoader->loadOwnedBuffer(bufferInfo);
         VerifyExpected(expected);
         gpuData.pAttributeBuffer = expected.value()->getBuffer();
+        bufferAssets.push_back(expected.value());
     }
 
     // Create index buffer
@@ -537,9 +548,10 @@ auto GeometryLoader::createGeometryResources(const std::vector<Meshlet>& meshlet
                 .contentType = BufferContentType::Index
             };
 
-            auto expected = m_pResourceLoader->load(bufferInfo);
+            auto expected = m_pResourceLoader->loadOwnedBuffer(bufferInfo);
             VerifyExpected(expected);
             gpuData.pIndexBuffer = expected.value()->getBuffer();
+            bufferAssets.push_back(expected.value());
         }
         else
         {
@@ -553,9 +565,10 @@ auto GeometryLoader::createGeometryResources(const std::vector<Meshlet>& meshlet
                 .contentType = BufferContentType::Index
             };
 
-            auto expected = m_pResourceLoader->load(bufferInfo);
+            auto expected = m_pResourceLoader->loadOwnedBuffer(bufferInfo);
             VerifyExpected(expected);
             gpuData.pIndexBuffer = expected.value()->getBuffer();
+            bufferAssets.push_back(expected.value());
         }
     }
 
@@ -571,9 +584,10 @@ auto GeometryLoader::createGeometryResources(const std::vector<Meshlet>& meshlet
             .contentType = BufferContentType::Storage
         };
 
-        auto expected = m_pResourceLoader->load(bufferInfo);
+        auto expected = m_pResourceLoader->loadOwnedBuffer(bufferInfo);
         VerifyExpected(expected);
         gpuData.pMeshletBuffer = expected.value()->getBuffer();
+        bufferAssets.push_back(expected.value());
     }
 
     // Create meshlet vertex buffer
@@ -588,9 +602,10 @@ auto GeometryLoader::createGeometryResources(const std::vector<Meshlet>& meshlet
             .contentType = BufferContentType::Storage
         };
 
-        auto expected = m_pResourceLoader->load(bufferInfo);
+        auto expected = m_pResourceLoader->loadOwnedBuffer(bufferInfo);
         VerifyExpected(expected);
         gpuData.pMeshletVertexBuffer = expected.value()->getBuffer();
+        bufferAssets.push_back(expected.value());
     }
 
     // Create meshlet index buffer
@@ -605,9 +620,10 @@ auto GeometryLoader::createGeometryResources(const std::vector<Meshlet>& meshlet
             .contentType = BufferContentType::Storage
         };
 
-        auto expected = m_pResourceLoader->load(bufferInfo);
+        auto expected = m_pResourceLoader->loadOwnedBuffer(bufferInfo);
         VerifyExpected(expected);
         gpuData.pMeshletIndexBuffer = expected.value()->getBuffer();
+        bufferAssets.push_back(expected.value());
     }
 
     // Create the geometry resource
@@ -618,6 +634,7 @@ auto GeometryLoader::createGeometryResources(const std::vector<Meshlet>& meshlet
 
     // Set the geometry resource in the asset
     (*ppGeometryAsset)->setGeometryResource(std::move(pGeometryResource));
+    (*ppGeometryAsset)->setBufferAssets(std::move(bufferAssets));
 
     return Result::Success;
 }
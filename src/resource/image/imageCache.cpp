@@ -21,17 +21,34 @@ ImageCache::ImageCache()
     }
 }
 
-ImageData* ImageCache::findImage(const std::string& cacheKey)
+void ImageCache::setResidencyManager(ResidencyManager* pResidency, ReleaseFunc&& release)
+{
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    APH_ASSERT(m_ownedImages.empty(), "The residency manager has to be set before images are cached");
+    m_pResidency = pResidency;
+    m_release    = std::move(release);
+}
+
+ImageData* ImageCache::acquireImage(const std::string& cacheKey)
 {
     APH_PROFILER_SCOPE();
 
     std::lock_guard<std::mutex> lock(m_cacheMutex);
 
-    if (auto it = m_memoryCache.find(cacheKey); it != m_memoryCache.end())
+    auto it = m_memoryCache.find(cacheKey);
+    if (it == m_memoryCache.end())
+    {
+        return nullptr;
+    }
+
+    // A failed pin means the image was just picked for eviction, treat it as a miss
+    ImageData* pImageData = it->second;
+    if (m_pResidency && !m_pResidency->pin(pImageData))
     {
-        return it->second;
+        return nullptr;
     }
-    return nullptr;
+    m_ownedImages[pImageData].useCount++;
+    return pImageData;
 }
 
 bool ImageCache::existsInFileCache(const std::string& cacheKey) const
@@ -52,29 +69,91 @@ void ImageCache::addImage(const std::string& cacheKey, ImageData* pImageData)
     if (!pImageData)
         return;
 
-    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    ImageData* pReleased = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_cacheMutex);
+        APH_ASSERT(!m_ownedImages.contains(pImageData));
 
-    // If entry already exists, remove the old one first
-    auto it = m_memoryCache.find(cacheKey);
-    if (it != m_memoryCache.end())
+        // The image this one replaces goes once nobody uses it anymore
+        auto it = m_memoryCache.find(cacheKey);
+        if (it != m_memoryCache.end())
+        {
+            ImageData* pOld = it->second;
+            m_memoryCache.erase(it);
+            pReleased = dropOrphan(pOld);
+        }
+
+        m_memoryCache[cacheKey]   = pImageData;
+        m_ownedImages[pImageData] = { .cacheKey = cacheKey, .useCount = 1 };
+
+        if (m_pResidency)
+        {
+            std::size_t size = sizeof(ImageData);
+            for (const auto& mipLevel : pImageData->mipLevels)
+            {
+                size += mipLevel.data.size();
+            }
+            m_pResidency->track(pImageData, ResidencyClass::ImageData, size, 0,
+                                [this, pImageData]()
+                                {
+                                    evictImage(pImageData);
+                                });
+            m_pResidency->pin(pImageData);
+        }
+    }
+
+    if (pReleased && m_release)
     {
-        // Don't delete the old one, just update the mapping
-        // The old one might still be in use somewhere
+        m_release(pReleased);
     }
+}
 
-    m_memoryCache[cacheKey] = pImageData;
+void ImageCache::releaseImage(ImageData* pImageData)
+{
+    ImageData* pReleased = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_cacheMutex);
+
+        auto it = m_ownedImages.find(pImageData);
+        APH_ASSERT(it != m_ownedImages.end() && it->second.useCount > 0, "Image wasn't acquired from the cache");
+        it->second.useCount--;
+        if (m_pResidency)
+        {
+            m_pResidency->unpin(pImageData);
+        }
+
+        auto cached = m_memoryCache.find(it->second.cacheKey);
+        if (cached == m_memoryCache.end() || cached->second != pImageData)
+        {
+            pReleased = dropOrphan(pImageData);
+        }
+    }
+
+    if (pReleased && m_release)
+    {
+        m_release(pReleased);
+    }
 }
 
 void ImageCache::removeImage(const std::string& cacheKey)
 {
-    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    ImageData* pReleased = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_cacheMutex);
 
-    auto it = m_memoryCache.find(cacheKey);
-    if (it != m_memoryCache.end())
+        auto it = m_memoryCache.find(cacheKey);
+        if (it != m_memoryCache.end())
+        {
+            // Images still in use are freed by their last releaseImage()
+            ImageData* pImageData = it->second;
+            m_memoryCache.erase(it);
+            pReleased = dropOrphan(pImageData);
+        }
+    }
+
+    if (pReleased && m_release)
     {
-        // Just remove from cache, don't delete the object
-        // It might still be in use somewhere
-        m_memoryCache.erase(it);
+        m_release(pReleased);
     }
 }
 
@@ -101,11 +180,77 @@ void ImageCache::clear()
 {
     APH_PROFILER_SCOPE();
 
-    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    HashMap<ImageData*, OwnedImage> ownedImages;
+    {
+        std::lock_guard<std::mutex> lock(m_cacheMutex);
+        m_memoryCache.clear();
+        std::swap(ownedImages, m_ownedImages);
+
+        for (const auto& [pImageData, ownedImage] : ownedImages)
+        {
+            APH_ASSERT(ownedImage.useCount == 0, "Clearing an image cache that is still in use");
+            if (m_pResidency)
+            {
+                m_pResidency->untrack(pImageData);
+            }
+        }
+    }
+
+    if (m_release)
+    {
+        for (const auto& [pImageData, ownedImage] : ownedImages)
+        {
+            m_release(pImageData);
+        }
+    }
+}
+
+void ImageCache::evictImage(ImageData* pImageData)
+{
+    std::string cacheKey;
+    {
+        std::lock_guard<std::mutex> lock(m_cacheMutex);
 
-    // Only clear the cache mapping, don't delete the objects
-    // They might still be in use somewhere
-    m_memoryCache.clear();
+        // Gone already if clear() ran in between
+        auto it = m_ownedImages.find(pImageData);
+        if (it == m_ownedImages.end())
+        {
+            return;
+        }
+
+        // Pinned while in use, so an evicted image is never acquired again
+        APH_ASSERT(it->second.useCount == 0);
+        cacheKey    = it->second.cacheKey;
+        auto cached = m_memoryCache.find(it->second.cacheKey);
+        if (cached != m_memoryCache.end() && cached->second == pImageData)
+        {
+            m_memoryCache.erase(cached);
+        }
+        m_ownedImages.erase(it);
+    }
+
+    CM_LOG_DEBUG("Evicted decoded image %s from the memory cache", cacheKey);
+    if (m_release)
+    {
+        m_release(pImageData);
+    }
+}
+
+auto ImageCache::dropOrphan(ImageData* pImageData) -> ImageData*
+{
+    auto it = m_ownedImages.find(pImageData);
+    if (it == m_ownedImages.end() || it->second.useCount > 0)
+    {
+        return nullptr;
+    }
+
+    // Lost against an eviction in flight, evictImage() frees it
+    if (m_pResidency && !m_pResidency->untrack(pImageData))
+    {
+        return nullptr;
+    }
+    m_ownedImages.erase(it);
+    return pImageData;
 }
 
 // Helper function to generate a cache key based on image load info
@@ -2,6 +2,7 @@
 
 #include "common/common.h"
 #include "imageAsset.h"
+#include "resource/residencyManager.h"
 
 namespace aph
 {
@@ -9,12 +10,20 @@ namespace aph
 struct ImageData;
 
 // Image cache manager
+//
+// Decoded images in the memory cache are accounted as ResidencyClass::ImageData once a residency manager is set.
+// The cache owns them from addImage() on and frees them through the release callback when they are evicted or
+// replaced. Users hold on to an image between acquireImage() (or addImage()) and releaseImage().
 class ImageCache
 {
 public:
+    using ReleaseFunc = std::function<void(ImageData*)>;
+
     // Constructor is now public
     ImageCache();
 
+    void setResidencyManager(ResidencyManager* pResidency, ReleaseFunc&& release);
+
     // Cache directory management
     void setCacheDirectory(const std::string& path);
     auto getCacheDirectory() const -> std::string;
@@ -22,17 +31,32 @@ public:
 
     // Memory cache operations
     void addImage(const std::string& cacheKey, ImageData* pImageData);
+    auto acquireImage(const std::string& cacheKey) -> ImageData*;
+    void releaseImage(ImageData* pImageData);
     void removeImage(const std::string& cacheKey);
     void clear();
-    auto findImage(const std::string& cacheKey) -> ImageData*;
 
     // Cache key and existence checks
     auto existsInFileCache(const std::string& cacheKey) const -> bool;
     auto generateCacheKey(const ImageLoadInfo& info) const -> std::string;
 
 private:
+    void evictImage(ImageData* pImageData);
+    // Drops an image that is neither in use nor reachable through its key anymore, returns it for m_release
+    auto dropOrphan(ImageData* pImageData) -> ImageData*;
+
+    struct OwnedImage
+    {
+        std::string cacheKey;
+        uint32_t useCount;
+    };
+
     std::string m_cacheDirectory;
     HashMap<std::string, ImageData*> m_memoryCache;
+    // Every image the cache owns, including replaced ones that are still in use
+    HashMap<ImageData*, OwnedImage> m_ownedImages;
+    ResidencyManager* m_pResidency = {};
+    ReleaseFunc m_release;
     mutable std::mutex m_cacheMutex;
 };
-} // namespace aph
\ No newline at end of file
+} // namespace aph
@@ -17,6 +17,12 @@
 
 namespace aph
 {
+namespace
+{
+// Staging offsets of buffer to image copies have to be a multiple of 4 and of the texel block size
+constexpr std::size_t ImageCopyAlignment = 16;
+} // namespace
+
 //-----------------------------------------------------------------------------
 // ImageLoader Implementation
 //-----------------------------------------------------------------------------
@@ -44,6 +50,11 @@ ImageLoader::ImageLoader(ResourceLoader* pResourceLoader)
 
     // Initialize the image cache with our cache path
     m_imageCache.setCacheDirectory(m_cachePath);
+    m_imageCache.setResidencyManager(m_pResourceLoader->getResidencyManager(),
+                                     [this](ImageData* pImageData)
+                                     {
+                                         m_imageDataPool.free(pImageData);
+                                     });
 
     LOADER_LOG_INFO("Image cache directory: %s", m_cachePath.c_str());
 }
@@ -257,7 +268,7 @@ Expected<ImageAsset*> ImageLoader::load(const ImageLoadInfo& info)
             auto genResult = generateMipmaps(imageDataResult.value());
             if (!genResult)
             {
-                m_imageDataPool.free(imageDataResult.value());
+                releaseImageData(imageDataResult.value());
                 return genResult.transform(
                     [](bool)
                     {
@@ -267,14 +278,23 @@ Expected<ImageAsset*> ImageLoader::load(const ImageLoadInfo& info)
         }
     }
 
-    // Create and return the asset from the image data
+    // Create and return the asset from the image data, which is staged by now and not needed anymore
     auto result = createImageResources(imageDataResult.value(), info);
-    if (!result)
+    releaseImageData(imageDataResult.value());
+    return result;
+}
+
+void ImageLoader::releaseImageData(ImageData* pImageData)
+{
+    // Cached image data belongs to the memory cache, everything else was decoded for a single load
+    if (pImageData->isCached)
     {
-        // Free the image data since we couldn't create the resource
-        m_imageDataPool.free(imageDataResult.value());
+        m_imageCache.releaseImage(pImageData);
+    }
+    else
+    {
+        m_imageDataPool.free(pImageData);
     }
-    return result;
 }
 
 void ImageLoader::unload(ImageAsset* pImageAsset)
@@ -302,7 +322,7 @@ Expected<ImageData*> ImageLoader::loadFromCache(const std::string& cacheKey)
     APH_PROFILER_SCOPE();
 
     // First check if the image is in memory cache
-    if (ImageData* pCachedImage = m_imageCache.findImage(cacheKey))
+    if (ImageData* pCachedImage = m_imageCache.acquireImage(cacheKey))
     {
         return pCachedImage;
     }
@@ -889,39 +909,7 @@ Expected<ImageAsset*> ImageLoader::createImageResources(ImageData* pImageData, c
         return { Result::RuntimeError, "Device or queues not available" };
     }
 
-    // Create staging buffer for the base mip level
-    vk::Buffer* stagingBuffer = nullptr;
-    {
-        // Get size of first mip level
-        size_t baseDataSize = pImageData->mipLevels[0].data.size();
-
-        vk::BufferCreateInfo bufferCI{
-            .size   = baseDataSize,
-            .usage  = BufferUsage::TransferSrc,
-            .domain = MemoryDomain::Upload,
-        };
-
-        auto stagingResult = pDevice->create(bufferCI, std::string{ info.debugName } + std::string{ "_staging" });
-        if (!stagingResult)
-        {
-            m_imageAssetPool.free(pImageAsset);
-            return { Result::RuntimeError, "Failed to create staging buffer: " + stagingResult.error().message };
-        }
-
-        stagingBuffer = stagingResult.value();
-
-        // Map and copy data to staging buffer
-        void* pMapped = pDevice->mapMemory(stagingBuffer);
-        if (!pMapped)
-        {
-            pDevice->destroy(stagingBuffer);
-            m_imageAssetPool.free(pImageAsset);
-            return { Result::RuntimeError, "Failed to map staging buffer memory" };
-        }
-
-        std::memcpy(pMapped, pImageData->mipLevels[0].data.data(), baseDataSize);
-        pDevice->unMapMemory(stagingBuffer);
-    }
+    StagingUploader* pUploader = m_pResourceLoader->getStagingUploader();
 
     // Create the image
     vk::Image* image = nullptr;
@@ -956,59 +944,74 @@ Expected<ImageAsset*> ImageLoader::createImageResources(ImageData* pImageData, c
         auto imageResult = pDevice->create(imageCI, info.debugName);
         if (!imageResult)
         {
-            pDevice->destroy(stagingBuffer);
             m_imageAssetPool.free(pImageAsset);
             return { Result::RuntimeError, "Failed to create image: " + imageResult.error().message };
         }
 
         image = imageResult.value();
 
-        // For simple copy operations, use the transfer queue
-        pDevice->executeCommand(pTransferQueue,
-                                [&](auto* cmd)
-                                {
-                                    // Transition from Undefined to CopyDest
-                                    vk::ImageBarrier barrier{ .pImage             = image,
-                                                              .currentState       = ResourceState::Undefined,
-                                                              .newState           = ResourceState::CopyDest,
-                                                              .queueType          = pTransferQueue->getType(),
-                                                              .subresourceBarrier = 0 };
-                                    cmd->insertBarrier({ barrier });
-
-                                    // Create BufferImageCopy info
-                                    BufferImageCopy region{
-                                        .bufferOffset      = 0,
-                                        .bufferRowLength   = 0, // Tightly packed
-                                        .bufferImageHeight = 0, // Tightly packed
-                                        .imageSubresource  = { .aspectMask     = 1, // Color aspect
-                                                               .mipLevel       = 0, // Base mip level
-                                                               .baseArrayLayer = 0,
-                                                              .layerCount     = 1 },
-                                        .imageOffset       = {}, // Zero offset
-                                        .imageExtent       = { .width  = pImageData->width,
-                                                              .height = pImageData->height,
-                                                              .depth  = pImageData->depth }
-                                    };
-
-                                    // Copy from staging buffer to image
-                                    cmd->copy(stagingBuffer, image, { region });
-
-                                    // Transition to ShaderResource for sampling (if mipmaps aren't being generated)
-                                    if (pImageData->mipLevels.size() == 1 &&
-                                        (info.featureFlags & ImageFeatureBits::eGenerateMips) ==
-                                            ImageFeatureBits::eNone)
-                                    {
-                                        barrier.currentState = ResourceState::CopyDest;
-                                        barrier.newState     = ResourceState::ShaderResource;
-                                        cmd->insertBarrier({ barrier });
-                                    }
-                                });
+        // The copies are batched with the other uploads on the transfer queue. The records run when the batch
+        // is submitted, so they only capture values that outlive this function.
+        const uint32_t width     = pImageData->width;
+        const uint32_t height    = pImageData->height;
+        const uint32_t depth     = pImageData->depth;
+        const QueueType copyType = pTransferQueue->getType();
+
+        // Transition to ShaderResource for sampling (if mipmaps aren't being generated)
+        const bool finalizeBaseLevel = pImageData->mipLevels.size() == 1 &&
+                                       (info.featureFlags & ImageFeatureBits::eGenerateMips) == ImageFeatureBits::eNone;
+
+        const auto& baseLevel = pImageData->mipLevels[0].data;
+        auto uploadResult     = pUploader->upload(
+            baseLevel.data(), baseLevel.size(), ImageCopyAlignment,
+            [=](vk::CommandBuffer* cmd, const StagingRegion& staging)
+            {
+                // Transition from Undefined to CopyDest
+                vk::ImageBarrier barrier{ .pImage             = image,
+                                          .currentState       = ResourceState::Undefined,
+                                          .newState           = ResourceState::CopyDest,
+                                          .queueType          = copyType,
+                                          .subresourceBarrier = 0 };
+                cmd->insertBarrier({ barrier });
+
+                // Create BufferImageCopy info
+                BufferImageCopy region{
+                    .bufferOffset      = staging.offset,
+                    .bufferRowLength   = 0, // Tightly packed
+                    .bufferImageHeight = 0, // Tightly packed
+                    .imageSubresource  = { .aspectMask     = 1, // Color aspect
+                                           .mipLevel       = 0, // Base mip level
+                                           .baseArrayLayer = 0,
+                                           .layerCount     = 1 },
+                    .imageOffset       = {}, // Zero offset
+                    .imageExtent       = { .width = width, .height = height, .depth = depth }
+                };
+
+                // Copy from staging buffer to image
+                cmd->copy(staging.pBuffer, image, { region });
+
+                if (finalizeBaseLevel)
+                {
+                    barrier.currentState = ResourceState::CopyDest;
+                    barrier.newState     = ResourceState::ShaderResource;
+                    cmd->insertBarrier({ barrier });
+                }
+            });
+        if (!uploadResult)
+        {
+            pDevice->destroy(image);
+            m_imageAssetPool.free(pImageAsset);
+            return { Result::RuntimeError, "Failed to stage image data: " + std::string{ uploadResult.toString() } };
+        }
 
         // Check if we need to generate mipmaps using the GPU
         bool gpuMipmapsGenerated = false;
         if (pImageData->mipLevels.size() == 1 &&
             (info.featureFlags & ImageFeatureBits::eGenerateMips) != ImageFeatureBits::eNone)
         {
+            // Mip generation on the graphics queue reads the base level, which has to be uploaded by then
+            pUploader->flush();
+
             // Determine preferred mipmap generation mode
             MipmapGenerationMode mode = MipmapGenerationMode::ePreferGPU;
 
@@ -1056,74 +1059,47 @@ Expected<ImageAsset*> ImageLoader::createImageResources(ImageData* pImageData, c
             // If we have multiple mip levels from CPU generation, upload them
             for (uint32_t i = 1; i < pImageData->mipLevels.size(); i++)
             {
-                // Create a staging buffer for this mip level
-                size_t mipDataSize = pImageData->mipLevels[i].data.size();
-
-                vk::BufferCreateInfo mipBufferCI{
-                    .size   = mipDataSize,
-                    .usage  = BufferUsage::TransferSrc,
-                    .domain = MemoryDomain::Upload,
-                };
-
-                std::string mipStagingName = info.debugName + "_mip" + std::to_string(i) + "_staging";
-                auto mipStagingResult      = pDevice->create(mipBufferCI, mipStagingName);
-                if (!mipStagingResult)
-                {
-                    continue; // Skip this mip level if we can't create a staging buffer
-                }
-
-                vk::Buffer* mipStagingBuffer = mipStagingResult.value();
-
-                // Map and copy data to staging buffer
-                void* pMapped = pDevice->mapMemory(mipStagingBuffer);
-                if (!pMapped)
+                const auto& mipLevel = pImageData->mipLevels[i].data;
+                auto mipResult       = pUploader->upload(
+                    mipLevel.data(), mipLevel.size(), ImageCopyAlignment,
+                    [=](vk::CommandBuffer* cmd, const StagingRegion& staging)
+                    {
+                        // Create BufferImageCopy info for this mip level
+                        BufferImageCopy region{
+                            .bufferOffset      = staging.offset,
+                            .bufferRowLength   = 0, // Tightly packed
+                            .bufferImageHeight = 0, // Tightly packed
+                            .imageSubresource  = { .aspectMask     = 1,
+                                                   .mipLevel       = i,
+                                                   .baseArrayLayer = 0,
+                                                   .layerCount     = 1 },
+                            .imageOffset       = {}, // Zero offset
+                            .imageExtent       = { .width  = std::max(1u, width >> i),
+                                                   .height = std::max(1u, height >> i),
+                                                   .depth  = depth }
+                        };
+
+                        // Transition mip level from Undefined/General to CopyDst
+                        vk::ImageBarrier barrier{ .pImage             = image,
+                                                  .currentState       = ResourceState::Undefined,
+                                                  .newState           = ResourceState::CopyDest,
+                                                  .queueType          = copyType,
+                                                  .subresourceBarrier = 1, // Only this mip level
+                                                  .mipLevel           = static_cast<uint8_t>(i) };
+                        cmd->insertBarrier({ barrier });
+
+                        // Copy from staging buffer to image
+                        cmd->copy(staging.pBuffer, image, { region });
+
+                        // Transition to ShaderResource for sampling
+                        barrier.currentState = ResourceState::CopyDest;
+                        barrier.newState     = ResourceState::ShaderResource;
+                        cmd->insertBarrier({ barrier });
+                    });
+                if (!mipResult)
                 {
-                    pDevice->destroy(mipStagingBuffer);
-                    continue;
+                    continue; // Skip this mip level if it can't be staged
                 }
-
-                std::memcpy(pMapped, pImageData->mipLevels[i].data.data(), mipDataSize);
-                pDevice->unMapMemory(mipStagingBuffer);
-
-                // Copy from staging buffer to image for this mip level
-                pDevice->executeCommand(pTransferQueue,
-                                        [&](auto* cmd)
-                                        {
-                                            // Create BufferImageCopy info for this mip level
-                                            BufferImageCopy region{
-                                                .bufferOffset      = 0,
-                                                .bufferRowLength   = 0, // Tightly packed
-                                                .bufferImageHeight = 0, // Tightly packed
-                                                .imageSubresource  = { .aspectMask     = 1,
-                                                                      .mipLevel       = i,
-                                                                      .baseArrayLayer = 0,
-                                                                      .layerCount     = 1 },
-                                                .imageOffset       = {}, // Zero offset
-                                                .imageExtent       = { .width  = std::max(1u, pImageData->width >> i),
-                                                                      .height = std::max(1u, pImageData->height >> i),
-                                                                      .depth  = pImageData->depth }
-                                            };
-
-                                            // Transition mip level from Undefined/General to CopyDst
-                                            vk::ImageBarrier barrier{ .pImage             = image,
-                                                                      .currentState       = ResourceState::Undefined,
-                                                                      .newState           = ResourceState::CopyDest,
-                                                                      .queueType          = pTransferQueue->getType(),
-                                                                      .subresourceBarrier = 1, // Only this mip level
-                                                                      .mipLevel           = static_cast<uint8_t>(i) };
-                                            cmd->insertBarrier({ barrier });
-
-                                            // Copy from staging buffer to image
-                                            cmd->copy(mipStagingBuffer, image, { region });
-
-                                            // Transition to ShaderResource for sampling
-                                            barrier.currentState = ResourceState::CopyDest;
-                                            barrier.newState     = ResourceState::ShaderResource;
-                                            cmd->insertBarrier({ barrier });
-                                        });
-
-                // Destroy the staging buffer for this mip level
-                pDevice->destroy(mipStagingBuffer);
             }
         }
         else
@@ -1131,25 +1107,21 @@ Expected<ImageAsset*> ImageLoader::createImageResources(ImageData* pImageData, c
             // Simple final transition for base mip level since it's the only one we uploaded
             // and no mipmaps were generated. Only needed if we haven't already done this
             // transition during the initial upload.
-            pDevice->executeCommand(pTransferQueue,
-                                    [&](auto* cmd)
-                                    {
-                                        vk::ImageBarrier finalBarrier{
-                                            .pImage             = image,
-                                            .currentState       = ResourceState::CopyDest,
-                                            .newState           = ResourceState::ShaderResource,
-                                            .queueType          = pTransferQueue->getType(),
-                                            .subresourceBarrier = 0, // Apply to all mip levels
-                                        };
-                                        cmd->insertBarrier({ finalBarrier });
-                                    });
+            pUploader->record(
+                [image, copyType](vk::CommandBuffer* cmd)
+                {
+                    vk::ImageBarrier finalBarrier{
+                        .pImage             = image,
+                        .currentState       = ResourceState::CopyDest,
+                        .newState           = ResourceState::ShaderResource,
+                        .queueType          = copyType,
+                        .subresourceBarrier = 0, // Apply to all mip levels
+                    };
+                    cmd->insertBarrier({ finalBarrier });
+                });
         }
     }
 
-    // Cleanup staging buffer
-    pDevice->destroy(stagingBuffer);
-    stagingBuffer = nullptr;
-
     // Set the image in the asset
     pImageAsset->setImageResource(image);
 
@@ -1409,7 +1381,7 @@ Expected<ImageData*> ImageLoader::processStandardFormat(const std::string& resol
             auto genResult = generateMipmaps(imageDataResult.value());
             if (!genResult)
             {
-                m_imageDataPool.free(imageDataResult.value());
+                releaseImageData(imageDataResult.value());
                 return genResult.transform(
                     [](bool)
                     {
@@ -41,6 +41,7 @@ private:
     auto processKtxTexture(ktxTexture* texture, bool isFlipY) -> Expected<ImageData*>;
     auto processKtxTexture2(ktxTexture2* texture, bool isFlipY) -> Expected<ImageData*>;
     auto createImageResources(ImageData* pImageData, const ImageLoadInfo& info) -> Expected<ImageAsset*>;
+    void releaseImageData(ImageData* pImageData);
 
 private:
     ResourceLoader* m_pResourceLoader = {};
@@ -1,6 +1,8 @@
 #include "imageUtil.h"
 #include "api/vulkan/device.h"
 #include "common/profiler.h"
+#include "global/globalManager.h"
+#include "threads/taskManager.h"
 #include "ktx.h"
 #include "ktxvulkan.h"
 
@@ -376,44 +378,48 @@ Expected<bool> generateMipmaps(ImageData* pImageData)
         uint32_t srcHeight   = pImageData->mipLevels[level - 1].height;
         uint32_t srcRowPitch = pImageData->mipLevels[level - 1].rowPitch;
 
-        // Simple box filter for downsampling
-        for (uint32_t y = 0; y < mipHeight; y++)
-        {
-            for (uint32_t x = 0; x < mipWidth; x++)
+        // Simple box filter for downsampling, rows are independent and filtered in parallel
+        const uint32_t rowGrain = std::max(1u, 4096u / mipWidth);
+        APH_DEFAULT_TASK_MANAGER.parallelFor(
+            0, mipHeight, rowGrain,
+            [&](size_t row)
             {
-                // Source coordinates (in the level above)
-                uint32_t srcX = x << 1;
-                uint32_t srcY = y << 1;
-
-                // Average the 2x2 block of pixels
-                for (uint32_t c = 0; c < componentCount; c++)
+                const auto y = static_cast<uint32_t>(row);
+                for (uint32_t x = 0; x < mipWidth; x++)
                 {
-                    uint32_t sum   = 0;
-                    uint32_t count = 0;
+                    // Source coordinates (in the level above)
+                    uint32_t srcX = x << 1;
+                    uint32_t srcY = y << 1;
 
-                    // Sample up to 4 pixels in a 2x2 block
-                    for (uint32_t dy = 0; dy < 2; dy++)
+                    // Average the 2x2 block of pixels
+                    for (uint32_t c = 0; c < componentCount; c++)
                     {
-                        for (uint32_t dx = 0; dx < 2; dx++)
-                        {
-                            uint32_t sx = srcX + dx;
-                            uint32_t sy = srcY + dy;
+                        uint32_t sum   = 0;
+                        uint32_t count = 0;
 
-                            // Skip if outside source image
-                            if (sx >= srcWidth || sy >= srcHeight)
-                                continue;
-
-                            // Add pixel value to sum
-                            sum += srcData[(sy * srcRowPitch) + (sx * componentCount) + c];
-                            count++;
+                        // Sample up to 4 pixels in a 2x2 block
+                        for (uint32_t dy = 0; dy < 2; dy++)
+                        {
+                            for (uint32_t dx = 0; dx < 2; dx++)
+                            {
+                                uint32_t sx = srcX + dx;
+                                uint32_t sy = srcY + dy;
+
+                                // Skip if outside source image
+                                if (sx >= srcWidth || sy >= srcHeight)
+                                    continue;
+
+                                // Add pixel value to sum
+                                sum += srcData[(sy * srcRowPitch) + (sx * componentCount) + c];
+                                count++;
+                            }
                         }
-                    }
 
-                    // Calculate average and store in destination
-                    dstData[(y * mipLevel.rowPitch) + (x * componentCount) + c] = static_cast<uint8_t>(sum / count);
+                        // Calculate average and store in destination
+                        dstData[(y * mipLevel.rowPitch) + (x * componentCount) + c] = static_cast<uint8_t>(sum / count);
+                    }
                 }
-            }
-        }
+            });
 
         // Add this mip level to the image data
         pImageData->mipLevels.push_back(std::move(mipLevel));
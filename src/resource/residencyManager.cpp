@@ -0,0 +1,228 @@
+#include "residencyManager.h"
+
+#include "common/debug.h"
+#include "common/profiler.h"
+#include "common/smallVector.h"
+
+namespace aph
+{
+ResidencyManager::ResidencyManager(const ResidencyManagerCreateInfo& createInfo)
+    : m_protectedFrameCount(createInfo.protectedFrameCount)
+{
+    for (std::size_t i = 0; i < ResidencyClassCount; i++)
+    {
+        m_classes[i].stats.budget = createInfo.budgets[i];
+    }
+}
+
+void ResidencyManager::setBudget(ResidencyClass residencyClass, ResidencyBudget budget)
+{
+    std::lock_guard<std::mutex> lock{ m_lock };
+    getState(residencyClass).stats.budget = budget;
+}
+
+auto ResidencyManager::getBudget(ResidencyClass residencyClass) const -> ResidencyBudget
+{
+    std::lock_guard<std::mutex> lock{ m_lock };
+    return getState(residencyClass).stats.budget;
+}
+
+void ResidencyManager::track(const void* pResource, ResidencyClass residencyClass, std::size_t cpuBytes,
+                             std::size_t gpuBytes, EvictFunc&& evict, bool requireTouch)
+{
+    APH_ASSERT(pResource && residencyClass < ResidencyClass::Count);
+
+    std::lock_guard<std::mutex> lock{ m_lock };
+    APH_ASSERT(!m_entries.contains(pResource), "Resource is tracked already");
+
+    ClassState& state = getState(residencyClass);
+    state.entries.push_back({ .pResource     = pResource,
+                              .cpuBytes      = cpuBytes,
+                              .gpuBytes      = gpuBytes,
+                              .lastUsedFrame = m_frame,
+                              .pinCount      = 0,
+                              .usageTracked  = !requireTouch,
+                              .evict         = std::move(evict) });
+    state.stats.cpuBytes += cpuBytes;
+    state.stats.gpuBytes += gpuBytes;
+    state.stats.residentCount++;
+    m_entries[pResource] = { residencyClass, std::prev(state.entries.end()) };
+}
+
+auto ResidencyManager::untrack(const void* pResource) -> bool
+{
+    std::lock_guard<std::mutex> lock{ m_lock };
+    auto it = m_entries.find(pResource);
+    if (it == m_entries.end())
+    {
+        return false;
+    }
+    auto [residencyClass, entry] = it->second;
+    remove(getState(residencyClass), entry);
+    return true;
+}
+
+auto ResidencyManager::isTracked(const void* pResource) const -> bool
+{
+    std::lock_guard<std::mutex> lock{ m_lock };
+    return m_entries.contains(pResource);
+}
+
+void ResidencyManager::clear()
+{
+    std::lock_guard<std::mutex> lock{ m_lock };
+    for (ClassState& state : m_classes)
+    {
+        state.entries.clear();
+        state.stats.cpuBytes      = 0;
+        state.stats.gpuBytes      = 0;
+        state.stats.residentCount = 0;
+    }
+    m_entries.clear();
+}
+
+void ResidencyManager::touch(const void* pResource)
+{
+    std::lock_guard<std::mutex> lock{ m_lock };
+    auto it = m_entries.find(pResource);
+    if (it == m_entries.end())
+    {
+        return;
+    }
+    auto [residencyClass, entry] = it->second;
+    entry->lastUsedFrame         = m_frame;
+    entry->usageTracked          = true;
+
+    EntryList& entries = getState(residencyClass).entries;
+    entries.splice(entries.end(), entries, entry);
+}
+
+auto ResidencyManager::pin(const void* pResource) -> bool
+{
+    std::lock_guard<std::mutex> lock{ m_lock };
+    auto it = m_entries.find(pResource);
+    if (it == m_entries.end())
+    {
+        return false;
+    }
+    it->second.second->pinCount++;
+    it->second.second->usageTracked = true;
+    return true;
+}
+
+void ResidencyManager::unpin(const void* pResource)
+{
+    std::lock_guard<std::mutex> lock{ m_lock };
+    auto it = m_entries.find(pResource);
+    if (it == m_entries.end())
+    {
+        return;
+    }
+    auto [residencyClass, entry] = it->second;
+    APH_ASSERT(entry->pinCount > 0, "Unbalanced unpin");
+    entry->pinCount--;
+
+    // Unpinning counts as a use, the resource was needed right up to here
+    entry->lastUsedFrame = m_frame;
+    EntryList& entries   = getState(residencyClass).entries;
+    entries.splice(entries.end(), entries, entry);
+}
+
+void ResidencyManager::nextFrame()
+{
+    std::lock_guard<std::mutex> lock{ m_lock };
+    m_frame++;
+}
+
+auto ResidencyManager::evict() -> std::size_t
+{
+    APH_PROFILER_SCOPE();
+
+    SmallVector<EvictFunc> evictions;
+    {
+        std::lock_guard<std::mutex> lock{ m_lock };
+        for (ClassState& state : m_classes)
+        {
+            auto it = state.entries.begin();
+            while (it != state.entries.end() && isOverBudget(state))
+            {
+                const ResidencyBudget& budget = state.stats.budget;
+                const bool cpuOver            = budget.cpuBytes != 0 && state.stats.cpuBytes > budget.cpuBytes;
+                const bool gpuOver            = budget.gpuBytes != 0 && state.stats.gpuBytes > budget.gpuBytes;
+
+                // Skip what is in use and what wouldn't bring the class closer to its budget
+                if (isProtected(*it) || !((cpuOver && it->cpuBytes > 0) || (gpuOver && it->gpuBytes > 0)))
+                {
+                    ++it;
+                    continue;
+                }
+
+                state.stats.evictionCount++;
+                state.stats.evictedCpuBytes += it->cpuBytes;
+                state.stats.evictedGpuBytes += it->gpuBytes;
+                evictions.push_back(std::move(it->evict));
+                remove(state, it++);
+            }
+        }
+    }
+
+    for (EvictFunc& evictFunc : evictions)
+    {
+        if (evictFunc)
+        {
+            evictFunc();
+        }
+    }
+    return evictions.size();
+}
+
+auto ResidencyManager::isOverBudget(ResidencyClass residencyClass) const -> bool
+{
+    std::lock_guard<std::mutex> lock{ m_lock };
+    return isOverBudget(getState(residencyClass));
+}
+
+auto ResidencyManager::getStats() const -> ResidencyStats
+{
+    std::lock_guard<std::mutex> lock{ m_lock };
+    ResidencyStats stats{ .frame = m_frame };
+    for (std::size_t i = 0; i < ResidencyClassCount; i++)
+    {
+        stats.classes[i] = m_classes[i].stats;
+        stats.cpuBytes += m_classes[i].stats.cpuBytes;
+        stats.gpuBytes += m_classes[i].stats.gpuBytes;
+    }
+    return stats;
+}
+
+auto ResidencyManager::getState(ResidencyClass residencyClass) -> ClassState&
+{
+    return m_classes[static_cast<std::size_t>(residencyClass)];
+}
+
+auto ResidencyManager::getState(ResidencyClass residencyClass) const -> const ClassState&
+{
+    return m_classes[static_cast<std::size_t>(residencyClass)];
+}
+
+auto ResidencyManager::isOverBudget(const ClassState& state) const -> bool
+{
+    const ResidencyBudget& budget = state.stats.budget;
+    return (budget.cpuBytes != 0 && state.stats.cpuBytes > budget.cpuBytes) ||
+           (budget.gpuBytes != 0 && state.stats.gpuBytes > budget.gpuBytes);
+}
+
+auto ResidencyManager::isProtected(const Entry& entry) const -> bool
+{
+    return entry.pinCount > 0 || !entry.usageTracked || m_frame - entry.lastUsedFrame < m_protectedFrameCount;
+}
+
+void ResidencyManager::remove(ClassState& state, EntryList::iterator it)
+{
+    state.stats.cpuBytes -= it->cpuBytes;
+    state.stats.gpuBytes -= it->gpuBytes;
+    state.stats.residentCount--;
+    m_entries.erase(it->pResource);
+    state.entries.erase(it);
+}
+} // namespace aph
@@ -0,0 +1,169 @@
+#pragma once
+
+#include "common/hash.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <string_view>
+
+namespace aph
+{
+enum class ResidencyClass : uint8_t
+{
+    Image,
+    Geometry,
+    Shader,
+    Buffer,
+    // Decoded images kept in memory by the image cache
+    ImageData,
+    Count,
+};
+
+constexpr std::size_t ResidencyClassCount = static_cast<std::size_t>(ResidencyClass::Count);
+
+// Name used in logs and for the budget keys in config.toml
+constexpr auto getResidencyClassName(ResidencyClass residencyClass) -> std::string_view
+{
+    switch (residencyClass)
+    {
+    case ResidencyClass::Image:
+        return "image";
+    case ResidencyClass::Geometry:
+        return "geometry";
+    case ResidencyClass::Shader:
+        return "shader";
+    case ResidencyClass::Buffer:
+        return "buffer";
+    case ResidencyClass::ImageData:
+        return "image_cache";
+    case ResidencyClass::Count:
+        break;
+    }
+    return "unknown";
+}
+
+// Byte budget of one residency class, 0 leaves that side unlimited
+struct ResidencyBudget
+{
+    std::size_t cpuBytes = 0;
+    std::size_t gpuBytes = 0;
+};
+
+using ResidencyBudgets = std::array<ResidencyBudget, ResidencyClassCount>;
+
+struct ResidencyManagerCreateInfo
+{
+    ResidencyBudgets budgets = {};
+    // Resources used within this many frames may still be read by the GPU and are never evicted
+    uint32_t protectedFrameCount = 3;
+};
+
+struct ResidencyClassStats
+{
+    ResidencyBudget budget;
+    std::size_t cpuBytes        = 0;
+    std::size_t gpuBytes        = 0;
+    std::size_t residentCount   = 0;
+    std::size_t evictionCount   = 0;
+    std::size_t evictedCpuBytes = 0;
+    std::size_t evictedGpuBytes = 0;
+};
+
+struct ResidencyStats
+{
+    std::array<ResidencyClassStats, ResidencyClassCount> classes = {};
+    std::size_t cpuBytes                                         = 0;
+    std::size_t gpuBytes                                         = 0;
+    uint64_t frame                                               = 0;
+
+    auto operator[](ResidencyClass residencyClass) const -> const ResidencyClassStats&
+    {
+        return classes[static_cast<std::size_t>(residencyClass)];
+    }
+};
+
+// Tracks the CPU and GPU bytes of loaded resources per class and evicts the least recently used ones of a class
+// that went over its budget. Only the bookkeeping lives here, resources are released through the callback handed
+// to track(), so the policy works the same with made up sizes.
+//
+// A resource can't be evicted while it is pinned or when it was touched within the last protectedFrameCount
+// frames. Anything the application keeps a pointer to has to be touched in the frames it is used, or pinned.
+// Resources tracked with requireTouch are kept until their use is reported that way at least once, nothing is
+// known about the use of a resource that was handed out and never touched.
+//
+// Thread safe. Eviction callbacks run without the lock held and may call back into the manager.
+class ResidencyManager
+{
+public:
+    using EvictFunc = std::function<void()>;
+
+    explicit ResidencyManager(const ResidencyManagerCreateInfo& createInfo = {});
+
+    ResidencyManager(const ResidencyManager&)                    = delete;
+    ResidencyManager(ResidencyManager&&)                         = delete;
+    auto operator=(const ResidencyManager&) -> ResidencyManager& = delete;
+    auto operator=(ResidencyManager&&) -> ResidencyManager&      = delete;
+
+    void setBudget(ResidencyClass residencyClass, ResidencyBudget budget);
+    auto getBudget(ResidencyClass residencyClass) const -> ResidencyBudget;
+
+    // The resource counts as used in the current frame
+    void track(const void* pResource, ResidencyClass residencyClass, std::size_t cpuBytes, std::size_t gpuBytes,
+               EvictFunc&& evict, bool requireTouch = false);
+    auto untrack(const void* pResource) -> bool;
+    auto isTracked(const void* pResource) const -> bool;
+    // Forgets every resource without evicting it
+    void clear();
+
+    // Marks the resource as used in the current frame, which also makes it the last one to be evicted
+    void touch(const void* pResource);
+
+    // Pins nest, false if the resource isn't tracked (anymore)
+    auto pin(const void* pResource) -> bool;
+    void unpin(const void* pResource);
+
+    void nextFrame();
+
+    // Evicts until every class is within budget or only protected resources are left, returns the eviction count
+    auto evict() -> std::size_t;
+
+    auto isOverBudget(ResidencyClass residencyClass) const -> bool;
+    auto getStats() const -> ResidencyStats;
+
+private:
+    struct Entry
+    {
+        const void* pResource;
+        std::size_t cpuBytes;
+        std::size_t gpuBytes;
+        uint64_t lastUsedFrame;
+        uint32_t pinCount;
+        bool usageTracked; // False until a resource tracked with requireTouch is touched or pinned
+        EvictFunc evict;
+    };
+
+    // Least recently used first
+    using EntryList = std::list<Entry>;
+
+    struct ClassState
+    {
+        EntryList entries;
+        ResidencyClassStats stats;
+    };
+
+    auto getState(ResidencyClass residencyClass) -> ClassState&;
+    auto getState(ResidencyClass residencyClass) const -> const ClassState&;
+    auto isOverBudget(const ClassState& state) const -> bool;
+    auto isProtected(const Entry& entry) const -> bool;
+    void remove(ClassState& state, EntryList::iterator it);
+
+    mutable std::mutex m_lock;
+    std::array<ClassState, ResidencyClassCount> m_classes;
+    HashMap<const void*, std::pair<ResidencyClass, EntryList::iterator>> m_entries;
+    uint64_t m_frame               = 0;
+    uint32_t m_protectedFrameCount = 0;
+};
+} // namespace aph
@@ -9,6 +9,12 @@
 
 namespace aph
 {
+namespace
+{
+// Loaded assets are handed to the application, they are only evicted once it reports their use
+constexpr bool RequireTouch = true;
+} // namespace
+
 auto ResourceLoader::Create(const ResourceLoaderCreateInfo& createInfo) -> Expected<ResourceLoader*>
 {
     APH_PROFILER_SCOPE();
@@ -44,6 +50,7 @@ void ResourceLoader::Destroy(ResourceLoader* pResourceLoader)
 ResourceLoader::ResourceLoader(const ResourceLoaderCreateInfo& createInfo)
     : m_createInfo(createInfo)
     , m_pDevice(createInfo.pDevice)
+    , m_residency(createInfo.residency)
     , m_shaderLoader(m_pDevice)
     , m_geometryLoader(this)
     , m_imageLoader(this)
@@ -69,13 +76,17 @@ auto ResourceLoader::initialize(const ResourceLoaderCreateInfo& createInfo) -> R
         APH_LOG_WARN("ResourceLoader initialized without a valid MaterialRegistry");
     }
 
+    APH_RETURN_IF_ERROR(m_stagingUploader.initialize(m_pDevice, m_pQueue, createInfo.stagingRingSize));
+
     return Result::Success;
 }
 
 void ResourceLoader::cleanup()
 {
     APH_PROFILER_SCOPE();
+    m_stagingUploader.cleanup();
     APH_VERIFY_RESULT(m_pDevice->waitIdle());
+    m_residency.clear();
     for (const auto& [res, unLoadCB] : m_unloadQueue)
     {
         unLoadCB();
@@ -83,7 +94,7 @@ void ResourceLoader::cleanup()
     m_unloadQueue.clear();
 }
 
-void ResourceLoader::update(const BufferUpdateInfo& info, BufferAsset* pBufferAsset) const
+void ResourceLoader::update(const BufferUpdateInfo& info, BufferAsset* pBufferAsset)
 {
     APH_PROFILER_SCOPE();
 
@@ -93,13 +104,29 @@ void ResourceLoader::update(const BufferUpdateInfo& info, BufferAsset* pBufferAs
         return;
     }
 
-    auto result = pBufferAsset->update(info);
+    auto result = m_bufferLoader.update(pBufferAsset, info);
     if (!result)
     {
         LOADER_LOG_ERR("Failed to update buffer: %s", result.toString());
     }
 }
 
+void ResourceLoader::flushUploads()
+{
+    APH_PROFILER_SCOPE();
+    m_stagingUploader.flush();
+}
+
+void ResourceLoader::updateResidency()
+{
+    APH_PROFILER_SCOPE();
+    m_residency.nextFrame();
+    if (std::size_t evictionCount = m_residency.evict(); evictionCount > 0)
+    {
+        LOADER_LOG_DEBUG("Evicted %zu resources to stay within the memory budgets", evictionCount);
+    }
+}
+
 void ResourceLoader::unLoadImpl(ShaderAsset* pShaderAsset)
 {
     APH_PROFILER_SCOPE();
@@ -133,6 +160,88 @@ void ResourceLoader::unLoadImpl(MaterialAsset* pMaterialAsset)
     m_materialLoader.unload(pMaterialAsset);
 }
 
+auto ResourceLoader::loadOwnedBuffer(const BufferLoadInfo& info) -> Expected<BufferAsset*>
+{
+    LOADER_LOG_DEBUG("Loading owned buffer: [%s]", info.debugName);
+    return loadImpl(info);
+}
+
+void ResourceLoader::unLoadOwnedBuffer(BufferAsset* pBufferAsset)
+{
+    APH_ASSERT(pBufferAsset && !m_unloadQueue.contains(pBufferAsset));
+    unLoadImpl(pBufferAsset);
+}
+
+void ResourceLoader::trackResidency(BufferAsset* pBufferAsset)
+{
+    m_residency.track(pBufferAsset, ResidencyClass::Buffer, 0, pBufferAsset->getSize(),
+                      [this, pBufferAsset]()
+                      {
+                          unLoad(pBufferAsset);
+                      },
+                      RequireTouch);
+}
+
+void ResourceLoader::trackResidency(ShaderAsset* pShaderAsset)
+{
+    // Shaders take no device memory worth counting, the SPIR-V kept for every stage is what adds up
+    std::size_t codeSize = 0;
+    for (ShaderStage stage : { ShaderStage::VS, ShaderStage::TCS, ShaderStage::TES, ShaderStage::GS, ShaderStage::FS,
+                               ShaderStage::CS, ShaderStage::TS, ShaderStage::MS })
+    {
+        if (vk::Shader* pShader = pShaderAsset->getShader(stage))
+        {
+            codeSize += pShader->getCode().size() * sizeof(uint32_t);
+        }
+    }
+    m_residency.track(pShaderAsset, ResidencyClass::Shader, codeSize, 0,
+                      [this, pShaderAsset]()
+                      {
+                          unLoad(pShaderAsset);
+                      },
+                      RequireTouch);
+}
+
+void ResourceLoader::trackResidency(GeometryAsset* pGeometryAsset)
+{
+    std::size_t bufferSize = 0;
+    for (vk::Buffer* pBuffer : { pGeometryAsset->getPositionBuffer(), pGeometryAsset->getAttributeBuffer(),
+                                 pGeometryAsset->getIndexBuffer(), pGeometryAsset->getMeshletBuffer(),
+                                 pGeometryAsset->getMeshletVertexBuffer(), pGeometryAsset->getMeshletIndexBuffer() })
+    {
+        if (pBuffer)
+        {
+            bufferSize += pBuffer->getSize();
+        }
+    }
+    m_residency.track(pGeometryAsset, ResidencyClass::Geometry, 0, bufferSize,
+                      [this, pGeometryAsset]()
+                      {
+                          unLoad(pGeometryAsset);
+                      },
+                      RequireTouch);
+}
+
+void ResourceLoader::trackResidency(ImageAsset* pImageAsset)
+{
+    std::size_t imageSize = 0;
+    if (vk::Image* pImage = pImageAsset->getImage())
+    {
+        imageSize = m_pDevice->getHandle().getImageMemoryRequirements(pImage->getHandle()).size;
+    }
+    m_residency.track(pImageAsset, ResidencyClass::Image, 0, imageSize,
+                      [this, pImageAsset]()
+                      {
+                          unLoad(pImageAsset);
+                      },
+                      RequireTouch);
+}
+
+void ResourceLoader::trackResidency(MaterialAsset* /*pMaterialAsset*/)
+{
+    // Materials only reference other assets
+}
+
 auto ResourceLoader::createRequest() -> LoadRequest
 {
     LoadRequest request{ this, m_taskManager.createTaskGroup("Load Request"), m_createInfo.async };
@@ -233,6 +342,21 @@ auto ResourceLoader::getDevice() const -> vk::Device*
     return m_pDevice;
 }
 
+auto ResourceLoader::getStagingUploader() -> StagingUploader*
+{
+    return &m_stagingUploader;
+}
+
+auto ResourceLoader::getResidencyManager() -> ResidencyManager*
+{
+    return &m_residency;
+}
+
+auto ResourceLoader::getResidencyStats() const -> ResidencyStats
+{
+    return m_residency.getStats();
+}
+
 auto LoadRequest::loadAsync() -> std::future<Result>
 {
     APH_PROFILER_SCOPE();
@@ -244,13 +368,22 @@ auto LoadRequest::loadAsync() -> std::future<Result>
         promise.set_value(Result{ Result::Success });
         return promise.get_future();
     }
+
+    // The last load task flushes the uploads, so the request completes with them
+    if (m_pCompletion->pendingCount.load(std::memory_order_relaxed) == 0)
+    {
+        m_pLoader->flushUploads();
+    }
+    m_pCompletion->flushUploads = true;
     return m_pTaskGroup->submitAsync();
 }
 
 void LoadRequest::load()
 {
     APH_PROFILER_SCOPE();
+    m_pCompletion->flushUploads = false;
     APH_VERIFY_RESULT(m_pTaskGroup->submit());
+    m_pLoader->flushUploads();
 }
 
 LoadRequest::LoadRequest(ResourceLoader* pLoader, TaskGroup* pGroup, bool async)
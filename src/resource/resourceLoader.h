@@ -12,9 +12,11 @@
 #include "image/imageLoader.h"
 #include "material/materialAsset.h"
 #include "material/materialLoader.h"
+#include "residencyManager.h"
 #include "shader/shaderAsset.h"
 #include "shader/shaderLoader.h"
 #include "threads/taskManager.h"
+#include "upload/stagingUploader.h"
 
 namespace aph
 {
@@ -23,7 +25,9 @@ struct ResourceLoaderCreateInfo
     bool async          = true;
     bool forceUncached  = false;
     vk::Device* pDevice = {};
-    MaterialRegistry* pMaterialRegistry = {};
+    MaterialRegistry* pMaterialRegistry  = {};
+    std::size_t stagingRingSize          = 64 * memory::MB;
+    ResidencyManagerCreateInfo residency = {};
 };
 
 // Type traits to map CreateInfo types to Resource types
@@ -70,9 +74,18 @@ struct LoadRequest
 private:
     friend class ResourceLoader;
     LoadRequest(ResourceLoader* pLoader, TaskGroup* pGroup, bool async);
-    ResourceLoader* m_pLoader = {};
-    TaskGroup* m_pTaskGroup   = {};
-    bool m_async              = true;
+
+    // Shared with the load tasks, the last one to finish flushes the uploads of an async request
+    struct Completion
+    {
+        std::atomic<uint32_t> pendingCount{ 0 };
+        bool flushUploads = false;
+    };
+
+    ResourceLoader* m_pLoader                 = {};
+    TaskGroup* m_pTaskGroup                   = {};
+    bool m_async                              = true;
+    std::shared_ptr<Completion> m_pCompletion = std::make_shared<Completion>();
 };
 
 class ResourceLoader
@@ -94,17 +107,33 @@ public:
 
     auto createRequest() -> LoadRequest;
 
+    // Loads the resource and waits for its GPU upload
     template <typename TLoadInfo, typename TResource = typename ResourceTraits<std::decay_t<TLoadInfo>>::ResourceType>
     auto load(TLoadInfo&& loadInfo) -> Expected<TResource*>;
 
+    // Loads the resource, its GPU upload is only queued and can be used after the next flushUploads()
+    template <typename TLoadInfo, typename TResource = typename ResourceTraits<std::decay_t<TLoadInfo>>::ResourceType>
+    auto loadDeferred(TLoadInfo&& loadInfo) -> Expected<TResource*>;
+
+    // Submits the queued uploads in one batch and waits for them
+    void flushUploads();
+
     template <typename TResource>
     void unLoad(TResource* pResource);
 
-    void update(const BufferUpdateInfo& info, BufferAsset* pBufferAsset) const;
+    void update(const BufferUpdateInfo& info, BufferAsset* pBufferAsset);
+
+    // Starts a new residency frame and unloads the least recently used resources of classes over budget.
+    // Only resources whose use was reported through the residency manager with touch() or pin() are unloaded,
+    // from then on they have to be touched in every frame they are used.
+    void updateResidency();
 
     void cleanup();
 
     auto getDevice() const -> vk::Device*;
+    auto getStagingUploader() -> StagingUploader*;
+    auto getResidencyManager() -> ResidencyManager*;
+    auto getResidencyStats() const -> ResidencyStats;
 
 private:
     auto loadImpl(const GeometryLoadInfo& info) -> Expected<GeometryAsset*>;
@@ -119,6 +148,17 @@ private:
     void unLoadImpl(ImageAsset* pImageAsset);
     void unLoadImpl(MaterialAsset* pMaterialAsset);
 
+    // Buffers backing another asset: not queued for unloading and not tracked for residency, the owning loader
+    // unloads them together with its asset
+    auto loadOwnedBuffer(const BufferLoadInfo& info) -> Expected<BufferAsset*>;
+    void unLoadOwnedBuffer(BufferAsset* pBufferAsset);
+
+    void trackResidency(BufferAsset* pBufferAsset);
+    void trackResidency(ShaderAsset* pShaderAsset);
+    void trackResidency(GeometryAsset* pGeometryAsset);
+    void trackResidency(ImageAsset* pImageAsset);
+    void trackResidency(MaterialAsset* pMaterialAsset);
+
 private:
     ResourceLoaderCreateInfo m_createInfo;
 
@@ -129,10 +169,17 @@ private:
     TaskManager& m_taskManager = APH_DEFAULT_TASK_MANAGER;
 
 private:
+    friend struct LoadRequest;
+    friend class GeometryLoader;
+
+    StagingUploader m_stagingUploader;
     std::mutex m_updateLock;
     std::mutex m_unloadQueueLock;
     HashMap<void*, std::function<void()>> m_unloadQueue;
 
+    // Constructed ahead of the loaders, the image cache accounts its decoded images here
+    ResidencyManager m_residency;
+
     ShaderLoader m_shaderLoader{ m_pDevice };
     GeometryLoader m_geometryLoader{ this };
     ImageLoader m_imageLoader{ this };
@@ -156,6 +203,7 @@ inline void ResourceLoader::unLoad(TResource* pResource)
     APH_ASSERT(m_unloadQueue.contains(pResource));
     if (pResource && m_unloadQueue.contains(pResource))
     {
+        m_residency.untrack(pResource);
         unLoadImpl(pResource);
         std::lock_guard<std::mutex> lock{ m_unloadQueueLock };
         m_unloadQueue.erase(pResource);
@@ -173,6 +221,17 @@ inline void ResourceLoader::unLoad(TResource* pResource)
 
 template <typename TLoadInfo, typename TResource>
 inline auto ResourceLoader::load(TLoadInfo&& loadInfo) -> Expected<TResource*>
+{
+    auto expected = loadDeferred(std::forward<TLoadInfo>(loadInfo));
+    if (expected)
+    {
+        flushUploads();
+    }
+    return expected;
+}
+
+template <typename TLoadInfo, typename TResource>
+inline auto ResourceLoader::loadDeferred(TLoadInfo&& loadInfo) -> Expected<TResource*>
 {
     LOADER_LOG_DEBUG("Loading begin: [%s]", loadInfo.debugName);
     auto expected = loadImpl(std::forward<TLoadInfo>(loadInfo));
@@ -180,11 +239,14 @@ inline auto ResourceLoader::load(TLoadInfo&& loadInfo) -> Expected<TResource*>
     {
         return expected;
     }
-    std::lock_guard<std::mutex> lock{ m_unloadQueueLock };
-    m_unloadQueue[expected.value()] = [this, pResource = expected.value()]()
     {
-        unLoadImpl(pResource);
-    };
+        std::lock_guard<std::mutex> lock{ m_unloadQueueLock };
+        m_unloadQueue[expected.value()] = [this, pResource = expected.value()]()
+        {
+            unLoadImpl(pResource);
+        };
+    }
+    trackResidency(expected.value());
     LOADER_LOG_DEBUG("Loading end: [%s]", loadInfo.debugName);
     return expected;
 }
@@ -192,15 +254,23 @@ inline auto ResourceLoader::load(TLoadInfo&& loadInfo) -> Expected<TResource*>
 template <typename TLoadInfo, typename TResource>
 inline auto LoadRequest::add(TLoadInfo loadInfo, TResource** ppResource) -> LoadRequest&
 {
-    auto loadFunction = [](ResourceLoader* pLoader, TLoadInfo info, TResource** ppRes) -> TaskType
+    auto loadFunction = [](ResourceLoader* pLoader, TLoadInfo info, TResource** ppRes,
+                           std::shared_ptr<Completion> pCompletion) -> TaskType
     {
-        auto expected = pLoader->load(std::move(info));
+        auto expected = pLoader->loadDeferred(std::move(info));
         VerifyExpected(expected);
         *ppRes = expected.value();
+
+        // The uploads queued by every task of the request go out in one batch
+        if (pCompletion->pendingCount.fetch_sub(1, std::memory_order_acq_rel) == 1 && pCompletion->flushUploads)
+        {
+            pLoader->flushUploads();
+        }
         co_return Result::Success;
     };
 
-    m_pTaskGroup->addTask(loadFunction(m_pLoader, loadInfo, ppResource));
+    m_pCompletion->pendingCount.fetch_add(1, std::memory_order_relaxed);
+    m_pTaskGroup->addTask(loadFunction(m_pLoader, loadInfo, ppResource, m_pCompletion));
     return *this;
 }
 
@@ -0,0 +1,204 @@
+#pragma once
+
+#include "common/debug.h"
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+
+namespace aph
+{
+// Completion tracking of the batches submitted out of a StagingRing. The uploader implements it with one
+// fence per queue submission, tests with a mock.
+class StagingRingBackend
+{
+public:
+    virtual ~StagingRingBackend() = default;
+
+    virtual auto isBatchComplete(uint64_t batchId) -> bool = 0;
+    virtual void waitBatch(uint64_t batchId)               = 0;
+};
+
+// Ring sub-allocator over one persistently mapped staging buffer.
+//
+// Allocations are bumped from the head of the ring and belong to the open batch until closeBatch() hands it
+// to the backend under the id of the submission that reads it. Space is reclaimed from the tail in
+// submission order once the backend reports a batch as complete. An allocation never wraps around the end of
+// the buffer, the remainder in front of it is skipped instead. Batch ids have to increase.
+//
+// Not thread safe.
+class StagingRing
+{
+public:
+    struct Allocation
+    {
+        std::byte* pData;
+        std::size_t offset;
+    };
+
+    StagingRing() = default;
+
+    StagingRing(StagingRingBackend* pBackend, std::byte* pData, std::size_t capacity)
+        : m_pBackend(pBackend)
+        , m_pData(pData)
+        , m_capacity(capacity)
+    {
+    }
+
+    // Waits for completed batches if needed. Fails when the request is larger than the ring or when the open
+    // batch is what fills it, then the caller has to submit the open batch and retry.
+    auto allocate(std::size_t size, std::size_t alignment) -> std::optional<Allocation>;
+
+    // Everything allocated since the previous close is released once batchId is complete
+    void closeBatch(uint64_t batchId);
+
+    // Reclaims the space of completed batches without blocking
+    void reclaim();
+    // Waits until batchId and all batches before it are complete
+    void wait(uint64_t batchId);
+    void waitIdle();
+
+    auto getCapacity() const -> std::size_t
+    {
+        return m_capacity;
+    }
+
+    // Bytes between tail and head, including the padding of skipped ring ends
+    auto getUsedSize() const -> std::size_t
+    {
+        return m_head - m_tail;
+    }
+
+    auto getOpenSize() const -> std::size_t
+    {
+        return m_head - m_openBegin;
+    }
+
+    auto getInFlightBatchCount() const -> std::size_t
+    {
+        return m_inFlight.size();
+    }
+
+    auto getCompletedBatchId() const -> uint64_t
+    {
+        return m_completedBatchId;
+    }
+
+private:
+    struct Batch
+    {
+        uint64_t id;
+        uint64_t end;
+    };
+
+    void retireFront();
+
+    StagingRingBackend* m_pBackend = {};
+    std::byte* m_pData             = {};
+    std::size_t m_capacity         = 0;
+
+    // Offsets keep counting across wrap arounds, the physical offset is the remainder by the capacity
+    uint64_t m_head      = 0;
+    uint64_t m_tail      = 0;
+    uint64_t m_openBegin = 0;
+
+    std::deque<Batch> m_inFlight;
+    uint64_t m_completedBatchId = 0;
+};
+
+inline auto StagingRing::allocate(std::size_t size, std::size_t alignment) -> std::optional<Allocation>
+{
+    APH_ASSERT(size > 0);
+    APH_ASSERT(std::has_single_bit(alignment));
+
+    if (size > m_capacity)
+    {
+        return std::nullopt;
+    }
+
+    while (true)
+    {
+        const std::size_t position = m_head % m_capacity;
+        std::size_t offset         = (position + alignment - 1) & ~(alignment - 1);
+        if (offset + size > m_capacity)
+        {
+            offset = m_capacity;
+        }
+
+        const uint64_t end = m_head + (offset - position) + size;
+        if (end - m_tail <= m_capacity)
+        {
+            m_head = end;
+            offset %= m_capacity;
+            return Allocation{ .pData = m_pData + offset, .offset = offset };
+        }
+
+        // Only the open batch is left, nothing to wait for
+        if (m_inFlight.empty())
+        {
+            return std::nullopt;
+        }
+
+        const std::size_t inFlightCount = m_inFlight.size();
+        reclaim();
+        if (m_inFlight.size() == inFlightCount)
+        {
+            m_pBackend->waitBatch(m_inFlight.front().id);
+            retireFront();
+        }
+    }
+}
+
+inline void StagingRing::closeBatch(uint64_t batchId)
+{
+    APH_ASSERT(batchId > m_completedBatchId && (m_inFlight.empty() || batchId > m_inFlight.back().id));
+    m_inFlight.push_back({ .id = batchId, .end = m_head });
+    m_openBegin = m_head;
+}
+
+inline void StagingRing::reclaim()
+{
+    while (!m_inFlight.empty() && m_pBackend->isBatchComplete(m_inFlight.front().id))
+    {
+        retireFront();
+    }
+}
+
+inline void StagingRing::wait(uint64_t batchId)
+{
+    while (!m_inFlight.empty() && m_inFlight.front().id <= batchId)
+    {
+        m_pBackend->waitBatch(m_inFlight.front().id);
+        retireFront();
+    }
+}
+
+inline void StagingRing::waitIdle()
+{
+    while (!m_inFlight.empty())
+    {
+        m_pBackend->waitBatch(m_inFlight.front().id);
+        retireFront();
+    }
+}
+
+inline void StagingRing::retireFront()
+{
+    m_tail             = m_inFlight.front().end;
+    m_completedBatchId = m_inFlight.front().id;
+    m_inFlight.pop_front();
+
+    // Restart at the beginning of the buffer once it has drained, so a full sized request fits again
+    if (m_tail == m_head)
+    {
+        m_head      = 0;
+        m_tail      = 0;
+        m_openBegin = 0;
+        for (Batch& batch : m_inFlight)
+        {
+            batch.end = 0;
+        }
+    }
+}
+} // namespace aph
@@ -0,0 +1,265 @@
+#include "stagingUploader.h"
+
+#include "common/profiler.h"
+#include "exception/errorMacros.h"
+#include "resource/forward.h"
+#include <cstring>
+
+namespace aph
+{
+StagingUploader::~StagingUploader()
+{
+    APH_ASSERT(m_pRingBuffer == nullptr, "StagingUploader destroyed without cleanup()");
+}
+
+auto StagingUploader::initialize(vk::Device* pDevice, vk::Queue* pQueue, std::size_t ringSize) -> Result
+{
+    APH_PROFILER_SCOPE();
+    APH_ASSERT(pDevice && pQueue);
+
+    m_pDevice = pDevice;
+    m_pQueue  = pQueue;
+
+    vk::BufferCreateInfo ringCI{
+        .size   = ringSize,
+        .usage  = BufferUsage::TransferSrc,
+        .domain = MemoryDomain::Upload,
+    };
+    auto ringResult = m_pDevice->create(ringCI, "staging ring");
+    if (!ringResult)
+    {
+        return { Result::RuntimeError, "Failed to create staging ring buffer: " + ringResult.error().message };
+    }
+    m_pRingBuffer = ringResult.value();
+
+    // Upload memory is host coherent, the mapping stays valid until cleanup()
+    auto* pMapped = static_cast<std::byte*>(m_pDevice->mapMemory(m_pRingBuffer));
+    if (!pMapped)
+    {
+        m_pDevice->destroy(m_pRingBuffer);
+        m_pRingBuffer = nullptr;
+        return { Result::RuntimeError, "Failed to map staging ring buffer" };
+    }
+
+    m_ring = StagingRing{ this, pMapped, ringSize };
+    return Result::Success;
+}
+
+void StagingUploader::cleanup()
+{
+    APH_PROFILER_SCOPE();
+    if (!m_pRingBuffer)
+    {
+        return;
+    }
+
+    flush();
+
+    std::lock_guard<std::mutex> lock{ m_lock };
+    m_pDevice->unMapMemory(m_pRingBuffer);
+    m_pDevice->destroy(m_pRingBuffer);
+    m_pRingBuffer = nullptr;
+    m_ring        = {};
+}
+
+auto StagingUploader::upload(const void* pData, std::size_t size, std::size_t alignment, UploadRecordFunc&& record)
+    -> Result
+{
+    APH_PROFILER_SCOPE();
+    APH_ASSERT(pData && size > 0);
+
+    std::lock_guard<std::mutex> lock{ m_lock };
+    APH_ASSERT(m_pRingBuffer, "StagingUploader is not initialized");
+
+    StagingRegion region{};
+    if (size <= m_ring.getCapacity())
+    {
+        auto allocation = m_ring.allocate(size, alignment);
+        if (!allocation)
+        {
+            // The queued uploads fill the ring, send them off to make room
+            submitLocked();
+            allocation = m_ring.allocate(size, alignment);
+        }
+        APH_ASSERT(allocation);
+
+        std::memcpy(allocation->pData, pData, size);
+        region = { .pBuffer = m_pRingBuffer, .offset = allocation->offset };
+    }
+    else
+    {
+        auto bufferResult = createDedicatedBuffer(size);
+        if (!bufferResult)
+        {
+            return { bufferResult.error().code, bufferResult.error().message };
+        }
+
+        vk::Buffer* pBuffer = bufferResult.value();
+        void* pMapped       = m_pDevice->mapMemory(pBuffer);
+        if (!pMapped)
+        {
+            m_pDevice->destroy(pBuffer);
+            return { Result::RuntimeError, "Failed to map dedicated staging buffer" };
+        }
+        std::memcpy(pMapped, pData, size);
+        m_pDevice->unMapMemory(pBuffer);
+
+        m_pendingDedicatedBuffers.push_back(pBuffer);
+        region = { .pBuffer = pBuffer, .offset = 0 };
+    }
+
+    m_pendingRecords.push_back([record = std::move(record), region](vk::CommandBuffer* pCmd)
+                               {
+                                   record(pCmd, region);
+                               });
+    m_stats.uploadCount++;
+    m_stats.uploadBytes += size;
+    return Result::Success;
+}
+
+auto StagingUploader::uploadBuffer(vk::Buffer* pBuffer, Range range, const void* pData) -> Result
+{
+    APH_ASSERT(pBuffer);
+    return upload(pData, range.size, 16,
+                  [pBuffer, range](vk::CommandBuffer* pCmd, const StagingRegion& region)
+                  {
+                      pCmd->copy(region.pBuffer, pBuffer, range, region.offset);
+                  });
+}
+
+void StagingUploader::record(RecordFunc&& record)
+{
+    std::lock_guard<std::mutex> lock{ m_lock };
+    m_pendingRecords.push_back(std::move(record));
+}
+
+auto StagingUploader::submit() -> uint64_t
+{
+    APH_PROFILER_SCOPE();
+    std::lock_guard<std::mutex> lock{ m_lock };
+    return submitLocked();
+}
+
+void StagingUploader::wait(uint64_t batchId)
+{
+    APH_PROFILER_SCOPE();
+    std::lock_guard<std::mutex> lock{ m_lock };
+    m_ring.wait(batchId);
+    releaseCompletedBatches();
+}
+
+void StagingUploader::flush()
+{
+    APH_PROFILER_SCOPE();
+    std::lock_guard<std::mutex> lock{ m_lock };
+    submitLocked();
+    m_ring.waitIdle();
+    releaseCompletedBatches();
+}
+
+auto StagingUploader::getStats() const -> Stats
+{
+    std::lock_guard<std::mutex> lock{ m_lock };
+    return m_stats;
+}
+
+auto StagingUploader::submitLocked() -> uint64_t
+{
+    APH_PROFILER_SCOPE();
+
+    // Recycle what the GPU is done with while we are here
+    m_ring.reclaim();
+    releaseCompletedBatches();
+
+    if (m_pendingRecords.empty())
+    {
+        APH_ASSERT(m_pendingDedicatedBuffers.empty());
+        return 0;
+    }
+
+    vk::CommandBuffer* pCmd = m_pDevice->getCommandBufferAllocator()->acquire(m_pQueue->getType());
+    APH_ASSERT(pCmd, "Failed to acquire command buffer");
+
+    APH_VERIFY_RESULT(pCmd->begin());
+    for (const RecordFunc& record : m_pendingRecords)
+    {
+        record(pCmd);
+    }
+    APH_VERIFY_RESULT(pCmd->end());
+
+    vk::Fence* pFence = m_pDevice->acquireFence(false);
+    APH_ASSERT(pFence, "Failed to acquire fence");
+    APH_VERIFY_RESULT(m_pQueue->submit({ vk::QueueSubmitInfo{ .commandBuffers = { pCmd } } }, pFence));
+
+    const uint64_t batchId        = m_nextBatchId++;
+    const std::size_t stagedBytes = m_ring.getOpenSize();
+    m_ring.closeBatch(batchId);
+    m_inFlight.push_back(
+        { .id = batchId, .pFence = pFence, .pCmd = pCmd, .dedicatedBuffers = std::move(m_pendingDedicatedBuffers) });
+
+    LOADER_LOG_DEBUG("Submitted staging batch %llu: %zu commands, %zu bytes staged",
+                     static_cast<unsigned long long>(batchId), m_pendingRecords.size(), stagedBytes);
+    m_pendingRecords.clear();
+    m_pendingDedicatedBuffers.clear();
+    m_stats.submitCount++;
+    return batchId;
+}
+
+void StagingUploader::releaseCompletedBatches()
+{
+    while (!m_inFlight.empty() && m_inFlight.front().id <= m_ring.getCompletedBatchId())
+    {
+        Batch& batch = m_inFlight.front();
+        m_pDevice->getCommandBufferAllocator()->release(batch.pCmd);
+        APH_VERIFY_RESULT(m_pDevice->releaseFence(batch.pFence));
+        for (vk::Buffer* pBuffer : batch.dedicatedBuffers)
+        {
+            m_pDevice->destroy(pBuffer);
+        }
+        m_inFlight.pop_front();
+    }
+}
+
+auto StagingUploader::isBatchComplete(uint64_t batchId) -> bool
+{
+    Batch* pBatch = findBatch(batchId);
+    return pBatch == nullptr || pBatch->pFence->wait(0);
+}
+
+void StagingUploader::waitBatch(uint64_t batchId)
+{
+    if (Batch* pBatch = findBatch(batchId))
+    {
+        pBatch->pFence->wait();
+    }
+}
+
+auto StagingUploader::findBatch(uint64_t batchId) -> Batch*
+{
+    // Ids are handed out in order, the batch asked for is almost always the oldest one
+    for (Batch& batch : m_inFlight)
+    {
+        if (batch.id == batchId)
+        {
+            return &batch;
+        }
+    }
+    return nullptr;
+}
+
+auto StagingUploader::createDedicatedBuffer(std::size_t size) -> Expected<vk::Buffer*>
+{
+    vk::BufferCreateInfo bufferCI{
+        .size   = size,
+        .usage  = BufferUsage::TransferSrc,
+        .domain = MemoryDomain::Upload,
+    };
+    auto result = m_pDevice->create(bufferCI, "dedicated staging buffer");
+    if (!result)
+    {
+        return { Result::RuntimeError, "Failed to create dedicated staging buffer: " + result.error().message };
+    }
+    m_stats.dedicatedBufferCount++;
+    return result.value();
+}
+} // namespace aph
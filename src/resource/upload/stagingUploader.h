@@ -0,0 +1,94 @@
+#pragma once
+
+#include "allocator/allocator.h"
+#include "api/vulkan/device.h"
+#include "common/result.h"
+#include "stagingRing.h"
+#include <deque>
+#include <functional>
+#include <mutex>
+
+namespace aph
+{
+struct StagingRegion
+{
+    vk::Buffer* pBuffer;
+    std::size_t offset;
+};
+
+// Uploads data to device local resources through one persistently mapped staging ring.
+//
+// Uploads are copied into the ring right away and their copy commands are queued, submit() records everything
+// queued so far into a single command buffer and submits it with a fence. The ring space of a submission is
+// reused once its fence has signaled. Uploads larger than the ring get a dedicated staging buffer that is
+// destroyed with its submission. All functions are thread safe.
+class StagingUploader final : private StagingRingBackend
+{
+public:
+    using RecordFunc       = std::function<void(vk::CommandBuffer* pCmd)>;
+    using UploadRecordFunc = std::function<void(vk::CommandBuffer* pCmd, const StagingRegion& region)>;
+
+    struct Stats
+    {
+        std::size_t uploadCount;
+        std::size_t uploadBytes;
+        std::size_t submitCount;
+        std::size_t dedicatedBufferCount;
+    };
+
+    StagingUploader() = default;
+    ~StagingUploader();
+
+    StagingUploader(const StagingUploader&)                    = delete;
+    StagingUploader(StagingUploader&&)                         = delete;
+    auto operator=(const StagingUploader&) -> StagingUploader& = delete;
+    auto operator=(StagingUploader&&) -> StagingUploader&      = delete;
+
+    auto initialize(vk::Device* pDevice, vk::Queue* pQueue, std::size_t ringSize = 64 * memory::MB) -> Result;
+    void cleanup();
+
+    // Copies the data into staging memory and queues record() for the next submission
+    auto upload(const void* pData, std::size_t size, std::size_t alignment, UploadRecordFunc&& record) -> Result;
+    auto uploadBuffer(vk::Buffer* pBuffer, Range range, const void* pData) -> Result;
+
+    // Queues commands that have to run in order with the uploads, e.g. layout transitions
+    void record(RecordFunc&& record);
+
+    // Submits the queued uploads, returns the id of the batch or 0 when nothing was queued
+    auto submit() -> uint64_t;
+    void wait(uint64_t batchId);
+    // Submits and waits for everything queued so far
+    void flush();
+
+    auto getStats() const -> Stats;
+
+private:
+    struct Batch
+    {
+        uint64_t id;
+        vk::Fence* pFence;
+        vk::CommandBuffer* pCmd;
+        SmallVector<vk::Buffer*> dedicatedBuffers;
+    };
+
+    auto isBatchComplete(uint64_t batchId) -> bool override;
+    void waitBatch(uint64_t batchId) override;
+
+    auto findBatch(uint64_t batchId) -> Batch*;
+    auto createDedicatedBuffer(std::size_t size) -> Expected<vk::Buffer*>;
+    auto submitLocked() -> uint64_t;
+    void releaseCompletedBatches();
+
+    vk::Device* m_pDevice     = {};
+    vk::Queue* m_pQueue       = {};
+    vk::Buffer* m_pRingBuffer = {};
+
+    mutable std::mutex m_lock;
+    StagingRing m_ring;
+    SmallVector<RecordFunc> m_pendingRecords;
+    SmallVector<vk::Buffer*> m_pendingDedicatedBuffers;
+    std::deque<Batch> m_inFlight;
+    uint64_t m_nextBatchId = 1;
+    Stats m_stats          = {};
+};
+} // namespace aph
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "workStealingDeque.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <type_traits>
+
+namespace aph
+{
+// Bounded lock-free multi-producer multi-consumer queue (Vyukov). Each slot carries a sequence number
+// that tells producers and consumers whether it is free for the current lap, so push and pop are a
+// single CAS on their own index and never touch the other side's cache line.
+template <typename T>
+    requires std::is_nothrow_move_constructible_v<T> && std::is_default_constructible_v<T>
+class MPMCQueue
+{
+public:
+    explicit MPMCQueue(std::size_t capacity = 4096)
+    {
+        std::size_t slotCount = 2;
+        while (slotCount < capacity)
+        {
+            slotCount <<= 1;
+        }
+        m_mask  = slotCount - 1;
+        m_slots = std::make_unique<Slot[]>(slotCount);
+        for (std::size_t index = 0; index < slotCount; ++index)
+        {
+            m_slots[index].sequence.store(index, std::memory_order_relaxed);
+        }
+    }
+
+    MPMCQueue(const MPMCQueue&)            = delete;
+    MPMCQueue& operator=(const MPMCQueue&) = delete;
+
+    // Returns false when the queue is full
+    [[nodiscard]] auto tryPush(T&& value) -> bool
+    {
+        std::size_t position = m_pushIndex.load(std::memory_order_relaxed);
+        Slot* pSlot          = nullptr;
+        while (true)
+        {
+            pSlot                    = &m_slots[position & m_mask];
+            const std::size_t seq    = pSlot->sequence.load(std::memory_order_acquire);
+            const std::intptr_t diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(position);
+            if (diff == 0)
+            {
+                if (m_pushIndex.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false;
+            }
+            else
+            {
+                position = m_pushIndex.load(std::memory_order_relaxed);
+            }
+        }
+
+        pSlot->value = std::move(value);
+        pSlot->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    [[nodiscard]] auto tryPop() -> std::optional<T>
+    {
+        std::size_t position = m_popIndex.load(std::memory_order_relaxed);
+        Slot* pSlot          = nullptr;
+        while (true)
+        {
+            pSlot                    = &m_slots[position & m_mask];
+            const std::size_t seq    = pSlot->sequence.load(std::memory_order_acquire);
+            const std::intptr_t diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(position + 1);
+            if (diff == 0)
+            {
+                if (m_popIndex.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                return std::nullopt;
+            }
+            else
+            {
+                position = m_popIndex.load(std::memory_order_relaxed);
+            }
+        }
+
+        std::optional<T> value{ std::move(pSlot->value) };
+        pSlot->sequence.store(position + m_mask + 1, std::memory_order_release);
+        return value;
+    }
+
+    // Approximate when called concurrently with push/pop
+    [[nodiscard]] auto empty() const -> bool
+    {
+        return m_pushIndex.load(std::memory_order_relaxed) <= m_popIndex.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] auto capacity() const -> std::size_t
+    {
+        return m_mask + 1;
+    }
+
+private:
+    struct Slot
+    {
+        std::atomic<std::size_t> sequence{ 0 };
+        T value{};
+    };
+
+    alignas(threads::CacheLineSize) std::atomic<std::size_t> m_pushIndex{ 0 };
+    alignas(threads::CacheLineSize) std::atomic<std::size_t> m_popIndex{ 0 };
+    alignas(threads::CacheLineSize) std::size_t m_mask = 0;
+    std::unique_ptr<Slot[]> m_slots;
+};
+} // namespace aph
@@ -0,0 +1,154 @@
+#pragma once
+
+#include "workStealingDeque.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+
+namespace aph
+{
+// Bounded lock-free multi-producer single-consumer queue. Producers claim slots like in MPMCQueue, the single
+// consumer owns the pop index and takes values out without a CAS. Values live in raw slot storage, so T does not
+// have to be default constructible.
+template <typename T>
+    requires std::is_nothrow_move_constructible_v<T>
+class MPSCQueue
+{
+public:
+    explicit MPSCQueue(std::size_t capacity = 1024)
+    {
+        std::size_t slotCount = 2;
+        while (slotCount < capacity)
+        {
+            slotCount <<= 1;
+        }
+        m_mask  = slotCount - 1;
+        m_slots = std::make_unique<Slot[]>(slotCount);
+        for (std::size_t index = 0; index < slotCount; ++index)
+        {
+            m_slots[index].sequence.store(index, std::memory_order_relaxed);
+        }
+    }
+
+    ~MPSCQueue()
+    {
+        consume(
+            [](T&&)
+            {
+            });
+    }
+
+    MPSCQueue(const MPSCQueue&)            = delete;
+    MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+    // Any thread. Returns false when the queue is full, value is left untouched then.
+    [[nodiscard]] auto tryPush(T&& value) -> bool
+    {
+        std::size_t position = m_pushIndex.load(std::memory_order_relaxed);
+        Slot* pSlot          = nullptr;
+        while (true)
+        {
+            pSlot                    = &m_slots[position & m_mask];
+            const std::size_t seq    = pSlot->sequence.load(std::memory_order_acquire);
+            const std::intptr_t diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(position);
+            if (diff == 0)
+            {
+                if (m_pushIndex.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false;
+            }
+            else
+            {
+                position = m_pushIndex.load(std::memory_order_relaxed);
+            }
+        }
+
+        ::new (pSlot->storage) T(std::move(value));
+        pSlot->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer only. Calls func(T&&) for the values in push order and stops at the first slot that is not
+    // published yet, a producer may still be writing it. Returns how many values were consumed.
+    template <typename Func>
+    auto consume(Func&& func) -> std::size_t
+    {
+        std::size_t count = 0;
+        while (tryConsume(func))
+        {
+            ++count;
+        }
+        return count;
+    }
+
+    // Consumer only. Like consume(), but also waits for the slots that were claimed before the call to be
+    // published, so every push that started before it is seen.
+    template <typename Func>
+    auto consumeAll(Func&& func) -> std::size_t
+    {
+        const std::size_t end = m_pushIndex.load(std::memory_order_acquire);
+        std::size_t count     = 0;
+        while (m_popIndex < end)
+        {
+            if (tryConsume(func))
+            {
+                ++count;
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+        return count + consume(func);
+    }
+
+    // Consumer only, approximate when called concurrently with push
+    [[nodiscard]] auto empty() const -> bool
+    {
+        return m_pushIndex.load(std::memory_order_relaxed) <= m_popIndex;
+    }
+
+    [[nodiscard]] auto capacity() const -> std::size_t
+    {
+        return m_mask + 1;
+    }
+
+private:
+    struct Slot
+    {
+        std::atomic<std::size_t> sequence{ 0 };
+        alignas(T) std::byte storage[sizeof(T)];
+    };
+
+    template <typename Func>
+    auto tryConsume(Func& func) -> bool
+    {
+        Slot* pSlot = &m_slots[m_popIndex & m_mask];
+        if (pSlot->sequence.load(std::memory_order_acquire) != m_popIndex + 1)
+        {
+            return false;
+        }
+
+        T* pValue = std::launder(reinterpret_cast<T*>(pSlot->storage));
+        func(std::move(*pValue));
+        pValue->~T();
+        pSlot->sequence.store(m_popIndex + m_mask + 1, std::memory_order_release);
+        ++m_popIndex;
+        return true;
+    }
+
+    alignas(threads::CacheLineSize) std::atomic<std::size_t> m_pushIndex{ 0 };
+    alignas(threads::CacheLineSize) std::size_t m_popIndex = 0;
+    std::size_t m_mask                                     = 0;
+    std::unique_ptr<Slot[]> m_slots;
+};
+} // namespace aph
@@ -4,18 +4,25 @@
 #include "common/common.h"
 #include "common/hash.h"
 #include "common/smallVector.h"
+#include "threadPool.h"
 
 namespace aph
 {
 using TaskType = coro::task<Result>;
 class TaskManager;
 
+// A node of the job graph. Tasks added to a group start once every group it waits for has completed, and
+// the group completes when all of its tasks have returned. Dependencies are resolved with atomic counters
+// by the worker finishing the last producer task, nothing blocks a worker thread while waiting.
 class TaskGroup
 {
 public:
     void addTask(TaskType task);
     std::future<Result> submitAsync();
     Result submit();
+
+    // Delays the next submission of this group until the next submission of pGroup has completed.
+    // Must be called before either group is submitted.
     void waitFor(TaskGroup* pGroup);
 
 private:
@@ -31,8 +38,19 @@ private:
     SmallVector<TaskType> m_tasks;
     TaskManager* m_pTaskManager = {};
     std::string m_name;
-    HashSet<TaskGroup*> m_pendingGroups;
-    coro::latch m_waitLatch{ 0 };
+
+    // Groups waiting for the in-flight or next submission of this one
+    std::mutex m_dependentLock;
+    SmallVector<TaskGroup*> m_dependents;
+
+    // Producers that haven't completed yet, plus one until the group itself is submitted
+    std::atomic<uint32_t> m_unresolvedCount{ 1 };
+
+    // In-flight submission
+    std::vector<TaskType> m_runningTasks;
+    std::vector<Result> m_results;
+    std::atomic<uint32_t> m_remainingTasks{ 0 };
+    std::promise<Result> m_promise;
 };
 
 class TaskManager
@@ -46,8 +64,9 @@ public:
     template <typename TStr>
     TaskGroup* createTaskGroup(TStr&& name = {})
     {
-        auto* pGroup           = m_taskGroupPools.allocate(this, APH_FWD(name));
-        m_pendingTasks[pGroup] = {};
+        auto* pGroup = m_taskGroupPools.allocate(this, APH_FWD(name));
+        std::lock_guard<std::mutex> lock{ m_groupLock };
+        m_taskGroups.insert(pGroup);
         return pGroup;
     }
 
@@ -55,9 +74,200 @@ public:
     std::future<Result> submit(TaskGroup* pGroup);
     void setDependencies(TaskGroup* pProducer, TaskGroup* pConsumer);
 
+    // Waits for a submission. On a worker thread, queued tasks are run in the meantime so that nested
+    // submissions can't starve the pool.
+    Result wait(std::future<Result>& future);
+
+    // Calls func(index) for every index in [begin, end), or func(chunkBegin, chunkEnd) once per chunk if it
+    // takes two indices. The calling thread takes part and the call returns once every index is processed.
+    // Chunks are handed out guided: large while plenty of work remains, shrinking towards grain at the end
+    // so that uneven iterations still balance across workers. Exceptions thrown by func are rethrown here.
+    template <typename Func>
+    void parallelFor(std::size_t begin, std::size_t end, std::size_t grain, Func&& func);
+
+    // Maps every chunk of [begin, end) to a partial value with map(chunkBegin, chunkEnd) and folds the
+    // partials with combine(T, T). Chunk boundaries only depend on the range and grain, and partials are
+    // combined in index order, so the result is deterministic even for floating point.
+    template <typename T, typename MapFunc, typename CombineFunc>
+    auto parallelReduce(std::size_t begin, std::size_t end, std::size_t grain, T identity, MapFunc&& map,
+                        CombineFunc&& combine) -> T;
+
 private:
-    HashMap<TaskGroup*, SmallVector<TaskType>> m_pendingTasks;
-    coro::thread_pool m_threadPool{};
+    struct ParallelForState
+    {
+        std::atomic<std::size_t> next{ 0 };
+        std::atomic<std::size_t> remaining{ 0 };
+        std::size_t end     = 0;
+        std::size_t grain   = 1;
+        std::size_t divisor = 1;
+        std::atomic_flag failed;
+        std::exception_ptr exception;
+    };
+
+    // Claims the next chunk, returns false once the range is exhausted
+    static auto claimChunk(ParallelForState& state, std::size_t& chunkBegin, std::size_t& chunkEnd) -> bool;
+
+    template <typename ChunkFunc>
+    void runChunks(std::size_t begin, std::size_t end, std::size_t grain, const ChunkFunc& chunkFunc);
+
+    void launch(TaskGroup* pGroup);
+    void completeTask(TaskGroup* pGroup, uint32_t taskIndex, Result result);
+    void completeGroup(TaskGroup* pGroup);
+
+    ThreadPool<> m_threadPool;
+    std::mutex m_groupLock;
+    HashSet<TaskGroup*> m_taskGroups;
     ThreadSafeObjectPool<TaskGroup> m_taskGroupPools;
 };
+
+template <typename Func>
+inline void TaskManager::parallelFor(std::size_t begin, std::size_t end, std::size_t grain, Func&& func)
+{
+    APH_PROFILER_SCOPE();
+
+    auto chunkFunc = [&func](std::size_t chunkBegin, std::size_t chunkEnd)
+    {
+        if constexpr (std::is_invocable_v<Func&, std::size_t, std::size_t>)
+        {
+            func(chunkBegin, chunkEnd);
+        }
+        else
+        {
+            for (std::size_t index = chunkBegin; index < chunkEnd; ++index)
+            {
+                func(index);
+            }
+        }
+    };
+
+    grain = std::max<std::size_t>(grain, 1);
+    if (end <= begin)
+    {
+        return;
+    }
+    if (end - begin <= grain || m_threadPool.size() == 0)
+    {
+        chunkFunc(begin, end);
+        return;
+    }
+    runChunks(begin, end, grain, chunkFunc);
+}
+
+template <typename T, typename MapFunc, typename CombineFunc>
+inline auto TaskManager::parallelReduce(std::size_t begin, std::size_t end, std::size_t grain, T identity,
+                                        MapFunc&& map, CombineFunc&& combine) -> T
+{
+    APH_PROFILER_SCOPE();
+
+    grain = std::max<std::size_t>(grain, 1);
+    if (end <= begin)
+    {
+        return identity;
+    }
+
+    const std::size_t chunkCount = (end - begin + grain - 1) / grain;
+    std::vector<T> partials(chunkCount, identity);
+    parallelFor(0, chunkCount, 1,
+                [&](std::size_t chunkIndex)
+                {
+                    const std::size_t chunkBegin = begin + (chunkIndex * grain);
+                    partials[chunkIndex]         = map(chunkBegin, std::min(end, chunkBegin + grain));
+                });
+
+    T result = std::move(identity);
+    for (auto& partial : partials)
+    {
+        result = combine(std::move(result), std::move(partial));
+    }
+    return result;
+}
+
+inline auto TaskManager::claimChunk(ParallelForState& state, std::size_t& chunkBegin, std::size_t& chunkEnd) -> bool
+{
+    std::size_t current = state.next.load(std::memory_order_relaxed);
+    while (current < state.end)
+    {
+        const std::size_t remaining = state.end - current;
+        const std::size_t chunkSize = std::min(remaining, std::max(state.grain, remaining / state.divisor));
+        if (state.next.compare_exchange_weak(current, current + chunkSize, std::memory_order_relaxed))
+        {
+            chunkBegin = current;
+            chunkEnd   = current + chunkSize;
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename ChunkFunc>
+inline void TaskManager::runChunks(std::size_t begin, std::size_t end, std::size_t grain, const ChunkFunc& chunkFunc)
+{
+    // One helper per worker that can get a grain-sized chunk, the calling thread covers the rest
+    const std::size_t chunkCount  = (end - begin + grain - 1) / grain;
+    const std::size_t helperCount = std::min(m_threadPool.size(), chunkCount - 1);
+
+    auto state = std::make_shared<ParallelForState>();
+    state->next.store(begin, std::memory_order_relaxed);
+    state->remaining.store(end - begin, std::memory_order_relaxed);
+    state->end     = end;
+    state->grain   = grain;
+    state->divisor = 2 * (helperCount + 1);
+
+    // Helpers that only start once the range is exhausted never claim a chunk, so they don't touch chunkFunc
+    // after the caller returned, the shared state keeps everything else alive
+    auto work = [state, pChunkFunc = &chunkFunc]()
+    {
+        std::size_t chunkBegin = 0;
+        std::size_t chunkEnd   = 0;
+        while (claimChunk(*state, chunkBegin, chunkEnd))
+        {
+            try
+            {
+                (*pChunkFunc)(chunkBegin, chunkEnd);
+            }
+            catch (...)
+            {
+                if (!state->failed.test_and_set(std::memory_order_relaxed))
+                {
+                    state->exception = std::current_exception();
+                }
+            }
+
+            const std::size_t chunkSize = chunkEnd - chunkBegin;
+            if (state->remaining.fetch_sub(chunkSize, std::memory_order_acq_rel) == chunkSize)
+            {
+                state->remaining.notify_all();
+            }
+        }
+    };
+
+    for (std::size_t index = 0; index < helperCount; ++index)
+    {
+        m_threadPool.enqueueDetach(work);
+    }
+    work();
+
+    // Every chunk is claimed by now, wait for the ones still running elsewhere
+    std::size_t remaining = state->remaining.load(std::memory_order_acquire);
+    while (remaining != 0)
+    {
+        if (m_threadPool.isWorkerThread())
+        {
+            if (!m_threadPool.runPendingTask())
+            {
+                std::this_thread::yield();
+            }
+        }
+        else
+        {
+            state->remaining.wait(remaining, std::memory_order_acquire);
+        }
+        remaining = state->remaining.load(std::memory_order_acquire);
+    }
+
+    if (state->exception)
+    {
+        std::rethrow_exception(state->exception);
+    }
+}
 } // namespace aph
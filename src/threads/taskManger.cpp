@@ -10,6 +10,37 @@
 namespace aph
 {
 
+namespace
+{
+// Fire-and-forget coroutine that drives a task on the thread that starts it. A task that completes
+// synchronously runs inline on the worker; one that suspends continues on whichever thread resumes it.
+struct DetachedTask
+{
+    struct promise_type
+    {
+        auto get_return_object() noexcept -> DetachedTask
+        {
+            return {};
+        }
+        auto initial_suspend() noexcept -> std::suspend_never
+        {
+            return {};
+        }
+        auto final_suspend() noexcept -> std::suspend_never
+        {
+            return {};
+        }
+        void return_void() noexcept
+        {
+        }
+        void unhandled_exception() noexcept
+        {
+            std::terminate();
+        }
+    };
+};
+} // namespace
+
 void TaskGroup::addTask(coro::task<Result> task)
 {
     m_tasks.push_back(std::move(task));
@@ -22,25 +53,19 @@ std::future<Result> TaskGroup::submitAsync()
 
 Result TaskGroup::submit()
 {
-    return submitAsync().get();
+    auto future = submitAsync();
+    return m_pTaskManager->wait(future);
 }
 
 void TaskGroup::waitFor(TaskGroup* pGroup)
 {
-    m_pTaskManager->setDependencies(this, pGroup);
+    m_pTaskManager->setDependencies(pGroup, this);
 }
 
 TaskManager::TaskManager(uint32_t threadCount)
-    : m_threadPool(coro::thread_pool::options{ .thread_count            = threadCount,
-                                               .on_thread_start_functor = [](std::size_t worker_idx) -> void
-                                               {
-                                                   CM_LOG_DEBUG("thread pool worker %u is starting up.", worker_idx);
-                                               },
-                                               .on_thread_stop_functor = [](std::size_t worker_idx) -> void
-                                               {
-                                                   CM_LOG_DEBUG("thread pool worker %u is shutting down.", worker_idx);
-                                               } })
+    : m_threadPool(threadCount)
 {
+    CM_LOG_DEBUG("task manager started with %zu workers.", m_threadPool.size());
 }
 
 void TaskManager::addTask(TaskGroup* pGroup, coro::task<Result> task)
@@ -51,63 +76,129 @@ void TaskManager::addTask(TaskGroup* pGroup, coro::task<Result> task)
 std::future<Result> TaskManager::submit(TaskGroup* pGroup)
 {
     APH_PROFILER_SCOPE();
-    auto taskDoneLatch = std::make_shared<coro::latch>(pGroup->m_tasks.size());
-
-    SmallVector<TaskType> pendingTasks;
 
     for (auto&& task : pGroup->m_tasks)
     {
-        auto taskWrapper = [](coro::thread_pool& tp, coro::task<Result> task, const coro::latch& waitLatch,
-                              std::shared_ptr<coro::latch> signalLatch) -> TaskType
-        {
-            co_await tp.schedule();
-            co_await waitLatch;
-            auto result = co_await tp.schedule(std::move(task));
-            signalLatch->count_down();
-            co_return result;
-        };
-
-        pendingTasks.emplace_back(taskWrapper(m_threadPool, std::move(task), pGroup->m_waitLatch, taskDoneLatch));
+        pGroup->m_runningTasks.push_back(std::move(task));
     }
+    pGroup->m_tasks.clear();
+    pGroup->m_results.assign(pGroup->m_runningTasks.size(), Result::Success);
+    pGroup->m_promise = {};
+    auto future       = pGroup->m_promise.get_future();
 
-    for (auto* pendingGroup : pGroup->m_pendingGroups)
+    // drop the submission reference, the last producer to complete launches the group if it isn't ready yet
+    if (pGroup->m_unresolvedCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
     {
-        auto signalTask = [](coro::thread_pool& tp, TaskGroup* pPendingGroup,
-                             std::shared_ptr<coro::latch> waitLatch) -> TaskType
-        {
-            co_await tp.schedule();
-            co_await *waitLatch;
-            pPendingGroup->m_waitLatch.count_down();
-            co_return Result::Success;
-        };
+        launch(pGroup);
+    }
+    return future;
+}
+
+void TaskManager::launch(TaskGroup* pGroup)
+{
+    APH_PROFILER_SCOPE();
 
-        pendingTasks.emplace_back(signalTask(m_threadPool, pendingGroup, taskDoneLatch));
+    // re-arm the submission reference, dependencies declared from now on apply to the next submission
+    pGroup->m_unresolvedCount.fetch_add(1, std::memory_order_relaxed);
+
+    const auto taskCount = static_cast<uint32_t>(pGroup->m_runningTasks.size());
+    if (taskCount == 0)
+    {
+        completeGroup(pGroup);
+        return;
     }
 
-    auto promise    = std::make_shared<std::promise<Result>>();
-    auto submitTask = [](SmallVector<TaskType> tasks, std::shared_ptr<std::promise<Result>> promise) -> coro::task<void>
+    // tasks made ready by a worker land on its own deque: it picks the first one up right away while idle
+    // workers steal the rest
+    pGroup->m_remainingTasks.store(taskCount, std::memory_order_release);
+    for (uint32_t taskIndex = 0; taskIndex < taskCount; ++taskIndex)
     {
-        ResultGroup resultGroup{};
-        auto results = coro::sync_wait(coro::when_all(std::move(tasks)));
-        for (const auto& result : results)
-        {
-            resultGroup += std::move(result.return_value());
-        }
-        promise->set_value(resultGroup);
-        co_return;
-    };
+        m_threadPool.enqueueDetach(
+            [this, pGroup, taskIndex]()
+            {
+                [](TaskManager* pManager, TaskGroup* pGroup, uint32_t taskIndex) -> DetachedTask
+                {
+                    Result result = Result::Success;
+                    try
+                    {
+                        result = co_await std::move(pGroup->m_runningTasks[taskIndex]);
+                    }
+                    catch (const std::exception& e)
+                    {
+                        result = { Result::RuntimeError, e.what() };
+                    }
+                    catch (...)
+                    {
+                        result = { Result::RuntimeError, "Unknown exception in task" };
+                    }
+                    pManager->completeTask(pGroup, taskIndex, std::move(result));
+                }(this, pGroup, taskIndex);
+            });
+    }
+}
 
-    m_threadPool.spawn(submitTask(std::move(pendingTasks), promise));
+void TaskManager::completeTask(TaskGroup* pGroup, uint32_t taskIndex, Result result)
+{
+    pGroup->m_results[taskIndex] = std::move(result);
+    if (pGroup->m_remainingTasks.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        completeGroup(pGroup);
+    }
+}
 
-    pGroup->m_tasks.clear();
-    return promise->get_future();
+void TaskManager::completeGroup(TaskGroup* pGroup)
+{
+    APH_PROFILER_SCOPE();
+
+    ResultGroup resultGroup{};
+    for (auto& result : pGroup->m_results)
+    {
+        resultGroup += std::move(result);
+    }
+    pGroup->m_results.clear();
+
+    // every task is parked at its final suspend point by now, including the one completing the group
+    pGroup->m_runningTasks.clear();
+
+    SmallVector<TaskGroup*> dependents;
+    {
+        std::lock_guard<std::mutex> lock{ pGroup->m_dependentLock };
+        std::swap(dependents, pGroup->m_dependents);
+    }
+
+    // the promise goes last, the submitter may reuse the group as soon as it is fulfilled
+    auto promise = std::move(pGroup->m_promise);
+    for (auto* pDependent : dependents)
+    {
+        if (pDependent->m_unresolvedCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            launch(pDependent);
+        }
+    }
+    promise.set_value(resultGroup);
 }
 
 void TaskManager::setDependencies(TaskGroup* pProducer, TaskGroup* pConsumer)
 {
-    pProducer->m_pendingGroups.insert(pConsumer);
-    // TODO check if UB
-    pConsumer->m_waitLatch.count_down(-1);
+    std::lock_guard<std::mutex> lock{ pProducer->m_dependentLock };
+    pProducer->m_dependents.push_back(pConsumer);
+    pConsumer->m_unresolvedCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+Result TaskManager::wait(std::future<Result>& future)
+{
+    APH_PROFILER_SCOPE();
+    if (m_threadPool.isWorkerThread())
+    {
+        while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        {
+            if (!m_threadPool.runPendingTask())
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+    return future.get();
 }
 
 TaskManager::~TaskManager()
@@ -117,11 +208,12 @@ TaskManager::~TaskManager()
 
 void TaskManager::cleanup()
 {
-    for (const auto& [group, _] : m_pendingTasks)
+    std::lock_guard<std::mutex> lock{ m_groupLock };
+    for (auto* pGroup : m_taskGroups)
     {
-        m_taskGroupPools.free(group);
+        m_taskGroupPools.free(pGroup);
     }
-    m_pendingTasks.clear();
+    m_taskGroups.clear();
     m_taskGroupPools.clear();
 }
 } // namespace aph
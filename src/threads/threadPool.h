@@ -1,13 +1,11 @@
 #pragma once
 
 #include <atomic>
-#include <barrier>
 #include <concepts>
 #include <deque>
 #include <functional>
 #include <future>
 #include <memory>
-#include <semaphore>
 #include <thread>
 #include <type_traits>
 #ifdef __has_include
@@ -16,7 +14,8 @@
 #endif
 #endif
 
-#include "threadSafeQueue.h"
+#include "mpmcQueue.h"
+#include "workStealingDeque.h"
 
 namespace aph
 {
@@ -29,6 +28,9 @@ using DefaultFunctionType = std::function<void()>;
 #endif
 } // namespace threads
 
+// Work-stealing thread pool. Every worker owns a Chase-Lev deque it pushes to and pops from without locks,
+// tasks submitted from outside the pool go through a shared lock-free injection queue, and idle workers
+// steal from a random victim before going to sleep on an atomic wait.
 template <typename FunctionType = threads::DefaultFunctionType, typename ThreadType = std::jthread>
     requires std::invocable<FunctionType> && std::is_same_v<void, std::invoke_result_t<FunctionType>>
 class ThreadPool
@@ -37,79 +39,44 @@ public:
     explicit ThreadPool(const unsigned int& number_of_threads = std::thread::hardware_concurrency())
         : m_tasks(number_of_threads)
     {
-        std::size_t current_id = 0;
         for (std::size_t i = 0; i < number_of_threads; ++i)
         {
-            m_priority_queue.push_back(size_t(current_id));
             try
             {
-                m_threads.emplace_back(
-                    [&, id = current_id](const std::stop_token& stop_tok)
-                    {
-                        do
-                        {
-                            // wait until signaled
-                            m_tasks[id].signal.acquire();
-
-                            do
-                            {
-                                // invoke the task
-                                while (auto task = m_tasks[id].tasks.pop_front())
-                                {
-                                    try
-                                    {
-                                        m_pending_tasks.fetch_sub(1, std::memory_order_release);
-                                        std::invoke(std::move(task.value()));
-                                    }
-                                    catch (...)
-                                    {
-                                    }
-                                }
-
-                                // try to steal a task
-                                for (std::size_t j = 1; j < m_tasks.size(); ++j)
-                                {
-                                    const std::size_t index = (id + j) % m_tasks.size();
-                                    if (auto task = m_tasks[index].tasks.steal())
-                                    {
-                                        // steal a task
-                                        m_pending_tasks.fetch_sub(1, std::memory_order_release);
-                                        std::invoke(std::move(task.value()));
-                                        // stop stealing once we have invoked a stolen task
-                                        break;
-                                    }
-                                }
-
-                            } while (m_pending_tasks.load(std::memory_order_acquire) > 0);
-
-                            m_priority_queue.rotate_to_front(id);
-
-                        } while (!stop_tok.stop_requested());
-                    });
-                // increment the thread id
-                ++current_id;
+                m_threads.emplace_back([this, id = i](const std::stop_token& stop_tok) { workerLoop(id, stop_tok); });
             }
             catch (...)
             {
-                // catch all
-
-                // remove one item from the tasks
-                m_tasks.pop_back();
-
-                // remove our thread from the priority queue
-                std::ignore = m_priority_queue.pop_back();
+                // the deque of a worker that failed to start stays empty, only the injection queue feeds other
+                // threads from the outside
             }
         }
     }
 
     ~ThreadPool()
     {
-        // stop all threads
-        for (std::size_t i = 0; i < m_threads.size(); ++i)
+        // stop all threads, they drain the remaining tasks before exiting
+        for (auto& thread : m_threads)
+        {
+            thread.request_stop();
+        }
+        wakeWorkers(true);
+        for (auto& thread : m_threads)
         {
-            m_threads[i].request_stop();
-            m_tasks[i].signal.release();
-            m_threads[i].join();
+            thread.join();
+        }
+
+        // tasks pushed concurrently with the destruction never run
+        while (auto task = m_injection_queue.tryPop())
+        {
+            delete task.value();
+        }
+        for (auto& item : m_tasks)
+        {
+            while (auto task = item.steal())
+            {
+                delete task.value();
+            }
         }
     }
 
@@ -144,7 +111,7 @@ public:
                 promise.set_exception(std::current_exception());
             }
         };
-        enqueue_task(std::move(task));
+        enqueueTask(std::move(task));
         return future;
 #else
         /*
@@ -209,31 +176,178 @@ public:
         return m_threads.size();
     }
 
+    [[nodiscard]] auto isWorkerThread() const -> bool
+    {
+        return t_worker.pPool == this;
+    }
+
+    // Lets a worker that waits on other tasks run one of them instead of blocking its thread.
+    // Returns false when called from outside the pool or when no task is queued.
+    auto runPendingTask() -> bool
+    {
+        if (!isWorkerThread())
+        {
+            return false;
+        }
+        TaskNode* task = findTask(t_worker.id, t_worker.random_state);
+        if (!task)
+        {
+            return false;
+        }
+        runTask(task);
+        return true;
+    }
+
 private:
+    struct TaskNode
+    {
+        FunctionType function;
+    };
+
+    struct WorkerContext
+    {
+        const ThreadPool* pPool = {};
+        std::size_t id          = 0;
+        uint32_t random_state   = 1;
+    };
+    static inline thread_local WorkerContext t_worker{};
+
     template <typename Function>
     void enqueueTask(Function&& f)
     {
-        auto i_opt = m_priority_queue.copy_front_and_rotate_to_back();
-        if (!i_opt.has_value())
+        if (m_threads.empty())
         {
             // would only be a problem if there are zero threads
             return;
         }
-        auto i = *(i_opt);
-        m_pending_tasks.fetch_add(1, std::memory_order_relaxed);
-        m_tasks[i].tasks.push_back(std::forward<Function>(f));
-        m_tasks[i].signal.release();
+
+        auto* task = new TaskNode{ FunctionType{ std::forward<Function>(f) } };
+        if (t_worker.pPool == this)
+        {
+            // tasks spawned by a worker stay on its own deque, other workers steal them when idle
+            m_tasks[t_worker.id].push(task);
+        }
+        else
+        {
+            // the injection queue is bounded, apply back pressure instead of dropping the task
+            while (!m_injection_queue.tryPush(std::move(task)))
+            {
+                wakeWorkers(false);
+                std::this_thread::yield();
+            }
+        }
+        wakeWorkers(false);
     }
 
-    struct TaskItem
+    [[nodiscard]] auto findTask(std::size_t id, uint32_t& random_state) -> TaskNode*
     {
-        aph::ThreadSafeQueue<FunctionType> tasks{};
-        std::binary_semaphore signal{ 0 };
-    };
+        if (auto task = m_tasks[id].pop())
+        {
+            return task.value();
+        }
+        if (auto task = m_injection_queue.tryPop())
+        {
+            return task.value();
+        }
+
+        // try to steal a task, starting from a random victim so thieves don't all hit the same deque
+        random_state ^= random_state << 13;
+        random_state ^= random_state >> 17;
+        random_state ^= random_state << 5;
+        const std::size_t count = m_tasks.size();
+        const std::size_t start = random_state % count;
+        for (std::size_t j = 0; j < count; ++j)
+        {
+            const std::size_t index = (start + j) % count;
+            if (index == id)
+            {
+                continue;
+            }
+            if (auto task = m_tasks[index].steal())
+            {
+                return task.value();
+            }
+        }
+        return nullptr;
+    }
+
+    void workerLoop(std::size_t id, const std::stop_token& stop_tok)
+    {
+        t_worker           = { this, id, static_cast<uint32_t>(id * 2654435761u + 1u) };
+        auto& random_state = t_worker.random_state;
+
+        while (true)
+        {
+            TaskNode* task = findTask(id, random_state);
+            if (!task)
+            {
+                if (stop_tok.stop_requested())
+                {
+                    break;
+                }
+
+                // announce that we are going to sleep, then look once more before waiting so that a push racing
+                // with us either sees the sleeper or gets picked up by the second search
+                const uint32_t epoch = m_wake_epoch.load(std::memory_order_acquire);
+                m_sleeping_workers.fetch_add(1, std::memory_order_seq_cst);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                task = findTask(id, random_state);
+                if (!task && !stop_tok.stop_requested())
+                {
+                    m_wake_epoch.wait(epoch, std::memory_order_acquire);
+                }
+                m_sleeping_workers.fetch_sub(1, std::memory_order_relaxed);
+                if (!task)
+                {
+                    continue;
+                }
+            }
+
+            // more work is queued than this thread can take, hand it to a sleeping worker
+            if (!m_tasks[id].empty() || !m_injection_queue.empty())
+            {
+                wakeWorkers(false);
+            }
+
+            runTask(task);
+        }
+        t_worker = {};
+    }
+
+    static void runTask(TaskNode* task)
+    {
+        try
+        {
+            std::invoke(std::move(task->function));
+        }
+        catch (...)
+        {
+        }
+        delete task;
+    }
+
+    void wakeWorkers(bool all)
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!all && m_sleeping_workers.load(std::memory_order_relaxed) == 0)
+        {
+            return;
+        }
+        m_wake_epoch.fetch_add(1, std::memory_order_release);
+        if (all)
+        {
+            m_wake_epoch.notify_all();
+        }
+        else
+        {
+            m_wake_epoch.notify_one();
+        }
+    }
 
     std::vector<ThreadType> m_threads;
-    std::deque<TaskItem> m_tasks;
-    aph::ThreadSafeQueue<std::size_t> m_priority_queue;
-    std::atomic_int_fast64_t m_pending_tasks{};
+    std::deque<WorkStealingDeque<TaskNode*>> m_tasks;
+    MPMCQueue<TaskNode*> m_injection_queue;
+    alignas(threads::CacheLineSize) std::atomic<uint32_t> m_wake_epoch{};
+    alignas(threads::CacheLineSize) std::atomic<uint32_t> m_sleeping_workers{};
 };
 } // namespace aph
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+namespace aph
+{
+namespace threads
+{
+// Keeps the owner and thief indices of lock-free queues on separate cache lines
+inline constexpr std::size_t CacheLineSize = 64;
+} // namespace threads
+
+// Chase-Lev work-stealing deque, following "Correct and Efficient Work-Stealing for Weak Memory Models"
+// (Le et al. 2013). The owning thread pushes and pops at the bottom without any read-modify-write in the
+// common case, other threads steal from the top with a single CAS.
+//
+// Elements are copied in and out of a ring that can be read concurrently by a thief, so T must be
+// trivially copyable (typically a pointer to the actual work item). The ring grows on demand and retired
+// rings are kept alive until the deque is destroyed, since a thief may still be reading from one.
+template <typename T>
+    requires std::is_trivially_copyable_v<T>
+class WorkStealingDeque
+{
+public:
+    explicit WorkStealingDeque(std::size_t capacity = 256)
+    {
+        std::size_t ringCapacity = 1;
+        while (ringCapacity < capacity)
+        {
+            ringCapacity <<= 1;
+        }
+        m_rings.push_back(std::make_unique<Ring>(ringCapacity));
+        m_ring.store(m_rings.back().get(), std::memory_order_relaxed);
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&)            = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    // Owner thread only
+    void push(T value)
+    {
+        const int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+        const int64_t top    = m_top.load(std::memory_order_acquire);
+        Ring* pRing          = m_ring.load(std::memory_order_relaxed);
+
+        if (bottom - top > static_cast<int64_t>(pRing->mask))
+        {
+            pRing = grow(pRing, top, bottom);
+        }
+
+        // release on bottom rather than a standalone fence, same codegen and visible to the thread sanitizer
+        pRing->store(bottom, value);
+        m_bottom.store(bottom + 1, std::memory_order_release);
+    }
+
+    // Owner thread only, LIFO
+    [[nodiscard]] auto pop() -> std::optional<T>
+    {
+        const int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+        Ring* pRing          = m_ring.load(std::memory_order_relaxed);
+        m_bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t top = m_top.load(std::memory_order_relaxed);
+
+        if (top > bottom)
+        {
+            // Empty
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            return std::nullopt;
+        }
+
+        T value = pRing->load(bottom);
+        if (top == bottom)
+        {
+            // Last element, race against thieves for it
+            const bool won =
+                m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            if (!won)
+            {
+                return std::nullopt;
+            }
+        }
+        return value;
+    }
+
+    // Any thread, FIFO. Fails spuriously when losing a race against the owner or another thief.
+    [[nodiscard]] auto steal() -> std::optional<T>
+    {
+        int64_t top = m_top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t bottom = m_bottom.load(std::memory_order_acquire);
+
+        if (top >= bottom)
+        {
+            return std::nullopt;
+        }
+
+        Ring* pRing = m_ring.load(std::memory_order_acquire);
+        T value     = pRing->load(top);
+        if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        {
+            return std::nullopt;
+        }
+        return value;
+    }
+
+    // Approximate when called concurrently with push/pop/steal
+    [[nodiscard]] auto empty() const -> bool
+    {
+        return m_bottom.load(std::memory_order_relaxed) <= m_top.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] auto size() const -> std::size_t
+    {
+        const int64_t count = m_bottom.load(std::memory_order_relaxed) - m_top.load(std::memory_order_relaxed);
+        return count > 0 ? static_cast<std::size_t>(count) : 0;
+    }
+
+    [[nodiscard]] auto capacity() const -> std::size_t
+    {
+        return m_ring.load(std::memory_order_relaxed)->mask + 1;
+    }
+
+private:
+    struct Ring
+    {
+        explicit Ring(std::size_t capacity)
+            : mask(capacity - 1)
+            , slots(std::make_unique<std::atomic<T>[]>(capacity))
+        {
+        }
+
+        void store(int64_t index, T value)
+        {
+            slots[static_cast<std::size_t>(index) & mask].store(value, std::memory_order_relaxed);
+        }
+
+        auto load(int64_t index) const -> T
+        {
+            return slots[static_cast<std::size_t>(index) & mask].load(std::memory_order_relaxed);
+        }
+
+        std::size_t mask;
+        std::unique_ptr<std::atomic<T>[]> slots;
+    };
+
+    auto grow(Ring* pRing, int64_t top, int64_t bottom) -> Ring*
+    {
+        auto newRing = std::make_unique<Ring>((pRing->mask + 1) * 2);
+        for (int64_t index = top; index < bottom; ++index)
+        {
+            newRing->store(index, pRing->load(index));
+        }
+
+        Ring* pNewRing = newRing.get();
+        m_rings.push_back(std::move(newRing));
+        m_ring.store(pNewRing, std::memory_order_release);
+        return pNewRing;
+    }
+
+    alignas(threads::CacheLineSize) std::atomic<int64_t> m_top{ 0 };
+    alignas(threads::CacheLineSize) std::atomic<int64_t> m_bottom{ 0 };
+    alignas(threads::CacheLineSize) std::atomic<Ring*> m_ring{ nullptr };
+
+    // Owner thread only
+    std::vector<std::unique_ptr<Ring>> m_rings;
+};
+} // namespace aph
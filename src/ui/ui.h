@@ -12,7 +12,10 @@
 #include <string>
 #include <vector>
 
-GENERATE_LOG_FUNCS(UI);
+#define UI_LOG_DEBUG(...) APH_LOG_TAGGED(UI, Debug, __VA_ARGS__)
+#define UI_LOG_INFO(...)  APH_LOG_TAGGED(UI, Info, __VA_ARGS__)
+#define UI_LOG_WARN(...)  APH_LOG_TAGGED(UI, Warn, __VA_ARGS__)
+#define UI_LOG_ERR(...)   APH_LOG_TAGGED(UI, Error, __VA_ARGS__)
 
 // Forward declarations for ImGui
 struct ImGuiContext;
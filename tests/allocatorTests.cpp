@@ -0,0 +1,335 @@
+#include "allocator/allocator.h"
+
+#include <algorithm>
+#include <catch2/catch_all.hpp>
+#include <cstdint>
+#include <cstdlib>
+#include <source_location>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using namespace aph;
+using namespace aph::memory;
+
+namespace
+{
+void* allocateSmall()
+{
+    return aph_malloc(64);
+}
+
+void* allocateLarge()
+{
+    return aph_malloc(4096);
+}
+
+// Restores the previously active tracker when a test is done
+struct ScopedTracker
+{
+    ScopedTracker()
+        : pPrevious(getActiveAllocationTracker())
+    {
+        setActiveAllocationTracker(&tracker);
+    }
+
+    ~ScopedTracker()
+    {
+        setActiveAllocationTracker(pPrevious);
+    }
+
+    AllocationTracker tracker;
+    AllocationTracker* pPrevious;
+};
+} // namespace
+
+TEST_CASE("AllocationTracker aggregates per call site", "[allocator][tracker]")
+{
+    constexpr int numThreads      = 4;
+    constexpr int allocsPerThread = 3000;
+
+    std::vector<std::vector<void*>> allocations(numThreads);
+    {
+        ScopedTracker scope;
+        AllocationTracker& tracker = scope.tracker;
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < numThreads; t++)
+        {
+            threads.emplace_back(
+                [&allocations, t]()
+                {
+                    for (int i = 0; i < allocsPerThread; i++)
+                    {
+                        allocations[t].push_back(i % 2 == 0 ? allocateSmall() : allocateLarge());
+                    }
+                });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        threads.clear();
+
+        // Free the small allocations on a different thread than the one that made them
+        for (int t = 0; t < numThreads; t++)
+        {
+            threads.emplace_back(
+                [&allocations, t]()
+                {
+                    auto& other = allocations[(t + 1) % numThreads];
+                    for (size_t i = 0; i < other.size(); i += 2)
+                    {
+                        aph_free(other[i]);
+                    }
+                });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        auto stats = tracker.getCallSiteStats();
+        REQUIRE(stats.size() == 2);
+        auto small = std::ranges::find_if(stats, [](const CallSiteStats& site) { return site.liveBytes == 0; });
+        auto large = std::ranges::find_if(stats, [](const CallSiteStats& site) { return site.liveBytes != 0; });
+        REQUIRE(small != stats.end());
+        REQUIRE(large != stats.end());
+
+        REQUIRE(small->allocationCount == numThreads * allocsPerThread / 2);
+        REQUIRE(small->freeCount == numThreads * allocsPerThread / 2);
+        REQUIRE(small->liveCount == 0);
+        REQUIRE(large->liveCount == numThreads * allocsPerThread / 2);
+        REQUIRE(large->liveBytes == large->liveCount * 4096);
+        REQUIRE(std::string_view{ large->file } == small->file);
+
+        REQUIRE(tracker.generateSummaryReport().find("Outstanding allocations: 6000") != std::string::npos);
+
+        tracker.clear();
+        REQUIRE(tracker.getCallSiteStats().empty());
+    }
+
+    // Tracking is off again, these frees aren't recorded anywhere
+    for (auto& threadAllocations : allocations)
+    {
+        for (size_t i = 1; i < threadAllocations.size(); i += 2)
+        {
+            aph_free(threadAllocations[i]);
+        }
+    }
+}
+
+TEST_CASE("AllocationTracker handles realloc and typed allocations", "[allocator][tracker]")
+{
+    ScopedTracker scope;
+    AllocationTracker& tracker = scope.tracker;
+
+    int* value = aph_new<int>();
+    aph_delete(value);
+
+    void* buffer = aph_malloc(16);
+    buffer       = aph_realloc(buffer, 256);
+    REQUIRE(buffer != nullptr);
+
+    size_t liveCount = 0;
+    size_t liveBytes = 0;
+    for (const CallSiteStats& site : tracker.getCallSiteStats())
+    {
+        liveCount += site.liveCount;
+        liveBytes += site.liveBytes;
+    }
+    REQUIRE(liveCount == 1);
+    REQUIRE(liveBytes == 256);
+
+    aph_free(buffer);
+}
+
+TEST_CASE("AllocationTracker ignores frees of untracked allocations", "[allocator][tracker]")
+{
+    AllocationTracker tracker;
+    const auto location = std::source_location::current();
+
+    // The address is freed before the tracker saw it allocated, then handed out again
+    std::uint64_t block = 0;
+    tracker.trackAllocation(AllocationRecord::Type::Free, &block, 0, location);
+    tracker.trackAllocation(AllocationRecord::Type::Malloc, &block, sizeof(block), location);
+
+    auto stats = tracker.getCallSiteStats();
+    REQUIRE(stats.size() == 1);
+    REQUIRE(stats[0].liveCount == 1);
+    REQUIRE(stats[0].liveBytes == sizeof(block));
+
+    tracker.trackAllocation(AllocationRecord::Type::Free, &block, 0, location);
+    stats = tracker.getCallSiteStats();
+    REQUIRE(stats[0].liveCount == 0);
+    REQUIRE(stats[0].freeCount == 1);
+}
+
+TEST_CASE("AllocationTracker source subsystems", "[allocator][tracker]")
+{
+    REQUIRE(getSourceSubsystem("/home/user/Aphrodite/src/resource/image/imageLoader.cpp") == "resource");
+    REQUIRE(getSourceSubsystem("C:\\Aphrodite\\src\\api\\vulkan\\device.cpp") == "api");
+    REQUIRE(getSourceSubsystem("/home/user/Aphrodite/tests/allocatorTests.cpp") == "tests");
+    REQUIRE(getSourceSubsystem("allocator.cpp") == "unknown");
+}
+
+TEST_CASE("AllocationTracker per frame tag counters", "[allocator][tracker]")
+{
+    ScopedTracker scope;
+    AllocationTracker& tracker = scope.tracker;
+
+    std::vector<void*> physics;
+    {
+        AllocationTagScope tag{ "physics" };
+        for (int i = 0; i < 3; i++)
+        {
+            physics.push_back(allocateSmall());
+        }
+    }
+    void* untagged = allocateLarge();
+    tracker.nextFrame();
+
+    // Frees count against the tag of the allocation, wherever they happen
+    {
+        AllocationTagScope tag{ "audio" };
+        aph_free(physics.back());
+        physics.pop_back();
+    }
+    tracker.nextFrame();
+    aph_free(untagged);
+    for (void* ptr : physics)
+    {
+        aph_free(ptr);
+    }
+    tracker.nextFrame();
+
+    auto tags = tracker.getTagStats();
+    REQUIRE(tags.size() == 2);
+    const auto physicsTag = static_cast<uint32_t>(
+        std::ranges::find(tags, std::string_view{ "physics" }, &AllocationTagStats::name) - tags.begin());
+    const auto fileTag = 1 - physicsTag;
+    REQUIRE(physicsTag < 2);
+    REQUIRE(tags[physicsTag].allocationCount == 3);
+    REQUIRE(tags[physicsTag].freeCount == 3);
+    REQUIRE(tags[physicsTag].totalBytes == 3 * 64);
+    REQUIRE(tags[physicsTag].liveBytes == 0);
+    REQUIRE(tags[fileTag].name == getSourceSubsystem(std::source_location::current().file_name()));
+    REQUIRE(tags[fileTag].allocationCount == 1);
+
+    auto timeline = tracker.getTimeline();
+    REQUIRE(timeline.size() == 3);
+    REQUIRE(timeline[0].frame == 0);
+    REQUIRE(timeline[0].tags.size() == 2);
+    for (const AllocationFrameTagStats& tag : timeline[0].tags)
+    {
+        REQUIRE(tag.liveBytes == (tag.tag == physicsTag ? 3 * 64 : 4096));
+    }
+
+    REQUIRE(timeline[1].tags.size() == 2);
+    const auto& physicsFrame = *std::ranges::find(timeline[1].tags, physicsTag, &AllocationFrameTagStats::tag);
+    REQUIRE(physicsFrame.allocationCount == 0);
+    REQUIRE(physicsFrame.freeCount == 1);
+    REQUIRE(physicsFrame.liveBytes == 2 * 64);
+
+    // Everything was freed, only the activity shows up
+    REQUIRE(timeline[2].tags.size() == 2);
+    for (const AllocationFrameTagStats& tag : timeline[2].tags)
+    {
+        REQUIRE(tag.liveBytes == 0);
+        REQUIRE(tag.freeCount > 0);
+    }
+
+    const std::string trace = tracker.exportChromeTrace();
+    REQUIRE(trace.starts_with("{\"displayTimeUnit\""));
+    REQUIRE(trace.find(R"({"name":"live bytes","ph":"C","pid":1,"tid":0,"ts":1000,"args":{)") != std::string::npos);
+    REQUIRE(trace.find(R"("physics":{"allocations":3,"frees":3,"allocatedBytes":192,"liveCount":0,"liveBytes":0})") !=
+            std::string::npos);
+    REQUIRE(tracker.generateTagReport().find("physics | 3 | 3") != std::string::npos);
+}
+
+TEST_CASE("AllocationTracker timeline keeps the newest frames", "[allocator][tracker]")
+{
+    ScopedTracker scope;
+    AllocationTracker& tracker = scope.tracker;
+    tracker.setTimelineCapacity(4);
+
+    std::vector<void*> ptrs;
+    for (int frame = 0; frame < 10; frame++)
+    {
+        ptrs.push_back(allocateSmall());
+        tracker.nextFrame();
+    }
+
+    auto timeline = tracker.getTimeline();
+    REQUIRE(timeline.size() == 4);
+    for (std::size_t i = 0; i < timeline.size(); i++)
+    {
+        REQUIRE(timeline[i].frame == 6 + i);
+        REQUIRE(timeline[i].tags.size() == 1);
+        REQUIRE(timeline[i].tags[0].allocationCount == 1);
+        REQUIRE(timeline[i].tags[0].liveBytes == (7 + i) * 64);
+    }
+
+    tracker.setTimelineCapacity(2);
+    timeline = tracker.getTimeline();
+    REQUIRE(timeline.size() == 2);
+    REQUIRE(timeline[0].frame == 8);
+    REQUIRE(timeline[1].frame == 9);
+
+    for (void* ptr : ptrs)
+    {
+        aph_free(ptr);
+    }
+}
+
+TEST_CASE("AllocationTracker overhead benchmark", "[allocator][tracker][!benchmark]")
+{
+    constexpr int batchSize = 1000;
+    std::vector<void*> ptrs(batchSize);
+
+    BENCHMARK("std::malloc/free")
+    {
+        for (int i = 0; i < batchSize; i++)
+        {
+            ptrs[i] = std::malloc(64);
+        }
+        for (int i = 0; i < batchSize; i++)
+        {
+            std::free(ptrs[i]);
+        }
+        return ptrs[0];
+    };
+
+    AllocationTracker* pPrevious = getActiveAllocationTracker();
+    setActiveAllocationTracker(nullptr);
+    BENCHMARK("aph_malloc/aph_free, tracking disabled")
+    {
+        for (int i = 0; i < batchSize; i++)
+        {
+            ptrs[i] = aph_malloc(64);
+        }
+        for (int i = 0; i < batchSize; i++)
+        {
+            aph_free(ptrs[i]);
+        }
+        return ptrs[0];
+    };
+
+    {
+        ScopedTracker scope;
+        BENCHMARK("aph_malloc/aph_free, tracking enabled")
+        {
+            for (int i = 0; i < batchSize; i++)
+            {
+                ptrs[i] = aph_malloc(64);
+            }
+            for (int i = 0; i < batchSize; i++)
+            {
+                aph_free(ptrs[i]);
+            }
+            return ptrs[0];
+        };
+    }
+    setActiveAllocationTracker(pPrevious);
+}
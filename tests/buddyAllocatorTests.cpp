@@ -0,0 +1,137 @@
+#include "allocator/buddyAllocator.h"
+
+#include <algorithm>
+#include <catch2/catch_all.hpp>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <vector>
+
+using namespace aph;
+
+TEST_CASE("BuddyAllocator offsets", "[allocator][buddy]")
+{
+    constexpr std::size_t capacity     = 64 * 1024;
+    constexpr std::size_t minBlockSize = 256;
+    BuddyAllocator allocator{ capacity, minBlockSize };
+
+    SECTION("sizes round up to power of two blocks")
+    {
+        auto first = allocator.allocate(100);
+        REQUIRE(first == 0);
+        REQUIRE(allocator.getBlockSize(*first) == minBlockSize);
+
+        auto second = allocator.allocate(1000);
+        REQUIRE(second);
+        REQUIRE(*second % 1024 == 0);
+        REQUIRE(allocator.getBlockSize(*second) == 1024);
+        REQUIRE(allocator.getUsedSize() == minBlockSize + 1024);
+        REQUIRE(allocator.getAllocationCount() == 2);
+    }
+
+    SECTION("alignment up to the block size")
+    {
+        REQUIRE(allocator.allocate(16) == 0);
+        auto aligned = allocator.allocate(16, 4096);
+        REQUIRE(aligned);
+        REQUIRE(*aligned % 4096 == 0);
+        REQUIRE(allocator.getBlockSize(*aligned) == 4096);
+    }
+
+    SECTION("exhaustion and full merge")
+    {
+        std::vector<std::size_t> offsets;
+        while (auto offset = allocator.allocate(minBlockSize))
+        {
+            offsets.push_back(*offset);
+        }
+        REQUIRE(offsets.size() == capacity / minBlockSize);
+        REQUIRE(allocator.getUsedSize() == capacity);
+        REQUIRE_FALSE(allocator.allocate(1));
+
+        // Freeing in any order merges everything back into one block
+        std::mt19937 rng{ 42 };
+        std::ranges::shuffle(offsets, rng);
+        for (std::size_t offset : offsets)
+        {
+            allocator.free(offset);
+        }
+        REQUIRE(allocator.isEmpty());
+        REQUIRE(allocator.allocate(capacity) == 0);
+    }
+
+    SECTION("oversized requests fail")
+    {
+        REQUIRE_FALSE(allocator.allocate(capacity + 1));
+        REQUIRE_FALSE(allocator.allocate(16, capacity * 2));
+    }
+}
+
+TEST_CASE("BuddyAllocator random allocations don't overlap", "[allocator][buddy]")
+{
+    constexpr std::size_t capacity = 4 * 1024 * 1024;
+    BuddyAllocator allocator{ capacity, 256 };
+
+    std::mt19937 rng{ 1234 };
+    std::uniform_int_distribution<std::size_t> sizeDist{ 1, 64 * 1024 };
+    std::uniform_int_distribution<int> shiftDist{ 0, 10 };
+
+    // offset -> end of the block
+    std::map<std::size_t, std::size_t> live;
+    for (int i = 0; i < 20000; i++)
+    {
+        if (live.empty() || rng() % 3 != 0)
+        {
+            const std::size_t size      = sizeDist(rng);
+            const std::size_t alignment = std::size_t{ 1 } << shiftDist(rng);
+            auto offset                 = allocator.allocate(size, alignment);
+            if (!offset)
+            {
+                continue;
+            }
+            REQUIRE(*offset % alignment == 0);
+            REQUIRE(*offset + size <= capacity);
+
+            const std::size_t end = *offset + allocator.getBlockSize(*offset);
+            auto next             = live.lower_bound(*offset);
+            REQUIRE((next == live.end() || next->first >= end));
+            REQUIRE((next == live.begin() || std::prev(next)->second <= *offset));
+            live.emplace(*offset, end);
+        }
+        else
+        {
+            auto it = std::next(live.begin(), static_cast<std::ptrdiff_t>(rng() % live.size()));
+            allocator.free(it->first);
+            live.erase(it);
+        }
+
+        REQUIRE(allocator.getAllocationCount() == live.size());
+    }
+
+    for (const auto& [offset, end] : live)
+    {
+        allocator.free(offset);
+    }
+    REQUIRE(allocator.isEmpty());
+    REQUIRE(allocator.getUsedSize() == 0);
+}
+
+TEST_CASE("BuddyAllocator benchmark", "[allocator][buddy][!benchmark]")
+{
+    constexpr int batchSize = 1000;
+    std::vector<std::size_t> offsets(batchSize);
+
+    BuddyAllocator allocator{ 4 * 1024 * 1024, 256 };
+    BENCHMARK("allocate/free 1000 small blocks")
+    {
+        for (int i = 0; i < batchSize; i++)
+        {
+            offsets[i] = *allocator.allocate(static_cast<std::size_t>(64 + i % 4 * 512), 64);
+        }
+        for (int i = 0; i < batchSize; i++)
+        {
+            allocator.free(offsets[i]);
+        }
+        return offsets[0];
+    };
+}
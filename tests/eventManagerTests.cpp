@@ -0,0 +1,283 @@
+#include "common/hash.h"
+#include "event/event.h"
+#include "event/eventManager.h"
+
+#include <algorithm>
+#include <atomic>
+#include <catch2/catch_all.hpp>
+#include <format>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+using namespace aph;
+
+namespace
+{
+struct TestEvent
+{
+    uint32_t producer;
+    uint32_t index;
+};
+
+// Baseline for the benchmark: every push takes one mutex and looks its type up in a hash map, events are handled
+// one at a time
+class LockedEventManager
+{
+public:
+    template <typename TEvent>
+    void pushEvent(const TEvent& e)
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        getEventData<TEvent>().events.push(e);
+    }
+
+    template <typename TEvent>
+    void registerEvent(std::function<bool(const TEvent&)>&& func)
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        getEventData<TEvent>().handlers.push_back(std::move(func));
+    }
+
+    void processAll()
+    {
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        for (auto& [_, pData] : m_eventData)
+        {
+            pData->process();
+        }
+    }
+
+private:
+    struct TypeErased
+    {
+        virtual ~TypeErased()  = default;
+        virtual void process() = 0;
+    };
+
+    template <typename TEvent>
+    struct EventData : TypeErased
+    {
+        std::queue<TEvent> events;
+        std::vector<std::function<bool(const TEvent&)>> handlers;
+
+        void process() override
+        {
+            while (!events.empty())
+            {
+                auto e = events.front();
+                events.pop();
+                for (const auto& handler : handlers)
+                {
+                    handler(e);
+                }
+            }
+        }
+    };
+
+    template <typename TEvent>
+    auto getEventData() -> EventData<TEvent>&
+    {
+        auto& pData = m_eventData[detail::EventTypeIndex::get<TEvent>()];
+        if (!pData)
+        {
+            pData = std::make_unique<EventData<TEvent>>();
+        }
+        return *static_cast<EventData<TEvent>*>(pData.get());
+    }
+
+    std::mutex m_mutex;
+    HashMap<uint32_t, std::unique_ptr<TypeErased>> m_eventData;
+};
+
+// Producers push concurrently while the calling thread keeps processing until every event was handled
+template <typename TManager>
+void runProducers(TManager& manager, const std::atomic<uint32_t>& handled, uint32_t producerCount,
+                  uint32_t eventsPerProducer)
+{
+    std::vector<std::jthread> producers;
+    for (uint32_t producer = 0; producer < producerCount; ++producer)
+    {
+        producers.emplace_back(
+            [&manager, producer, eventsPerProducer]
+            {
+                for (uint32_t index = 0; index < eventsPerProducer; ++index)
+                {
+                    manager.pushEvent(TestEvent{ producer, index });
+                }
+            });
+    }
+
+    const uint32_t expected = handled.load(std::memory_order_relaxed) + producerCount * eventsPerProducer;
+    while (handled.load(std::memory_order_relaxed) < expected)
+    {
+        manager.processAll();
+    }
+}
+} // namespace
+
+TEST_CASE("EventManager dispatches batches in push order", "[event]")
+{
+    EventManager manager;
+    std::vector<float> moves;
+    std::vector<std::size_t> batchSizes;
+    std::vector<Key> keys;
+
+    manager.pushEvent(KeyboardEvent{ Key::A, KeyState::Pressed });
+    for (int i = 0; i < 100; ++i)
+    {
+        manager.pushEvent(MouseMoveEvent{ static_cast<float>(i), 0.0f, 0.0f, 0.0f });
+    }
+    manager.registerEvent(std::function<bool(const MouseMoveEvent&)>{ [&moves](const MouseMoveEvent& e)
+    {
+        moves.push_back(e.m_deltaX);
+        return true;
+    } });
+    manager.registerBatchEvent(EventManager::BatchHandler<MouseMoveEvent>{ [&batchSizes](auto events)
+    {
+        batchSizes.push_back(events.size());
+    } });
+    manager.registerEvent(std::function<bool(const KeyboardEvent&)>{ [&keys](const KeyboardEvent& e)
+    {
+        keys.push_back(e.m_key);
+        return true;
+    } });
+    REQUIRE(moves.empty());
+
+    // Handlers registered before processAll() see the events queued before them
+    manager.processAll();
+    REQUIRE(moves.size() == 100);
+    REQUIRE(std::ranges::is_sorted(moves));
+    REQUIRE(batchSizes == std::vector<std::size_t>{ 100 });
+    REQUIRE(keys == std::vector<Key>{ Key::A });
+
+    // Nothing queued, no batch
+    manager.processAll();
+    REQUIRE(batchSizes.size() == 1);
+}
+
+TEST_CASE("Events pushed by handlers go to the next batch", "[event]")
+{
+    EventManager manager;
+    std::vector<uint32_t> handled;
+    manager.registerEvent(std::function<bool(const TestEvent&)>{ [&](const TestEvent& e)
+    {
+        handled.push_back(e.index);
+        if (e.index < 3)
+        {
+            manager.pushEvent(TestEvent{ 0, e.index + 1 });
+        }
+        return true;
+    } });
+
+    manager.pushEvent(TestEvent{ 0, 0 });
+    for (uint32_t frame = 0; frame < 4; ++frame)
+    {
+        manager.processAll();
+        REQUIRE(handled.size() == frame + 1);
+    }
+    manager.processAll();
+    REQUIRE(handled == std::vector<uint32_t>{ 0, 1, 2, 3 });
+}
+
+TEST_CASE("EventManager keeps the order of each producer", "[event]")
+{
+    constexpr uint32_t ProducerCount     = 8;
+    constexpr uint32_t EventsPerProducer = 20000;
+
+    // A small queue fills up all the time, the events spill
+    EventManager manager;
+    manager.registerEventType<TestEvent>(64);
+
+    std::vector<uint32_t> next(ProducerCount, 0);
+    std::atomic<uint32_t> handled{ 0 };
+    bool ordered = true;
+    manager.registerBatchEvent(EventManager::BatchHandler<TestEvent>{ [&](std::span<const TestEvent> events)
+    {
+        for (const TestEvent& e : events)
+        {
+            ordered = ordered && e.index == next[e.producer]++;
+        }
+        handled.fetch_add(static_cast<uint32_t>(events.size()));
+    } });
+
+    SECTION("concurrent producers")
+    {
+        runProducers(manager, handled, ProducerCount, EventsPerProducer);
+    }
+
+    SECTION("handlers registered while processing")
+    {
+        std::atomic<uint32_t> lateHandled{ 0 };
+        const auto countLate = [&lateHandled](const TestEvent&)
+        {
+            lateHandled.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        };
+        std::jthread registering{ [&manager, &countLate]
+        {
+            for (int i = 0; i < 16; ++i)
+            {
+                manager.registerEvent(std::function<bool(const TestEvent&)>{ countLate });
+                std::this_thread::yield();
+            }
+        } };
+        runProducers(manager, handled, ProducerCount, EventsPerProducer);
+        registering.join();
+
+        const uint32_t before = lateHandled.load();
+        manager.pushEvent(TestEvent{ 0, EventsPerProducer });
+        manager.processAll();
+        REQUIRE(lateHandled.load() == before + 16);
+    }
+
+    REQUIRE(ordered);
+    REQUIRE(std::ranges::all_of(next, [](uint32_t count) { return count >= EventsPerProducer; }));
+}
+
+// Divide the event count by the reported mean to get events/sec
+TEST_CASE("EventManager producer throughput benchmark", "[event][!benchmark]")
+{
+    constexpr uint32_t EventsPerProducer = 20000;
+
+    for (uint32_t producerCount : { 1u, 2u, 4u, 8u, 16u })
+    {
+        std::atomic<uint32_t> handled{ 0 };
+        const auto countEvent = [&handled](const TestEvent&)
+        {
+            handled.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        };
+
+        LockedEventManager lockedManager;
+        lockedManager.registerEvent(std::function<bool(const TestEvent&)>{ countEvent });
+        BENCHMARK(std::format("mutex and hash map, {} events, {} producers", producerCount * EventsPerProducer,
+                              producerCount))
+        {
+            runProducers(lockedManager, handled, producerCount, EventsPerProducer);
+        };
+
+        EventManager manager;
+        manager.registerEventType<TestEvent>(4096);
+        manager.registerEvent(std::function<bool(const TestEvent&)>{ countEvent });
+        BENCHMARK(std::format("lock-free queue, {} events, {} producers", producerCount * EventsPerProducer,
+                              producerCount))
+        {
+            runProducers(manager, handled, producerCount, EventsPerProducer);
+        };
+
+        EventManager batchManager;
+        batchManager.registerEventType<TestEvent>(4096);
+        batchManager.registerBatchEvent(EventManager::BatchHandler<TestEvent>{
+            [&handled](std::span<const TestEvent> events)
+            {
+                handled.fetch_add(static_cast<uint32_t>(events.size()), std::memory_order_relaxed);
+            } });
+        BENCHMARK(std::format("lock-free queue, batch handler, {} events, {} producers",
+                              producerCount * EventsPerProducer, producerCount))
+        {
+            runProducers(batchManager, handled, producerCount, EventsPerProducer);
+        };
+    }
+}
@@ -0,0 +1,160 @@
+#include "allocator/frameAllocator.h"
+
+#include <algorithm>
+#include <catch2/catch_all.hpp>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace aph;
+
+TEST_CASE("FrameAllocator bump allocation", "[allocator][frame]")
+{
+    FrameAllocator allocator{ 2, 4096 };
+
+    SECTION("alignment and large allocations")
+    {
+        for (std::size_t alignment : { 1, 2, 8, 16, 64, 256 })
+        {
+            void* ptr = allocator.allocate(3, alignment);
+            REQUIRE(ptr != nullptr);
+            REQUIRE(reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0);
+        }
+
+        // larger than a block, gets a dedicated one
+        auto* pLarge = static_cast<std::byte*>(allocator.allocate(64 * 1024, 128));
+        REQUIRE(reinterpret_cast<std::uintptr_t>(pLarge) % 128 == 0);
+        std::memset(pLarge, 0xff, 64 * 1024);
+    }
+
+    SECTION("threads bump through their own blocks")
+    {
+        constexpr int numThreads      = 4;
+        constexpr int allocsPerThread = 2000;
+
+        std::vector<std::vector<uint64_t*>> allocations(numThreads);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < numThreads; t++)
+        {
+            threads.emplace_back(
+                [&allocator, &allocations, t]()
+                {
+                    for (int i = 0; i < allocsPerThread; i++)
+                    {
+                        auto* pValue = allocator.allocateArray<uint64_t>(2);
+                        pValue[0]    = t;
+                        pValue[1]    = i;
+                        allocations[t].push_back(pValue);
+                    }
+                });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        // nothing was handed out twice
+        for (int t = 0; t < numThreads; t++)
+        {
+            for (int i = 0; i < allocsPerThread; i++)
+            {
+                REQUIRE(allocations[t][i][0] == static_cast<uint64_t>(t));
+                REQUIRE(allocations[t][i][1] == static_cast<uint64_t>(i));
+            }
+        }
+        REQUIRE(allocator.getStats().blockCount >= numThreads);
+    }
+
+    SECTION("blocks are recycled after frameCount frames")
+    {
+        for (int i = 0; i < 100; i++)
+        {
+            (void)allocator.allocate(100);
+        }
+        const std::size_t usedBlocks = allocator.getStats().blockCount;
+        REQUIRE(usedBlocks > 0);
+
+        allocator.nextFrame();
+        REQUIRE(allocator.getStats().blockCount == 0);
+        REQUIRE(allocator.getStats().freeBlockCount == 0);
+
+        allocator.nextFrame();
+        REQUIRE(allocator.getFrameIndex() == 0);
+        REQUIRE(allocator.getStats().freeBlockCount == usedBlocks);
+
+        // the recycled blocks are reused instead of allocating new ones
+        for (int i = 0; i < 100; i++)
+        {
+            (void)allocator.allocate(100);
+        }
+        REQUIRE(allocator.getStats().freeBlockCount == 0);
+        REQUIRE(allocator.getStats().blockCount == usedBlocks);
+    }
+}
+
+TEST_CASE("FrameStlAllocator containers", "[allocator][frame]")
+{
+    FrameAllocator allocator{ 2 };
+
+    FrameVector<int> values{ &allocator };
+    for (int i = 0; i < 10000; i++)
+    {
+        values.push_back(i);
+    }
+    REQUIRE(values.size() == 10000);
+    REQUIRE(values.back() == 9999);
+
+    FrameHashMap<int, int> map{ &allocator };
+    for (int i = 0; i < 1000; i++)
+    {
+        map[i] = i * 2;
+    }
+    REQUIRE(map.at(500) == 1000);
+
+    // without a frame allocator the containers use the heap
+    FrameVector<int> heapValues;
+    heapValues.assign(100, 3);
+    REQUIRE(std::ranges::all_of(heapValues, [](int value) { return value == 3; }));
+}
+
+// Typical per-frame scratch work: a few maps and vectors built up and thrown away every frame
+TEST_CASE("FrameAllocator per-frame scratch benchmark", "[allocator][frame][!benchmark]")
+{
+    constexpr int queueCount   = 3;
+    constexpr int barrierCount = 64;
+
+    auto buildFrame = [](auto&& makeMap, auto&& makeVector)
+    {
+        auto submitInfos = makeMap();
+        for (int queue = 0; queue < queueCount; queue++)
+        {
+            auto& barriers = submitInfos.try_emplace(queue, makeVector()).first->second;
+            for (int i = 0; i < barrierCount; i++)
+            {
+                barriers.push_back(static_cast<uint64_t>(queue * barrierCount + i));
+            }
+        }
+
+        auto counts = makeVector();
+        for (const auto& [queue, barriers] : submitInfos)
+        {
+            counts.push_back(barriers.size());
+        }
+        return counts.size();
+    };
+
+    BENCHMARK("heap containers, 1 frame")
+    {
+        return buildFrame([]() { return HashMap<int, std::vector<uint64_t>>{}; },
+                          []() { return std::vector<uint64_t>{}; });
+    };
+
+    FrameAllocator allocator{ 2 };
+    BENCHMARK("frame allocator containers, 1 frame")
+    {
+        allocator.nextFrame();
+        return buildFrame([&allocator]() { return FrameHashMap<int, FrameVector<uint64_t>>{ &allocator }; },
+                          [&allocator]() { return FrameVector<uint64_t>{ &allocator }; });
+    };
+}
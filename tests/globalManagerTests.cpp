@@ -0,0 +1,78 @@
+#include "global/globalManager.h"
+#include "common/logger.h"
+
+#include <catch2/catch_all.hpp>
+#include <memory>
+#include <string>
+
+using namespace aph;
+
+namespace
+{
+struct CustomSubsystem
+{
+    int value = 0;
+};
+} // namespace
+
+TEST_CASE("Built-in subsystems are found by type", "[global]")
+{
+    GlobalManager& manager = GlobalManager::instance();
+
+    REQUIRE(getBuiltInSubsystem<TaskManager>() != nullptr);
+    REQUIRE(getBuiltInSubsystem<TaskManager>() ==
+            manager.getSubsystem<TaskManager>(GlobalManager::TASK_MANAGER_NAME));
+    REQUIRE(getBuiltInSubsystem<Filesystem>() == manager.getSubsystem<Filesystem>(GlobalManager::FILESYSTEM_NAME));
+    REQUIRE(getBuiltInSubsystem<EventManager>() ==
+            manager.getSubsystem<EventManager>(GlobalManager::EVENT_MANAGER_NAME));
+    REQUIRE(getBuiltInSubsystem<memory::AllocationTracker>() ==
+            manager.getSubsystem<memory::AllocationTracker>(GlobalManager::MEMORY_TRACKER_NAME));
+    REQUIRE(&APH_LOGGER == manager.getSubsystem<Logger>(GlobalManager::LOGGER_NAME));
+    REQUIRE(&APH_LOGGER == getActiveLogger());
+}
+
+TEST_CASE("Custom subsystems are found by name", "[global]")
+{
+    GlobalManager& manager = GlobalManager::instance();
+
+    auto pCustom      = std::make_unique<CustomSubsystem>();
+    pCustom->value    = 42;
+    auto* pRegistered = pCustom.get();
+    REQUIRE(manager.registerSubsystem("CustomSubsystem", std::move(pCustom)));
+    REQUIRE_FALSE(manager.registerSubsystem("CustomSubsystem", std::make_unique<CustomSubsystem>()));
+    REQUIRE(manager.getSubsystem<CustomSubsystem>("CustomSubsystem") == pRegistered);
+    REQUIRE(manager.getSubsystem<CustomSubsystem>(std::string{ "CustomSubsystem" })->value == 42);
+    REQUIRE(manager.getSubsystem<CustomSubsystem>("Missing") == nullptr);
+
+    // Only the built-in name takes the slot, other instances of a built-in type are custom subsystems
+    Logger* pBuiltIn = getBuiltInSubsystem<Logger>();
+    auto pLogger     = std::make_unique<Logger>();
+    auto* pSecond    = pLogger.get();
+    REQUIRE(manager.registerSubsystem("SecondLogger", std::move(pLogger)));
+    REQUIRE(manager.getSubsystem<Logger>("SecondLogger") == pSecond);
+    REQUIRE(getBuiltInSubsystem<Logger>() == pBuiltIn);
+}
+
+TEST_CASE("Subsystem lookup benchmark", "[global][!benchmark]")
+{
+    GlobalManager& manager = GlobalManager::instance();
+
+    // What every lookup paid before: a std::string built from the name and hashed
+    HashMap<std::string, TaskManager*> namedSubsystems{
+        { GlobalManager::TASK_MANAGER_NAME, manager.getSubsystem<TaskManager>(GlobalManager::TASK_MANAGER_NAME) }
+    };
+    BENCHMARK("std::string key lookup")
+    {
+        return namedSubsystems.find(std::string{ GlobalManager::TASK_MANAGER_NAME })->second;
+    };
+
+    BENCHMARK("getSubsystem by name")
+    {
+        return manager.getSubsystem<TaskManager>(GlobalManager::TASK_MANAGER_NAME);
+    };
+
+    BENCHMARK("APH_DEFAULT_TASK_MANAGER")
+    {
+        return &APH_DEFAULT_TASK_MANAGER;
+    };
+}
@@ -0,0 +1,376 @@
+#include "common/logger.h"
+#include "common/binaryLog.h"
+
+#include <algorithm>
+#include <atomic>
+#include <catch2/catch_all.hpp>
+#include <filesystem>
+#include <format>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using namespace aph;
+
+namespace
+{
+// Collects what a logger writes. The logger keeps its own copy of a sink, the state is shared with the test.
+struct CaptureSink
+{
+    struct State
+    {
+        std::mutex lock;
+        std::vector<std::string> messages;
+        // Holds the logging thread in write() to fill up the rings
+        std::atomic<bool> blocked{ false };
+        std::atomic<bool> entered{ false };
+    };
+
+    std::shared_ptr<State> pState = std::make_shared<State>();
+
+    void write(const std::string& msg)
+    {
+        pState->entered = true;
+        while (pState->blocked)
+        {
+            std::this_thread::yield();
+        }
+        std::lock_guard<std::mutex> lock{ pState->lock };
+        pState->messages.push_back(msg);
+    }
+
+    void flush()
+    {
+    }
+};
+
+auto createLogger(const CaptureSink& sink, const Logger::AsyncOptions& options) -> std::unique_ptr<Logger>
+{
+    auto pLogger = std::make_unique<Logger>();
+    pLogger->setEnableColor(false);
+    pLogger->addSink(CaptureSink{ sink });
+    pLogger->initialize();
+    pLogger->setAsync(options);
+    return pLogger;
+}
+} // namespace
+
+TEST_CASE("Async logger formats queued messages", "[logger]")
+{
+    CaptureSink sink;
+    auto pLogger = createLogger(sink, { .enabled = true });
+    REQUIRE(pLogger->isAsync());
+
+    {
+        // Strings are copied into the record, this one is gone before it is formatted
+        std::string text = "temporary";
+        pLogger->log(Logger::Level::Info, "[TEST] ", "%s %d %.1f %c", text, 42, 1.5, 'x');
+    }
+    pLogger->debug("untagged %u", 7u);
+    pLogger->setLogLevel(Logger::Level::Warn);
+    pLogger->info("filtered %d", 1);
+    pLogger->flush();
+
+    REQUIRE(sink.pState->messages ==
+            std::vector<std::string>{ " [I] [TEST] temporary 42 1.5 x\n", " [D] untagged 7\n" });
+}
+
+TEST_CASE("Async logger keeps the order of each thread", "[logger]")
+{
+    constexpr int threadCount  = 4;
+    constexpr int messageCount = 2000;
+
+    // A small ring wraps and fills up all the time
+    CaptureSink sink;
+    auto pLogger =
+        createLogger(sink, { .enabled = true, .ringSize = 1024, .overflowPolicy = Logger::OverflowPolicy::Block });
+
+    std::vector<std::thread> threads;
+    for (int thread = 0; thread < threadCount; thread++)
+    {
+        threads.emplace_back(
+            [&pLogger, thread]()
+            {
+                for (int i = 0; i < messageCount; i++)
+                {
+                    pLogger->info("%d %d", thread, i);
+                }
+            });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    pLogger->flush();
+
+    REQUIRE(pLogger->getDroppedCount() == 0);
+    REQUIRE(sink.pState->messages.size() == threadCount * messageCount);
+
+    std::vector<int> next(threadCount, 0);
+    for (const std::string& message : sink.pState->messages)
+    {
+        int thread = 0;
+        int i      = 0;
+        REQUIRE(std::sscanf(message.c_str(), " [I] %d %d", &thread, &i) == 2);
+        REQUIRE(i == next[thread]++);
+    }
+}
+
+TEST_CASE("Async logger drops messages when a ring is full", "[logger]")
+{
+    constexpr int messageCount = 200;
+
+    CaptureSink sink;
+    auto pLogger = createLogger(sink, { .enabled = true, .ringSize = 1024 });
+
+    sink.pState->blocked = true;
+    pLogger->info("first");
+    while (!sink.pState->entered)
+    {
+        std::this_thread::yield();
+    }
+
+    for (int i = 0; i < messageCount; i++)
+    {
+        pLogger->info("message %d", i);
+    }
+    sink.pState->blocked = false;
+    pLogger->flush();
+
+    const auto written = std::ranges::count_if(sink.pState->messages,
+                                               [](const std::string& message)
+                                               {
+                                                   return message.starts_with(" [I] message");
+                                               });
+    REQUIRE(pLogger->getDroppedCount() > 0);
+    REQUIRE(written + pLogger->getDroppedCount() == messageCount);
+    REQUIRE(std::ranges::any_of(sink.pState->messages,
+                                [](const std::string& message)
+                                {
+                                    return message.starts_with(" [W] [Logger] Dropped");
+                                }));
+}
+
+TEST_CASE("Async logger writes messages too large for a ring directly", "[logger]")
+{
+    CaptureSink sink;
+    auto pLogger = createLogger(sink, { .enabled = true, .ringSize = 1024 });
+
+    const std::string large(1000, 'x');
+    pLogger->info("small");
+    pLogger->info("%s", large);
+    pLogger->info("after");
+    pLogger->flush();
+
+    REQUIRE(sink.pState->messages.size() == 3);
+    REQUIRE(sink.pState->messages[0] == " [I] small\n");
+    REQUIRE(sink.pState->messages[1] == " [I] " + large + "\n");
+    REQUIRE(sink.pState->messages[2] == " [I] after\n");
+}
+
+TEST_CASE("Logger drains the rings when async mode is turned off", "[logger]")
+{
+    CaptureSink sink;
+    auto pLogger = createLogger(sink, { .enabled = true });
+
+    pLogger->warn("queued %d", 1);
+    pLogger->setAsync({ .enabled = false });
+    REQUIRE_FALSE(pLogger->isAsync());
+    pLogger->warn("direct %d", 2);
+
+    REQUIRE(sink.pState->messages == std::vector<std::string>{ " [W] queued 1\n", " [W] direct 2\n" });
+}
+
+TEST_CASE("Binary log files decode to the messages of the text sinks", "[logger]")
+{
+    const bool async = GENERATE(false, true);
+    const std::filesystem::path path =
+        std::filesystem::temp_directory_path() / (async ? "aph_logger_async.aphlog" : "aph_logger_sync.aphlog");
+
+    CaptureSink sink;
+    auto pLogger = createLogger(sink, { .enabled = async });
+    const auto before = std::chrono::system_clock::now();
+    pLogger->setBinaryLogFile(path.string());
+    REQUIRE(std::filesystem::exists(path));
+
+    int value = 0;
+    for (int i = 0; i < 3; i++)
+    {
+        pLogger->log(Logger::Level::Info, "[TEST] ", "%s %d %.1f %c", std::string(i + 1, 's'), -i, 1.5 * i, 'x');
+    }
+    pLogger->warn("%u %zu %lld %hhu %hd", 7u, std::size_t{ 1 } << 40, -(1LL << 40), uint8_t{ 200 }, int16_t{ -5 });
+    pLogger->error("[%-*d] [%5.2s] %x 100%%", 6, -42, "abc", 255u);
+    pLogger->debug("%p %s", static_cast<const void*>(&value), std::filesystem::path{ "a/b" });
+    pLogger->info("no arguments");
+    pLogger->setBinaryLogFile("");
+    const auto after = std::chrono::system_clock::now();
+
+    BinaryLogReader reader;
+    REQUIRE(reader.open(path).success());
+    std::vector<std::string> decoded;
+    std::vector<int64_t> times;
+    REQUIRE(reader
+                .read(
+                    [&](const BinaryLogMessage& message)
+                    {
+                        const char* levels[] = { "D", "I", "W", "E" };
+                        decoded.push_back(std::format(" [{}] {}{}\n", levels[static_cast<uint32_t>(message.level)],
+                                                      message.tag, formatBinaryLogMessage(message)));
+                        times.push_back(message.systemTime);
+                    })
+                .success());
+    std::filesystem::remove(path);
+
+    REQUIRE(decoded == sink.pState->messages);
+    REQUIRE(std::ranges::is_sorted(times));
+    const auto toNanoseconds = [](std::chrono::system_clock::time_point time)
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+    };
+    REQUIRE(times.front() >= toNanoseconds(before) - 1'000'000);
+    REQUIRE(times.back() <= toNanoseconds(after) + 1'000'000);
+}
+
+TEST_CASE("Binary log files store each format string once", "[logger]")
+{
+    constexpr int messageCount = 1000;
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "aph_logger_interned.aphlog";
+
+    CaptureSink sink;
+    auto pLogger = createLogger(sink, { .enabled = true });
+    pLogger->setTextOutput(false);
+    pLogger->setBinaryLogFile(path.string());
+    for (int i = 0; i < messageCount; i++)
+    {
+        pLogger->info("A fairly long message that is only written to the file once, number %d", i);
+    }
+    pLogger->setBinaryLogFile("");
+    REQUIRE(sink.pState->messages.empty());
+
+    // A record is its fixed header and the integer
+    const auto fileSize = std::filesystem::file_size(path);
+    REQUIRE(fileSize < messageCount * (sizeof(BinaryLogRecord) + sizeof(int)) + 1024);
+
+    BinaryLogReader reader;
+    REQUIRE(reader.open(path).success());
+    int count = 0;
+    REQUIRE(reader
+                .read(
+                    [&](const BinaryLogMessage& message)
+                    {
+                        REQUIRE(formatBinaryLogMessage(message) ==
+                                std::format("A fairly long message that is only written to the file once, number {}",
+                                            count++));
+                    })
+                .success());
+    REQUIRE(count == messageCount);
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("String views are logged up to their length", "[logger]")
+{
+    const bool async = GENERATE(false, true);
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "aph_logger_views.aphlog";
+
+    CaptureSink sink;
+    auto pLogger = createLogger(sink, { .enabled = async });
+    pLogger->setBinaryLogFile(path.string());
+
+    // Neither view is terminated where it ends
+    const std::string text = "first second";
+    const std::string_view first{ text.data(), 5 };
+    const std::string_view second{ text.data() + 6, 3 };
+    pLogger->info("'%s' '%5s' %d", first, second, 7);
+    pLogger->setBinaryLogFile("");
+
+    REQUIRE(sink.pState->messages == std::vector<std::string>{ " [I] 'first' '  sec' 7\n" });
+
+    BinaryLogReader reader;
+    REQUIRE(reader.open(path).success());
+    std::vector<std::string> decoded;
+    REQUIRE(reader
+                .read(
+                    [&](const BinaryLogMessage& message)
+                    {
+                        decoded.push_back(formatBinaryLogMessage(message));
+                    })
+                .success());
+    std::filesystem::remove(path);
+    REQUIRE(decoded == std::vector<std::string>{ "'first' '  sec' 7" });
+}
+
+TEST_CASE("Log format strings are checked against their arguments", "[logger]")
+{
+    // Mismatches fail to compile, so only the accepted cases can be tested here
+    STATIC_REQUIRE(detail::checkLogFormat<>("100%% done"));
+    STATIC_REQUIRE(detail::checkLogFormat<int, unsigned, std::size_t, long long>("%d %u %zu %lld"));
+    STATIC_REQUIRE(detail::checkLogFormat<int, int, double>("%-*.*f"));
+    STATIC_REQUIRE(detail::checkLogFormat<const char*, std::string, std::string_view, std::filesystem::path>(
+        "%s %s %s %s"));
+    STATIC_REQUIRE(detail::checkLogFormat<const char (&)[6], char, bool>("%s %c %d"));
+    STATIC_REQUIRE(detail::checkLogFormat<const void*, const char*, std::nullptr_t>("%p %p %p"));
+}
+
+TEST_CASE("Log macros only evaluate their arguments when the level is enabled", "[logger]")
+{
+    CaptureSink sink;
+    auto pLogger = createLogger(sink, {});
+    pLogger->setLogLevel(Logger::Level::Warn);
+    setActiveLogger(pLogger.get());
+
+    int evaluations = 0;
+    auto evaluate   = [&evaluations]()
+    {
+        return ++evaluations;
+    };
+    CM_LOG_DEBUG("debug %d", evaluate());
+    CM_LOG_WARN("warn %d", evaluate());
+    setActiveLogger(nullptr);
+
+    if constexpr (Logger::CompiledLevel <= Logger::Level::Warn)
+    {
+        REQUIRE(evaluations == 1);
+        REQUIRE(sink.pState->messages == std::vector<std::string>{ " [W] [CM] warn 1\n" });
+    }
+    else
+    {
+        REQUIRE(evaluations == 0);
+    }
+}
+
+TEST_CASE("Disabled log call benchmark", "[logger][!benchmark]")
+{
+    CaptureSink sink;
+    auto pLogger = createLogger(sink, {});
+    pLogger->setLogLevel(Logger::Level::Warn);
+    setActiveLogger(pLogger.get());
+
+    const std::string name = "gbuffer.albedo";
+    uint32_t index         = 0;
+
+    BENCHMARK("CM_LOG_DEBUG below the runtime level")
+    {
+        CM_LOG_DEBUG("Resource %s used by pass %u", name, index++);
+        return index;
+    };
+
+    // What every call paid before the level check, disabled or not
+    BENCHMARK("Combined tag format of the previous log functions")
+    {
+        std::string combined = std::format("[{}] {}", "CM", "Resource %s used by pass %u");
+        return combined.size();
+    };
+
+    pLogger->setLogLevel(Logger::Level::Debug);
+    pLogger->setAsync({ .enabled = true, .ringSize = 1024 * 1024 });
+    BENCHMARK("CM_LOG_DEBUG enabled, async")
+    {
+        CM_LOG_DEBUG("Resource %s used by pass %u", name, index++);
+        return index;
+    };
+
+    setActiveLogger(nullptr);
+}
@@ -2,8 +2,11 @@
 #include "allocator/polyObjectPool.h"
 #include "common/debug.h"
 
+#include <algorithm>
 #include <atomic>
 #include <catch2/catch_all.hpp>
+#include <format>
+#include <memory>
 #include <mutex>
 #include <thread>
 #include <vector>
@@ -145,6 +148,35 @@ private:
     float m_value;
 };
 
+// Puts the BaseClass subobject behind another base, so that base and derived pointers differ
+class PayloadBase
+{
+public:
+    virtual ~PayloadBase() = default;
+
+    double payload[4] = {};
+};
+
+class DerivedClassC : public PayloadBase, public BaseClass
+{
+public:
+    DerivedClassC(int val = 3)
+        : m_value(val)
+    {
+    }
+    int getType() const override
+    {
+        return 3;
+    }
+    int getIntValue() const override
+    {
+        return m_value;
+    }
+
+private:
+    int m_value;
+};
+
 // ObjectPool Tests
 TEST_CASE("ObjectPool basic functionality", "[objectpool]")
 {
@@ -409,3 +441,359 @@ TEST_CASE("ThreadSafePolymorphicObjectPool thread safety", "[polyobjectpool][thr
     // Ensure all allocations were properly destroyed
     REQUIRE(BaseClass::getConstructCount() == BaseClass::getDestructCount());
 }
+
+TEST_CASE("ObjectPool slot reuse and ownership", "[objectpool]")
+{
+    TestObject::resetStats();
+
+    {
+        ObjectPool<TestObject> pool;
+        ObjectPool<TestObject> otherPool;
+
+        // enough objects to span several chunks
+        std::vector<TestObject*> objects;
+        for (int i = 0; i < 10000; i++)
+        {
+            objects.push_back(pool.allocate(i));
+        }
+        for (int i = 0; i < 10000; i++)
+        {
+            REQUIRE(objects[i]->getValue() == i);
+        }
+
+        // freed slots are handed out again before the pool grows
+        TestObject* freed = objects[5000];
+        pool.free(freed);
+        objects[5000] = pool.allocate(-1);
+        REQUIRE(objects[5000] == freed);
+        REQUIRE(objects[5000]->getValue() == -1);
+
+        // pools never hand out each other's slots
+        TestObject* foreign = otherPool.allocate(42);
+        REQUIRE(pool.getAllocationCount() == 10000);
+        REQUIRE(otherPool.getAllocationCount() == 1);
+        REQUIRE(foreign->getValue() == 42);
+        otherPool.free(foreign);
+
+#ifdef APH_DEBUG
+        // debug builds reject pointers that never came from a pool without reading their chunk header
+        detail::PoolSlabAllocator<TestObject> slabs;
+        void* pSlot     = slabs.allocateSlot();
+        auto heapObject = std::make_unique<TestObject>(7);
+        REQUIRE(slabs.owns(pSlot));
+        REQUIRE_FALSE(slabs.owns(heapObject.get()));
+        REQUIRE_FALSE(slabs.owns(objects[1]));
+        slabs.freeSlot(pSlot);
+#endif
+
+        for (int i = 0; i < 10000; i += 2)
+        {
+            pool.free(objects[i]);
+        }
+        REQUIRE(pool.getAllocationCount() == 5000);
+
+        // clear destroys the survivors
+        pool.clear();
+        REQUIRE(pool.getAllocationCount() == 0);
+    }
+
+    REQUIRE(TestObject::getConstructCount() == TestObject::getDestructCount());
+}
+
+TEST_CASE("PolymorphicObjectPool slabs per derived type", "[polyobjectpool]")
+{
+    BaseClass::resetStats();
+
+    {
+        PolymorphicObjectPool<BaseClass> pool;
+        PolymorphicObjectPool<BaseClass> otherPool;
+
+        // Enough objects to span several chunks of every type
+        std::vector<BaseClass*> objects;
+        for (int i = 0; i < 9000; i++)
+        {
+            switch (i % 3)
+            {
+            case 0:
+                objects.push_back(pool.allocate<DerivedClassA>(i));
+                break;
+            case 1:
+                objects.push_back(pool.allocate<DerivedClassB>(static_cast<float>(i)));
+                break;
+            default:
+                objects.push_back(pool.allocate<DerivedClassC>(i));
+                break;
+            }
+        }
+        REQUIRE(static_cast<void*>(objects[2]) != static_cast<void*>(static_cast<DerivedClassC*>(objects[2])));
+        REQUIRE(otherPool.allocate<DerivedClassA>(7) != nullptr);
+
+        // Free every other object through its base pointer, the rest goes with clear()
+        for (size_t i = 0; i < objects.size(); i += 2)
+        {
+            REQUIRE(objects[i]->getType() == static_cast<int>(i % 3) + 1);
+            pool.free(objects[i]);
+        }
+        REQUIRE(pool.getAllocationCount() == objects.size() / 2);
+        REQUIRE(BaseClass::getDestructCount() == static_cast<int>(objects.size() / 2));
+
+        // Freed slots are reused by the same type
+        DerivedClassC* pReused = pool.allocate<DerivedClassC>(-1);
+        REQUIRE(std::find(objects.begin(), objects.end(), static_cast<BaseClass*>(pReused)) != objects.end());
+
+        pool.clear();
+        REQUIRE(pool.getAllocationCount() == 0);
+        REQUIRE(otherPool.getAllocationCount() == 1);
+        REQUIRE(BaseClass::getDestructCount() == BaseClass::getConstructCount() - 1);
+
+        // Slabs outlive clear()
+        BaseClass* pAfterClear = pool.allocate<DerivedClassC>(5);
+        REQUIRE(pAfterClear->getIntValue() == 5);
+        pool.free(pAfterClear);
+    }
+
+    REQUIRE(BaseClass::getConstructCount() == BaseClass::getDestructCount());
+}
+
+TEST_CASE("ObjectPool throughput benchmark", "[objectpool][!benchmark]")
+{
+    constexpr int batchSize = 1000;
+    std::vector<TestObject*> objects(batchSize);
+
+    BENCHMARK(std::format("new/delete, {} objects", batchSize))
+    {
+        for (int i = 0; i < batchSize; i++)
+        {
+            objects[i] = new TestObject(i);
+        }
+        for (int i = 0; i < batchSize; i++)
+        {
+            delete objects[i];
+        }
+        return objects[0];
+    };
+
+    ObjectPool<TestObject> pool;
+    BENCHMARK(std::format("ObjectPool, {} objects", batchSize))
+    {
+        for (int i = 0; i < batchSize; i++)
+        {
+            objects[i] = pool.allocate(i);
+        }
+        for (int i = 0; i < batchSize; i++)
+        {
+            pool.free(objects[i]);
+        }
+        return objects[0];
+    };
+
+    ThreadSafeObjectPool<TestObject> threadSafePool;
+    BENCHMARK(std::format("ThreadSafeObjectPool, {} objects", batchSize))
+    {
+        for (int i = 0; i < batchSize; i++)
+        {
+            objects[i] = threadSafePool.allocate(i);
+        }
+        for (int i = 0; i < batchSize; i++)
+        {
+            threadSafePool.free(objects[i]);
+        }
+        return objects[0];
+    };
+
+    // interleaved lifetimes, like command buffers and descriptor sets recycled every frame
+    BENCHMARK(std::format("ObjectPool churn, {} objects", batchSize))
+    {
+        for (int i = 0; i < batchSize; i++)
+        {
+            objects[i] = pool.allocate(i);
+        }
+        for (int round = 0; round < 4; round++)
+        {
+            for (int i = round; i < batchSize; i += 4)
+            {
+                pool.free(objects[i]);
+                objects[i] = pool.allocate(i);
+            }
+        }
+        for (int i = 0; i < batchSize; i++)
+        {
+            pool.free(objects[i]);
+        }
+        return objects[0];
+    };
+}
+
+TEST_CASE("ThreadSafeObjectPool thread caches", "[objectpool][threadsafe]")
+{
+    TestObject::resetStats();
+
+    {
+        ThreadSafeObjectPool<TestObject> pool;
+
+        SECTION("objects freed on another thread")
+        {
+            std::vector<TestObject*> objects;
+            for (int i = 0; i < 5000; i++)
+            {
+                objects.push_back(pool.allocate(i));
+            }
+            std::thread(
+                [&pool, &objects]()
+                {
+                    for (TestObject* obj : objects)
+                    {
+                        pool.free(obj);
+                    }
+                })
+                .join();
+            REQUIRE(pool.getAllocationCount() == 0);
+
+            // slots cached by the exited thread are handed back and reused
+            for (int i = 0; i < 5000; i++)
+            {
+                objects[i] = pool.allocate(i);
+            }
+            REQUIRE(pool.getAllocationCount() == 5000);
+            for (int i = 0; i < 5000; i++)
+            {
+                REQUIRE(objects[i]->getValue() == i);
+            }
+        }
+
+        SECTION("clear resets the thread caches")
+        {
+            for (int i = 0; i < 100; i++)
+            {
+                pool.allocate(i);
+            }
+            pool.clear();
+            REQUIRE(pool.getAllocationCount() == 0);
+
+            TestObject* obj = pool.allocate(7);
+            REQUIRE(obj->getValue() == 7);
+            REQUIRE(pool.getAllocationCount() == 1);
+        }
+    }
+
+    REQUIRE(TestObject::getConstructCount() == TestObject::getDestructCount());
+}
+
+TEST_CASE("ThreadSafeObjectPool contention benchmark", "[objectpool][threadsafe][!benchmark]")
+{
+    constexpr int batchSize = 1000;
+    constexpr int rounds    = 16;
+
+    // Baseline: the single-threaded pool behind one mutex
+    struct LockedObjectPool
+    {
+        TestObject* allocate(int value)
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            return pool.allocate(value);
+        }
+
+        void free(TestObject* ptr)
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            pool.free(ptr);
+        }
+
+        std::mutex mutex;
+        ObjectPool<TestObject> pool;
+    };
+
+    // Every thread allocates a batch and frees it again, half of it in a different order
+    auto churn = [](auto& pool, int numThreads)
+    {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < numThreads; t++)
+        {
+            threads.emplace_back(
+                [&pool]()
+                {
+                    std::vector<TestObject*> local(batchSize);
+                    for (int round = 0; round < rounds; round++)
+                    {
+                        for (int i = 0; i < batchSize; i++)
+                        {
+                            local[i] = pool.allocate(i);
+                        }
+                        for (int i = 0; i < batchSize; i += 2)
+                        {
+                            pool.free(local[i]);
+                        }
+                        for (int i = batchSize - 1; i > 0; i -= 2)
+                        {
+                            pool.free(local[i]);
+                        }
+                    }
+                });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    };
+
+    for (int numThreads : {1, 2, 4, 8, 16, 32})
+    {
+        LockedObjectPool lockedPool;
+        BENCHMARK(std::format("mutex pool, {} threads", numThreads))
+        {
+            churn(lockedPool, numThreads);
+        };
+
+        ThreadSafeObjectPool<TestObject> pool;
+        BENCHMARK(std::format("thread cached pool, {} threads", numThreads))
+        {
+            churn(pool, numThreads);
+        };
+    }
+}
+
+TEST_CASE("PolymorphicObjectPool rebuild benchmark", "[polyobjectpool][!benchmark]")
+{
+    // A widget tree torn down and rebuilt every frame
+    constexpr int batchSize = 1000;
+    std::vector<BaseClass*> objects(batchSize);
+
+    BENCHMARK(std::format("new/delete, {} objects", batchSize))
+    {
+        for (int i = 0; i < batchSize; i++)
+        {
+            objects[i] = i % 2 == 0 ? static_cast<BaseClass*>(new DerivedClassA(i)) : new DerivedClassB(1.0f);
+        }
+        for (int i = 0; i < batchSize; i++)
+        {
+            delete objects[i];
+        }
+        return objects[0];
+    };
+
+    PolymorphicObjectPool<BaseClass> pool;
+    BENCHMARK(std::format("PolymorphicObjectPool free, {} objects", batchSize))
+    {
+        for (int i = 0; i < batchSize; i++)
+        {
+            objects[i] = i % 2 == 0 ? static_cast<BaseClass*>(pool.allocate<DerivedClassA>(i))
+                                    : pool.allocate<DerivedClassB>(1.0f);
+        }
+        for (int i = 0; i < batchSize; i++)
+        {
+            pool.free(objects[i]);
+        }
+        return objects[0];
+    };
+
+    BENCHMARK(std::format("PolymorphicObjectPool clear, {} objects", batchSize))
+    {
+        for (int i = 0; i < batchSize; i++)
+        {
+            objects[i] = i % 2 == 0 ? static_cast<BaseClass*>(pool.allocate<DerivedClassA>(i))
+                                    : pool.allocate<DerivedClassB>(1.0f);
+        }
+        pool.clear();
+        return objects[0];
+    };
+}
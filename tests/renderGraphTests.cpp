@@ -0,0 +1,649 @@
+#include "renderGraph/renderGraph.h"
+#include "renderGraph/transientAllocator.h"
+
+#include <catch2/catch_all.hpp>
+#include <filesystem>
+#include <random>
+
+using namespace aph;
+using namespace Catch;
+
+namespace
+{
+auto createAttachmentInfo(uint32_t width, uint32_t height, Format format) -> RenderPassAttachmentInfo
+{
+    return { .createInfo = {
+                 .extent    = { width, height, 1 },
+                 .usage     = ImageUsage::ColorAttachment,
+                 .domain    = MemoryDomain::Device,
+                 .imageType = ImageType::e2D,
+                 .format    = format,
+             } };
+}
+
+auto sampledInput(const std::string& name) -> ImageResourceInfo
+{
+    return { .name = name, .resource = static_cast<vk::Image*>(nullptr), .usage = ImageUsage::Sampled };
+}
+} // namespace
+
+TEST_CASE("TransientAliasingAllocator placement", "[rendergraph][aliasing]")
+{
+    SECTION("Disjoint lifetimes share memory")
+    {
+        std::vector<TransientAllocationRequest> requests = {
+            { .size = 1024, .alignment = 256, .firstUsePassIndex = 0, .lastUsePassIndex = 1 },
+            { .size = 1024, .alignment = 256, .firstUsePassIndex = 2, .lastUsePassIndex = 3 },
+        };
+
+        auto plan = TransientAliasingAllocator::plan(requests);
+        REQUIRE(TransientAliasingAllocator::validate(requests, plan));
+        REQUIRE(plan.heaps.size() == 1);
+        REQUIRE(plan.placements[0].offset == plan.placements[1].offset);
+        REQUIRE(plan.naiveSize == 2048);
+        REQUIRE(plan.aliasedSize == 1024);
+        REQUIRE(plan.peakLiveSize == 1024);
+
+        // The second resource has to wait for the first one to be done with the memory
+        REQUIRE(plan.aliasing.size() == 1);
+        REQUIRE(plan.aliasing[0].request == 1);
+        REQUIRE(plan.aliasing[0].previousRequest == 0);
+    }
+
+    SECTION("Overlapping lifetimes never share memory")
+    {
+        std::vector<TransientAllocationRequest> requests = {
+            { .size = 1000, .alignment = 256, .firstUsePassIndex = 0, .lastUsePassIndex = 2 },
+            { .size = 1000, .alignment = 256, .firstUsePassIndex = 2, .lastUsePassIndex = 4 },
+        };
+
+        auto plan = TransientAliasingAllocator::plan(requests);
+        REQUIRE(TransientAliasingAllocator::validate(requests, plan));
+        REQUIRE(plan.placements[1].offset % 256 == 0);
+        REQUIRE(plan.aliasedSize == 1024 + 1000);
+        REQUIRE(plan.aliasing.empty());
+    }
+
+    SECTION("Best fit reuses the smallest hole")
+    {
+        // The small resource fits in the gap left behind by the medium one
+        std::vector<TransientAllocationRequest> requests = {
+            { .size = 4096, .alignment = 1, .firstUsePassIndex = 0, .lastUsePassIndex = 3 },
+            { .size = 2048, .alignment = 1, .firstUsePassIndex = 0, .lastUsePassIndex = 0 },
+            { .size = 1024, .alignment = 1, .firstUsePassIndex = 2, .lastUsePassIndex = 3 },
+        };
+
+        auto plan = TransientAliasingAllocator::plan(requests);
+        REQUIRE(TransientAliasingAllocator::validate(requests, plan));
+        REQUIRE(plan.aliasedSize == 4096 + 2048);
+        REQUIRE(plan.placements[2].offset == plan.placements[1].offset);
+    }
+
+    SECTION("Different heap keys are never aliased")
+    {
+        std::vector<TransientAllocationRequest> requests = {
+            { .size = 512, .firstUsePassIndex = 0, .lastUsePassIndex = 0, .heapKey = 0 },
+            { .size = 512, .firstUsePassIndex = 1, .lastUsePassIndex = 1, .heapKey = 1 },
+        };
+
+        auto plan = TransientAliasingAllocator::plan(requests);
+        REQUIRE(plan.heaps.size() == 2);
+        REQUIRE(plan.placements[0].heapIndex != plan.placements[1].heapIndex);
+        REQUIRE(plan.aliasedSize == plan.naiveSize);
+    }
+
+    SECTION("Requests of different queues are never aliased")
+    {
+        constexpr uint32_t MultiQueue = TransientAllocationRequest::MultiQueueKey;
+
+        std::vector<TransientAllocationRequest> requests = {
+            { .size = 512, .firstUsePassIndex = 0, .lastUsePassIndex = 0, .queueKey = 0 },
+            { .size = 512, .firstUsePassIndex = 1, .lastUsePassIndex = 1, .queueKey = 1 },
+            { .size = 512, .firstUsePassIndex = 2, .lastUsePassIndex = 2, .queueKey = MultiQueue },
+            { .size = 512, .firstUsePassIndex = 3, .lastUsePassIndex = 3, .queueKey = MultiQueue },
+        };
+
+        auto plan = TransientAliasingAllocator::plan(requests);
+        REQUIRE(TransientAliasingAllocator::validate(requests, plan));
+        REQUIRE(plan.heaps.size() == 1);
+        REQUIRE(plan.aliasedSize == plan.naiveSize);
+        REQUIRE(plan.aliasing.empty());
+    }
+
+    SECTION("Random workloads stay valid")
+    {
+        std::mt19937 rng{ 42 };
+        for (uint32_t iteration = 0; iteration < 200; ++iteration)
+        {
+            std::vector<TransientAllocationRequest> requests(rng() % 64);
+            for (auto& request : requests)
+            {
+                request.firstUsePassIndex = rng() % 32;
+                request.lastUsePassIndex  = request.firstUsePassIndex + rng() % 8;
+                request.size              = 1 + rng() % 4096;
+                request.alignment         = std::size_t{ 1 } << (rng() % 10);
+                request.heapKey           = rng() % 2;
+            }
+
+            auto plan = TransientAliasingAllocator::plan(requests);
+            REQUIRE(TransientAliasingAllocator::validate(requests, plan));
+            REQUIRE(plan.peakLiveSize <= plan.aliasedSize);
+        }
+    }
+}
+
+TEST_CASE("RenderGraph transient memory plan in dry run", "[rendergraph][aliasing]")
+{
+    auto result = RenderGraph::CreateDryRun();
+    REQUIRE(result.success());
+    RenderGraph* pGraph = result.value();
+    pGraph->enableDebugOutput(false);
+
+    auto colorInfo = createAttachmentInfo(1920, 1080, Format::RGBA8_UNORM);
+
+    auto* gbufferPass = pGraph->createPass("GBuffer", QueueType::Graphics);
+    gbufferPass->setColorOut("Albedo", colorInfo);
+    gbufferPass->setColorOut("Normal", colorInfo);
+
+    auto* lightingPass = pGraph->createPass("Lighting", QueueType::Graphics);
+    lightingPass->addTextureIn(sampledInput("Albedo"));
+    lightingPass->addTextureIn(sampledInput("Normal"));
+    lightingPass->setColorOut("Lit", colorInfo);
+
+    auto* postPass = pGraph->createPass("Post", QueueType::Graphics);
+    postPass->addTextureIn(sampledInput("Lit"));
+    postPass->setColorOut("Tonemapped", colorInfo);
+
+    auto* finalPass = pGraph->createPass("Final", QueueType::Graphics);
+    finalPass->addTextureIn(sampledInput("Tonemapped"));
+    finalPass->setColorOut("Final", colorInfo);
+
+    pGraph->setBackBuffer("Final");
+    pGraph->build();
+
+    const auto& plan = pGraph->getTransientMemoryPlan();
+    REQUIRE(plan.placements.size() == 4);
+    REQUIRE(plan.aliasedSize < plan.naiveSize);
+    REQUIRE(plan.peakLiveSize <= plan.aliasedSize);
+
+    // The back buffer is presented, it can't live in transient memory
+    REQUIRE(pGraph->getTransientPlacement("Final") == nullptr);
+
+    // The G-buffer is dead once tonemapping starts, so one of its targets gets reused
+    const auto* pTonemapped = pGraph->getTransientPlacement("Tonemapped");
+    const auto* pAlbedo     = pGraph->getTransientPlacement("Albedo");
+    const auto* pNormal     = pGraph->getTransientPlacement("Normal");
+    REQUIRE(pTonemapped != nullptr);
+    REQUIRE(pAlbedo != nullptr);
+    REQUIRE(pNormal != nullptr);
+    REQUIRE((pTonemapped->offset == pAlbedo->offset || pTonemapped->offset == pNormal->offset));
+
+    // Its first use waits for the reads of the G-buffer target it replaces
+    REQUIRE(plan.aliasing.size() == 1);
+    REQUIRE(pGraph->getBarrierStats().aliasingCount == 1);
+
+    SECTION("Aliasing can be disabled")
+    {
+        pGraph->setTransientAliasingEnabled(false);
+        pGraph->build();
+        REQUIRE(pGraph->getTransientMemoryPlan().placements.empty());
+        REQUIRE(pGraph->getTransientPlacement("Albedo") == nullptr);
+    }
+
+    RenderGraph::Destroy(pGraph);
+}
+
+TEST_CASE("RenderGraph culls passes that don't contribute to the output", "[rendergraph][culling]")
+{
+    auto result = RenderGraph::CreateDryRun();
+    REQUIRE(result.success());
+    RenderGraph* pGraph = result.value();
+    pGraph->enableDebugOutput(false);
+
+    auto colorInfo = createAttachmentInfo(1280, 720, Format::RGBA8_UNORM);
+
+    auto* scenePass = pGraph->createPass("Scene", QueueType::Graphics);
+    scenePass->setColorOut("SceneColor", colorInfo);
+
+    auto* debugPass = pGraph->createPass("Debug", QueueType::Graphics);
+    debugPass->addTextureIn(sampledInput("SceneColor"));
+    debugPass->setColorOut("DebugView", colorInfo);
+
+    auto* finalPass = pGraph->createPass("Final", QueueType::Graphics);
+    finalPass->addTextureIn(sampledInput("SceneColor"));
+    finalPass->setColorOut("Final", colorInfo);
+
+    pGraph->setBackBuffer("Final");
+
+    auto isScheduled = [pGraph](RenderPass* pass)
+    {
+        const auto& passes = pGraph->getSortedPasses();
+        return std::ranges::find(passes, pass) != passes.end();
+    };
+
+    pGraph->build();
+    REQUIRE(pGraph->getSortedPasses().size() == 2);
+    REQUIRE_FALSE(isScheduled(debugPass));
+    REQUIRE(pGraph->getCulledPasses().size() == 1);
+    REQUIRE(pGraph->getCulledPasses()[0] == debugPass);
+
+    // Culled passes don't keep their resources alive
+    REQUIRE(pGraph->getTransientPlacement("DebugView") == nullptr);
+
+    SECTION("Exported resources keep their producers alive")
+    {
+        pGraph->exportResource("DebugView");
+        pGraph->build();
+        REQUIRE(isScheduled(debugPass));
+        REQUIRE(pGraph->getCulledPasses().empty());
+    }
+
+    SECTION("Explicitly culled passes are removed with their exclusive producers")
+    {
+        finalPass->setCulled(true);
+        pGraph->build();
+        REQUIRE(pGraph->getSortedPasses().empty());
+        REQUIRE(pGraph->getCulledPasses().size() == 3);
+    }
+
+    SECTION("Conditional passes stay scheduled")
+    {
+        bool enabled = false;
+        finalPass->setExecutionCondition([&enabled]() { return enabled; });
+        pGraph->build();
+        REQUIRE(isScheduled(finalPass));
+        REQUIRE_FALSE(finalPass->shouldExecute());
+        enabled = true;
+        REQUIRE(finalPass->shouldExecute());
+    }
+
+    RenderGraph::Destroy(pGraph);
+}
+
+TEST_CASE("RenderGraph schedules passes across queues", "[rendergraph][multiqueue]")
+{
+    auto result = RenderGraph::CreateDryRun();
+    REQUIRE(result.success());
+    RenderGraph* pGraph = result.value();
+    pGraph->enableDebugOutput(false);
+
+    auto colorInfo = createAttachmentInfo(1280, 720, Format::RGBA8_UNORM);
+
+    auto findBatch = [pGraph](RenderPass* pass) -> uint32_t
+    {
+        const auto& batches = pGraph->getSubmissionBatches();
+        for (uint32_t index = 0; index < batches.size(); ++index)
+        {
+            if (std::ranges::find(batches[index].passes, pass) != batches[index].passes.end())
+            {
+                return index;
+            }
+        }
+        return UINT32_MAX;
+    };
+
+    SECTION("Single queue graphs are submitted as one batch")
+    {
+        auto* scenePass = pGraph->createPass("Scene", QueueType::Graphics);
+        scenePass->setColorOut("Scene", colorInfo);
+
+        auto* finalPass = pGraph->createPass("Final", QueueType::Graphics);
+        finalPass->addTextureIn(sampledInput("Scene"));
+        finalPass->setColorOut("Final", colorInfo);
+
+        pGraph->setBackBuffer("Final");
+        pGraph->build();
+
+        const auto& batches = pGraph->getSubmissionBatches();
+        REQUIRE(batches.size() == 1);
+        REQUIRE(batches[0].waitBatches.empty());
+        REQUIRE(batches[0].passes.size() == 2);
+        REQUIRE(batches[0].passes[0] == scenePass);
+    }
+
+    SECTION("Async compute only waits on real cross-queue dependencies")
+    {
+        auto* depthPass = pGraph->createPass("Depth", QueueType::Graphics);
+        depthPass->setColorOut("SceneDepth", colorInfo);
+
+        auto* cullingPass = pGraph->createPass("Culling", QueueType::Compute);
+        cullingPass->addTextureIn(sampledInput("SceneDepth"));
+        cullingPass->addBufferOut("DrawList");
+
+        auto* shadowPass = pGraph->createPass("Shadow", QueueType::Graphics);
+        shadowPass->setColorOut("ShadowMap", colorInfo);
+
+        auto* lightingPass = pGraph->createPass("Lighting", QueueType::Graphics);
+        lightingPass->addBufferIn(
+            { .name = "DrawList", .resource = static_cast<vk::Buffer*>(nullptr), .usage = BufferUsage::Storage });
+        lightingPass->addTextureIn(sampledInput("ShadowMap"));
+        lightingPass->setColorOut("Final", colorInfo);
+
+        pGraph->setBackBuffer("Final");
+        pGraph->build();
+
+        const auto& batches = pGraph->getSubmissionBatches();
+        uint32_t depthBatch    = findBatch(depthPass);
+        uint32_t cullingBatch  = findBatch(cullingPass);
+        uint32_t lightingBatch = findBatch(lightingPass);
+        REQUIRE(depthBatch != UINT32_MAX);
+        REQUIRE(cullingBatch != UINT32_MAX);
+        REQUIRE(lightingBatch != UINT32_MAX);
+
+        // Compute work is split out and synchronized with a single wait on each side
+        REQUIRE(batches[cullingBatch].queueType == QueueType::Compute);
+        REQUIRE(batches[cullingBatch].waitBatches.size() == 1);
+        REQUIRE(batches[cullingBatch].waitBatches[0] == depthBatch);
+        REQUIRE(batches[lightingBatch].waitBatches.size() == 1);
+        REQUIRE(batches[lightingBatch].waitBatches[0] == cullingBatch);
+        REQUIRE(depthBatch != lightingBatch);
+
+        // Semaphores are only used between queues
+        uint32_t waitCount = 0;
+        for (const auto& batch : batches)
+        {
+            for (uint32_t waitBatchIndex : batch.waitBatches)
+            {
+                REQUIRE(batches[waitBatchIndex].queueType != batch.queueType);
+                waitCount++;
+            }
+        }
+        REQUIRE(waitCount == 2);
+
+        // Batches of a queue signal consecutive timeline values
+        HashMap<QueueType, uint32_t> queueBatchCounts;
+        for (const auto& batch : batches)
+        {
+            REQUIRE(batch.queueBatchIndex == queueBatchCounts[batch.queueType]++);
+        }
+    }
+
+    SECTION("Resources used on several queues keep their own memory")
+    {
+        auto* depthPass = pGraph->createPass("Depth", QueueType::Graphics);
+        depthPass->setColorOut("SceneDepth", colorInfo);
+
+        auto* cullingPass = pGraph->createPass("Culling", QueueType::Compute);
+        cullingPass->addTextureIn(sampledInput("SceneDepth"));
+        cullingPass->addBufferOut("DrawList");
+
+        auto* lightingPass = pGraph->createPass("Lighting", QueueType::Graphics);
+        lightingPass->addBufferIn(
+            { .name = "DrawList", .resource = static_cast<vk::Buffer*>(nullptr), .usage = BufferUsage::Storage });
+        lightingPass->setColorOut("Lit", colorInfo);
+
+        auto* finalPass = pGraph->createPass("Final", QueueType::Graphics);
+        finalPass->addTextureIn(sampledInput("Lit"));
+        finalPass->setColorOut("Final", colorInfo);
+
+        pGraph->setBackBuffer("Final");
+        pGraph->build();
+
+        // Lit comes after the last use of SceneDepth in pass order, but the compute read isn't ordered with it
+        const auto* pSceneDepth = pGraph->getTransientPlacement("SceneDepth");
+        const auto* pLit        = pGraph->getTransientPlacement("Lit");
+        REQUIRE(pSceneDepth != nullptr);
+        REQUIRE(pLit != nullptr);
+        REQUIRE(pSceneDepth->offset != pLit->offset);
+        REQUIRE(pGraph->getTransientMemoryPlan().aliasing.empty());
+    }
+
+    RenderGraph::Destroy(pGraph);
+}
+
+TEST_CASE("RenderGraph batches barriers and skips redundant transitions", "[rendergraph][barrier]")
+{
+    auto result = RenderGraph::CreateDryRun();
+    REQUIRE(result.success());
+    RenderGraph* pGraph = result.value();
+    pGraph->enableDebugOutput(false);
+
+    auto colorInfo = createAttachmentInfo(1280, 720, Format::RGBA8_UNORM);
+
+    auto* scenePass = pGraph->createPass("Scene", QueueType::Graphics);
+    scenePass->setColorOut("SceneColor", colorInfo);
+
+    auto* bloomPass = pGraph->createPass("Bloom", QueueType::Graphics);
+    bloomPass->addTextureIn(sampledInput("SceneColor"));
+    bloomPass->setColorOut("Bloom", colorInfo);
+
+    auto* finalPass = pGraph->createPass("Final", QueueType::Graphics);
+    finalPass->addTextureIn(sampledInput("SceneColor"));
+    finalPass->addTextureIn(sampledInput("Bloom"));
+    finalPass->setColorOut("Final", colorInfo);
+
+    pGraph->setBackBuffer("Final");
+    pGraph->build();
+
+    // Scene: SceneColor -> RT
+    // Bloom: Bloom -> RT, SceneColor RT -> SR
+    // Final: Final -> RT, Bloom RT -> SR, SceneColor is already readable
+    const auto& stats = pGraph->getBarrierStats();
+    REQUIRE(stats.barrierCount == 5);
+    REQUIRE(stats.batchCount == 3);
+    REQUIRE(stats.skippedCount == 1);
+
+    RenderGraph::Destroy(pGraph);
+}
+
+TEST_CASE("RenderGraph re-records only dirty passes", "[rendergraph][incremental]")
+{
+    auto result = RenderGraph::CreateDryRun();
+    REQUIRE(result.success());
+    RenderGraph* pGraph = result.value();
+    pGraph->enableDebugOutput(false);
+
+    auto colorInfo = createAttachmentInfo(1280, 720, Format::RGBA8_UNORM);
+
+    auto* scenePass = pGraph->createPass("Scene", QueueType::Graphics);
+    scenePass->setColorOut("SceneColor", colorInfo);
+    scenePass->recordExecute([](auto*) {});
+
+    auto* bloomPass = pGraph->createPass("Bloom", QueueType::Graphics);
+    bloomPass->addTextureIn(sampledInput("SceneColor"));
+    bloomPass->setColorOut("Bloom", colorInfo);
+
+    auto* finalPass = pGraph->createPass("Final", QueueType::Graphics);
+    finalPass->addTextureIn(sampledInput("Bloom"));
+    finalPass->setColorOut("Final", colorInfo);
+
+    pGraph->setBackBuffer("Final");
+    pGraph->build();
+    REQUIRE(pGraph->getRecordedPassCount() == 3);
+
+    SECTION("Clean graphs keep their recorded commands")
+    {
+        pGraph->build();
+        REQUIRE(pGraph->getRecordedPassCount() == 3);
+        REQUIRE(pGraph->getSortedPasses().size() == 3);
+    }
+
+    SECTION("Command changes only re-record their pass")
+    {
+        bloomPass->configure().resetExecute().execute([](auto*) {});
+        pGraph->build();
+        REQUIRE(pGraph->getRecordedPassCount() == 1);
+        REQUIRE(pGraph->getBarrierStats().barrierCount == 5);
+    }
+
+    SECTION("Structural changes rebuild the whole graph")
+    {
+        bloomPass->recordExecute([](auto*) {});
+        finalPass->addTextureIn(sampledInput("SceneColor"));
+        pGraph->build();
+        REQUIRE(pGraph->getRecordedPassCount() == 3);
+    }
+
+    RenderGraph::Destroy(pGraph);
+}
+
+TEST_CASE("RenderGraph compiled graph snapshots round-trip in dry run", "[rendergraph][snapshot]")
+{
+    auto colorInfo = createAttachmentInfo(1280, 720, Format::RGBA8_UNORM);
+
+    auto createGraph = [&colorInfo](bool withDebugPass) -> RenderGraph*
+    {
+        auto result = RenderGraph::CreateDryRun();
+        REQUIRE(result.success());
+        RenderGraph* pGraph = result.value();
+        pGraph->enableDebugOutput(false);
+
+        auto* depthPass = pGraph->createPass("Depth", QueueType::Graphics);
+        depthPass->setColorOut("SceneDepth", colorInfo);
+
+        auto* cullingPass = pGraph->createPass("Culling", QueueType::Compute);
+        cullingPass->addTextureIn(sampledInput("SceneDepth"));
+        cullingPass->addBufferOut("DrawList");
+
+        auto* lightingPass = pGraph->createPass("Lighting", QueueType::Graphics);
+        lightingPass->addBufferIn(
+            { .name = "DrawList", .resource = static_cast<vk::Buffer*>(nullptr), .usage = BufferUsage::Storage });
+        lightingPass->addTextureIn(sampledInput("SceneDepth"));
+        lightingPass->setColorOut("Final", colorInfo);
+
+        auto* unusedPass = pGraph->createPass("Unused", QueueType::Graphics);
+        unusedPass->addTextureIn(sampledInput("SceneDepth"));
+        unusedPass->setColorOut("UnusedColor", colorInfo);
+
+        if (withDebugPass)
+        {
+            auto* debugPass = pGraph->createPass("Debug", QueueType::Graphics);
+            debugPass->addTextureIn(sampledInput("Final"));
+            debugPass->setColorOut("DebugView", colorInfo);
+            pGraph->exportResource("DebugView");
+        }
+
+        pGraph->setBackBuffer("Final");
+        return pGraph;
+    };
+
+    RenderGraph* pSource = createGraph(false);
+    pSource->build();
+    REQUIRE_FALSE(pSource->isCompiledGraphApplied());
+
+    auto bytes        = pSource->getCompiledGraph().serialize();
+    auto loadedResult = CompiledGraph::Deserialize(bytes);
+    REQUIRE(loadedResult.success());
+    REQUIRE(loadedResult.value().hash == pSource->getGraphHash());
+
+    SECTION("Identical declarations skip compilation")
+    {
+        RenderGraph* pGraph = createGraph(false);
+        REQUIRE(pGraph->getGraphHash() == pSource->getGraphHash());
+        pGraph->setCompiledGraph(std::move(loadedResult.value()));
+        pGraph->build();
+        REQUIRE(pGraph->isCompiledGraphApplied());
+
+        const auto& sortedPasses = pGraph->getSortedPasses();
+        REQUIRE(sortedPasses.size() == 3);
+        REQUIRE(sortedPasses[0] == pGraph->getPass("Depth"));
+        REQUIRE(sortedPasses[1] == pGraph->getPass("Culling"));
+        REQUIRE(sortedPasses[2] == pGraph->getPass("Lighting"));
+        REQUIRE(pGraph->getCulledPasses().size() == 1);
+        REQUIRE(pGraph->getCulledPasses()[0] == pGraph->getPass("Unused"));
+        REQUIRE(pGraph->getSubmissionBatches().size() == pSource->getSubmissionBatches().size());
+        REQUIRE(pGraph->getBarrierStats().barrierCount == pSource->getBarrierStats().barrierCount);
+        REQUIRE(pGraph->getBarrierStats().skippedCount == pSource->getBarrierStats().skippedCount);
+        REQUIRE(pGraph->getBarrierStats().aliasingCount == pSource->getBarrierStats().aliasingCount);
+        REQUIRE(pGraph->getTransientMemoryPlan().aliasedSize == pSource->getTransientMemoryPlan().aliasedSize);
+
+        // Taking a snapshot of the restored graph gives back the same bytes
+        REQUIRE(pGraph->getCompiledGraph().serialize() == bytes);
+
+        RenderGraph::Destroy(pGraph);
+    }
+
+    SECTION("Changed declarations are compiled from scratch")
+    {
+        RenderGraph* pGraph = createGraph(true);
+        REQUIRE(pGraph->getGraphHash() != pSource->getGraphHash());
+        pGraph->setCompiledGraph(std::move(loadedResult.value()));
+        pGraph->build();
+        REQUIRE_FALSE(pGraph->isCompiledGraphApplied());
+        REQUIRE(pGraph->getSortedPasses().size() == pSource->getSortedPasses().size() + 1);
+
+        RenderGraph::Destroy(pGraph);
+    }
+
+    SECTION("Truncated data is rejected")
+    {
+        bytes.resize(bytes.size() / 2);
+        REQUIRE_FALSE(CompiledGraph::Deserialize(bytes).success());
+    }
+
+    SECTION("The graph cache serves later builds of the same declaration")
+    {
+        const auto cacheDirectory = (std::filesystem::temp_directory_path() / "aph_graph_cache_test").string();
+        std::error_code error;
+        std::filesystem::remove_all(cacheDirectory, error);
+
+        RenderGraph* pFirst = createGraph(false);
+        pFirst->setCompiledGraphCache(cacheDirectory);
+        pFirst->build();
+        REQUIRE_FALSE(pFirst->isCompiledGraphApplied());
+
+        RenderGraph* pSecond = createGraph(false);
+        pSecond->setCompiledGraphCache(cacheDirectory);
+        pSecond->build();
+        REQUIRE(pSecond->isCompiledGraphApplied());
+        REQUIRE(pSecond->getCompiledGraph().serialize() == bytes);
+
+        RenderGraph* pChanged = createGraph(true);
+        pChanged->setCompiledGraphCache(cacheDirectory);
+        pChanged->build();
+        REQUIRE_FALSE(pChanged->isCompiledGraphApplied());
+
+        // One snapshot per declaration
+        const auto fileCount = std::ranges::distance(std::filesystem::directory_iterator{ cacheDirectory });
+        REQUIRE(fileCount == 2);
+
+        RenderGraph::Destroy(pChanged);
+        RenderGraph::Destroy(pSecond);
+        RenderGraph::Destroy(pFirst);
+        std::filesystem::remove_all(cacheDirectory, error);
+    }
+
+    RenderGraph::Destroy(pSource);
+}
+
+TEST_CASE("RenderGraph build benchmark", "[rendergraph][incremental][!benchmark]")
+{
+    auto colorInfo = createAttachmentInfo(64, 64, Format::RGBA8_UNORM);
+
+    for (uint32_t passCount : { 10U, 100U, 1000U })
+    {
+        auto result = RenderGraph::CreateDryRun();
+        REQUIRE(result.success());
+        RenderGraph* pGraph = result.value();
+        pGraph->enableDebugOutput(false);
+
+        // A chain where every pass samples the output of the previous one
+        std::vector<RenderPass*> passes;
+        for (uint32_t index = 0; index < passCount; ++index)
+        {
+            auto* pass = pGraph->createPass(std::format("Pass{}", index), QueueType::Graphics);
+            if (index > 0)
+            {
+                pass->addTextureIn(sampledInput(std::format("Color{}", index - 1)));
+            }
+            pass->setColorOut(std::format("Color{}", index), colorInfo);
+            passes.push_back(pass);
+        }
+        pGraph->setBackBuffer(std::format("Color{}", passCount - 1));
+        pGraph->build();
+
+        BENCHMARK(std::format("full build, {} passes", passCount))
+        {
+            passes.back()->setCulled(false);
+            pGraph->build();
+        };
+
+        BENCHMARK(std::format("single pass command change, {} passes", passCount))
+        {
+            passes[passCount / 2]->recordExecute([](auto*) {});
+            pGraph->build();
+        };
+
+        RenderGraph::Destroy(pGraph);
+    }
+}
@@ -0,0 +1,191 @@
+#include "resource/residencyManager.h"
+
+#include <catch2/catch_all.hpp>
+#include <cstdint>
+#include <vector>
+
+using namespace aph;
+
+namespace
+{
+// Stand-in for loaded assets, only the addresses matter
+struct FakeResource
+{
+    int id;
+};
+} // namespace
+
+TEST_CASE("ResidencyManager accounting", "[resource][residency]")
+{
+    ResidencyManager residency{ { .protectedFrameCount = 0 } };
+    FakeResource a{ 0 }, b{ 1 }, c{ 2 };
+
+    residency.track(&a, ResidencyClass::Image, 100, 1000, {});
+    residency.track(&b, ResidencyClass::Image, 0, 2000, {});
+    residency.track(&c, ResidencyClass::Geometry, 50, 500, {});
+
+    auto stats = residency.getStats();
+    REQUIRE(stats[ResidencyClass::Image].residentCount == 2);
+    REQUIRE(stats[ResidencyClass::Image].cpuBytes == 100);
+    REQUIRE(stats[ResidencyClass::Image].gpuBytes == 3000);
+    REQUIRE(stats[ResidencyClass::Geometry].gpuBytes == 500);
+    REQUIRE(stats.cpuBytes == 150);
+    REQUIRE(stats.gpuBytes == 3500);
+
+    REQUIRE(residency.untrack(&a));
+    REQUIRE_FALSE(residency.untrack(&a));
+    REQUIRE_FALSE(residency.isTracked(&a));
+    stats = residency.getStats();
+    REQUIRE(stats[ResidencyClass::Image].residentCount == 1);
+    REQUIRE(stats[ResidencyClass::Image].gpuBytes == 2000);
+
+    // Nothing has a budget, nothing goes
+    REQUIRE(residency.evict() == 0);
+}
+
+TEST_CASE("ResidencyManager eviction", "[resource][residency]")
+{
+    constexpr std::size_t imageSize = 1024;
+    ResidencyManager residency{ { .protectedFrameCount = 2 } };
+    residency.setBudget(ResidencyClass::Image, { .gpuBytes = 4 * imageSize });
+
+    std::vector<FakeResource> images(8);
+    std::vector<int> evicted;
+    auto trackImage = [&](int id)
+    {
+        images[id].id = id;
+        residency.track(&images[id], ResidencyClass::Image, 0, imageSize,
+                        [&evicted, id]()
+                        {
+                            evicted.push_back(id);
+                        });
+    };
+
+    SECTION("least recently used go first")
+    {
+        for (int id = 0; id < 6; id++)
+        {
+            trackImage(id);
+        }
+        residency.nextFrame();
+        residency.nextFrame();
+
+        // 1 is still in use, 0 and 2 are the oldest after it
+        residency.touch(&images[1]);
+        REQUIRE(residency.isOverBudget(ResidencyClass::Image));
+        REQUIRE(residency.evict() == 2);
+        REQUIRE(evicted == std::vector<int>{ 0, 2 });
+        REQUIRE_FALSE(residency.isOverBudget(ResidencyClass::Image));
+
+        auto stats = residency.getStats();
+        REQUIRE(stats[ResidencyClass::Image].gpuBytes == 4 * imageSize);
+        REQUIRE(stats[ResidencyClass::Image].evictionCount == 2);
+        REQUIRE(stats[ResidencyClass::Image].evictedGpuBytes == 2 * imageSize);
+    }
+
+    SECTION("recently used and pinned resources are protected")
+    {
+        for (int id = 0; id < 6; id++)
+        {
+            trackImage(id);
+        }
+
+        // Everything was used this frame, the class stays over budget for now
+        REQUIRE(residency.evict() == 0);
+        REQUIRE(residency.isOverBudget(ResidencyClass::Image));
+
+        residency.nextFrame();
+        REQUIRE(residency.evict() == 0);
+
+        REQUIRE(residency.pin(&images[0]));
+        residency.nextFrame();
+        REQUIRE(residency.evict() == 2);
+        REQUIRE(evicted == std::vector<int>{ 1, 2 });
+
+        // Once unpinned it counts as just used
+        residency.unpin(&images[0]);
+        trackImage(6);
+        residency.nextFrame();
+        residency.nextFrame();
+        REQUIRE(residency.evict() == 1);
+        REQUIRE(evicted == std::vector<int>{ 1, 2, 3 });
+    }
+
+    SECTION("only over budget classes and sides are evicted")
+    {
+        FakeResource geometry{}, shader{};
+        residency.track(&geometry, ResidencyClass::Geometry, 0, 100 * imageSize, {});
+        residency.track(&shader, ResidencyClass::Shader, 100, 0, {});
+        for (int id = 0; id < 6; id++)
+        {
+            trackImage(id);
+        }
+        // CPU only images can't bring the GPU side down
+        FakeResource cpuOnly{};
+        residency.track(&cpuOnly, ResidencyClass::Image, 4096, 0, {});
+        residency.touch(&images[0]);
+        residency.nextFrame();
+        residency.nextFrame();
+
+        REQUIRE(residency.evict() == 2);
+        REQUIRE(evicted == std::vector<int>{ 1, 2 });
+        REQUIRE(residency.isTracked(&cpuOnly));
+        REQUIRE(residency.isTracked(&geometry));
+        REQUIRE(residency.isTracked(&shader));
+    }
+}
+
+TEST_CASE("ResidencyManager keeps resources whose use was never reported", "[resource][residency]")
+{
+    ResidencyManager residency{ { .protectedFrameCount = 1 } };
+    residency.setBudget(ResidencyClass::Geometry, { .gpuBytes = 100 });
+
+    FakeResource drawn{}, untouched{};
+    std::vector<const FakeResource*> evicted;
+    for (FakeResource* pResource : { &drawn, &untouched })
+    {
+        residency.track(
+            pResource, ResidencyClass::Geometry, 0, 80,
+            [&evicted, pResource]()
+            {
+                evicted.push_back(pResource);
+            },
+            true);
+    }
+    residency.nextFrame();
+    residency.nextFrame();
+
+    // Nobody said whether they are still drawn, so neither can go
+    REQUIRE(residency.evict() == 0);
+    REQUIRE(residency.isOverBudget(ResidencyClass::Geometry));
+
+    // Once touched, the usual protection window applies
+    residency.touch(&drawn);
+    REQUIRE(residency.evict() == 0);
+    residency.nextFrame();
+    REQUIRE(residency.evict() == 1);
+    REQUIRE(evicted == std::vector<const FakeResource*>{ &drawn });
+    REQUIRE(residency.isTracked(&untouched));
+}
+
+TEST_CASE("ResidencyManager eviction callbacks can reenter", "[resource][residency]")
+{
+    ResidencyManager residency{ { .protectedFrameCount = 0 } };
+    residency.setBudget(ResidencyClass::ImageData, { .cpuBytes = 100 });
+
+    FakeResource a{}, b{};
+    bool untracked = true;
+    residency.track(&a, ResidencyClass::ImageData, 80, 0,
+                    [&]()
+                    {
+                        // Like ResourceLoader::unLoad() would
+                        untracked = residency.untrack(&a);
+                        residency.touch(&b);
+                    });
+    residency.track(&b, ResidencyClass::ImageData, 80, 0, {});
+
+    REQUIRE(residency.evict() == 1);
+    REQUIRE_FALSE(untracked);
+    REQUIRE_FALSE(residency.pin(&a));
+    REQUIRE(residency.getStats()[ResidencyClass::ImageData].cpuBytes == 80);
+}
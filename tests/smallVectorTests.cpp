@@ -0,0 +1,427 @@
+#include "common/smallVector.h"
+
+#include <algorithm>
+#include <catch2/catch_all.hpp>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <ranges>
+#include <string>
+#include <vector>
+
+using namespace aph;
+
+namespace
+{
+// Counts live objects to catch leaked or doubly destroyed elements
+struct Tracked
+{
+    inline static int s_aliveCount = 0;
+
+    Tracked(int value = 0)
+        : value(value)
+    {
+        s_aliveCount++;
+    }
+
+    Tracked(const Tracked& other)
+        : value(other.value)
+    {
+        s_aliveCount++;
+    }
+
+    Tracked(Tracked&& other) noexcept
+        : value(other.value)
+    {
+        other.value = -1;
+        s_aliveCount++;
+    }
+
+    Tracked& operator=(const Tracked&) = default;
+    Tracked& operator=(Tracked&&)      = default;
+
+    ~Tracked()
+    {
+        s_aliveCount--;
+    }
+
+    bool operator==(const Tracked& other) const = default;
+
+    int value;
+};
+
+// The std::vector based implementation SmallVector replaced, kept as the benchmark baseline
+template <typename T, size_t MaxSize = 8, typename NonReboundT = T>
+struct LegacySmallBufferAllocator
+{
+    alignas(alignof(T)) std::byte m_smallBuffer[MaxSize * sizeof(T)];
+    std::allocator<T> m_alloc{};
+    bool m_smallBufferUsed = false;
+
+    using value_type                             = T;
+    using propagate_on_container_move_assignment = std::false_type;
+    using propagate_on_container_swap            = std::false_type;
+    using is_always_equal                        = std::false_type;
+
+    constexpr LegacySmallBufferAllocator() noexcept = default;
+
+    template <class U>
+    constexpr LegacySmallBufferAllocator(const LegacySmallBufferAllocator<U, MaxSize, NonReboundT>&) noexcept
+    {
+    }
+
+    template <class U>
+    struct rebind
+    {
+        using other = LegacySmallBufferAllocator<U, MaxSize, NonReboundT>;
+    };
+
+    constexpr LegacySmallBufferAllocator(const LegacySmallBufferAllocator& other) noexcept
+        : m_smallBufferUsed(other.m_smallBufferUsed)
+    {
+    }
+
+    constexpr LegacySmallBufferAllocator& operator=(const LegacySmallBufferAllocator& other) noexcept
+    {
+        m_smallBufferUsed = other.m_smallBufferUsed;
+        return *this;
+    }
+
+    constexpr LegacySmallBufferAllocator(LegacySmallBufferAllocator&&) noexcept
+    {
+    }
+
+    [[nodiscard]] constexpr T* allocate(const size_t n)
+    {
+        if constexpr (std::is_same_v<T, NonReboundT>)
+        {
+            if (n <= MaxSize)
+            {
+                m_smallBufferUsed = true;
+                return reinterpret_cast<T*>(&m_smallBuffer);
+            }
+        }
+        m_smallBufferUsed = false;
+        return m_alloc.allocate(n);
+    }
+
+    constexpr void deallocate(void* p, const size_t n)
+    {
+        if (&m_smallBuffer != p)
+        {
+            m_alloc.deallocate(static_cast<T*>(p), n);
+        }
+        m_smallBufferUsed = false;
+    }
+
+    friend constexpr bool operator==(const LegacySmallBufferAllocator& lhs, const LegacySmallBufferAllocator& rhs)
+    {
+        return !lhs.m_smallBufferUsed && !rhs.m_smallBufferUsed;
+    }
+};
+
+template <typename T, size_t N = 8>
+class LegacySmallVector : public std::vector<T, LegacySmallBufferAllocator<T, N>>
+{
+public:
+    using vec = std::vector<T, LegacySmallBufferAllocator<T, N>>;
+
+    LegacySmallVector() noexcept
+    {
+        vec::reserve(N);
+    }
+
+    LegacySmallVector(LegacySmallVector&& other) noexcept
+    {
+        if (other.size() <= N)
+        {
+            vec::reserve(N);
+        }
+        vec::operator=(std::move(other));
+    }
+
+    LegacySmallVector& operator=(LegacySmallVector&& other) noexcept
+    {
+        if (other.size() <= N)
+        {
+            vec::reserve(N);
+        }
+        vec::operator=(std::move(other));
+        return *this;
+    }
+};
+
+// Compares a SmallVector against std::vector over random edits
+template <typename T, size_t N, typename MakeValue>
+void checkAgainstStdVector(MakeValue&& makeValue)
+{
+    std::mt19937 rng{ 7 };
+    SmallVector<T, N> small;
+    std::vector<T> reference;
+
+    for (int step = 0; step < 2000; step++)
+    {
+        const auto op    = rng() % 9;
+        const size_t pos = reference.empty() ? 0 : rng() % (reference.size() + 1);
+        const T value    = makeValue(step);
+        switch (op)
+        {
+        case 0:
+        case 1:
+            small.push_back(value);
+            reference.push_back(value);
+            break;
+        case 2:
+            small.insert(small.begin() + pos, value);
+            reference.insert(reference.begin() + pos, value);
+            break;
+        case 3:
+            small.insert(small.begin() + pos, 3, value);
+            reference.insert(reference.begin() + pos, 3, value);
+            break;
+        case 4:
+            if (pos < reference.size())
+            {
+                const size_t last = std::min(reference.size(), pos + rng() % 4);
+                small.erase(small.begin() + pos, small.begin() + last);
+                reference.erase(reference.begin() + pos, reference.begin() + last);
+            }
+            break;
+        case 5:
+            if (!reference.empty())
+            {
+                small.pop_back();
+                reference.pop_back();
+            }
+            break;
+        case 6:
+        {
+            const size_t count = rng() % 24;
+            small.resize(count, value);
+            reference.resize(count, value);
+            break;
+        }
+        case 7:
+            // Copies of elements of the vector itself, which move while they are inserted
+            if (!reference.empty())
+            {
+                small.push_back(small.front());
+                reference.push_back(reference.front());
+                small.insert(small.begin() + pos, small.back());
+                reference.insert(reference.begin() + pos, reference.back());
+            }
+            break;
+        case 8:
+        {
+            SmallVector<T, N> moved{ std::move(small) };
+            REQUIRE(small.empty());
+            small = rng() % 2 ? std::move(moved) : moved;
+            if (rng() % 4 == 0)
+            {
+                small.shrink_to_fit();
+            }
+            break;
+        }
+        }
+
+        REQUIRE(small.size() == reference.size());
+        REQUIRE(std::equal(small.begin(), small.end(), reference.begin(), reference.end()));
+    }
+}
+} // namespace
+
+TEST_CASE("SmallVector layout", "[common][smallvector]")
+{
+    constexpr size_t headerSize = sizeof(void*) + 2 * sizeof(uint32_t);
+    STATIC_REQUIRE(sizeof(SmallVector<uint32_t, 0>) == headerSize);
+    STATIC_REQUIRE(sizeof(SmallVector<uint32_t, 4>) == headerSize + 4 * sizeof(uint32_t));
+    STATIC_REQUIRE(sizeof(SmallVector<uint64_t, 2>) == headerSize + 2 * sizeof(uint64_t));
+    STATIC_REQUIRE(std::is_nothrow_move_constructible_v<SmallVector<std::unique_ptr<int>>>);
+    STATIC_REQUIRE(std::ranges::contiguous_range<SmallVector<int>>);
+}
+
+TEST_CASE("SmallVector inline and heap storage", "[common][smallvector]")
+{
+    SmallVector<int, 4> values;
+    REQUIRE(values.isInline());
+    REQUIRE(values.capacity() == 4);
+
+    for (int i = 0; i < 4; i++)
+    {
+        values.push_back(i);
+    }
+    REQUIRE(values.isInline());
+
+    // Pushing an element of the vector itself while it grows
+    values.push_back(values[0]);
+    REQUIRE_FALSE(values.isInline());
+    REQUIRE(values == SmallVector<int, 4>{ 0, 1, 2, 3, 0 });
+
+    SECTION("moving a heap vector takes its buffer")
+    {
+        const int* pData = values.data();
+        SmallVector<int, 4> moved{ std::move(values) };
+        REQUIRE(moved.data() == pData);
+        REQUIRE(values.empty());
+        REQUIRE(values.isInline());
+    }
+
+    SECTION("shrinking moves back inline")
+    {
+        values.resize(2);
+        values.shrink_to_fit();
+        REQUIRE(values.isInline());
+        REQUIRE(values == SmallVector<int, 4>{ 0, 1 });
+    }
+
+    SECTION("count constructors")
+    {
+        SmallVector<int, 4> zeros(6);
+        REQUIRE(zeros.size() == 6);
+        REQUIRE(std::ranges::all_of(zeros, [](int value) { return value == 0; }));
+
+        SmallVector<int, 4> sevens(3, 7);
+        REQUIRE(sevens == SmallVector<int, 4>{ 7, 7, 7 });
+        REQUIRE(erase_if(sevens, [](int value) { return value == 7; }) == 3);
+        REQUIRE(sevens.empty());
+    }
+}
+
+TEST_CASE("SmallVector element lifetimes", "[common][smallvector]")
+{
+    Tracked::s_aliveCount = 0;
+    {
+        SmallVector<Tracked, 3> a{ 1, 2 };
+        SmallVector<Tracked, 3> b;
+        for (int i = 0; i < 10; i++)
+        {
+            b.emplace_back(i);
+        }
+        REQUIRE(Tracked::s_aliveCount == 12);
+
+        // Inline elements are moved one by one, heap buffers change hands
+        swap(a, b);
+        REQUIRE(a.size() == 10);
+        REQUIRE(b == SmallVector<Tracked, 3>{ 1, 2 });
+        REQUIRE(Tracked::s_aliveCount == 12);
+
+        a.erase(a.begin() + 2, a.begin() + 5);
+        a.insert(a.begin() + 1, { 20, 21 });
+        a.emplace(a.begin(), a.back());
+        REQUIRE(a.front().value == 9);
+        REQUIRE(Tracked::s_aliveCount == 12 - 3 + 3);
+
+        b = a;
+        a.clear();
+        REQUIRE(Tracked::s_aliveCount == static_cast<int>(b.size()));
+    }
+    REQUIRE(Tracked::s_aliveCount == 0);
+}
+
+TEST_CASE("SmallVector matches std::vector", "[common][smallvector]")
+{
+    SECTION("trivially relocatable")
+    {
+        checkAgainstStdVector<int, 4>([](int step) { return step; });
+    }
+
+    SECTION("non-trivial")
+    {
+        // Long enough to not fit the small string buffer
+        checkAgainstStdVector<std::string, 4>([](int step) { return std::string(20, 'a') + std::to_string(step); });
+    }
+
+    SECTION("no inline storage")
+    {
+        checkAgainstStdVector<Tracked, 0>([](int step) { return Tracked{ step }; });
+    }
+}
+
+TEST_CASE("SmallVector benchmark", "[common][smallvector][!benchmark]")
+{
+    BENCHMARK("LegacySmallVector push 6 inline")
+    {
+        LegacySmallVector<uint32_t> values;
+        for (uint32_t i = 0; i < 6; i++)
+        {
+            values.push_back(i);
+        }
+        return values.size();
+    };
+
+    BENCHMARK("SmallVector push 6 inline")
+    {
+        SmallVector<uint32_t> values;
+        for (uint32_t i = 0; i < 6; i++)
+        {
+            values.push_back(i);
+        }
+        return values.size();
+    };
+
+    BENCHMARK("LegacySmallVector push 64")
+    {
+        LegacySmallVector<uint32_t> values;
+        for (uint32_t i = 0; i < 64; i++)
+        {
+            values.push_back(i);
+        }
+        return values.size();
+    };
+
+    BENCHMARK("SmallVector push 64")
+    {
+        SmallVector<uint32_t> values;
+        for (uint32_t i = 0; i < 64; i++)
+        {
+            values.push_back(i);
+        }
+        return values.size();
+    };
+
+    LegacySmallVector<uint64_t> legacyInline;
+    SmallVector<uint64_t> smallInline;
+    for (uint64_t i = 0; i < 4; i++)
+    {
+        legacyInline.push_back(i);
+        smallInline.push_back(i);
+    }
+
+    BENCHMARK("LegacySmallVector move 4 inline")
+    {
+        LegacySmallVector<uint64_t> moved{ std::move(legacyInline) };
+        legacyInline = std::move(moved);
+        return legacyInline.size();
+    };
+
+    BENCHMARK("SmallVector move 4 inline")
+    {
+        SmallVector<uint64_t> moved{ std::move(smallInline) };
+        smallInline = std::move(moved);
+        return smallInline.size();
+    };
+
+    std::vector<LegacySmallVector<uint32_t>> legacyVectors;
+    std::vector<SmallVector<uint32_t>> smallVectors;
+    BENCHMARK("LegacySmallVector relocate 256 vectors")
+    {
+        legacyVectors.clear();
+        legacyVectors.shrink_to_fit();
+        for (int i = 0; i < 256; i++)
+        {
+            legacyVectors.emplace_back().push_back(i);
+        }
+        return legacyVectors.size();
+    };
+
+    BENCHMARK("SmallVector relocate 256 vectors")
+    {
+        smallVectors.clear();
+        smallVectors.shrink_to_fit();
+        for (int i = 0; i < 256; i++)
+        {
+            smallVectors.emplace_back().push_back(i);
+        }
+        return smallVectors.size();
+    };
+}
@@ -0,0 +1,156 @@
+#include "resource/upload/stagingRing.h"
+
+#include <algorithm>
+#include <catch2/catch_all.hpp>
+#include <cstdint>
+#include <vector>
+
+using namespace aph;
+
+namespace
+{
+// Batches complete when the test says so, waiting on one completes it and everything submitted before it
+struct MockBackend : StagingRingBackend
+{
+    auto isBatchComplete(uint64_t batchId) -> bool override
+    {
+        return batchId <= completedBatchId;
+    }
+
+    void waitBatch(uint64_t batchId) override
+    {
+        waitedBatchIds.push_back(batchId);
+        completedBatchId = std::max(completedBatchId, batchId);
+    }
+
+    uint64_t completedBatchId = 0;
+    std::vector<uint64_t> waitedBatchIds;
+};
+} // namespace
+
+TEST_CASE("StagingRing sub-allocation", "[resource][staging]")
+{
+    constexpr std::size_t capacity = 1024;
+    std::vector<std::byte> memory(capacity);
+    MockBackend backend;
+    StagingRing ring{ &backend, memory.data(), capacity };
+
+    SECTION("allocations are aligned and don't overlap")
+    {
+        std::size_t previousEnd = 0;
+        for (std::size_t alignment : { 1, 4, 16, 64, 256 })
+        {
+            auto allocation = ring.allocate(10, alignment);
+            REQUIRE(allocation);
+            REQUIRE(allocation->offset % alignment == 0);
+            REQUIRE(allocation->offset >= previousEnd);
+            REQUIRE(allocation->pData == memory.data() + allocation->offset);
+            previousEnd = allocation->offset + 10;
+        }
+        REQUIRE(ring.getOpenSize() == previousEnd);
+    }
+
+    SECTION("requests larger than the ring fail")
+    {
+        REQUIRE_FALSE(ring.allocate(capacity + 1, 1));
+        REQUIRE(ring.allocate(capacity, 1));
+    }
+
+    SECTION("the open batch can't be waited for")
+    {
+        REQUIRE(ring.allocate(800, 16));
+        REQUIRE_FALSE(ring.allocate(300, 16));
+        REQUIRE(backend.waitedBatchIds.empty());
+
+        // Once it is submitted and done, its space is reused from the start
+        ring.closeBatch(1);
+        backend.completedBatchId = 1;
+        auto allocation          = ring.allocate(300, 16);
+        REQUIRE(allocation);
+        REQUIRE(allocation->offset == 0);
+        REQUIRE(backend.waitedBatchIds.empty());
+    }
+}
+
+TEST_CASE("StagingRing reclamation", "[resource][staging]")
+{
+    constexpr std::size_t capacity = 1024;
+    std::vector<std::byte> memory(capacity);
+    MockBackend backend;
+    StagingRing ring{ &backend, memory.data(), capacity };
+
+    SECTION("completed batches are reclaimed in order")
+    {
+        for (uint64_t batchId = 1; batchId <= 4; batchId++)
+        {
+            REQUIRE(ring.allocate(200, 1));
+            ring.closeBatch(batchId);
+        }
+        REQUIRE(ring.getInFlightBatchCount() == 4);
+        REQUIRE(ring.getUsedSize() == 800);
+
+        backend.completedBatchId = 2;
+        ring.reclaim();
+        REQUIRE(ring.getInFlightBatchCount() == 2);
+        REQUIRE(ring.getUsedSize() == 400);
+        REQUIRE(ring.getCompletedBatchId() == 2);
+
+        ring.wait(3);
+        REQUIRE(backend.waitedBatchIds == std::vector<uint64_t>{ 3 });
+        REQUIRE(ring.getInFlightBatchCount() == 1);
+
+        ring.waitIdle();
+        REQUIRE(ring.getInFlightBatchCount() == 0);
+        REQUIRE(ring.getUsedSize() == 0);
+    }
+
+    SECTION("a full ring waits for the oldest batch only")
+    {
+        for (uint64_t batchId = 1; batchId <= 4; batchId++)
+        {
+            REQUIRE(ring.allocate(256, 1));
+            ring.closeBatch(batchId);
+        }
+
+        auto allocation = ring.allocate(256, 1);
+        REQUIRE(allocation);
+        REQUIRE(allocation->offset == 0);
+        REQUIRE(backend.waitedBatchIds == std::vector<uint64_t>{ 1 });
+        REQUIRE(ring.getInFlightBatchCount() == 3);
+    }
+
+    SECTION("allocations skip the end of the ring instead of wrapping")
+    {
+        REQUIRE(ring.allocate(700, 1));
+        ring.closeBatch(1);
+        REQUIRE(ring.allocate(200, 1));
+        ring.closeBatch(2);
+
+        // 124 bytes are left at the end, the request goes to the front once batch 1 is done
+        backend.completedBatchId = 1;
+        auto allocation          = ring.allocate(300, 1);
+        REQUIRE(allocation);
+        REQUIRE(allocation->offset == 0);
+        REQUIRE(backend.waitedBatchIds.empty());
+        REQUIRE(ring.getUsedSize() == 200 + 124 + 300);
+    }
+
+    SECTION("many small uploads cycle through the ring")
+    {
+        uint64_t batchId = 0;
+        for (int frame = 0; frame < 1000; frame++)
+        {
+            for (int i = 0; i < 7; i++)
+            {
+                auto allocation = ring.allocate(48, 16);
+                REQUIRE(allocation);
+                REQUIRE(allocation->offset + 48 <= capacity);
+            }
+            ring.closeBatch(++batchId);
+            // The GPU lags two batches behind
+            backend.completedBatchId = batchId > 2 ? batchId - 2 : 0;
+        }
+        REQUIRE(ring.getUsedSize() <= capacity);
+        REQUIRE(ring.getInFlightBatchCount() <= 3);
+    }
+}
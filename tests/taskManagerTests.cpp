@@ -0,0 +1,285 @@
+#include "threads/taskManager.h"
+
+#include <algorithm>
+#include <atomic>
+#include <catch2/catch_all.hpp>
+#include <cmath>
+#include <format>
+#include <mutex>
+#include <numeric>
+#include <vector>
+
+using namespace aph;
+
+namespace
+{
+auto countTask(std::atomic<uint32_t>* pCounter) -> TaskType
+{
+    pCounter->fetch_add(1, std::memory_order_relaxed);
+    co_return Result::Success;
+}
+
+auto recordTask(std::vector<int>* pOrder, std::mutex* pLock, int value) -> TaskType
+{
+    std::lock_guard<std::mutex> lock{ *pLock };
+    pOrder->push_back(value);
+    co_return Result::Success;
+}
+} // namespace
+
+TEST_CASE("TaskManager runs task groups in dependency order", "[threads][taskmanager]")
+{
+    TaskManager taskManager{ 4 };
+
+    SECTION("groups submitted before their producers")
+    {
+        std::vector<int> order;
+        std::mutex lock;
+
+        auto* pFirst  = taskManager.createTaskGroup("first");
+        auto* pSecond = taskManager.createTaskGroup("second");
+        auto* pThird  = taskManager.createTaskGroup("third");
+        for (int i = 0; i < 16; ++i)
+        {
+            pFirst->addTask(recordTask(&order, &lock, 0));
+            pSecond->addTask(recordTask(&order, &lock, 1));
+            pThird->addTask(recordTask(&order, &lock, 2));
+        }
+        pThird->waitFor(pFirst);
+        pThird->waitFor(pSecond);
+        pSecond->waitFor(pFirst);
+
+        auto thirdDone  = pThird->submitAsync();
+        auto secondDone = pSecond->submitAsync();
+        auto firstDone  = pFirst->submitAsync();
+
+        REQUIRE(taskManager.wait(thirdDone).success());
+        REQUIRE(taskManager.wait(secondDone).success());
+        REQUIRE(taskManager.wait(firstDone).success());
+        REQUIRE(order.size() == 48);
+        REQUIRE(std::ranges::is_sorted(order));
+    }
+
+    SECTION("failures and exceptions are reported")
+    {
+        auto* pGroup = taskManager.createTaskGroup("failing");
+        pGroup->addTask([]() -> TaskType { co_return { Result::RuntimeError, "task failed" }; }());
+        pGroup->addTask(
+            []() -> TaskType
+            {
+                throw std::runtime_error("task threw");
+                co_return Result::Success;
+            }());
+        REQUIRE_FALSE(pGroup->submit().success());
+
+        // the group can be reused once its submission completed
+        std::atomic<uint32_t> counter{ 0 };
+        pGroup->addTask(countTask(&counter));
+        REQUIRE(pGroup->submit().success());
+        REQUIRE(counter.load() == 1);
+    }
+
+    SECTION("empty groups still resolve their dependents")
+    {
+        std::atomic<uint32_t> counter{ 0 };
+        auto* pEmpty    = taskManager.createTaskGroup("empty");
+        auto* pConsumer = taskManager.createTaskGroup("consumer");
+        pConsumer->addTask(countTask(&counter));
+        pConsumer->waitFor(pEmpty);
+
+        auto consumerDone = pConsumer->submitAsync();
+        REQUIRE(pEmpty->submit().success());
+        REQUIRE(taskManager.wait(consumerDone).success());
+        REQUIRE(counter.load() == 1);
+    }
+
+    SECTION("nested submissions from tasks don't block the pool")
+    {
+        std::atomic<uint32_t> counter{ 0 };
+        auto* pOuter = taskManager.createTaskGroup("outer");
+        for (int i = 0; i < 16; ++i)
+        {
+            pOuter->addTask(
+                [](TaskManager* pTaskManager, std::atomic<uint32_t>* pCounter) -> TaskType
+                {
+                    auto* pInner = pTaskManager->createTaskGroup("inner");
+                    for (int j = 0; j < 16; ++j)
+                    {
+                        pInner->addTask(countTask(pCounter));
+                    }
+                    co_return pInner->submit();
+                }(&taskManager, &counter));
+        }
+        REQUIRE(pOuter->submit().success());
+        REQUIRE(counter.load() == 256);
+    }
+}
+
+TEST_CASE("TaskManager job graph benchmark", "[threads][taskmanager][!benchmark]")
+{
+    // 100k tiny tasks spread over groups that each wait for the previous group and one a few steps back
+    constexpr uint32_t GroupCount    = 1000;
+    constexpr uint32_t TasksPerGroup = 100;
+
+    for (uint32_t threadCount : { 1u, 4u, 16u })
+    {
+        TaskManager taskManager{ threadCount };
+        BENCHMARK(std::format("{} tasks in a DAG of {} groups, {} threads", GroupCount * TasksPerGroup, GroupCount,
+                              threadCount))
+        {
+            std::atomic<uint32_t> counter{ 0 };
+            std::vector<TaskGroup*> groups;
+            for (uint32_t groupIndex = 0; groupIndex < GroupCount; ++groupIndex)
+            {
+                auto* pGroup = taskManager.createTaskGroup("dag");
+                for (uint32_t taskIndex = 0; taskIndex < TasksPerGroup; ++taskIndex)
+                {
+                    pGroup->addTask(countTask(&counter));
+                }
+                if (groupIndex >= 1)
+                {
+                    pGroup->waitFor(groups[groupIndex - 1]);
+                }
+                if (groupIndex >= 7)
+                {
+                    pGroup->waitFor(groups[groupIndex - 7]);
+                }
+                groups.push_back(pGroup);
+            }
+
+            std::vector<std::future<Result>> submissions;
+            for (auto* pGroup : groups)
+            {
+                submissions.push_back(pGroup->submitAsync());
+            }
+            for (auto& submission : submissions)
+            {
+                std::ignore = taskManager.wait(submission);
+            }
+            return counter.load();
+        };
+        taskManager.cleanup();
+    }
+}
+
+TEST_CASE("TaskManager parallelFor and parallelReduce", "[threads][taskmanager][parallel]")
+{
+    TaskManager taskManager{ 4 };
+
+    SECTION("every index is visited once")
+    {
+        std::vector<std::atomic<uint32_t>> visits(10007);
+        taskManager.parallelFor(0, visits.size(), 7,
+                                [&](std::size_t index) { visits[index].fetch_add(1, std::memory_order_relaxed); });
+        REQUIRE(std::ranges::all_of(visits, [](const std::atomic<uint32_t>& count) { return count.load() == 1; }));
+
+        std::vector<uint32_t> chunkVisits(5000, 0);
+        taskManager.parallelFor(100, chunkVisits.size(), 64,
+                                [&](std::size_t chunkBegin, std::size_t chunkEnd)
+                                {
+                                    for (std::size_t index = chunkBegin; index < chunkEnd; ++index)
+                                    {
+                                        ++chunkVisits[index];
+                                    }
+                                });
+        for (std::size_t index = 0; index < chunkVisits.size(); ++index)
+        {
+            REQUIRE(chunkVisits[index] == (index >= 100 ? 1 : 0));
+        }
+    }
+
+    SECTION("reductions are deterministic")
+    {
+        auto harmonic = [&taskManager]()
+        {
+            return taskManager.parallelReduce(
+                0, 100000, 1000, 0.0,
+                [](std::size_t chunkBegin, std::size_t chunkEnd)
+                {
+                    double sum = 0.0;
+                    for (std::size_t index = chunkBegin; index < chunkEnd; ++index)
+                    {
+                        sum += 1.0 / static_cast<double>(index + 1);
+                    }
+                    return sum;
+                },
+                [](double lhs, double rhs) { return lhs + rhs; });
+        };
+
+        const double expected = harmonic();
+        for (int run = 0; run < 16; ++run)
+        {
+            REQUIRE(harmonic() == expected);
+        }
+    }
+
+    SECTION("exceptions reach the caller")
+    {
+        REQUIRE_THROWS_AS(taskManager.parallelFor(0, 1000, 1,
+                                                  [](std::size_t index)
+                                                  {
+                                                      if (index == 500)
+                                                      {
+                                                          throw std::runtime_error("iteration failed");
+                                                      }
+                                                  }),
+                          std::runtime_error);
+    }
+
+    SECTION("nested inside tasks")
+    {
+        std::atomic<uint32_t> counter{ 0 };
+        auto* pGroup = taskManager.createTaskGroup("nested parallel for");
+        for (int i = 0; i < 8; ++i)
+        {
+            pGroup->addTask(
+                [](TaskManager* pTaskManager, std::atomic<uint32_t>* pCounter) -> TaskType
+                {
+                    pTaskManager->parallelFor(0, 1000, 10, [pCounter](std::size_t)
+                                              { pCounter->fetch_add(1, std::memory_order_relaxed); });
+                    co_return Result::Success;
+                }(&taskManager, &counter));
+        }
+        REQUIRE(pGroup->submit().success());
+        REQUIRE(counter.load() == 8000);
+    }
+}
+
+TEST_CASE("TaskManager parallel primitives benchmark", "[threads][taskmanager][parallel][!benchmark]")
+{
+    std::vector<float> values(1 << 22);
+    std::iota(values.begin(), values.end(), 1.0f);
+
+    auto sumRange = [&values](std::size_t chunkBegin, std::size_t chunkEnd)
+    {
+        double sum = 0.0;
+        for (std::size_t index = chunkBegin; index < chunkEnd; ++index)
+        {
+            sum += std::sqrt(values[index]);
+        }
+        return sum;
+    };
+
+    BENCHMARK("serial reduce, 4M elements")
+    {
+        return sumRange(0, values.size());
+    };
+
+    for (uint32_t threadCount : { 1u, 4u, 16u })
+    {
+        TaskManager taskManager{ threadCount };
+        BENCHMARK(std::format("parallelReduce, 4M elements, {} threads", threadCount))
+        {
+            return taskManager.parallelReduce(0, values.size(), 1 << 14, 0.0, sumRange,
+                                              [](double lhs, double rhs) { return lhs + rhs; });
+        };
+
+        std::vector<float> output(values.size());
+        BENCHMARK(std::format("parallelFor, 4M elements, {} threads", threadCount))
+        {
+            taskManager.parallelFor(0, values.size(), 1 << 12,
+                                    [&](std::size_t index) { output[index] = std::sqrt(values[index]); });
+            return output[0];
+        };
+    }
+}
@@ -0,0 +1,370 @@
+#include "threads/mpmcQueue.h"
+#include "threads/mpscQueue.h"
+#include "threads/threadPool.h"
+#include "threads/threadSafeQueue.h"
+#include "threads/workStealingDeque.h"
+
+#include <algorithm>
+#include <atomic>
+#include <catch2/catch_all.hpp>
+#include <format>
+#include <latch>
+#include <semaphore>
+#include <thread>
+#include <vector>
+
+using namespace aph;
+
+namespace
+{
+// Baseline for the benchmark: one std::deque behind a mutex shared by every worker
+class LockedThreadPool
+{
+public:
+    explicit LockedThreadPool(uint32_t threadCount)
+    {
+        for (uint32_t i = 0; i < threadCount; ++i)
+        {
+            m_threads.emplace_back(
+                [this](const std::stop_token& stopToken)
+                {
+                    while (true)
+                    {
+                        m_signal.acquire();
+                        auto task = m_tasks.pop_front();
+                        if (!task)
+                        {
+                            if (stopToken.stop_requested())
+                            {
+                                break;
+                            }
+                            continue;
+                        }
+                        task.value()();
+                    }
+                });
+        }
+    }
+
+    ~LockedThreadPool()
+    {
+        for (auto& thread : m_threads)
+        {
+            thread.request_stop();
+        }
+        m_signal.release(static_cast<std::ptrdiff_t>(m_threads.size()));
+    }
+
+    void enqueueDetach(std::function<void()> task)
+    {
+        m_tasks.push_back(std::move(task));
+        m_signal.release();
+    }
+
+private:
+    ThreadSafeQueue<std::function<void()>> m_tasks;
+    std::counting_semaphore<> m_signal{ 0 };
+    std::vector<std::jthread> m_threads;
+};
+} // namespace
+
+TEST_CASE("WorkStealingDeque hands out every element once", "[threads][deque]")
+{
+    constexpr int ItemCount  = 100000;
+    constexpr int ThiefCount = 4;
+
+    // start small so the ring grows while thieves are reading it
+    WorkStealingDeque<int> deque{ 4 };
+    std::vector<std::atomic<int>> seen(ItemCount);
+    std::atomic<bool> done{ false };
+
+    std::vector<std::jthread> thieves;
+    for (int i = 0; i < ThiefCount; ++i)
+    {
+        thieves.emplace_back(
+            [&]
+            {
+                while (!done.load(std::memory_order_acquire) || !deque.empty())
+                {
+                    if (auto value = deque.steal())
+                    {
+                        seen[value.value()].fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+            });
+    }
+
+    for (int i = 0; i < ItemCount; ++i)
+    {
+        deque.push(i);
+        if (i % 3 == 0)
+        {
+            if (auto value = deque.pop())
+            {
+                seen[value.value()].fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+    while (auto value = deque.pop())
+    {
+        seen[value.value()].fetch_add(1, std::memory_order_relaxed);
+    }
+    done.store(true, std::memory_order_release);
+    thieves.clear();
+
+    REQUIRE(deque.empty());
+    REQUIRE(deque.capacity() > 4);
+    REQUIRE(std::ranges::all_of(seen, [](const std::atomic<int>& count) { return count.load() == 1; }));
+}
+
+TEST_CASE("MPMCQueue hands out every element once", "[threads][mpmc]")
+{
+    constexpr int ProducerCount    = 4;
+    constexpr int ConsumerCount    = 4;
+    constexpr int ItemsPerProducer = 25000;
+
+    MPMCQueue<int> queue{ 64 };
+    std::vector<std::atomic<int>> seen(ProducerCount * ItemsPerProducer);
+    std::atomic<int> consumed{ 0 };
+
+    SECTION("full queue rejects pushes")
+    {
+        MPMCQueue<int> small{ 2 };
+        REQUIRE(small.tryPush(1));
+        REQUIRE(small.tryPush(2));
+        REQUIRE_FALSE(small.tryPush(3));
+        REQUIRE(small.tryPop() == 1);
+        REQUIRE(small.tryPush(3));
+        REQUIRE(small.tryPop() == 2);
+        REQUIRE(small.tryPop() == 3);
+        REQUIRE_FALSE(small.tryPop().has_value());
+    }
+
+    SECTION("concurrent producers and consumers")
+    {
+        std::vector<std::jthread> threads;
+        for (int producer = 0; producer < ProducerCount; ++producer)
+        {
+            threads.emplace_back(
+                [&, producer]
+                {
+                    for (int i = 0; i < ItemsPerProducer; ++i)
+                    {
+                        while (!queue.tryPush(producer * ItemsPerProducer + i))
+                        {
+                            std::this_thread::yield();
+                        }
+                    }
+                });
+        }
+        for (int consumer = 0; consumer < ConsumerCount; ++consumer)
+        {
+            threads.emplace_back(
+                [&]
+                {
+                    while (consumed.load(std::memory_order_relaxed) < ProducerCount * ItemsPerProducer)
+                    {
+                        if (auto value = queue.tryPop())
+                        {
+                            seen[value.value()].fetch_add(1, std::memory_order_relaxed);
+                            consumed.fetch_add(1, std::memory_order_relaxed);
+                        }
+                    }
+                });
+        }
+        threads.clear();
+
+        REQUIRE(queue.empty());
+        REQUIRE(std::ranges::all_of(seen, [](const std::atomic<int>& count) { return count.load() == 1; }));
+    }
+}
+
+TEST_CASE("MPSCQueue keeps the order of each producer", "[threads][mpsc]")
+{
+    constexpr int ProducerCount    = 4;
+    constexpr int ItemsPerProducer = 25000;
+
+    SECTION("full queue rejects pushes")
+    {
+        MPSCQueue<std::unique_ptr<int>> small{ 2 };
+        auto value = std::make_unique<int>(3);
+        REQUIRE(small.tryPush(std::make_unique<int>(1)));
+        REQUIRE(small.tryPush(std::make_unique<int>(2)));
+        REQUIRE_FALSE(small.tryPush(std::move(value)));
+        REQUIRE(value);
+
+        std::vector<int> popped;
+        REQUIRE(small.consume([&popped](std::unique_ptr<int>&& item) { popped.push_back(*item); }) == 2);
+        REQUIRE(small.tryPush(std::move(value)));
+        REQUIRE(small.consume([&popped](std::unique_ptr<int>&& item) { popped.push_back(*item); }) == 1);
+        REQUIRE(popped == std::vector<int>{ 1, 2, 3 });
+        REQUIRE(small.empty());
+    }
+
+    SECTION("concurrent producers")
+    {
+        MPSCQueue<int> queue{ 64 };
+        std::vector<int> next(ProducerCount, 0);
+        int consumed = 0;
+        bool ordered = true;
+
+        std::vector<std::jthread> producers;
+        for (int producer = 0; producer < ProducerCount; ++producer)
+        {
+            producers.emplace_back(
+                [&queue, producer]
+                {
+                    for (int i = 0; i < ItemsPerProducer; ++i)
+                    {
+                        int value = producer * ItemsPerProducer + i;
+                        while (!queue.tryPush(std::move(value)))
+                        {
+                            std::this_thread::yield();
+                        }
+                    }
+                });
+        }
+        while (consumed < ProducerCount * ItemsPerProducer)
+        {
+            consumed += static_cast<int>(queue.consume(
+                [&](int value)
+                {
+                    const int producer = value / ItemsPerProducer;
+                    ordered            = ordered && value % ItemsPerProducer == next[producer]++;
+                }));
+        }
+        producers.clear();
+
+        REQUIRE(ordered);
+        REQUIRE(queue.empty());
+    }
+}
+
+TEST_CASE("ThreadPool runs every task", "[threads][threadpool]")
+{
+    ThreadPool<> pool{ 4 };
+    REQUIRE(pool.size() == 4);
+
+    SECTION("futures")
+    {
+        std::vector<std::future<int>> futures;
+        for (int i = 0; i < 1000; ++i)
+        {
+            futures.push_back(pool.enqueue([](int value) { return value * 2; }, i));
+        }
+        for (int i = 0; i < 1000; ++i)
+        {
+            REQUIRE(futures[i].get() == i * 2);
+        }
+
+        auto failing = pool.enqueue([]() -> int { throw std::runtime_error("task failed"); });
+        REQUIRE_THROWS_AS(failing.get(), std::runtime_error);
+    }
+
+    SECTION("tasks spawned from workers")
+    {
+        constexpr int RootCount  = 64;
+        constexpr int ChildCount = 256;
+
+        std::atomic<int> counter{ 0 };
+        std::latch finished{ RootCount * ChildCount };
+        for (int root = 0; root < RootCount; ++root)
+        {
+            pool.enqueueDetach(
+                [&]
+                {
+                    for (int child = 0; child < ChildCount; ++child)
+                    {
+                        pool.enqueueDetach(
+                            [&]
+                            {
+                                counter.fetch_add(1, std::memory_order_relaxed);
+                                finished.count_down();
+                            });
+                    }
+                });
+        }
+        finished.wait();
+        REQUIRE(counter.load() == RootCount * ChildCount);
+    }
+
+    SECTION("more external tasks than the injection queue holds")
+    {
+        constexpr int TaskCount = 20000;
+
+        std::latch finished{ TaskCount };
+        for (int i = 0; i < TaskCount; ++i)
+        {
+            pool.enqueueDetach([&finished] { finished.count_down(); });
+        }
+        finished.wait();
+    }
+}
+
+TEST_CASE("ThreadPool drains queued tasks on destruction", "[threads][threadpool]")
+{
+    std::atomic<int> counter{ 0 };
+    {
+        ThreadPool<> pool{ 2 };
+        for (int i = 0; i < 1000; ++i)
+        {
+            pool.enqueueDetach([&counter] { counter.fetch_add(1, std::memory_order_relaxed); });
+        }
+    }
+    REQUIRE(counter.load() == 1000);
+}
+
+// Divide the task count by the reported mean to get tasks/sec
+TEST_CASE("ThreadPool throughput benchmark", "[threads][threadpool][!benchmark]")
+{
+    constexpr int TaskCount = 10000;
+
+    auto tinyTask = [](std::atomic<uint64_t>& sink, std::latch& finished)
+    {
+        sink.fetch_add(1, std::memory_order_relaxed);
+        finished.count_down();
+    };
+
+    for (uint32_t threadCount : { 1u, 2u, 4u, 8u, 16u, 32u, 64u })
+    {
+        std::atomic<uint64_t> sink{ 0 };
+
+        {
+            LockedThreadPool pool{ threadCount };
+            BENCHMARK(std::format("mutex queue, {} tasks, {} threads", TaskCount, threadCount))
+            {
+                std::latch finished{ TaskCount };
+                for (int i = 0; i < TaskCount; ++i)
+                {
+                    pool.enqueueDetach([&] { tinyTask(sink, finished); });
+                }
+                finished.wait();
+            };
+        }
+
+        ThreadPool<> pool{ threadCount };
+        BENCHMARK(std::format("work stealing, external submit, {} tasks, {} threads", TaskCount, threadCount))
+        {
+            std::latch finished{ TaskCount };
+            for (int i = 0; i < TaskCount; ++i)
+            {
+                pool.enqueueDetach([&] { tinyTask(sink, finished); });
+            }
+            finished.wait();
+        };
+
+        BENCHMARK(std::format("work stealing, nested spawn, {} tasks, {} threads", TaskCount, threadCount))
+        {
+            std::latch finished{ TaskCount };
+            pool.enqueueDetach(
+                [&]
+                {
+                    for (int i = 0; i < TaskCount; ++i)
+                    {
+                        pool.enqueueDetach([&] { tinyTask(sink, finished); });
+                    }
+                });
+            finished.wait();
+        };
+    }
+}
@@ -0,0 +1,236 @@
+#include "cli/cli.h"
+#include "common/binaryLog.h"
+
+#include <cmath>
+#include <ctime>
+
+namespace
+{
+enum class OutputFormat : uint8_t
+{
+    Text,
+    Json,
+};
+
+auto getLevelName(aph::Logger::Level level, OutputFormat format) -> std::string_view
+{
+    switch (level)
+    {
+    case aph::Logger::Level::Debug:
+        return format == OutputFormat::Text ? "D" : "debug";
+    case aph::Logger::Level::Info:
+        return format == OutputFormat::Text ? "I" : "info";
+    case aph::Logger::Level::Warn:
+        return format == OutputFormat::Text ? "W" : "warn";
+    case aph::Logger::Level::Error:
+        return format == OutputFormat::Text ? "E" : "error";
+    default:
+        return "?";
+    }
+}
+
+// Local time with milliseconds, like the logger prints it
+auto formatTime(int64_t systemTime) -> std::string
+{
+    const std::time_t seconds = static_cast<std::time_t>(systemTime / 1'000'000'000);
+    const auto milliseconds   = static_cast<int>(systemTime / 1'000'000 % 1000);
+    const std::tm tm          = *std::localtime(&seconds);
+
+    std::array<char, 32> buffer;
+    const std::size_t size = std::strftime(buffer.data(), buffer.size(), "%Y-%m-%d %H:%M:%S", &tm);
+    return std::format("{}.{:03}", std::string_view{ buffer.data(), size }, milliseconds);
+}
+
+void appendJsonString(std::string& out, std::string_view value)
+{
+    out += '"';
+    for (const char c : value)
+    {
+        switch (c)
+        {
+        case '"':
+            out += "\\\"";
+            break;
+        case '\\':
+            out += "\\\\";
+            break;
+        case '\n':
+            out += "\\n";
+            break;
+        case '\r':
+            out += "\\r";
+            break;
+        case '\t':
+            out += "\\t";
+            break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20)
+            {
+                out += std::format("\\u{:04x}", static_cast<uint32_t>(c));
+            }
+            else
+            {
+                out += c;
+            }
+            break;
+        }
+    }
+    out += '"';
+}
+
+void appendJsonArg(std::string& out, const aph::BinaryLogArg& arg)
+{
+    switch (arg.encoding)
+    {
+    case aph::detail::LogArgEncoding::Signed:
+        out += std::to_string(static_cast<int64_t>(arg.integer));
+        break;
+    case aph::detail::LogArgEncoding::Unsigned:
+        out += std::to_string(arg.integer);
+        break;
+    case aph::detail::LogArgEncoding::Float:
+        // JSON has no infinities or NaNs
+        out += std::isfinite(arg.floating) ? std::format("{}", arg.floating) : "null";
+        break;
+    case aph::detail::LogArgEncoding::String:
+        appendJsonString(out, arg.string);
+        break;
+    case aph::detail::LogArgEncoding::Pointer:
+        out += std::format("\"{:#x}\"", arg.integer);
+        break;
+    }
+}
+
+// One object per line, so huge logs can be processed line by line
+void appendJson(std::string& out, const aph::BinaryLogMessage& message)
+{
+    // Tags are written as their "[TAG] " prefix
+    std::string_view tag = message.tag;
+    if (tag.starts_with('[') && tag.ends_with("] "))
+    {
+        tag = tag.substr(1, tag.size() - 3);
+    }
+
+    out += std::format(R"({{"time":"{}","time_ns":{},"level":"{}","tag":)", formatTime(message.systemTime),
+                       message.systemTime, getLevelName(message.level, OutputFormat::Json));
+    appendJsonString(out, tag);
+    out += R"(,"format":)";
+    appendJsonString(out, message.format);
+    out += R"(,"message":)";
+    appendJsonString(out, aph::formatBinaryLogMessage(message));
+    out += R"(,"args":[)";
+    for (std::size_t i = 0; i < message.args.size(); i++)
+    {
+        if (i > 0)
+        {
+            out += ',';
+        }
+        appendJsonArg(out, message.args[i]);
+    }
+    out += "]}\n";
+}
+
+void appendText(std::string& out, const aph::BinaryLogMessage& message)
+{
+    out += std::format("[{}] [{}] {}", formatTime(message.systemTime), getLevelName(message.level, OutputFormat::Text),
+                       message.tag);
+    out += aph::formatBinaryLogMessage(message);
+    out += '\n';
+}
+
+void printUsage()
+{
+    std::cerr << "Usage: log_decoder [--format text|json] [--output <file>] <binary log file>\n"
+                 "Decodes a log written by Logger::setBinaryLogFile(). JSON is written as one object per line.\n";
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    OutputFormat format = OutputFormat::Text;
+    std::string outputPath;
+    bool validArguments = true;
+
+    aph::CLICallbacks callbacks;
+    callbacks.setErrorHandler(
+        [&validArguments](const aph::CLIErrorInfo& info)
+        {
+            std::cerr << info.message << "\n";
+            validArguments = false;
+        });
+    callbacks.add("--format",
+                  [&](const aph::CLIParser& parser)
+                  {
+                      const auto value = parser.nextString();
+                      if (value && value.value() == "text")
+                      {
+                          format = OutputFormat::Text;
+                      }
+                      else if (value && value.value() == "json")
+                      {
+                          format = OutputFormat::Json;
+                      }
+                      else
+                      {
+                          validArguments = false;
+                      }
+                  });
+    callbacks.add("--output",
+                  [&](const aph::CLIParser& parser)
+                  {
+                      const auto value = parser.nextString();
+                      validArguments   = validArguments && value.success();
+                      outputPath       = value.valueOr(std::string_view{});
+                  });
+
+    // The options are taken out of argv, the input file is left
+    int exitCode = 0;
+    if (!callbacks.parse(argc, argv, exitCode) || !validArguments || argc != 2)
+    {
+        printUsage();
+        return 1;
+    }
+
+    aph::BinaryLogReader reader;
+    if (aph::Result result = reader.open(argv[1]); !result.success())
+    {
+        std::cerr << result.toString() << "\n";
+        return 1;
+    }
+
+    std::ofstream outputFile;
+    if (!outputPath.empty())
+    {
+        outputFile.open(outputPath, std::ofstream::out | std::ofstream::trunc);
+        if (!outputFile.is_open())
+        {
+            std::cerr << "Failed to open output file: " << outputPath << "\n";
+            return 1;
+        }
+    }
+    std::ostream& output = outputPath.empty() ? std::cout : outputFile;
+
+    std::string line;
+    const aph::Result result = reader.read(
+        [&](const aph::BinaryLogMessage& message)
+        {
+            line.clear();
+            if (format == OutputFormat::Json)
+            {
+                appendJson(line, message);
+            }
+            else
+            {
+                appendText(line, message);
+            }
+            output.write(line.data(), static_cast<std::streamsize>(line.size()));
+        });
+    output.flush();
+
+    if (!result.success())
+    {
+        std::cerr << result.toString() << "\n";
+        return 1;
+    }
+    return 0;
+}